@@ -117,7 +117,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <EasySMU_IOpanel.h>
 #endif
 
-void DelayAndUserInput(uint32_t delay);
+void ServiceUserInput();
+void PrintSettleProgress(uint8_t iteration, float flt_measured);
 
 //# Define
 //# ==================================
@@ -152,6 +153,20 @@ EasySMU SMU[8] =
   EasySMU(I2C_Board7_EEPROM_ADDR0, I2C_Board7_LTC2655_LLL_ADDR0, I2C_Board7_LTC2485_Vout_LF_ADDR0, I2C_Board7_LTC2485_Iout_LH_ADDR0)
 };
 
+//! LTC2485 global address of each board. Every board sits behind its own LTC4316 address translator, which also
+//! translates the global address, so the voltage and current ADCs of a board share one global address and each board needs its own.
+const uint8_t LTC2485_global_address[8] =
+{
+  I2C_Board0_LTC2485_Vout_LF_Global,
+  I2C_Board1_LTC2485_Vout_LF_Global,
+  I2C_Board2_LTC2485_Vout_LF_Global,
+  I2C_Board3_LTC2485_Vout_LF_Global,
+  I2C_Board4_LTC2485_Vout_LF_Global,
+  I2C_Board5_LTC2485_Vout_LF_Global,
+  I2C_Board6_LTC2485_Vout_LF_Global,
+  I2C_Board7_LTC2485_Vout_LF_Global
+};
+
 #ifndef ENABLE_CALIBRATION
 EasySMU_IOpanel IOpanel; //!< IOpanel provides an interface between the EasySMU hardware and a touchscreen
 #endif
@@ -223,14 +238,18 @@ Where indicated, 'x' is substituted with 0-7, a number corresponding to the appr
 |*IDN or *IDN?  | Return ID string that includes revision, channels that are present, serial number of each channel, etc. |
 |LCD:ENA        | Enable the LCD/TFT display (default) |
 |LCD:DIS        | Disable the LCD/TFT display. This might be useful to reduce noise at the output caused by SPI communication with the screen. |
+|LCD:TIM        | Report the time (in microseconds) and number of characters spent redrawing the LCD/TFT display during the last ADC conversion period. |
 |CHx:DIS        | Disable the output to put it in a relatively high-impedance state. |
 |CHx:ENA        | Enable the channel. (Default state) |
 |CHx:VOL value  | Set the output voltage to 'value' in volts |
 |CHx:CUR value  | Set the output current to 'current' in amps. If current is preceeded by '+' or '-' it will force source or sink only operation. |
+|CHx:VCL value  | Closed-loop version of CHx:VOL. Corrects the setting until the measured output voltage is 'value'. Prints '#iteration,measurement' after each iteration, then returns the measurement, iterations and settling time in ms. |
+|CHx:CCL value  | Closed-loop version of CHx:CUR, with the same '+' and '-' prefixes. Corrects the setting until the measured output current is 'value'. Reports like CHx:VCL, with the current in amps to 1 uA. |
 |CHx:CAL:SET    | Calibration routine. (Factory use only. Disabled by default.) |
 |CHx:CAL:RES    | Restore factory calibration. (Only useful if the user has overwritten the calibration, which is not possible without editing the firmware.) |
 |CHx:MEA:VOL    | Returns the measured output voltage in volts. |
 |CHx:MEA:CUR    | Returns the measured output current in amps. |
+|CHx:MEA:SMP    | Returns the number of samples completed by the round-robin poll and millis(). Two queries give the sample rate of the channel. |
 */
 void ParseSerialData(char chrSerialData[] //!< data received from the serial interface
                     )
@@ -315,18 +334,27 @@ void ParseSerialData(char chrSerialData[] //!< data received from the serial int
       break;
     case SERIAL_1_LCD:
 #ifndef ENABLE_CALIBRATION
-#define SERIAL_COMMANDS_SIZE_LCD 2
+#define SERIAL_COMMANDS_SIZE_LCD 3
       const char SerialCommands_LCD[SERIAL_COMMANDS_SIZE_LCD][3]=
       {
         {'D','I','S'},
-        {'E','N','A'}
+        {'E','N','A'},
+        {'T','I','M'}
       };
-      enum {SERIAL_LCD_DIS=0, SERIAL_LCD_ENA=1};
-      if (getToken(chrSerialData, SerialCommands_LCD, SERIAL_COMMANDS_SIZE_LCD)==SERIAL_LCD_DIS)
+      enum {SERIAL_LCD_DIS=0, SERIAL_LCD_ENA=1, SERIAL_LCD_TIM=2};
+      int16_t lcd_command;
+      lcd_command=getToken(chrSerialData, SerialCommands_LCD, SERIAL_COMMANDS_SIZE_LCD);
+      if (lcd_command==SERIAL_LCD_DIS)
       {
         IOpanel.enabled_=0;
         Serial.println(F("Disabled"));
       }
+      else if (lcd_command==SERIAL_LCD_TIM)
+      {
+        Serial.print(IOpanel.frame_time_);
+        Serial.print(F("us,"));
+        Serial.println(IOpanel.frame_glyphs_);
+      }
       else
       {
         IOpanel.enabled_=1;
@@ -337,7 +365,7 @@ void ParseSerialData(char chrSerialData[] //!< data received from the serial int
       //break;
   }
 
-#define SERIAL_COMMANDS_SIZE_12 6
+#define SERIAL_COMMANDS_SIZE_12 8
   const char SerialCommands_12[SERIAL_COMMANDS_SIZE_12][3]=
   {
     {'E','N','A'},
@@ -345,9 +373,11 @@ void ParseSerialData(char chrSerialData[] //!< data received from the serial int
     {'V','O','L'},
     {'C','U','R'},
     {'M','E','A'},
-    {'C','A','L'}
+    {'C','A','L'},
+    {'V','C','L'},
+    {'C','C','L'}
   };
-  enum {SERIAL_12_ENA=0, SERIAL_12_DIS=1, SERIAL_12_VOL=2, SERIAL_12_CUR=3, SERIAL_12_MEA=4, SERIAL_12_CAL=5};
+  enum {SERIAL_12_ENA=0, SERIAL_12_DIS=1, SERIAL_12_VOL=2, SERIAL_12_CUR=3, SERIAL_12_MEA=4, SERIAL_12_CAL=5, SERIAL_12_VCL=6, SERIAL_12_CCL=7};
 
   switch (getToken(chrSerialData, SerialCommands_12, SERIAL_COMMANDS_SIZE_12))
   {
@@ -419,16 +449,75 @@ void ParseSerialData(char chrSerialData[] //!< data received from the serial int
       }
       Serial.println(fValue,4);
       return;
+    case SERIAL_12_VCL:
+      {
+        fValue=atof(chrSerialData);
+        float flt_old=SMU[intSMUchan].fltReadVoltageSourceSetting();
+        SMU[intSMUchan].settle_progress_=PrintSettleProgress;
+        if (SMU[intSMUchan].fltSettleVoltageSource(fValue)) printError(_PRINT_ERROR_VOLTAGE_SOURCE_SETTING);
+        SMU[intSMUchan].settle_progress_=NULL;
+        float flt_new=SMU[intSMUchan].fltReadVoltageSourceSetting();
+#ifndef ENABLE_CALIBRATION
+        if (intSMUchan <= _CH3)
+        {
+          IOpanel.DisplayVoltageSourceSetting(intSMUchan,flt_old,flt_new);
+        }
+#endif
+        Serial.print(SMU[intSMUchan].flt_measured_voltage_,4);
+        Serial.print(',');
+        Serial.print(SMU[intSMUchan].settle_iterations_);
+        Serial.print(',');
+        Serial.println(SMU[intSMUchan].settle_time_);
+      }
+      return;
+    case SERIAL_12_CCL:
+      {
+        int8_t source_both_sink;
+        if (chrSerialData[0]=='+')
+        {
+          source_both_sink=_SOURCE_ONLY;
+          fValue=atof(chrSerialData+1);
+        }
+        else if (chrSerialData[0]=='-')
+        {
+          source_both_sink=_SINK_ONLY;
+          fValue=atof(chrSerialData+1);
+        }
+        else
+        {
+          source_both_sink=_SOURCE_AND_SINK;
+          fValue=atof(chrSerialData);
+        }
+
+        float flt_old=SMU[intSMUchan].fltReadCurrentSourceSetting();
+        SMU[intSMUchan].settle_progress_=PrintSettleProgress;
+        if (SMU[intSMUchan].fltSettleCurrentSource(fValue,source_both_sink)) printError(_PRINT_ERROR_CURRENT_SOURCE_SETTING);
+        SMU[intSMUchan].settle_progress_=NULL;
+        float flt_new=SMU[intSMUchan].fltReadCurrentSourceSetting();
+#ifndef ENABLE_CALIBRATION
+        if (intSMUchan <= _CH3)
+        {
+          IOpanel.DisplayCurrentSourceSetting(intSMUchan,flt_old,flt_new,source_both_sink);
+        }
+#endif
+        Serial.print(SMU[intSMUchan].flt_measured_current_,6);  //1 uA resolution against the 5 uA settle tolerance
+        Serial.print(',');
+        Serial.print(SMU[intSMUchan].settle_iterations_);
+        Serial.print(',');
+        Serial.println(SMU[intSMUchan].settle_time_);
+      }
+      return;
     case SERIAL_12_MEA:
       {
-#define SERIAL_COMMANDS_SIZE_121 2
+#define SERIAL_COMMANDS_SIZE_121 3
 
         const char SerialCommands_121[SERIAL_COMMANDS_SIZE_121][3]=
         {
           {'V','O','L'},
-          {'C','U','R'}
+          {'C','U','R'},
+          {'S','M','P'}
         };
-        enum {SERIAL_121_VOL=0, SERIAL_121_CUR=1};
+        enum {SERIAL_121_VOL=0, SERIAL_121_CUR=1, SERIAL_121_SMP=2};
 
         switch (getToken(chrSerialData, SerialCommands_121, SERIAL_COMMANDS_SIZE_121))
         {
@@ -447,6 +536,13 @@ void ParseSerialData(char chrSerialData[] //!< data received from the serial int
               Serial.println(sDisplay);
               return;
             }
+          case SERIAL_121_SMP:
+            {
+              Serial.print(SMU[intSMUchan].sample_count_);
+              Serial.print(',');
+              Serial.println(millis());
+              return;
+            }
         }
       }
     case SERIAL_12_CAL:
@@ -573,20 +669,25 @@ void SetCurrent()
 }
 #endif
 
-//! Wait for 'delay' milliseconds while handling button presses on the touchscreen.
-void DelayAndUserInput(uint32_t delay //!< Number of milliseconds to wait in this loop
-                      )
+//! Print one '#iteration,measurement' progress line from EasySMU::SettleSourceSetting(), so the ~2 s closed-loop settle of CHx:VCL and CHx:CCL is not silent.
+void PrintSettleProgress(uint8_t iteration, //!< iteration just measured, 1 for the open-loop setting
+                         float flt_measured //!< measured output in volts or amps
+                        )
 {
-  uint32_t end_time=millis()+delay;
+  Serial.print('#');
+  Serial.print(iteration);
+  Serial.print(',');
+  Serial.println(flt_measured,6);
+}
 
-  while ((int32_t)(millis()-end_time)<0)
-  {
+//! Handle button presses on the touchscreen. Called between ADC polls so the user interface stays responsive while measurements run.
+void ServiceUserInput()
+{
 #ifndef ENABLE_CALIBRATION
-    IOpanel.CheckButton();
-    if ((IOpanel.button_pressed_>=_VPLUS) && (IOpanel.button_pressed_<=_VMINUSMINUS)) SetVoltage();
-    if ((IOpanel.button_pressed_>=_IPLUS) && (IOpanel.button_pressed_<=_IMINUSMINUS)) SetCurrent();
+  IOpanel.CheckButton();
+  if ((IOpanel.button_pressed_>=_VPLUS) && (IOpanel.button_pressed_<=_VMINUSMINUS)) SetVoltage();
+  if ((IOpanel.button_pressed_>=_IPLUS) && (IOpanel.button_pressed_<=_IMINUSMINUS)) SetCurrent();
 #endif
-  }
 }
 
 //! Initialize the Linduino, EasySMU, screen, etc.
@@ -632,35 +733,56 @@ void setup()
 
   Serial.begin(9600);
 
+  //Let the conversions started above finish, then start both LTC2485s on each board with the board's global address so the boards are polled in step.
+  //A board that does not acknowledge keeps the conversion timing of its last measurement above.
+  delay(_LTC2485_CONVERSION_TIME);
+  for (int8_t iChan=_CH0; iChan <= _CH7; iChan++)
+  {
+    if ((SMU[iChan].present_ != 0) && (LTC2485_start_all(LTC2485_global_address[iChan], LTC2485_SPEED_1X | LTC2485_R60) == 0))
+      SMU[iChan].ConversionStarted();
+  }
 }
 
 //! Arduino/Linduino loop that runs continuously.
+//! The loop is a round-robin scheduler. The ADCs on every board convert continuously; each pass polls every present board
+//! for finished results (without waiting), and the serial port and touchscreen are serviced between polls. A board's display is
+//! updated as soon as its new sample is in, so the sample rate of each board does not drop as boards are added.
 void loop()
 {
-  //With this delay on every cycle, ideally the converters will never enter a time_out because they will finish conversion before polled each time.
-  DelayAndUserInput(_LTC2485_CONVERSION_TIME);
   for (int8_t iChan=_CH0; iChan<=_CH7; iChan++)
   {
     if (ReadLine(serial_data))
     {
       ParseSerialData(serial_data);
     }
+    ServiceUserInput();
     if (SMU[iChan].IsPresent()!=0)
     {
 #ifndef ENABLE_CALIBRATION
       float fltOldVout=SMU[iChan].flt_measured_voltage_;
       float fltOldIout=SMU[iChan].flt_measured_current_;
 #endif
-      SMU[iChan].MeasureVoltageCurrent();
-#ifndef ENABLE_CALIBRATION
-      if (iChan <= _CH3)
+      if (SMU[iChan].PollVoltageCurrent())
       {
-        IOpanel.DisplayMeasuredVoltage(iChan, fltOldVout, SMU[iChan].flt_measured_voltage_);
-        IOpanel.DisplayMeasuredCurrent(iChan, fltOldIout, SMU[iChan].flt_measured_current_);
-      }
+#ifndef ENABLE_CALIBRATION
+        if (iChan <= _CH3)
+        {
+          IOpanel.DisplayMeasuredVoltage(iChan, fltOldVout, SMU[iChan].flt_measured_voltage_);
+          IOpanel.DisplayMeasuredCurrent(iChan, fltOldIout, SMU[iChan].flt_measured_current_);
+        }
 #endif
+      }
     }
   }
+#ifndef ENABLE_CALIBRATION
+  //One display frame per ADC conversion period
+  static uint32_t next_frame=0;
+  if ((int32_t)(millis()-next_frame) >= 0)
+  {
+    IOpanel.EndFrame();
+    next_frame=millis()+_LTC2485_CONVERSION_TIME;
+  }
+#endif
 
   //Poll temperature once every ten seconds.
   /*  static uint32_t next_temperature_update=0;
@@ -146,9 +146,11 @@ void sneaker_port_init();
 uint8_t discover_DC2094(char *demo_name);
 void print_title();
 void print_prompt();
+
 void decode_values(uint32_t channel_data);
 void menu1_display_adc_output();
 void menu2_change_softspan_range();
+void menu3_burst_scan();
 
 //! Initialize Linduino
 void setup()
@@ -188,6 +190,9 @@ void loop()
       case 2:
         menu2_change_softspan_range();
         break;
+      case 3:
+        menu3_burst_scan();
+        break;
       default:
         Serial.println(F("Incorrect Option"));
     }
@@ -280,6 +285,7 @@ void print_prompt()
   Serial.print(F("\n\n\n\t\t\t\tOPTIONS\n"));
   Serial.print(F("\n1 - Display ADC output\n"));
   Serial.print(F("2 - Change configuration setting\n"));
+  Serial.print(F("3 - Burst scan enabled channels\n"));
 
   Serial.print(F("\nENTER A COMMAND: "));
 }
@@ -360,4 +366,43 @@ void menu2_change_softspan_range()
   Serial.println(config_word, HEX);
   configuration_bits.LT_uint32 = config_word;
   Serial.print(F("\nCONFIGURATION CHANGED!"));
-}
\ No newline at end of file
+}
+
+//! Captures a burst of frames and reports the achieved frame rate
+void menu3_burst_scan()
+{
+  const uint16_t num_frames = 8;
+  uint32_t codes[8][num_frames];
+  uint32_t *channel_data[8];
+  uint32_t elapsed_time;
+  uint8_t channel;
+
+  for (channel = 0; channel < 8; ++channel)
+  {
+    if ((configuration_bits.LT_uint32 >> (channel * 3)) & SOFTSPAN)
+      channel_data[channel] = codes[channel];
+    else
+      channel_data[channel] = NULL;
+  }
+
+  elapsed_time = LTC23XX_scan(QUIKEVAL_CS, configuration_bits.LT_uint32, num_frames, channel_data);
+
+  Serial.print(F("\nBytes per frame : "));
+  Serial.println(LTC23XX_frame_length(configuration_bits.LT_uint32));
+  Serial.print(F("Frames captured : "));
+  Serial.println(num_frames);
+  Serial.print(F("Frames/second   : "));
+  Serial.println(1000000.0 * num_frames / elapsed_time);
+  for (channel = 0; channel < 8; ++channel)
+  {
+    if (channel_data[channel] == NULL)
+      continue;
+    Serial.print(F("Channel "));
+    Serial.print(channel);
+    Serial.print(F(" last code : 0x"));
+    Serial.print(codes[channel][num_frames - 1], HEX);
+    Serial.print(F("\t"));
+    Serial.print(LTC23XX_voltage_calculator(codes[channel][num_frames - 1], (configuration_bits.LT_uint32 >> (channel * 3)) & SOFTSPAN), 6);
+    Serial.println(F(" V"));
+  }
+}
\ No newline at end of file
@@ -106,6 +106,7 @@ void menu_3_read_sequencer();
 void menu_4_select_bits();
 void menu_5_select_range();
 void menu_6_select_gain_compression();
+void menu_7_burst_read_sequencer();
 
 // Global variables
 static uint8_t adc_command;
@@ -173,6 +174,9 @@ void loop()
         case 6:
           menu_6_select_gain_compression();
           break;
+        case 7:
+          menu_7_burst_read_sequencer();
+          break;
         default:
           Serial.println("Invalid Option");
           break;
@@ -532,6 +536,47 @@ void menu_3_read_sequencer()
 }
 
 
+//! Load the same four configurations as menu 2 once, then capture them repeatedly
+//! @return void
+void menu_7_burst_read_sequencer()
+{
+  const uint8_t length = 4;
+  const uint16_t num_frames = 16;
+  uint8_t sequence[length];
+  uint32_t codes[length][num_frames];
+  uint32_t *results[length];
+  uint32_t elapsed_time;
+  uint8_t i;
+
+  sequence[0] = LTC2373_build_command(LTC2373_SEQUENCER_BIT, COMMAND_DIFF[3], LTC2373_RANGE_DIFF_BIPOLAR, LTC2373_NO_COMPRESSION);
+  sequence[1] = LTC2373_build_command(LTC2373_SEQUENCER_BIT, COMMAND_DIFF[6], LTC2373_RANGE_DIFF_BIPOLAR, LTC2373_NO_COMPRESSION);
+  sequence[2] = LTC2373_build_command(LTC2373_SEQUENCER_BIT, COMMAND_DIFF[4], LTC2373_RANGE_DIFF_UNIPOLAR, LTC2373_NO_COMPRESSION);
+  sequence[3] = LTC2373_build_command(LTC2373_SEQUENCER_BIT, COMMAND_SINGLE_ENDED[0], LTC2373_RANGE_UNIPOLAR, LTC2373_NO_COMPRESSION);
+  for (i = 0; i < length; i++)
+    results[i] = codes[i];
+
+  i2c_write_byte(I2C_ADDRESS, I2C_COMMAND);  //disable the CPLD communication
+  LTC2373_load_sequence(LTC2373_CS, sequence, length);
+  elapsed_time = LTC2373_scan(LTC2373_CS, length, num_frames, results);
+
+  Serial.print(F("    Sequences captured: "));
+  Serial.println(num_frames);
+  Serial.print(F("    Sequences/second: "));
+  Serial.println(1000000.0 * num_frames / elapsed_time);
+  for (i = 0; i < length; i++)
+  {
+    adc_code = codes[i][num_frames - 1];
+    adc_command = (adc_code >> 6) & 0x7F;
+    adc_voltage = LTC2373_code_to_voltage(adc_command, adc_code, LTC2373_vref);
+    Serial.print(F("    Register C"));
+    Serial.print(i);
+    Serial.print(F(" last voltage: "));
+    Serial.print(adc_voltage, 4);
+    Serial.println(F("V"));
+  }
+}
+
+
 //! Select number of bits
 //! @return void
 void menu_4_select_bits()
@@ -676,7 +721,8 @@ void print_prompt()
   Serial.println(F("  3-Read the Sequencer"));
   Serial.println(F("  4-Select Number of Bits (Default is 18 bits)"));
   Serial.println(F("  5-Select Range (Default is Single-Ended Unipolar Range)"));
-  Serial.println(F("  6-Select Gain Compression (Default is No Gain Compression)\n"));
+  Serial.println(F("  6-Select Gain Compression (Default is No Gain Compression)"));
+  Serial.println(F("  7-Burst Read the Sequencer\n"));
   Serial.println(F(""));
   Serial.print(F("  Enter a command: "));
 }
@@ -63,7 +63,7 @@ void print_title();                                         // Print the title b
 void print_prompt();
 void menu_1_read_input();
 void menu_2_select_gain_compression();
-void configureCNV();
+void menu_3_measure_throughput();
 
 // Global variables
 static uint8_t LTC2380_dgc = 0;         //!< Default set for no gain compression
@@ -77,7 +77,7 @@ void setup()
   quikeval_SPI_connect();        // Connect SPI to main data port
   Serial.begin(115200);          // Initialize the serial port to the PC
 
-  configureCNV();
+  LTC2380_init_cnv(LTC2380_CNV);
 
   print_title();
   print_prompt();
@@ -100,6 +100,9 @@ void loop()
       case 2:
         menu_2_select_gain_compression();
         break;
+      case 3:
+        menu_3_measure_throughput();
+        break;
       default:
         Serial.println("  Invalid Option");
         break;
@@ -116,8 +119,11 @@ void menu_1_read_input()
   int32_t adc_code;                           // The LTC2380 code
   float adc_voltage;
   int16_t cycles;
+  uint16_t n;
 
-  LTC2380_read(&adc_code, &cycles);
+  Serial.print("\nEnter the number of CNV pulses: ");
+  n = read_int();
+  LTC2380_read(n, &adc_code, &cycles);
   adc_voltage = LTC2380_code_to_voltage(adc_code, LTC2380_dgc, LTC2380_vref);    // Convert the received code to voltage
 
   Serial.print("\n24-bit decimal data: 0x ");
@@ -160,12 +166,51 @@ void menu_2_select_gain_compression()
   }
 }
 
+//! Measure sustained averaged throughput using continuous mode
+//! @return void
+void menu_3_measure_throughput()
+{
+  int32_t adc_code;
+  int16_t cycles;
+  uint16_t n;
+  uint16_t i;
+  uint32_t start_time, elapsed_time;
+  const uint16_t num_averages = 1000;
+
+  Serial.print("\nEnter the number of CNV pulses: ");
+  n = read_int();
+  if (n == 0)
+    n = 1;
+  Serial.println(n);
+
+  start_time = micros();
+  LTC2380_start_continuous(n);
+  for (i = 0; i < num_averages; i++)
+    LTC2380_read_continuous(&adc_code, &cycles);
+  elapsed_time = micros() - start_time;
+
+  Serial.print("Averages read: ");
+  Serial.println(num_averages);
+  Serial.print("Elapsed time: ");
+  Serial.print(elapsed_time);
+  Serial.println(" us");
+  Serial.print("Averaged output rate: ");
+  Serial.print(1000000.0 * num_averages / elapsed_time);
+  Serial.println(" averages/s");
+  Serial.print("Conversion rate: ");
+  Serial.print(1000000.0 * num_averages * n / elapsed_time);
+  Serial.println(" conversions/s");
+  Serial.print("No:of averaging cycles (last result): ");
+  Serial.println(cycles + 1);
+}
+
 //! Prints main menu.
 void print_prompt()
 {
   Serial.println(F("*************************"));
   Serial.println(F("1-Read ADC Input"));
   Serial.println(F("2-Select No Gain Compression / Gain Compression (default is no compression)"));
+  Serial.println(F("3-Measure Averaged Throughput"));
   Serial.print(F("Enter a command:"));
 }
 
@@ -183,9 +228,3 @@ void print_title()
   Serial.println(F("*                                                               *"));
   Serial.println(F("*****************************************************************"));
 }
-
-//! Function to configure CNV pin as an output
-void configureCNV()
-{
-  DDRB = DDRB | B00000100;       // Setting PB2 (CS) as output, connected to CNV pin.
-}
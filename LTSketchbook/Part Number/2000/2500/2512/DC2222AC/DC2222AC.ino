@@ -24,6 +24,13 @@ NOTES
    Option 1: Read 32 bits of data and calculate input analog voltage.
    Option 2: Set the DF value for filter.
    Option 3: Set the reference voltage.
+   Option 4: Stream filtered output words until a key is pressed. MCLK comes
+             from Timer1 and each word is read in the DRL interrupt.
+
+   Option 4 needs DRL wired to Linduino pin 2 (external interrupt 0). DRL is
+   not on the QuikEval connector, so add a jumper wire from DRL on the demo
+   board to pin 2 of the Linduino. MCLK is slowed below 1MHz when needed,
+   so that each word is read before the next one replaces it.
 
 USER INPUT DATA FORMAT:
  decimal : 1024
@@ -93,6 +100,9 @@ float VREF = 5.0;
 uint16_t global_config_data = CONFIG_DF_8;
 uint16_t num_of_mclk_pulses = 8;
 
+//! DRL is jumpered to Arduino pin 2 (external interrupt 0) for the streaming reader
+#define DRL_PIN 2
+
 // Function Declarations
 void sneaker_port_init();
 void initialise_i2c_data(uint16_t value, uint8_t i2c_data[48]);
@@ -132,6 +142,9 @@ void loop()
       case 3:
         menu_3_set_VREF();           // Sequencing menu
         break;
+      case 4:
+        menu_4_stream_data();
+        break;
       default:
         Serial.println("Incorrect Option");
         break;
@@ -204,6 +217,48 @@ void menu_3_set_VREF()
   Serial.println(F(" V"));
 }
 
+//! Streams filtered output words using the Timer1 MCLK and the DRL interrupt
+void menu_4_stream_data()
+{
+  uint16_t DF = 0;
+  uint32_t code = 0;
+  uint32_t num_words = 0;
+  uint32_t start_time, elapsed_time;
+  uint16_t mclk_period;
+
+  Serial.println(F("\n  Streaming, press any key to stop"));
+  while (Serial.available())
+    Serial.read();
+
+  mclk_period = LTC2512_mclk_timer_start(LTC25XX_MCLK_PERIOD_1MHZ, num_of_mclk_pulses);
+  LTC25XX_sync(QUIKEVAL_GPIO);
+  LTC2512_stream_start(DRL_PIN);
+  start_time = millis();
+  while (!Serial.available())
+  {
+    if (LTC2512_stream_read(&code, &DF) == 0)
+      num_words++;
+  }
+  elapsed_time = millis() - start_time;
+  LTC25XX_stream_stop(DRL_PIN);
+  LTC25XX_mclk_timer_stop();
+  read_int();
+
+  Serial.print(F("  Last code     : 0x"));
+  Serial.println(code, HEX);
+  Serial.print(F("  DF            : "));
+  Serial.println(DF);
+  Serial.print(F("  Words read    : "));
+  Serial.println(num_words);
+  Serial.print(F("  Words dropped : "));
+  Serial.println(LTC25XX_stream_overflows());
+  Serial.print(F("  MCLK          : "));
+  Serial.print(F_CPU / 1000.0 / mclk_period);
+  Serial.println(F(" kHz"));
+  Serial.print(F("  Output rate   : "));
+  Serial.print(1000.0 * num_words / elapsed_time);
+  Serial.println(F(" words/s"));
+}
 
 //! Send configuration data through sneaker port
 // Send I2C data to sneaker port to bit bang WRIN_I2C(CS) at P2,
@@ -300,5 +355,6 @@ void print_prompt()
   Serial.print(F("  1-Read Voltage input\n"));
   Serial.print(F("  2-Change DF\n"));
   Serial.print(F("  3-Set VREF\n"));
+  Serial.print(F("  4-Stream filtered output (timer MCLK)\n"));
   Serial.print(F("\nEnter a command:"));
-}
\ No newline at end of file
+}
\ No newline at end of file
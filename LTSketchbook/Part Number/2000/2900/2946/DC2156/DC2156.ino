@@ -272,15 +272,18 @@ int8_t menu_1_continuous_mode(uint8_t CTRLA,                    //!< CTRLA Regis
   //! Measurement is done by first reading the adc code and then converting it to the respective value.
   do
   {
+    LTC2946_snapshot snapshot;
+    ack |= LTC2946_read_snapshot(LTC2946_I2C_ADDRESS, &snapshot);             //! Read every register but the faults in three block transfers
+
     if (VOLTAGE_SEL != LTC2946_ADIN)
     {
 
       Serial.print(F("*************************\n\n"));
 
       uint32_t power_code, max_power_code, min_power_code;
-      ack |= LTC2946_read_24_bits(LTC2946_I2C_ADDRESS, LTC2946_POWER_MSB2_REG, &power_code);
-      ack |= LTC2946_read_24_bits(LTC2946_I2C_ADDRESS, LTC2946_MAX_POWER_MSB2_REG, &max_power_code);
-      ack |= LTC2946_read_24_bits(LTC2946_I2C_ADDRESS, LTC2946_MIN_POWER_MSB2_REG, &min_power_code);
+      power_code = LTC2946_snapshot_24_bits(&snapshot, LTC2946_POWER_MSB2_REG);
+      max_power_code = LTC2946_snapshot_24_bits(&snapshot, LTC2946_MAX_POWER_MSB2_REG);
+      min_power_code = LTC2946_snapshot_24_bits(&snapshot, LTC2946_MIN_POWER_MSB2_REG);
 
 
       float power, max_power, min_power;  // Store power results
@@ -307,9 +310,9 @@ int8_t menu_1_continuous_mode(uint8_t CTRLA,                    //!< CTRLA Regis
       Serial.println();
 
       uint32_t power_code, max_power_code, min_power_code;
-      ack |= LTC2946_read_24_bits(LTC2946_I2C_ADDRESS, LTC2946_POWER_MSB2_REG, &power_code);
-      ack |= LTC2946_read_24_bits(LTC2946_I2C_ADDRESS, LTC2946_MAX_POWER_MSB2_REG, &max_power_code);
-      ack |= LTC2946_read_24_bits(LTC2946_I2C_ADDRESS, LTC2946_MIN_POWER_MSB2_REG, &min_power_code);
+      power_code = LTC2946_snapshot_24_bits(&snapshot, LTC2946_POWER_MSB2_REG);
+      max_power_code = LTC2946_snapshot_24_bits(&snapshot, LTC2946_MAX_POWER_MSB2_REG);
+      min_power_code = LTC2946_snapshot_24_bits(&snapshot, LTC2946_MIN_POWER_MSB2_REG);
 
       float power, max_power, min_power;
       power = LTC2946_code_to_power(power_code, resistor, LTC2946_ADIN_DELTA_SENSE_lsb) * scale;
@@ -330,9 +333,9 @@ int8_t menu_1_continuous_mode(uint8_t CTRLA,                    //!< CTRLA Regis
     }
 
     uint16_t current_code, max_current_code, min_current_code;
-    ack |= LTC2946_read_12_bits(LTC2946_I2C_ADDRESS, LTC2946_DELTA_SENSE_MSB_REG, &current_code);
-    ack |= LTC2946_read_12_bits(LTC2946_I2C_ADDRESS, LTC2946_MAX_DELTA_SENSE_MSB_REG, &max_current_code);
-    ack |= LTC2946_read_12_bits(LTC2946_I2C_ADDRESS, LTC2946_MIN_DELTA_SENSE_MSB_REG, &min_current_code);
+    current_code = LTC2946_snapshot_12_bits(&snapshot, LTC2946_DELTA_SENSE_MSB_REG);
+    max_current_code = LTC2946_snapshot_12_bits(&snapshot, LTC2946_MAX_DELTA_SENSE_MSB_REG);
+    min_current_code = LTC2946_snapshot_12_bits(&snapshot, LTC2946_MIN_DELTA_SENSE_MSB_REG);
 
     float current, max_current, min_current;
     current = LTC2946_code_to_current(current_code, resistor, LTC2946_DELTA_SENSE_lsb);
@@ -352,9 +355,9 @@ int8_t menu_1_continuous_mode(uint8_t CTRLA,                    //!< CTRLA Regis
     Serial.print(F(" A\n"));
 
     uint16_t VIN_code, max_VIN_code, min_VIN_code;
-    ack |= LTC2946_read_12_bits(LTC2946_I2C_ADDRESS, LTC2946_VIN_MSB_REG, &VIN_code);
-    ack |= LTC2946_read_12_bits(LTC2946_I2C_ADDRESS, LTC2946_MAX_VIN_MSB_REG, &max_VIN_code);
-    ack |= LTC2946_read_12_bits(LTC2946_I2C_ADDRESS, LTC2946_MIN_VIN_MSB_REG, &min_VIN_code);
+    VIN_code = LTC2946_snapshot_12_bits(&snapshot, LTC2946_VIN_MSB_REG);
+    max_VIN_code = LTC2946_snapshot_12_bits(&snapshot, LTC2946_MAX_VIN_MSB_REG);
+    min_VIN_code = LTC2946_snapshot_12_bits(&snapshot, LTC2946_MIN_VIN_MSB_REG);
 
     float VIN, max_VIN, min_VIN;
     VIN = LTC2946_VIN_code_to_voltage(VIN_code , LTC2946_VIN_lsb);
@@ -374,9 +377,9 @@ int8_t menu_1_continuous_mode(uint8_t CTRLA,                    //!< CTRLA Regis
     Serial.print(F(" V\n"));
 
     uint16_t ADIN_code, max_ADIN_code, min_ADIN_code;
-    ack |= LTC2946_read_12_bits(LTC2946_I2C_ADDRESS, LTC2946_ADIN_MSB_REG, &ADIN_code);
-    ack |= LTC2946_read_12_bits(LTC2946_I2C_ADDRESS, LTC2946_MAX_ADIN_MSB_REG, &max_ADIN_code);
-    ack |= LTC2946_read_12_bits(LTC2946_I2C_ADDRESS, LTC2946_MIN_ADIN_MSB_REG, &min_ADIN_code);
+    ADIN_code = LTC2946_snapshot_12_bits(&snapshot, LTC2946_ADIN_MSB_REG);
+    max_ADIN_code = LTC2946_snapshot_12_bits(&snapshot, LTC2946_MAX_ADIN_MSB_REG);
+    min_ADIN_code = LTC2946_snapshot_12_bits(&snapshot, LTC2946_MIN_ADIN_MSB_REG);
 
     float ADIN, max_ADIN, min_ADIN;
     ADIN = LTC2946_ADIN_code_to_voltage(ADIN_code, LTC2946_ADIN_lsb)*scale;
@@ -398,14 +401,14 @@ int8_t menu_1_continuous_mode(uint8_t CTRLA,                    //!< CTRLA Regis
 
 
     uint32_t energy_code;
-    ack |= LTC2946_read_32_bits(LTC2946_I2C_ADDRESS, LTC2946_ENERGY_MSB3_REG, &energy_code);
+    energy_code = LTC2946_snapshot_32_bits(&snapshot, LTC2946_ENERGY_MSB3_REG);
 
     uint32_t charge_code;
-    ack |= LTC2946_read_32_bits(LTC2946_I2C_ADDRESS, LTC2946_CHARGE_MSB3_REG, &charge_code);
+    charge_code = LTC2946_snapshot_32_bits(&snapshot, LTC2946_CHARGE_MSB3_REG);
 
 
     uint32_t time_code;
-    ack |= LTC2946_read_32_bits(LTC2946_I2C_ADDRESS, LTC2946_TIME_COUNTER_MSB3_REG, &time_code);
+    time_code = LTC2946_snapshot_32_bits(&snapshot, LTC2946_TIME_COUNTER_MSB3_REG);
 
 
     float energy,charge,time;
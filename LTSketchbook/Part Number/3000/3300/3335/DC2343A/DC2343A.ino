@@ -25,6 +25,8 @@ Code will build for configuration specified in LTC3335_Config.h.
     value.  Applications reusing this code would improve performance if the actual battery voltage
     was measured and used for the correction functions.  See the DC2343A schematic for a circuit
     which measures the battery voltage with >10nA of average current drawn from the battery.
+ 7. Set LTC3335_USE_EDGE_CAPTURE to timestamp the /IRQ edges from an interrupt, so that the
+    battery current measurement stays accurate however long the loop is busy.
 
 @endverbatim
 
@@ -205,7 +207,8 @@ void loop()
     current_refresh_time_last += CURRENT_REFRESH_INTERVAL;
   }
 
-  //! Update the Counter Test current in the background.  Must be called more often than LTC3335_MIN_CURRENT_TASK_RATE.
+  //! Update the Counter Test current in the background.  Must be called more often than LTC3335_MIN_CURRENT_TASK_RATE,
+  //! unless LTC3335_USE_EDGE_CAPTURE is set.
   LTC3335_Counter_Test_Current_Task();
 #endif // #if LTC3335_USE_CURRENT_MEASUREMENT == true
 
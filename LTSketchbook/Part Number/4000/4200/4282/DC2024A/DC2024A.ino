@@ -286,50 +286,53 @@ int8_t menu_1_continuous_mode(uint8_t CTRLREG_LSB,    //!< Control LSB Register
   do
   {
 
+    LTC4282_snapshot snapshot;
+    ack |= LTC4282_read_snapshot(LTC4282_I2C_ADDRESS, &snapshot);                         //!< Read Every Register In One Block Transfer
+
     uint8_t adc_alert_log;
-    ack |= LTC4282_read(LTC4282_I2C_ADDRESS, LTC4282_ADC_ALERT_LOG_REG, &adc_alert_log);  //!<Read ADC Alert Log To Keep Track of Alerts
+    adc_alert_log = snapshot.reg[LTC4282_ADC_ALERT_LOG_REG];                              //!<Read ADC Alert Log To Keep Track of Alerts
 
     float vsource, vsource_min, vsource_max;
 
-    ack |= LTC4282_read_16_bits(LTC4282_I2C_ADDRESS, LTC4282_VSOURCE_MSB_REG, &voltage_code);         //!< Read Voltage Code From VSOURCE Register
+    voltage_code = LTC4282_snapshot_16_bits(&snapshot, LTC4282_VSOURCE_MSB_REG);                      //!< Read Voltage Code From VSOURCE Register
     vsource = LTC4282_code_to_voltage(voltage_code, voltage_fullscale);                               //!< Convert Voltage Code to Current Source Voltage
-    ack |= LTC4282_read_16_bits(LTC4282_I2C_ADDRESS, LTC4282_VSOURCE_MAX_MSB_REG, &voltage_code);     //!< Read Voltage Code From VSOURCE MAX Register
+    voltage_code = LTC4282_snapshot_16_bits(&snapshot, LTC4282_VSOURCE_MAX_MSB_REG);                  //!< Read Voltage Code From VSOURCE MAX Register
     vsource_max = LTC4282_code_to_voltage(voltage_code, voltage_fullscale);                           //!< Convert Voltage Code to Maximum Source Voltage
-    ack |= LTC4282_read_16_bits(LTC4282_I2C_ADDRESS, LTC4282_VSOURCE_MIN_MSB_REG, &voltage_code);     //!< Read Voltage Code From VSOURCE MIN Register
+    voltage_code = LTC4282_snapshot_16_bits(&snapshot, LTC4282_VSOURCE_MIN_MSB_REG);                  //!< Read Voltage Code From VSOURCE MIN Register
     vsource_min = LTC4282_code_to_voltage(voltage_code, voltage_fullscale);                           //!< Convert Voltage Code to Minimum Source Voltage
 
 
     float vgpio, vgpio_min, vgpio_max;
 
-    ack |= LTC4282_read_16_bits(LTC4282_I2C_ADDRESS, LTC4282_VGPIO_MSB_REG, &voltage_code);           //!< Read Voltage Code From VGPIO Register
+    voltage_code = LTC4282_snapshot_16_bits(&snapshot, LTC4282_VGPIO_MSB_REG);                        //!< Read Voltage Code From VGPIO Register
     vgpio = LTC4282_code_to_VGPIO(voltage_code);                                                      //!< Convert Voltage Code to VGPIO Voltage
-    ack |= LTC4282_read_16_bits(LTC4282_I2C_ADDRESS, LTC4282_VGPIO_MAX_MSB_REG, &voltage_code);       //!< Read Voltage Code From VGPIO MAX Register
+    voltage_code = LTC4282_snapshot_16_bits(&snapshot, LTC4282_VGPIO_MAX_MSB_REG);                    //!< Read Voltage Code From VGPIO MAX Register
     vgpio_max = LTC4282_code_to_VGPIO(voltage_code);                                                  //!< Convert Voltage Code to Maximum VGPIO Voltage
-    ack |= LTC4282_read_16_bits(LTC4282_I2C_ADDRESS, LTC4282_VGPIO_MIN_MSB_REG, &voltage_code);       //!< Read Voltage Code From VGPIO MIN Register
+    voltage_code = LTC4282_snapshot_16_bits(&snapshot, LTC4282_VGPIO_MIN_MSB_REG);                    //!< Read Voltage Code From VGPIO MIN Register
     vgpio_min = LTC4282_code_to_VGPIO(voltage_code);                                                  //!< Convert Voltage Code to Minimum VGPIO Voltage
 
 
     float current, current_min, current_max;
 
-    ack |= LTC4282_read_16_bits(LTC4282_I2C_ADDRESS, LTC4282_VSENSE_MSB_REG, &current_code);           //!< Read Current Code From VSENSE Register
+    current_code = LTC4282_snapshot_16_bits(&snapshot, LTC4282_VSENSE_MSB_REG);                        //!< Read Current Code From VSENSE Register
     current = LTC4282_code_to_current(current_code, resistor);                                         //!< Convert Current Code to Current
-    ack |= LTC4282_read_16_bits(LTC4282_I2C_ADDRESS, LTC4282_VSENSE_MAX_MSB_REG, &current_code);       //!< Read Current Code From VSENSE MAX Register
+    current_code = LTC4282_snapshot_16_bits(&snapshot, LTC4282_VSENSE_MAX_MSB_REG);                    //!< Read Current Code From VSENSE MAX Register
     current_max = LTC4282_code_to_current(current_code, resistor);                                     //!< Convert Current Code to Maximum Current
-    ack |= LTC4282_read_16_bits(LTC4282_I2C_ADDRESS, LTC4282_VSENSE_MIN_MSB_REG, &current_code);       //!< Read Current Code From VSENSE MIN Register
+    current_code = LTC4282_snapshot_16_bits(&snapshot, LTC4282_VSENSE_MIN_MSB_REG);                    //!< Read Current Code From VSENSE MIN Register
     current_min = LTC4282_code_to_current(current_code, resistor);                                     //!< Convert Current Code to Minimum Current
 
 
     float power, power_min, power_max;
 
-    ack |= LTC4282_read_16_bits(LTC4282_I2C_ADDRESS, LTC4282_POWER_MSB_REG, &power_code);               //!< Read Power Code From Power Register
+    power_code = LTC4282_snapshot_16_bits(&snapshot, LTC4282_POWER_MSB_REG);                           //!< Read Power Code From Power Register
     power = LTC4282_code_to_power(power_code,voltage_fullscale, resistor);                             //!< Convert Power Code to Power
-    ack |= LTC4282_read_16_bits(LTC4282_I2C_ADDRESS, LTC4282_POWER_MAX_MSB_REG, &power_code);          //!< Read Power Code From POWER MAX Register
-    power_max = LTC4282_code_to_power(current_code, voltage_fullscale, resistor);                      //!< Convert Power Code to Maximum Power
-    ack |= LTC4282_read_16_bits(LTC4282_I2C_ADDRESS, LTC4282_POWER_MIN_MSB_REG, &power_code);          //!< Read Power Code From POWER MIN Register
-    power_min = LTC4282_code_to_power(current_code, voltage_fullscale, resistor);                      //!< Convert Power Code to Minimum Power
+    power_code = LTC4282_snapshot_16_bits(&snapshot, LTC4282_POWER_MAX_MSB_REG);                       //!< Read Power Code From POWER MAX Register
+    power_max = LTC4282_code_to_power(power_code, voltage_fullscale, resistor);                        //!< Convert Power Code to Maximum Power
+    power_code = LTC4282_snapshot_16_bits(&snapshot, LTC4282_POWER_MIN_MSB_REG);                       //!< Read Power Code From POWER MIN Register
+    power_min = LTC4282_code_to_power(power_code, voltage_fullscale, resistor);                        //!< Convert Power Code to Minimum Power
 
 
-    ack|= LTC4282_read_32_bits(LTC4282_I2C_ADDRESS, LTC4282_TICK_COUNTER_MSB3_REG, &time_code);        //!< Read Minimum Time Code
+    time_code = LTC4282_snapshot_32_bits(&snapshot, LTC4282_TICK_COUNTER_MSB3_REG);                    //!< Read Minimum Time Code
 
     //! Display Min, Current And Max Voltage
     Serial.println(F("***********Voltage************"));
@@ -433,7 +436,7 @@ int8_t menu_1_continuous_mode(uint8_t CTRLREG_LSB,    //!< Control LSB Register
     {
 
       float coulombs;
-      ack |= LTC4282_read_48_bits(LTC4282_I2C_ADDRESS, LTC4282_METER_MSB5_REG, &meter_code);
+      meter_code = LTC4282_snapshot_48_bits(&snapshot, LTC4282_METER_MSB5_REG);
       coulombs = LTC4282_code_to_coulombs(meter_code, resistor, tConv);
 
       float avg_current;
@@ -451,7 +454,7 @@ int8_t menu_1_continuous_mode(uint8_t CTRLREG_LSB,    //!< Control LSB Register
     else
     {
       float energy;
-      ack |= LTC4282_read_48_bits(LTC4282_I2C_ADDRESS, LTC4282_METER_MSB5_REG, &meter_code);
+      meter_code = LTC4282_snapshot_48_bits(&snapshot, LTC4282_METER_MSB5_REG);
       energy = LTC4282_code_to_energy(meter_code, voltage_fullscale, resistor, tConv);
 
       float avg_power;
@@ -7,6 +7,46 @@ are supported except Uxxy the Write Port D bus. Added the 'D' delay ms command.
 With this program, the Linduino can be used by the QuikEval program running on a PC
 to communicate with QuikEval compatible demo boards.
 
+The 'B' command switches to a binary protocol for host tools that need more throughput
+than ASCII hex allows. The Linduino answers 'B'; older firmware ignores the command, so
+a host can fall back to ASCII when no answer arrives. In binary mode every request is a
+frame of an opcode byte, a 16 bit little endian payload length and the payload:
+
+0x01 batch  - execute the payload once
+0x02 record - store the payload for looped playback
+0x03 play   - execute the stored payload; the payload is a 16 bit little endian repeat count
+0x04 ascii  - return to the ASCII protocol
+0x05 append - add the payload to the stored one (up to RECORDING_SIZE bytes in all)
+
+The serial port has no flow control, and the ATmega328P holds only 64 received bytes.
+The host must wait for the status byte of a frame before sending the next one, and a
+payload may be at most BIN_FRAME_SIZE bytes, so a whole frame fits the receive buffer
+while the previous operations (delays, slow SPI) still run. Longer batches are split
+across frames; CS, the serial mode and I2C state carry over from frame to frame.
+If a byte is lost, the frame is cut short and the firmware would wait forever for the
+missing byte. Instead, once a frame has started, each byte must arrive within
+READ_TIMEOUT ms; otherwise the rest of the frame is dropped, the status byte is sent
+with bit 2 set, and the next byte starts a new frame. A host resyncs after a failed
+frame by waiting until the firmware has been silent for longer than READ_TIMEOUT.
+
+Batch payloads are a sequence of operations that use the ASCII command letters with raw
+bytes in place of hex pairs:
+
+x X g G s p H L    - as in ASCII mode
+M m                - change the serial mode, m is 'I', 'S' or 'X'
+D lo hi            - delay milliseconds
+K value pin        - bang pin, value and pin as in ASCII mode
+S n data[n]        - write n bytes (SPI or I2C)
+T n data[n]        - transceive n bytes (SPI)
+R n                - read n bytes (SPI, or I2C with NACK after the last byte)
+Q n                - read n bytes (SPI, or I2C with ACK after every byte)
+
+Read data is streamed back as raw bytes while the batch runs, so the host knows the
+response length from the batch it sent. Every frame is answered with one trailing status
+byte: 0 for success, bit 0 set if an I2C write was not acknowledged, bit 1 set for an
+unknown opcode, a payload longer than BIN_FRAME_SIZE or a recording that does not fit,
+bit 2 set if the frame timed out.
+
 The Kxy bit bang command uses the following pin mappings :
 0-Linduino 2
 1-Linduino 3
@@ -62,11 +102,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 
 // timeouts
-#define READ_TIMEOUT  20
+#define READ_TIMEOUT  20    // ms allowed between the bytes of a binary frame
 #define MISO_TIMEOUT  1000
 
 // recording mode constants
-#define RECORDING_SIZE 50
+#define RECORDING_SIZE 255  // shared by the ASCII recording loop and binary record/play
 const byte off = 0;
 const byte playback = 1;
 
@@ -75,6 +115,18 @@ const byte spi_mode = 0;
 const byte i2c_mode = 1;
 const byte i2c_auxiliary_mode = 2;
 
+// binary protocol constants
+const byte bin_batch = 0x01;
+const byte bin_record = 0x02;
+const byte bin_play = 0x03;
+const byte bin_ascii = 0x04;
+const byte bin_append = 0x05;
+const byte bin_ok = 0x00;
+const byte bin_nack = 0x01;
+const byte bin_error = 0x02;
+const byte bin_timeout = 0x04;
+#define BIN_FRAME_SIZE 60   // largest payload; with the 3 byte header it fits the 63 bytes the RX ring holds
+
 // hex conversion constants
 char hex_digits[16]=
 {
@@ -87,20 +139,21 @@ const char spi_divider = SPI_CLOCK_DIV32;  // configure the spi port for 4MHz SC
 // global variables
 byte serial_mode = spi_mode;  // current serial mode
 byte recording_mode = off;        // recording mode off
+byte binary_mode = 0;             // 1 after the 'B' command
 char id_string[51]="USBSPI,PIC,01,01,DC,DC590,----------------------\n\0"; // id string
-char hex_to_byte_buffer[5]=
-{
-  '0', 'x', '0', '0', '\0'
-};               // buffer for ASCII hex to byte conversion
 char byte_to_hex_buffer[3]=
 {
   '\0','\0','\0'
 };                     // buffer for byte to ASCII hex conversion
-char recording_buffer[RECORDING_SIZE]=
+char recording_buffer[RECORDING_SIZE+1]=
 {
   '\0'
 }; // buffer for saving recording loop
 byte recording_index = 0;                // index to the recording buffer
+byte recording_length = 0;               // length of the binary payload in the recording buffer
+uint16_t bin_remaining = 0;              // payload bytes left in the current binary frame
+byte bin_from_recording = 0;             // 1 while a binary payload is played from the recording buffer
+byte bin_timed_out = 0;                  // 1 after a frame byte did not arrive within READ_TIMEOUT
 
 char get_char();
 
@@ -112,14 +165,21 @@ void byte_to_hex(byte value)
   byte_to_hex_buffer[2]='\0';                        // add NULL at end
 }
 
+byte hex_to_nibble(char c)
+// convert one hex character to its value
+{
+  if (c >= 'a') return(c - 'a' + 10);
+  if (c >= 'A') return(c - 'A' + 10);
+  return(c - '0');
+}
+
 byte read_hex()
 // read 2 hex characters from the serial buffer and convert
 // them to a byte
 {
   byte data;
-  hex_to_byte_buffer[2]=get_char();
-  hex_to_byte_buffer[3]=get_char();
-  data = strtol(hex_to_byte_buffer, NULL, 0);
+  data = hex_to_nibble(get_char())<<4;
+  data |= hex_to_nibble(get_char());
   return(data);
 }
 
@@ -159,6 +219,211 @@ char get_char()
 int i = 0;
 unsigned char pseudo_reset = 0;
 
+byte bin_get()
+// get the next payload byte of a binary frame either from the
+// serial port or the recording buffer. Returns 0 past the end of
+// the payload so a malformed count cannot read into the next frame.
+// If the byte does not arrive within READ_TIMEOUT, the rest of the
+// frame is dropped and bin_timed_out is set.
+{
+  unsigned long start;
+  if (bin_remaining == 0) return(0);
+  bin_remaining--;
+  if (bin_from_recording) return(recording_buffer[recording_index++]);
+  start = millis();
+  while (Serial.available() <= 0)
+  {
+    if (millis() - start > READ_TIMEOUT)
+    {
+      bin_remaining = 0;
+      bin_timed_out = 1;
+      return(0);
+    }
+  }
+  return(Serial.read());
+}
+
+byte bin_run(uint16_t length)
+// execute a binary batch of length bytes and stream read data
+// to the serial port. Returns the status bits for the frame.
+{
+  byte status = bin_ok;
+  byte op;
+  byte count;
+  byte data;
+  int delay_value;
+  long delay_count;
+
+  bin_remaining = length;
+  while (bin_remaining > 0)
+  {
+    op = bin_get();
+    switch (op)
+    {
+      case 'x':
+        output_low(QUIKEVAL_CS);
+        break;
+      case 'X':
+        output_high(QUIKEVAL_CS);
+        break;
+      case 'g':
+        output_low(QUIKEVAL_GPIO);
+        break;
+      case 'G':
+        output_high(QUIKEVAL_GPIO);
+        break;
+      case 's':
+        if (serial_mode != spi_mode) i2c_start();
+        break;
+      case 'p':
+        if (serial_mode != spi_mode) TWCR=(1<<TWINT) | (1<<TWEN) | (1<<TWSTO);  // I2C stop
+        break;
+      case 'H':
+      case 'L':
+        // wait for MISO to go high ('H') or low ('L') with a timeout
+        for (delay_count = 0; delay_count <= MISO_TIMEOUT; delay_count++)
+        {
+          if (input(MISO) == (op == 'H')) break;
+          delay(1);
+        }
+        break;
+      case 'M':
+        data = bin_get();
+        if (data == 'I')
+        {
+          serial_mode = i2c_mode;
+          quikeval_I2C_connect();
+        }
+        else if (data == 'S')
+        {
+          serial_mode = spi_mode;
+          quikeval_SPI_connect();
+        }
+        else if (data == 'X')
+        {
+          serial_mode = i2c_auxiliary_mode;
+          quikeval_SPI_connect();
+        }
+        break;
+      case 'D':
+        delay_value = bin_get();
+        delay_value |= bin_get()<<8;
+        if (!bin_timed_out) delay(delay_value);
+        break;
+      case 'K':
+        data = bin_get();
+        op = bin_get();
+        if (!bin_timed_out) digitalWrite(op-'0'+2, (data == '0') ? LOW : HIGH);
+        break;
+      case 'S':
+        for (count = bin_get(); count > 0 && !bin_timed_out; count--)
+        {
+          data = bin_get();
+          if (serial_mode == spi_mode) spi_write(data);
+          else if (i2c_write(data) == 1) status |= bin_nack;
+        }
+        break;
+      case 'T':
+        for (count = bin_get(); count > 0; count--)
+        {
+          data = bin_get();
+          if (bin_timed_out) break;
+          Serial.write(spi_read(data));
+        }
+        break;
+      case 'R':
+      case 'Q':
+        for (count = bin_get(); count > 0 && !bin_timed_out; count--)
+        {
+          if (serial_mode == spi_mode) data = spi_read(0);
+          else data = i2c_read((op == 'R' && count == 1) ? WITH_NACK : WITH_ACK);
+          Serial.write(data);
+        }
+        break;
+      default:
+        // unknown operation, discard the rest of the batch
+        status |= bin_error;
+        while (bin_remaining > 0) bin_get();
+        break;
+    }
+  }
+  return(status);
+}
+
+void bin_loop()
+// read and execute one binary frame, if one has started to arrive
+{
+  byte opcode;
+  uint16_t length;
+  uint16_t repeat;
+  byte status = bin_ok;
+
+  if (Serial.available() <= 0) return;
+  bin_from_recording = 0;
+  bin_timed_out = 0;
+  opcode = Serial.read();
+  bin_remaining = 2;
+  length = bin_get();
+  length |= (uint16_t)bin_get()<<8;
+  if (length > BIN_FRAME_SIZE)
+  {
+    // the frame may already have overflowed the receive buffer; drop it until the line is quiet
+    bin_remaining = 0xFFFF;
+    while (!bin_timed_out) bin_get();
+    Serial.write(bin_error | bin_timeout);
+    return;
+  }
+  switch (opcode)
+  {
+    case bin_batch:
+      status = bin_run(length);
+      break;
+    case bin_record:
+      recording_length = 0;
+    // fall through
+    case bin_append:
+      bin_remaining = length;
+      if (recording_length + length > RECORDING_SIZE)
+      {
+        while (bin_remaining > 0) bin_get();
+        recording_length = 0;
+        status = bin_error;
+        break;
+      }
+      for (recording_index = recording_length; bin_remaining > 0; recording_index++)
+        recording_buffer[recording_index] = bin_get();
+      recording_length += length;
+      if (bin_timed_out) recording_length = 0;
+      break;
+    case bin_play:
+      bin_remaining = length;
+      repeat = bin_get();
+      repeat |= (uint16_t)bin_get()<<8;
+      while (bin_remaining > 0) bin_get();
+      if (bin_timed_out) repeat = 0;
+      bin_from_recording = 1;
+      for (; repeat > 0; repeat--)
+      {
+        recording_index = 0;
+        status |= bin_run(recording_length);
+      }
+      bin_from_recording = 0;
+      break;
+    case bin_ascii:
+      bin_remaining = length;
+      while (bin_remaining > 0) bin_get();
+      if (!bin_timed_out) binary_mode = 0;
+      break;
+    default:
+      bin_remaining = length;
+      while (bin_remaining > 0) bin_get();
+      status = bin_error;
+      break;
+  }
+  if (bin_timed_out) status |= bin_timeout;
+  Serial.write(status);
+}
+
 void setup()
 // Setup the program
 {
@@ -199,9 +464,19 @@ void loop()
   char command;
   int byte_count;
   long delay_count;
+  if (binary_mode)
+  {
+    bin_loop();
+    return;
+  }
   command = get_char();
   switch (command)
   {
+    case 'B':
+      // switch to the binary protocol
+      binary_mode = 1;
+      Serial.print('B');
+      break;
     case 'D':
       // delay milliseconds
       delay_value = read_hex();
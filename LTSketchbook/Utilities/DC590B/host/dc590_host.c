@@ -0,0 +1,616 @@
+/*
+DC590B binary protocol host client.
+
+NOT AN ARDUINO SKETCH.  This is a command-line tool for Linux that drives a
+Linduino running Utilities/DC590B/DC590B.ino over its USB serial port.  It
+switches the firmware to the binary protocol described at the top of
+DC590B.ino and falls back to ASCII hex when the firmware does not answer 'B'.
+
+  make
+  ./dc590_host /dev/ttyACM0 id                 print the controller id string
+  ./dc590_host /dev/ttyACM0 spi 9F 00 00       transceive bytes with CS low
+  ./dc590_host /dev/ttyACM0 bench [n] [bytes]  n SPI transactions of 'bytes' each,
+                                               ASCII vs binary batch vs binary loop
+  ./dc590_host loopback bench [n] [bytes]      same, against dc590_sim with MISO
+                                               tied to MOSI
+  ./dc590_host loopback test                   check the binary protocol against
+                                               dc590_sim, including a lost byte
+
+Loopback runs dc590_sim, DC590B.ino itself built for the host (see
+dc590_sim.cpp), in a child process on a socket pair, so the benchmark and the
+protocol checks run without hardware.  dc590_sim models the 115200 baud
+receive line and the 64 byte receive buffer, but its replies are not rate
+limited, so the benchmark also reports the bytes sent in each direction and an
+estimate of the time they take on a 115200 baud link.
+
+The serial port has no flow control.  Frames are sent one at a time and hold
+at most BIN_FRAME_SIZE payload bytes, so a whole frame fits the firmware's
+receive buffer; longer batches and recordings are split across frames.  After
+a failed frame the host waits for the line to go quiet (dc590_resync()), by
+which time the firmware has timed out and dropped the rest of the frame.
+
+Copyright 2018(c) Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in
+   the documentation and/or other materials provided with the
+   distribution.
+ - Neither the name of Analog Devices, Inc. nor the names of its
+   contributors may be used to endorse or promote products derived
+   from this software without specific prior written permission.
+ - The use of this software may or may not infringe the patent rights
+   of one or more patent holders.  This license does not release you
+   from the requirement that you obtain separate licenses from these
+   patent holders to use this software.
+ - Use of the software either in source or binary form, must be run
+   on or directly connected to an Analog Devices Inc. component.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#define BAUD_RATE        115200
+#define READ_TIMEOUT_MS  2000   // longest gap allowed between reply bytes
+#define HELLO_TIMEOUT_MS 3000   // opening the port resets the Linduino
+#define BINARY_TIMEOUT_MS 500   // older firmware never answers 'B'
+#define RESYNC_QUIET_MS  100    // longer than the firmware's READ_TIMEOUT
+
+// binary protocol, see DC590B.ino
+#define BIN_BATCH     0x01
+#define BIN_RECORD    0x02
+#define BIN_PLAY      0x03
+#define BIN_ASCII     0x04
+#define BIN_APPEND    0x05
+#define BIN_ERROR     0x02
+#define BIN_TIMEOUT   0x04
+#define RECORDING_SIZE 255
+#define BIN_FRAME_SIZE 60       // largest payload per frame, so a frame fits the 64 byte receive buffer
+#define BIN_T_MAX     (BIN_FRAME_SIZE - 4)  // 'T' data per operation, leaving room for 'x' and 'X'
+
+typedef struct
+{
+  int fd;
+  int binary;                   // 1 once the firmware accepted 'B'
+  unsigned long tx_bytes;       // bytes written to the Linduino
+  unsigned long rx_bytes;       // bytes read from the Linduino
+  unsigned long resyncs;        // failed frames
+} dc590_t;
+
+static double now(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Write out_len bytes while reading exactly in_len bytes.  Both directions are
+// serviced together so neither side stalls on a full buffer.
+static int transact(dc590_t *d, const void *out, size_t out_len, void *in, size_t in_len, int timeout_ms)
+{
+  const uint8_t *o = (const uint8_t *)out;
+  uint8_t *i = (uint8_t *)in;
+  size_t w = 0, r = 0;
+  ssize_t k;
+
+  while (w < out_len || r < in_len)
+  {
+    struct pollfd p;
+    p.fd = d->fd;
+    p.events = (w < out_len ? POLLOUT : 0) | (r < in_len ? POLLIN : 0);
+    if (poll(&p, 1, timeout_ms) <= 0) return -1;
+    if ((p.revents & POLLOUT) && w < out_len)
+    {
+      k = write(d->fd, o + w, out_len - w);
+      if (k < 0 && errno != EAGAIN) return -1;
+      if (k > 0) w += k;
+    }
+    if ((p.revents & POLLIN) && r < in_len)
+    {
+      k = read(d->fd, i + r, in_len - r);
+      if (k == 0 || (k < 0 && errno != EAGAIN)) return -1;
+      if (k > 0) r += k;
+    }
+    if ((p.revents & (POLLERR | POLLHUP)) && !(p.revents & POLLIN)) return -1;
+  }
+  d->tx_bytes += out_len;
+  d->rx_bytes += in_len;
+  return 0;
+}
+
+// Read until term has been received or timeout_ms passes without data.
+// Returns the number of bytes stored, excluding term, or -1.
+static int read_until(dc590_t *d, char *buf, size_t size, char term, int timeout_ms)
+{
+  size_t n = 0;
+  char c;
+
+  while (1)
+  {
+    if (transact(d, NULL, 0, &c, 1, timeout_ms)) return -1;
+    if (c == term) break;
+    if (n + 1 < size) buf[n++] = c;
+  }
+  buf[n] = '\0';
+  return n;
+}
+
+// Discard input until the firmware's "hello\n" banner or a timeout.
+static void wait_hello(dc590_t *d)
+{
+  char buf[64];
+  double end = now() + HELLO_TIMEOUT_MS / 1000.0;
+
+  while (now() < end)
+  {
+    if (read_until(d, buf, sizeof(buf), '\n', HELLO_TIMEOUT_MS) >= 0 && strstr(buf, "hello")) break;
+  }
+}
+
+static int dc590_open(dc590_t *d, const char *path)
+{
+  struct termios t;
+
+  memset(d, 0, sizeof(*d));
+  d->fd = open(path, O_RDWR | O_NOCTTY | O_NONBLOCK);
+  if (d->fd < 0) return -1;
+  if (tcgetattr(d->fd, &t)) return -1;
+  cfmakeraw(&t);
+  cfsetispeed(&t, B115200);
+  cfsetospeed(&t, B115200);
+  t.c_cflag |= CLOCAL | CREAD;
+  if (tcsetattr(d->fd, TCSANOW, &t)) return -1;
+  wait_hello(d);
+  tcflush(d->fd, TCIFLUSH);
+  d->tx_bytes = d->rx_bytes = 0;
+  return 0;
+}
+
+// Path of dc590_sim, next to this program
+static char sim_path[4096] = "./dc590_sim";
+
+// Start dc590_sim, the firmware built for the host, on a socket pair.
+static int dc590_open_loopback(dc590_t *d)
+{
+  int sv[2];
+
+  memset(d, 0, sizeof(*d));
+  if (access(sim_path, X_OK)) return -1;
+  if (socketpair(AF_UNIX, SOCK_STREAM, 0, sv)) return -1;
+  switch (fork())
+  {
+    case -1:
+      return -1;
+    case 0:
+      close(sv[0]);
+      dup2(sv[1], 0);
+      dup2(sv[1], 1);
+      close(sv[1]);
+      execl(sim_path, sim_path, (char *)NULL);
+      _exit(1);
+  }
+  close(sv[1]);
+  d->fd = sv[0];
+  fcntl(d->fd, F_SETFL, fcntl(d->fd, F_GETFL) | O_NONBLOCK);
+  wait_hello(d);
+  d->tx_bytes = d->rx_bytes = 0;
+  return 0;
+}
+
+static void dc590_close(dc590_t *d)
+{
+  close(d->fd);
+  while (wait(NULL) > 0);   // reap dc590_sim, if any
+}
+
+// Switch to the binary protocol.  Returns 0 if the firmware supports it.
+static int dc590_binary(dc590_t *d)
+{
+  char c;
+
+  if (d->binary) return 0;
+  if (transact(d, "B", 1, &c, 1, BINARY_TIMEOUT_MS) || c != 'B')
+  {
+    tcflush(d->fd, TCIFLUSH);
+    return -1;
+  }
+  d->binary = 1;
+  return 0;
+}
+
+// After a failed frame, wait until the firmware has dropped the rest of it:
+// discard input until the line has been quiet for RESYNC_QUIET_MS, which is
+// longer than the firmware's per-byte timeout.
+static void dc590_resync(dc590_t *d)
+{
+  uint8_t c;
+
+  while (transact(d, NULL, 0, &c, 1, RESYNC_QUIET_MS) == 0);
+  d->resyncs++;
+}
+
+// Send one binary frame of at most BIN_FRAME_SIZE payload bytes and read
+// rx_len bytes of streamed data plus the status byte.  Returns the status byte
+// or -1 on a communication error.  A frame that times out or is rejected is
+// followed by a resync, so the next frame starts cleanly.
+static int dc590_frame(dc590_t *d, uint8_t opcode, const uint8_t *payload, size_t len, uint8_t *rx, size_t rx_len)
+{
+  uint8_t out[BIN_FRAME_SIZE + 3];
+  uint8_t *in = malloc(rx_len + 1);
+  int status = -1;
+
+  if (len > BIN_FRAME_SIZE)
+  {
+    free(in);
+    return -1;
+  }
+  out[0] = opcode;
+  out[1] = len & 0xFF;
+  out[2] = len >> 8;
+  memcpy(out + 3, payload, len);
+  if (transact(d, out, len + 3, in, rx_len + 1, READ_TIMEOUT_MS) == 0)
+  {
+    if (rx) memcpy(rx, in, rx_len);
+    status = in[rx_len];
+  }
+  if (status < 0 || (status & (BIN_ERROR | BIN_TIMEOUT))) dc590_resync(d);
+  free(in);
+  return status;
+}
+
+static int dc590_ascii(dc590_t *d)
+{
+  if (!d->binary) return 0;
+  if (dc590_frame(d, BIN_ASCII, NULL, 0, NULL, 0) != 0) return -1;
+  d->binary = 0;
+  return 0;
+}
+
+static int dc590_id(dc590_t *d, char *buf, size_t size)
+{
+  if (dc590_ascii(d) || transact(d, "i", 1, NULL, 0, READ_TIMEOUT_MS)) return -1;
+  return read_until(d, buf, size, '\0', READ_TIMEOUT_MS) < 0 ? -1 : 0;
+}
+
+// Append one SPI transaction, 'x' T n data[n] ... 'X', to a batch.  No 'T'
+// is longer than fits a frame together with 'x' and 'X'.
+static size_t batch_spi(uint8_t *p, const uint8_t *tx, size_t n)
+{
+  size_t len = 0, chunk;
+
+  p[len++] = 'x';
+  while (n > 0)
+  {
+    chunk = n > BIN_T_MAX ? BIN_T_MAX : n;
+    p[len++] = 'T';
+    p[len++] = chunk;
+    memcpy(p + len, tx, chunk);
+    len += chunk;
+    tx += chunk;
+    n -= chunk;
+  }
+  p[len++] = 'X';
+  return len;
+}
+
+static size_t batch_spi_size(size_t n)
+{
+  return n + 2 * ((n + BIN_T_MAX - 1) / BIN_T_MAX) + 2;
+}
+
+// Length of the operation at p and the number of bytes it streams back.
+static size_t batch_op(const uint8_t *p, size_t *rx_len)
+{
+  switch (p[0])
+  {
+    case 'T':
+      *rx_len += p[1];
+      return 2 + p[1];
+    case 'S':
+      return 2 + p[1];
+    case 'R':
+    case 'Q':
+      *rx_len += p[1];
+      return 2;
+    case 'M':
+      return 2;
+    case 'D':
+    case 'K':
+      return 3;
+    default:
+      return 1;
+  }
+}
+
+// Run a batch of any length, split at operation boundaries into frames of at
+// most BIN_FRAME_SIZE bytes.  rx receives the streamed data of the whole batch.
+// Returns the ORed status bytes or -1.
+static int dc590_batch(dc590_t *d, const uint8_t *batch, size_t len, uint8_t *rx)
+{
+  size_t pos = 0;
+  int status, result = 0;
+
+  while (pos < len)
+  {
+    size_t frame = 0, rx_len = 0, op, op_rx;
+    do
+    {
+      op_rx = 0;
+      op = batch_op(batch + pos + frame, &op_rx);
+      if (frame + op > BIN_FRAME_SIZE) break;
+      frame += op;
+      rx_len += op_rx;
+    }
+    while (pos + frame < len);
+    if (frame == 0) return -1;    // a single operation longer than a frame
+    status = dc590_frame(d, BIN_BATCH, batch + pos, frame, rx, rx_len);
+    if (status < 0) return -1;
+    result |= status;
+    pos += frame;
+    rx += rx_len;
+  }
+  return result;
+}
+
+// Run count SPI transactions of n bytes each, tx and rx hold count * n bytes.
+// Binary mode sends the transactions as one batch, split into as few frames as
+// BIN_FRAME_SIZE allows; ASCII mode sends one transaction per round trip, like
+// QuikEval.
+static int dc590_spi(dc590_t *d, const uint8_t *tx, uint8_t *rx, size_t count, size_t n)
+{
+  size_t t = 0, len = 0;
+
+  if (d->binary)
+  {
+    uint8_t *batch = malloc(count * batch_spi_size(n));
+    int status;
+    for (t = 0; t < count; t++) len += batch_spi(batch + len, tx + t * n, n);
+    status = dc590_batch(d, batch, len, rx);
+    free(batch);
+    return status == 0 ? 0 : -1;
+  }
+
+  char *out = malloc(3 * n + 2);
+  char *in = malloc(2 * n);
+  for (; t < count; t++)
+  {
+    size_t i;
+    out[0] = 'x';
+    for (i = 0; i < n; i++) sprintf(out + 1 + 3 * i, "T%02X", tx[t * n + i]);
+    out[1 + 3 * n] = 'X';
+    if (transact(d, out, 3 * n + 2, in, 2 * n, READ_TIMEOUT_MS)) break;
+    for (i = 0; i < n; i++)
+    {
+      char hex[3] = { in[2 * i], in[2 * i + 1], '\0' };
+      rx[t * n + i] = strtol(hex, NULL, 16);
+    }
+  }
+  free(out);
+  free(in);
+  return t == count ? 0 : -1;
+}
+
+// Record one SPI transaction and play it back repeat times.  rx holds repeat * n bytes.
+// The recording is sent in frames of BIN_FRAME_SIZE: one record frame, then append frames.
+static int dc590_spi_loop(dc590_t *d, const uint8_t *tx, uint8_t *rx, size_t n, uint16_t repeat)
+{
+  uint8_t payload[RECORDING_SIZE + BIN_T_MAX];
+  uint8_t count[2] = { repeat & 0xFF, repeat >> 8 };
+  size_t len, pos, chunk;
+
+  if (!d->binary || batch_spi_size(n) > RECORDING_SIZE) return -1;
+  len = batch_spi(payload, tx, n);
+  for (pos = 0; pos < len; pos += chunk)
+  {
+    chunk = len - pos > BIN_FRAME_SIZE ? BIN_FRAME_SIZE : len - pos;
+    if (dc590_frame(d, pos == 0 ? BIN_RECORD : BIN_APPEND, payload + pos, chunk, NULL, 0) != 0) return -1;
+  }
+  return dc590_frame(d, BIN_PLAY, count, 2, rx, (size_t)repeat * n) == 0 ? 0 : -1;
+}
+
+static int bench(dc590_t *d, int loopback, size_t count, size_t n)
+{
+  uint8_t *tx = malloc(count * n), *rx = malloc(count * n);
+  const char *name[3] = { "ascii", "binary batch", "binary loop" };
+  size_t i;
+  int path, result = 0;
+
+  for (i = 0; i < count * n; i++) tx[i] = rand();
+  printf("%lu transactions of %lu bytes\n", (unsigned long)count, (unsigned long)n);
+  printf("%-14s %10s %10s %10s %12s %12s\n", "path", "time (s)", "host->dev", "dev->host", "bytes/s", "est. @115200");
+  for (path = 0; path < 3; path++)
+  {
+    double start;
+    int err;
+
+    if (path == 1 && dc590_binary(d))
+    {
+      printf("firmware does not support the binary protocol\n");
+      break;
+    }
+    if (path == 2)
+    {
+      if (batch_spi_size(n) > RECORDING_SIZE)
+      {
+        printf("%-14s transaction does not fit the %d byte recording buffer\n", name[path], RECORDING_SIZE);
+        break;
+      }
+      // loop playback repeats a single transaction
+      if (count > 0xFFFF) count = 0xFFFF;
+      for (i = n; i < count * n; i++) tx[i] = tx[i % n];
+    }
+    memset(rx, 0, count * n);
+    d->tx_bytes = d->rx_bytes = 0;
+    start = now();
+    err = path < 2 ? dc590_spi(d, tx, rx, count, n) : dc590_spi_loop(d, tx, rx, n, count);
+    double elapsed = now() - start;
+    unsigned long wire = d->tx_bytes > d->rx_bytes ? d->tx_bytes : d->rx_bytes;
+    if (err || (loopback && memcmp(tx, rx, count * n)))
+    {
+      printf("%-14s failed\n", name[path]);
+      result = 1;
+      continue;
+    }
+    printf("%-14s %10.3f %10lu %10lu %12.0f %11.3fs\n", name[path], elapsed, d->tx_bytes, d->rx_bytes,
+           count * n / elapsed, wire * 10.0 / BAUD_RATE);
+  }
+  printf("est. @115200 is an estimate, not a measurement: the busier direction's byte count\n"
+         "at 10 bits per byte, ignoring USB latency and firmware execution time.\n");
+  if (loopback)
+    printf("time (s) is measured against dc590_sim, which does not rate limit its replies.\n");
+  free(tx);
+  free(rx);
+  return result;
+}
+
+static int test_failures;
+
+static void test_check(int ok, const char *name)
+{
+  printf("%-44s %s\n", name, ok ? "ok" : "FAILED");
+  if (!ok) test_failures++;
+}
+
+// Checks of the binary protocol against dc590_sim, which models the 64 byte
+// receive buffer of the ATmega328P and can drop a byte on the line.
+static int loopback_test(void)
+{
+  dc590_t d;
+  uint8_t tx[300], rx[20 * 100], payload[BIN_FRAME_SIZE], raw[203];
+  size_t i, len;
+  int status;
+
+  for (i = 0; i < sizeof(tx); i++) tx[i] = rand();
+
+  // A full frame is received while a delay at its start runs
+  if (dc590_open_loopback(&d) || dc590_binary(&d)) return 1;
+  len = 0;
+  payload[len++] = 'D';
+  payload[len++] = 100;
+  payload[len++] = 0;
+  len += batch_spi(payload + len, tx, BIN_FRAME_SIZE - 7);
+  status = dc590_frame(&d, BIN_BATCH, payload, len, rx, BIN_FRAME_SIZE - 7);
+  test_check(len == BIN_FRAME_SIZE && status == 0 && memcmp(tx, rx, BIN_FRAME_SIZE - 7) == 0,
+             "full frame behind a 100 ms delay");
+
+  // A frame longer than BIN_FRAME_SIZE is refused once the line is quiet
+  memset(raw, 'x', sizeof(raw));
+  raw[0] = BIN_BATCH;
+  raw[1] = (sizeof(raw) - 3) & 0xFF;
+  raw[2] = (sizeof(raw) - 3) >> 8;
+  raw[3] = 'D';
+  raw[4] = 100;
+  raw[5] = 0;
+  test_check(transact(&d, raw, sizeof(raw), &payload[0], 1, READ_TIMEOUT_MS) == 0 &&
+             payload[0] == (BIN_ERROR | BIN_TIMEOUT), "oversized frame refused");
+  test_check(dc590_spi(&d, tx, rx, 1, 8) == 0 && memcmp(tx, rx, 8) == 0, "next frame after oversized frame");
+
+  // Batches and recordings longer than a frame are split
+  test_check(dc590_spi(&d, tx, rx, 1, sizeof(tx)) == 0 && memcmp(tx, rx, sizeof(tx)) == 0,
+             "300 byte transaction over several frames");
+  status = dc590_spi_loop(&d, tx, rx, 100, 20);
+  for (i = 0; i < 20 && memcmp(tx, rx + i * 100, 100) == 0; i++);
+  test_check(status == 0 && i == 20, "104 byte recording played 20 times");
+  dc590_ascii(&d);
+  dc590_close(&d);
+
+  // A byte lost on the line: the frame times out, the host resyncs, and the
+  // next frame works.  Byte 10 is a data byte of the first frame after 'B'.
+  setenv("DC590_SIM_DROP", "10", 1);
+  status = dc590_open_loopback(&d) || dc590_binary(&d);
+  unsetenv("DC590_SIM_DROP");
+  if (status) return 1;
+  test_check(dc590_spi(&d, tx, rx, 1, 16) != 0 && d.resyncs == 1, "lost byte fails the frame and resyncs");
+  test_check(dc590_spi(&d, tx, rx, 4, 16) == 0 && memcmp(tx, rx, 64) == 0, "next frames after the lost byte");
+  dc590_ascii(&d);
+  dc590_close(&d);
+
+  printf(test_failures ? "FAILED (%d checks)\n" : "PASSED\n", test_failures);
+  return test_failures != 0;
+}
+
+static void usage(void)
+{
+  fprintf(stderr, "usage: dc590_host <port|loopback> id\n"
+          "       dc590_host <port|loopback> spi <hex byte>...\n"
+          "       dc590_host <port|loopback> bench [transactions] [bytes]\n"
+          "       dc590_host loopback test\n");
+  exit(1);
+}
+
+int main(int argc, char *argv[])
+{
+  dc590_t d;
+  int loopback, result = 0;
+  const char *slash;
+
+  if (argc < 3) usage();
+  loopback = strcmp(argv[1], "loopback") == 0;
+  slash = strrchr(argv[0], '/');
+  if (slash && slash - argv[0] + sizeof("/dc590_sim") <= sizeof(sim_path))
+    sprintf(sim_path, "%.*s/dc590_sim", (int)(slash - argv[0]), argv[0]);
+  if (loopback && strcmp(argv[2], "test") == 0)
+    return loopback_test();
+  if (loopback ? dc590_open_loopback(&d) : dc590_open(&d, argv[1]))
+  {
+    perror(loopback ? sim_path : argv[1]);
+    return 1;
+  }
+
+  if (strcmp(argv[2], "id") == 0)
+  {
+    char id[64];
+    result = dc590_id(&d, id, sizeof(id));
+    if (result == 0) printf("%s", id);
+  }
+  else if (strcmp(argv[2], "spi") == 0 && argc > 3)
+  {
+    size_t i, n = argc - 3;
+    uint8_t *tx = malloc(n), *rx = malloc(n);
+    for (i = 0; i < n; i++) tx[i] = strtol(argv[i + 3], NULL, 16);
+    dc590_binary(&d);
+    result = dc590_spi(&d, tx, rx, 1, n);
+    for (i = 0; i < n && result == 0; i++) printf("%02X%c", rx[i], i + 1 < n ? ' ' : '\n');
+    free(tx);
+    free(rx);
+  }
+  else if (strcmp(argv[2], "bench") == 0)
+  {
+    size_t count = argc > 3 ? strtoul(argv[3], NULL, 0) : 1000;
+    size_t n = argc > 4 ? strtoul(argv[4], NULL, 0) : 4;
+    if (count == 0 || n == 0) usage();
+    result = bench(&d, loopback, count, n);
+  }
+  else usage();
+
+  if (result) fprintf(stderr, "communication error\n");
+  dc590_ascii(&d);
+  dc590_close(&d);
+  return result ? 1 : 0;
+}
@@ -0,0 +1,247 @@
+/*
+Host build of the DC590B bridge firmware, for dc590_host's loopback mode.
+
+NOT AN ARDUINO SKETCH.  dc590_sim compiles ../DC590B.ino unchanged against
+Utilities/host_stubs and runs setup() and loop() with the serial port on
+stdin/stdout, so the loopback benchmark and tests exercise the firmware's own
+command parser.  Time runs in real time.
+
+The receive side models the ATmega328P UART and HardwareSerial: bytes
+arrive at 115200 baud into a 64 byte ring buffer, which holds 63, and a byte
+that arrives while the ring is full is dropped.  The firmware sees a byte
+only once its arrival time has passed.  SPI has MISO tied to MOSI; I2C
+acknowledges every write and reads 0.
+
+  DC590_SIM_DROP=n   drop the n-th received byte (counting from 1), to test
+                     the resync after a byte lost on the line
+
+The number of bytes dropped is printed to stderr when the host closes the
+connection.
+
+Copyright 2018(c) Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in
+   the documentation and/or other materials provided with the
+   distribution.
+ - Neither the name of Analog Devices, Inc. nor the names of its
+   contributors may be used to endorse or promote products derived
+   from this software without specific prior written permission.
+ - The use of this software may or may not infringe the patent rights
+   of one or more patent holders.  This license does not release you
+   from the requirement that you obtain separate licenses from these
+   patent holders to use this software.
+ - Use of the software either in source or binary form, must be run
+   on or directly connected to an Analog Devices Inc. component.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <Arduino.h>
+#include <SPI.h>
+#include <Wire.h>
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+#include "Linduino.h"
+#include "LT_I2C.h"
+#include "LT_SPI.h"
+#include "QuikEval_EEPROM.h"
+#include "UserInterface.h"
+
+#define SIM_BAUD_RATE     115200
+#define SIM_RX_BUFFER     64        // SERIAL_RX_BUFFER_SIZE of the AVR core
+
+static double sim_start;
+
+static double sim_now()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9 - sim_start;
+}
+
+unsigned long millis()
+{
+  return (unsigned long)(sim_now() * 1e3);
+}
+unsigned long micros()
+{
+  return (unsigned long)(sim_now() * 1e6);
+}
+
+// Serial port of the simulated Linduino
+class SimSerial
+{
+  private:
+    uint8_t ring_[SIM_RX_BUFFER];
+    uint8_t head_, tail_;
+    uint8_t line_[4096];            // bytes read from stdin that are still on the wire
+    size_t line_len_, line_pos_;
+    double next_arrival_;           // time the next byte on the wire reaches the UART
+    unsigned long received_, dropped_, drop_;
+    bool eof_;                      // the host closed the connection
+
+    void receive()
+    {
+      double now = sim_now();
+      while (1)
+      {
+        if (line_pos_ == line_len_)
+        {
+          struct pollfd p = { 0, POLLIN, 0 };
+          ssize_t k;
+          if (poll(&p, 1, 0) <= 0) break;
+          k = ::read(0, line_, sizeof(line_));
+          if (k <= 0)
+          {
+            eof_ = true;
+            break;
+          }
+          line_len_ = k;
+          line_pos_ = 0;
+          // the line was idle until now
+          if (next_arrival_ < now) next_arrival_ = now;
+        }
+        if (next_arrival_ > now) break;
+        next_arrival_ += 10.0 / SIM_BAUD_RATE;
+        received_++;
+        uint8_t next = (head_ + 1) % SIM_RX_BUFFER;
+        if (next == tail_ || received_ == drop_)
+          dropped_++;
+        else
+        {
+          ring_[head_] = line_[line_pos_];
+          head_ = next;
+        }
+        line_pos_++;
+      }
+    }
+
+  public:
+    SimSerial() : head_(0), tail_(0), line_len_(0), line_pos_(0), next_arrival_(0), received_(0), dropped_(0), eof_(false)
+    {
+      const char *drop = getenv("DC590_SIM_DROP");
+      drop_ = drop ? strtoul(drop, NULL, 0) : 0;
+    }
+    void begin(long) {}
+    // The receive interrupt: move the bytes that have arrived by now into the ring
+    void service()
+    {
+      receive();
+    }
+    int available()
+    {
+      int n;
+      receive();
+      n = (head_ - tail_ + SIM_RX_BUFFER) % SIM_RX_BUFFER;
+      if (n == 0)
+      {
+        fflush(stdout);   // about to wait for the host, send what is pending
+        if (eof_)
+        {
+          fprintf(stderr, "dc590_sim: %lu bytes received, %lu dropped\n", received_, dropped_);
+          exit(0);
+        }
+      }
+      return n;
+    }
+    int read()
+    {
+      uint8_t c;
+      if (available() == 0) return -1;
+      c = ring_[tail_];
+      tail_ = (tail_ + 1) % SIM_RX_BUFFER;
+      return c;
+    }
+    size_t write(uint8_t c)
+    {
+      return fwrite(&c, 1, 1, stdout);
+    }
+    size_t print(char c)
+    {
+      return write(c);
+    }
+    size_t print(const char *s)
+    {
+      return fwrite(s, 1, strlen(s), stdout);
+    }
+    void flush()
+    {
+      fflush(stdout);
+    }
+};
+
+static SimSerial sim_serial;
+#define Serial sim_serial
+
+// The receive interrupt keeps running during a delay
+void delay(unsigned long ms)
+{
+  double end = sim_now() + ms * 1e-3;
+  fflush(stdout);
+  while (sim_now() < end)
+  {
+    sim_serial.service();
+    usleep(50);
+  }
+}
+void delayMicroseconds(unsigned int us)
+{
+  usleep(us);
+}
+
+char ui_buffer[UI_BUFFER_SIZE];
+
+uint8_t read_quikeval_id_string(char *buffer)
+{
+  buffer[0] = '\0';
+  return 0;
+}
+
+void quikeval_SPI_init() {}
+void quikeval_SPI_connect() {}
+void spi_write(int8_t) {}
+int8_t spi_read(int8_t data)
+{
+  return data;
+}
+void quikeval_I2C_init() {}
+void quikeval_I2C_connect() {}
+int8_t i2c_start()
+{
+  return 0;
+}
+void i2c_stop() {}
+int8_t i2c_write(uint8_t)
+{
+  return 0;
+}
+uint8_t i2c_read(int8_t)
+{
+  return 0;
+}
+
+#include "../DC590B.ino"
+
+int main()
+{
+  sim_start = sim_now();
+  setup();
+  while (1) loop();
+}
@@ -1,8 +1,12 @@
 /*
 I2C Address Scan
 
-This program will scan all 128 I2C addresses on the QuikEval connector
-and report all addresses that acknowledge an address+!w command.
+This program will scan the I2C addresses 0x01 to 0x7F on the QuikEval
+connector with LT_SMBus::scan() and report all addresses that acknowledge an
+address+!w command (SMBus quick command), with their ACK latency.  The scan
+runs at the lower of the bus speed and SW_I2C_FREQUENCY, so a bus slowed down
+for long wires is not sped up.  The general call address 0x00 and the Alert
+Response Address 0x0C are not probed.
 
 DATA TYPES:
 char  = 1 byte
@@ -48,12 +52,17 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // set I2C frequency in kHz
 #define SW_I2C_FREQUENCY  400
 
+// Age in ms for which the 'c' command reuses the previous scan
+#define SCAN_CACHE_AGE  5000
+
 #include <Arduino.h>
 #include <stdint.h>
-#include "LT_I2C.h"
-#include "QuikEval_EEPROM.h"
-#include "UserInterface.h"
 #include "Linduino.h"
+#include "UserInterface.h"
+#include <LT_SMBus.h>
+#include <LT_SMBusNoPec.h>
+
+LT_SMBus *smbus = new LT_SMBusNoPec(SW_I2C_FREQUENCY * 1000UL);
 
 void print_title()
 // Print the title block
@@ -62,8 +71,8 @@ void print_title()
   Serial.println("*****************************************************************");
   Serial.println("* I2C Address Scan                                              *");
   Serial.println("*                                                               *");
-  Serial.println("* This program will scan all 128 I2C addresses and report those *");
-  Serial.println("* that acknowledge a address+!w command.                        *");
+  Serial.println("* This program will scan I2C addresses 0x01 to 0x7F and report  *");
+  Serial.println("* those that acknowledge a address+!w command.                  *");
   Serial.println("*                                                               *");
   Serial.println("* Set the baud rate to 115200 select the newline terminator.    *");
   Serial.println("*                                                               *");
@@ -73,36 +82,34 @@ void print_title()
 void setup()
 // Setup the program
 {
-  quikeval_I2C_init();                // Enable the Software I2C
-  quikeval_I2C_connect();         // Connects to main I2C port
   Serial.begin(115200);        // Initialize the serial port to the PC
   print_title();
 }
 
 void loop()
 {
-  unsigned char ack;
-  unsigned char address;
-  unsigned char ack_count;
-  Serial.println("\nSend any character to start the I2C address scan. (Press enter in Arduino Serial Monitor.)");
-  read_int();
-  ack_count = 0;
-  for (address = 0; address < 128; address++)
+  uint8_t *found;
+  uint8_t i;
+  int8_t command;
+  Serial.println("\nSend any character to start the I2C address scan, or c to reuse a scan younger");
+  Serial.println("than 5 s. (Press enter in Arduino Serial Monitor.)");
+  command = read_char();
+  if (command == 'c' || command == 'C')
+    found = smbus->scanCached(0x01, 0x7F, false, SW_I2C_FREQUENCY * 1000UL, SCAN_CACHE_AGE);
+  else
+    found = smbus->scan(0x01, 0x7F, false, SW_I2C_FREQUENCY * 1000UL);
+  for (i = 0; found[i] != 0; i++)
   {
-    i2c_start();
-    ack = i2c_write(address << 1);
-    i2c_stop();
-    if (!ack)
-    {
-      ack_count++;
-      Serial.print("Acknowledge received from address : 0x");
-      Serial.print(address, HEX);
-      Serial.print(" (7 bit) 0x:");
-      Serial.print(address<<1, HEX);
-      Serial.println(" (8-bit)");
-    }
+    Serial.print("Acknowledge received from address : 0x");
+    Serial.print(found[i], HEX);
+    Serial.print(" (7 bit) 0x:");
+    Serial.print(found[i]<<1, HEX);
+    Serial.print(" (8-bit) ");
+    Serial.print(smbus->scanLatency(found[i]));
+    Serial.println(" us");
   }
-  if (ack_count == 0) Serial.println("No addresses acknowledged.");
+  if (i == 0) Serial.println("No addresses acknowledged.");
+  Serial.print("Scan time: ");
+  Serial.print(smbus->scanDuration());
+  Serial.println(" us");
 }
-
-
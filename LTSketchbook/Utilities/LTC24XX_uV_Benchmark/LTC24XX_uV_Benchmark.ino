@@ -0,0 +1,195 @@
+/*!
+LTC24XX microvolt kernel benchmark
+
+@verbatim
+
+Times the fixed-point LTC24XX_codes_to_uV() kernel against the float
+LTC24XX_SE_code_to_voltage() and LTC24XX_diff_code_to_voltage() paths on the
+Linduino itself. No demo board is needed. A buffer of pseudo-random 32-bit
+codes is converted BENCH_PASSES times by each path and the time per sample
+is printed in microseconds, together with the largest difference between
+the two results.
+
+The integer kernel does one 32 x 32 -> 64 bit multiply and a shift per
+sample. On the AVR that is a call into the 64-bit runtime rather than the
+soft-float multiply and divide of the float path, so the ratio printed here
+is the number to quote, not the one from the host test.
+
+Serial: 115200 baud. Send any character to repeat the run.
+
+@endverbatim
+
+Copyright 2018(c) Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in
+   the documentation and/or other materials provided with the
+   distribution.
+ - Neither the name of Analog Devices, Inc. nor the names of its
+   contributors may be used to endorse or promote products derived
+   from this software without specific prior written permission.
+ - The use of this software may or may not infringe the patent rights
+   of one or more patent holders.  This license does not release you
+   from the requirement that you obtain separate licenses from these
+   patent holders to use this software.
+ - Use of the software either in source or binary form, must be run
+   on or directly connected to an Analog Devices Inc. component.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*! @file
+    @ingroup LTC24XX_general
+*/
+
+#include <stdint.h>
+#include <Arduino.h>
+#include "Linduino.h"
+#include "LTC24XX_general.h"
+
+#define BENCH_SAMPLES   64      //!< Codes converted per pass
+#define BENCH_PASSES    16      //!< Passes over the buffer for each path
+#define BENCH_VREF      5.0     //!< Reference voltage used for both paths
+
+// Globals
+int32_t bench_code[BENCH_SAMPLES];        //!< Codes to convert
+int32_t bench_uV[BENCH_SAMPLES];          //!< Fixed-point results
+float bench_volts[BENCH_SAMPLES];         //!< Float results
+
+// Function Declarations
+void fill_codes();
+void run_benchmark();
+float time_float(uint8_t differential);
+float time_uV(const LTC24XX_uV_scale *scale);
+float max_error_uV();
+
+//! Initialize Linduino
+void setup()
+{
+  Serial.begin(115200);
+  Serial.println(F("LTC24XX microvolt kernel benchmark"));
+  randomSeed(26);
+  fill_codes();
+  run_benchmark();
+}
+
+//! Repeats Linduino loop
+void loop()
+{
+  if (Serial.available())
+  {
+    while (Serial.available())
+      Serial.read();
+    run_benchmark();
+  }
+}
+
+//! Fills the code buffer with codes in the range LTC24XX parts return
+void fill_codes()
+{
+  uint8_t i;
+
+  for (i = 0; i < BENCH_SAMPLES; i++)
+    bench_code[i] = ((int32_t)random(0x8000) << 15) | random(0x8000);   // 0x00000000 to 0x3FFFFFFF, both signs
+  bench_code[0] = 0x20000000;   // Zero scale
+  bench_code[1] = 0x3FFFFFFF;   // Positive full scale
+}
+
+//! Times each path and prints the results
+void run_benchmark()
+{
+  LTC24XX_uV_scale scale;
+  float float_us, uV_us;
+
+  Serial.println();
+  Serial.print(BENCH_SAMPLES * BENCH_PASSES);
+  Serial.println(F(" conversions per path"));
+
+  LTC24XX_SE_uV_scale(BENCH_VREF, &scale);
+  float_us = time_float(0);
+  uV_us = time_uV(&scale);
+  Serial.print(F("Single-ended  float: "));
+  Serial.print(float_us, 2);
+  Serial.print(F(" us/sample, uV kernel: "));
+  Serial.print(uV_us, 2);
+  Serial.print(F(" us/sample, max difference: "));
+  Serial.print(max_error_uV(), 2);
+  Serial.println(F(" uV"));
+
+  LTC24XX_diff_uV_scale(BENCH_VREF, &scale);
+  float_us = time_float(1);
+  uV_us = time_uV(&scale);
+  Serial.print(F("Differential  float: "));
+  Serial.print(float_us, 2);
+  Serial.print(F(" us/sample, uV kernel: "));
+  Serial.print(uV_us, 2);
+  Serial.print(F(" us/sample, max difference: "));
+  Serial.print(max_error_uV(), 2);
+  Serial.println(F(" uV"));
+}
+
+//! Converts the buffer BENCH_PASSES times with the float path
+//! @return Time per sample in microseconds
+float time_float(uint8_t differential)
+{
+  uint32_t start, elapsed;
+  uint8_t pass, i;
+
+  start = micros();
+  for (pass = 0; pass < BENCH_PASSES; pass++)
+  {
+    for (i = 0; i < BENCH_SAMPLES; i++)
+    {
+      if (differential)
+        bench_volts[i] = LTC24XX_diff_code_to_voltage(bench_code[i], BENCH_VREF);
+      else
+        bench_volts[i] = LTC24XX_SE_code_to_voltage(bench_code[i], BENCH_VREF);
+    }
+  }
+  elapsed = micros() - start;
+  return((float)elapsed / (BENCH_SAMPLES * BENCH_PASSES));
+}
+
+//! Converts the buffer BENCH_PASSES times with the fixed-point kernel
+//! @return Time per sample in microseconds
+float time_uV(const LTC24XX_uV_scale *scale)
+{
+  uint32_t start, elapsed;
+  uint8_t pass;
+
+  start = micros();
+  for (pass = 0; pass < BENCH_PASSES; pass++)
+    LTC24XX_codes_to_uV(bench_code, bench_uV, BENCH_SAMPLES, scale);
+  elapsed = micros() - start;
+  return((float)elapsed / (BENCH_SAMPLES * BENCH_PASSES));
+}
+
+//! @return The largest difference between the last float and fixed-point results, in microvolts
+float max_error_uV()
+{
+  float error, worst = 0;
+  uint8_t i;
+
+  for (i = 0; i < BENCH_SAMPLES; i++)
+  {
+    error = fabs(bench_volts[i] * 1000000.0 - bench_uV[i]);
+    if (error > worst)
+      worst = error;
+  }
+  return(worst);
+}
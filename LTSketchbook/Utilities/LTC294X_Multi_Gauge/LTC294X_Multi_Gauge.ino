@@ -0,0 +1,163 @@
+/*!
+LTC294X multi-gauge scheduler example
+
+@verbatim
+
+Polls GAUGES LTC2943 gas gauges behind a PCA9548A-style I2C mux with the
+LTC294X_Scheduler library. Each gauge sits on the mux channel matching its
+index, all at LTC2943_I2C_ADDRESS. Every SWEEP_PERIOD ms the scheduler
+starts a manual conversion on every gauge, waits one conversion time, then
+reads each gauge with one block read. A gauge whose conversion is still
+running is polled through its CONTROL register alone until it finishes.
+
+After each sweep the sketch prints, for every gauge, the voltage, current,
+temperature and accumulated charge, or FAIL if the gauge did not answer,
+followed by the measured sweep time. With twelve gauges at 100kHz a sweep
+takes about 70ms + 12 x 3.1ms = 107ms.
+
+If the gauges' ALCC outputs are wired together to ALCC_PIN, a gauge in
+alarm starts a sweep straight away and is read first. Leave ALCC_PIN at -1
+if they are not connected.
+
+Serial: 115200 baud. Send any character to pause or resume the printout.
+
+@endverbatim
+
+http://www.linear.com/product/LTC2943
+
+Copyright 2018(c) Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in
+   the documentation and/or other materials provided with the
+   distribution.
+ - Neither the name of Analog Devices, Inc. nor the names of its
+   contributors may be used to endorse or promote products derived
+   from this software without specific prior written permission.
+ - The use of this software may or may not infringe the patent rights
+   of one or more patent holders.  This license does not release you
+   from the requirement that you obtain separate licenses from these
+   patent holders to use this software.
+ - Use of the software either in source or binary form, must be run
+   on or directly connected to an Analog Devices Inc. component.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*! @file
+    @ingroup LTC294X_Scheduler
+*/
+
+#include <Arduino.h>
+#include <stdint.h>
+#include "Linduino.h"
+#include "LT_I2C.h"
+#include "LTC2943.h"
+#include "LTC294X_Scheduler.h"
+
+#define GAUGES              4       //!< Gauges on mux channels 0 to GAUGES - 1
+#define MUX_I2C_ADDRESS     0x70    //!< I2C address of the mux
+#define ALCC_PIN            -1      //!< Pin wired to the gauges' ALCC outputs, -1 if not connected
+#define SWEEP_PERIOD        1000    //!< Time between the starts of sweeps, in ms
+#define PRESCALAR           4096    //!< Coulomb counter prescaler, matches LTC2943_PRESCALAR_M_4096
+
+const float resistor = .100;        //!< Sense resistor on each gauge, in Ohms
+
+// Globals
+LTC294X_gauge gauge[GAUGES];        //!< Gauges polled by the scheduler
+LTC294X_scheduler sched;            //!< Scheduler state
+uint8_t print_enabled = 1;          //!< Send any character to toggle
+
+// Function Declarations
+int8_t select_mux_channel(uint8_t channel);
+void print_sweep();
+
+//! Initialize Linduino
+void setup()
+{
+  uint8_t i;
+
+  quikeval_I2C_init();              //! Configure the I2C port for 100kHz
+  quikeval_I2C_connect();           //! Connects to main I2C port
+  Serial.begin(115200);
+  Serial.println(F("LTC294X multi-gauge scheduler example"));
+
+  for (i = 0; i < GAUGES; i++)
+  {
+    gauge[i].part = LTC294X_LTC2943;
+    gauge[i].i2c_address = LTC2943_I2C_ADDRESS;
+    gauge[i].mux_channel = i;
+    gauge[i].control = LTC2943_MANUAL_MODE | LTC2943_PRESCALAR_M_4096 | LTC2943_ALERT_MODE;
+  }
+  LTC294X_scheduler_init(&sched, gauge, GAUGES, select_mux_channel, ALCC_PIN, SWEEP_PERIOD);
+}
+
+//! Repeats Linduino loop
+void loop()
+{
+  if (Serial.available())
+  {
+    while (Serial.available())
+      Serial.read();
+    print_enabled = !print_enabled;
+  }
+  if (LTC294X_scheduler_run(&sched) && print_enabled)
+    print_sweep();
+}
+
+//! Switches the mux to one channel
+//! @return 0 on acknowledge, 1 if the mux did not answer
+int8_t select_mux_channel(uint8_t channel)
+{
+  return(i2c_write_byte(MUX_I2C_ADDRESS, 1 << channel));
+}
+
+//! Prints every gauge's readings from the sweep that just finished
+void print_sweep()
+{
+  uint8_t i;
+
+  Serial.println();
+  for (i = 0; i < GAUGES; i++)
+  {
+    Serial.print(F("Gauge "));
+    Serial.print(i);
+    if (gauge[i].ack)
+    {
+      Serial.println(F(": FAIL"));
+      continue;
+    }
+    Serial.print(F(": "));
+    Serial.print(LTC2943_code_to_voltage(LTC294X_gauge_16_bits(&gauge[i], LTC2943_VOLTAGE_MSB_REG)), 4);
+    Serial.print(F(" V, "));
+    Serial.print(LTC2943_code_to_current(LTC294X_gauge_16_bits(&gauge[i], LTC2943_CURRENT_MSB_REG), resistor), 4);
+    Serial.print(F(" A, "));
+    Serial.print(LTC2943_code_to_celcius_temperature(LTC294X_gauge_16_bits(&gauge[i], LTC2943_TEMPERATURE_MSB_REG)), 1);
+    Serial.print(F(" C, "));
+    Serial.print(LTC2943_code_to_mAh(LTC294X_gauge_16_bits(&gauge[i], LTC2943_ACCUM_CHARGE_MSB_REG), resistor, PRESCALAR), 4);
+    Serial.print(F(" mAh"));
+    if (gauge[i].alarm)
+    {
+      Serial.print(F(", alarm 0x"));
+      Serial.print(gauge[i].alarm, HEX);
+    }
+    Serial.println();
+  }
+  Serial.print(F("Sweep time (ms): "));
+  Serial.println(sched.sweep_time);
+}
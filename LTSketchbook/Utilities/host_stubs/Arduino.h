@@ -0,0 +1,165 @@
+/*
+Minimal Arduino core declarations for building Linduino libraries on a PC.
+
+NOT PART OF ANY SKETCH.  The host test programs under libraries/<name>/extras/host
+put this directory first on the include path, so that library sources compile
+with g++ unchanged.  Only what those libraries use is declared; host_stubs.cpp
+supplies default definitions that a test program can replace with its own
+device model.
+
+Time does not pass on its own.  millis() and micros() read host_time_us, which
+delay() and delayMicroseconds() advance, and which a test may also set directly.
+*/
+
+#ifndef HOST_STUBS_ARDUINO_H
+#define HOST_STUBS_ARDUINO_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <stdio.h>
+#include <avr/io.h>
+#include <avr/pgmspace.h>
+#include <avr/interrupt.h>
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+
+static const uint8_t SS = 10;
+static const uint8_t MOSI = 11;
+static const uint8_t MISO = 12;
+static const uint8_t SCK = 13;
+
+#define DEC 10
+#define HEX 16
+#define BIN 2
+
+#define CHANGE 1
+#define FALLING 2
+#define RISING 3
+
+extern unsigned long host_time_us;
+
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+void pinMode(uint8_t pin, uint8_t mode);
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+unsigned long millis();
+unsigned long micros();
+int analogRead(uint8_t pin);
+void analogWrite(uint8_t pin, int value);
+void attachInterrupt(uint8_t interrupt, void (*isr)(void), int mode);
+void detachInterrupt(uint8_t interrupt);
+
+#define digitalPinToInterrupt(p) (p)
+#define digitalPinToPort(p) (p)
+#define digitalPinToBitMask(p) (1 << ((p) & 7))
+#define portOutputRegister(p) (&PORTB)
+#define portInputRegister(p) (&PINB)
+#define noInterrupts() cli()
+#define interrupts() sei()
+
+#define F(x) (x)
+#define min(a,b) ((a)<(b)?(a):(b))
+#define max(a,b) ((a)>(b)?(a):(b))
+#define constrain(a,l,h) ((a)<(l)?(l):((a)>(h)?(h):(a)))
+#define bitRead(v,b) (((v)>>(b))&1)
+#define lowByte(w) ((uint8_t)((w)&0xff))
+#define highByte(w) ((uint8_t)((w)>>8))
+
+class __FlashStringHelper;
+char *dtostrf(double value, signed char width, unsigned char precision, char *buffer);
+
+class String
+{
+  public:
+    String() {}
+    String(const char *) {}
+    String(int) {}
+    const char *c_str() const
+    {
+      return "";
+    }
+    int length() const
+    {
+      return 0;
+    }
+};
+
+// Output is discarded; test programs report with printf().
+class Print
+{
+  public:
+    template<class T> size_t print(T)
+    {
+      return 0;
+    }
+    template<class T> size_t print(T, int)
+    {
+      return 0;
+    }
+    template<class T> size_t println(T)
+    {
+      return 0;
+    }
+    template<class T> size_t println(T, int)
+    {
+      return 0;
+    }
+    size_t println()
+    {
+      return 0;
+    }
+    size_t write(uint8_t)
+    {
+      return 0;
+    }
+    size_t write(const uint8_t *, size_t)
+    {
+      return 0;
+    }
+};
+
+class HardwareSerial : public Print
+{
+  public:
+    void begin(long) {}
+    int available()
+    {
+      return 0;
+    }
+    int read()
+    {
+      return -1;
+    }
+    int peek()
+    {
+      return -1;
+    }
+    void flush() {}
+    size_t readBytes(char *, size_t)
+    {
+      return 0;
+    }
+    size_t readBytes(uint8_t *, size_t)
+    {
+      return 0;
+    }
+    void setTimeout(long) {}
+    operator bool()
+    {
+      return true;
+    }
+};
+
+extern HardwareSerial Serial;
+
+#endif  // HOST_STUBS_ARDUINO_H
@@ -0,0 +1,8 @@
+// Host stand-in for <Print.h>.  See Arduino.h in this directory.
+
+#ifndef HOST_STUBS_PRINT_H
+#define HOST_STUBS_PRINT_H
+
+#include <Arduino.h>
+
+#endif  // HOST_STUBS_PRINT_H
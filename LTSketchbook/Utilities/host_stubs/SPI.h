@@ -0,0 +1,54 @@
+// Host stand-in for the Arduino SPI library.  See Arduino.h in this directory.
+
+#ifndef HOST_STUBS_SPI_H
+#define HOST_STUBS_SPI_H
+
+#include <Arduino.h>
+
+#define SPI_MODE0 0
+#define SPI_MODE1 4
+#define SPI_MODE2 8
+#define SPI_MODE3 12
+#define SPI_CLOCK_DIV2 4
+#define SPI_CLOCK_DIV4 0
+#define SPI_CLOCK_DIV8 5
+#define SPI_CLOCK_DIV16 1
+#define SPI_CLOCK_DIV32 6
+#define SPI_CLOCK_DIV64 2
+#define SPI_CLOCK_DIV128 3
+#define MSBFIRST 1
+#define LSBFIRST 0
+
+class SPISettings
+{
+  public:
+    SPISettings() {}
+    SPISettings(uint32_t, uint8_t, uint8_t) {}
+};
+
+// transfer() is defined in host_stubs.cpp and may be replaced by a test
+class SPIClass
+{
+  public:
+    void begin() {}
+    void end() {}
+    uint8_t transfer(uint8_t data);
+    uint16_t transfer16(uint16_t data)
+    {
+      return (uint16_t)(transfer(data >> 8) << 8) | transfer(data & 0xFF);
+    }
+    void transfer(void *buffer, size_t count)
+    {
+      for (size_t i = 0; i < count; i++)
+        ((uint8_t *)buffer)[i] = transfer(((uint8_t *)buffer)[i]);
+    }
+    void setClockDivider(uint8_t) {}
+    void setDataMode(uint8_t) {}
+    void setBitOrder(uint8_t) {}
+    void beginTransaction(SPISettings) {}
+    void endTransaction() {}
+};
+
+extern SPIClass SPI;
+
+#endif  // HOST_STUBS_SPI_H
@@ -0,0 +1,31 @@
+// Host stand-in for the Arduino Wire library.  See Arduino.h in this directory.
+
+#ifndef HOST_STUBS_WIRE_H
+#define HOST_STUBS_WIRE_H
+
+#include <Arduino.h>
+
+class TwoWire : public Print
+{
+  public:
+    void begin() {}
+    void beginTransmission(uint8_t address);
+    uint8_t endTransmission(uint8_t sendStop = 1);
+    uint8_t requestFrom(uint8_t, uint8_t, uint8_t = 1)
+    {
+      return 0;
+    }
+    int available()
+    {
+      return 0;
+    }
+    int read()
+    {
+      return 0;
+    }
+    void setClock(uint32_t) {}
+};
+
+extern TwoWire Wire;
+
+#endif  // HOST_STUBS_WIRE_H
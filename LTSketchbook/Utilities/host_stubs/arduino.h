@@ -0,0 +1,9 @@
+// Host stand-in for <arduino.h>, the lower case spelling some libraries use.
+// See Arduino.h in this directory.
+
+#ifndef HOST_STUBS_ARDUINO_LOWER_H
+#define HOST_STUBS_ARDUINO_LOWER_H
+
+#include <Arduino.h>
+
+#endif  // HOST_STUBS_ARDUINO_LOWER_H
@@ -0,0 +1,12 @@
+// Host stand-in for <avr/interrupt.h>.  An ISR becomes a plain function the test can call.
+
+#ifndef HOST_STUBS_AVR_INTERRUPT_H
+#define HOST_STUBS_AVR_INTERRUPT_H
+
+#define ISR(vector, ...) extern "C" void vector(void) __VA_ARGS__; extern "C" void vector(void)
+#define ISR_NOBLOCK
+
+void cli();
+void sei();
+
+#endif  // HOST_STUBS_AVR_INTERRUPT_H
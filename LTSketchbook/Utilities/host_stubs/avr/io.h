@@ -0,0 +1,101 @@
+// Host stand-in for <avr/io.h>.  ATmega328P registers are plain variables defined in host_stubs.cpp.
+
+#ifndef HOST_STUBS_AVR_IO_H
+#define HOST_STUBS_AVR_IO_H
+
+#include <stdint.h>
+
+#define F_CPU 16000000UL
+
+extern volatile uint8_t SREG;
+extern volatile uint8_t PORTB, PINB, DDRB, PORTC, PINC, DDRC, PORTD, PIND, DDRD;
+extern volatile uint8_t SPCR, SPSR, SPDR;
+extern volatile uint8_t TWDR, TWSR, TWBR, TWAR;
+
+#ifdef HOST_TWI_MODEL
+// With HOST_TWI_MODEL defined, TWCR is a register whose writes go to host_twi_control(), which
+// the test supplies to model the TWI hardware.  Reads return host_twcr, which the model updates.
+void host_twi_control(uint8_t value);
+extern volatile uint8_t host_twcr;
+
+struct host_twcr_register
+{
+  host_twcr_register &operator=(uint8_t value)
+  {
+    host_twi_control(value);
+    return *this;
+  }
+  operator uint8_t() const
+  {
+    return host_twcr;
+  }
+};
+extern host_twcr_register TWCR;
+#else
+extern volatile uint8_t TWCR;
+#endif
+extern volatile uint8_t TCCR0A, TCCR0B, OCR0A, TIMSK0;
+extern volatile uint8_t TCCR1A, TCCR1B, TCCR1C, TIMSK1, TIFR1;
+extern volatile uint16_t TCNT1, OCR1A, OCR1B, ICR1;
+extern volatile uint8_t TCCR2A, TCCR2B, TCNT2, OCR2A, OCR2B, TIMSK2;
+extern volatile uint8_t EICRA, EIMSK, EIFR;
+
+#define _BV(b) (1 << (b))
+#define bit_is_set(r,b) ((r) & _BV(b))
+#define bit_is_clear(r,b) (!((r) & _BV(b)))
+
+#define PB2 2
+#define PORTB2 2
+
+#define SPI2X 0
+#define SPR0 0
+#define SPR1 1
+#define MSTR 4
+#define SPE 6
+#define SPIF 7
+
+#define TWIE 0
+#define TWEN 2
+#define TWWC 3
+#define TWSTO 4
+#define TWSTA 5
+#define TWEA 6
+#define TWINT 7
+#define TWPS0 0
+#define TWPS1 1
+
+#define CS10 0
+#define CS11 1
+#define CS12 2
+#define WGM10 0
+#define WGM11 1
+#define WGM12 3
+#define WGM13 4
+#define COM1B0 4
+#define COM1B1 5
+#define COM1A0 6
+#define COM1A1 7
+#define ICES1 6
+#define ICNC1 7
+#define TOIE1 0
+#define OCIE1A 1
+#define OCIE1B 2
+#define ICIE1 5
+#define TOV1 0
+#define OCF1A 1
+#define OCF1B 2
+#define ICF1 5
+
+#define CS20 0
+#define WGM20 0
+#define WGM21 1
+#define COM2B1 5
+#define COM2A0 6
+#define OCIE2A 1
+
+#define INT0 0
+#define INT1 1
+#define INTF0 0
+#define INTF1 1
+
+#endif  // HOST_STUBS_AVR_IO_H
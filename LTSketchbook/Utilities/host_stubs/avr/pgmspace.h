@@ -0,0 +1,18 @@
+// Host stand-in for <avr/pgmspace.h>.  Program memory is ordinary memory on the host.
+
+#ifndef HOST_STUBS_AVR_PGMSPACE_H
+#define HOST_STUBS_AVR_PGMSPACE_H
+
+#define PROGMEM
+#define PSTR(x) (x)
+#define pgm_read_byte(a) (*(const uint8_t *)(a))
+#define pgm_read_byte_near(a) (*(const uint8_t *)(a))
+#define pgm_read_word(a) (*(const uint16_t *)(a))
+#define pgm_read_word_near(a) (*(const uint16_t *)(a))
+// The display libraries read PROGMEM pointers with pgm_read_dword(), which
+// must therefore be pointer sized here.
+#define pgm_read_dword(a) (*(const uintptr_t *)(a))
+#define pgm_read_pointer(a) (*(void * const *)(a))
+typedef char prog_char;
+
+#endif  // HOST_STUBS_AVR_PGMSPACE_H
@@ -0,0 +1,101 @@
+/*
+Default definitions for the declarations in this directory.
+
+NOT PART OF ANY SKETCH.  Link this file into a host test program.  Every
+function is weak, so a test that models a device replaces only the calls it
+cares about (for example SPIClass::transfer() or digitalWrite()) and keeps
+the rest.
+*/
+
+#include <Arduino.h>
+#include <SPI.h>
+#include <Wire.h>
+
+#define HOST_WEAK __attribute__((weak))
+
+volatile uint8_t SREG;
+volatile uint8_t PORTB, PINB, DDRB, PORTC, PINC, DDRC, PORTD, PIND, DDRD;
+volatile uint8_t SPCR, SPSR, SPDR;
+volatile uint8_t TWDR, TWSR, TWBR, TWAR;
+#ifdef HOST_TWI_MODEL
+volatile uint8_t host_twcr;
+host_twcr_register TWCR;
+#else
+volatile uint8_t TWCR;
+#endif
+volatile uint8_t TCCR0A, TCCR0B, OCR0A, TIMSK0;
+volatile uint8_t TCCR1A, TCCR1B, TCCR1C, TIMSK1, TIFR1;
+volatile uint16_t TCNT1, OCR1A, OCR1B, ICR1;
+volatile uint8_t TCCR2A, TCCR2B, TCNT2, OCR2A, OCR2B, TIMSK2;
+volatile uint8_t EICRA, EIMSK, EIFR;
+
+HardwareSerial Serial;
+SPIClass SPI;
+TwoWire Wire;
+
+unsigned long host_time_us;
+
+HOST_WEAK void digitalWrite(uint8_t, uint8_t) {}
+HOST_WEAK int digitalRead(uint8_t)
+{
+  return LOW;
+}
+HOST_WEAK void pinMode(uint8_t, uint8_t) {}
+HOST_WEAK int analogRead(uint8_t)
+{
+  return 0;
+}
+HOST_WEAK void analogWrite(uint8_t, int) {}
+HOST_WEAK void attachInterrupt(uint8_t, void (*)(void), int) {}
+HOST_WEAK void detachInterrupt(uint8_t) {}
+
+HOST_WEAK void delay(unsigned long ms)
+{
+  host_time_us += ms * 1000UL;
+}
+HOST_WEAK void delayMicroseconds(unsigned int us)
+{
+  host_time_us += us;
+}
+HOST_WEAK unsigned long millis()
+{
+  return host_time_us / 1000UL;
+}
+HOST_WEAK unsigned long micros()
+{
+  return host_time_us;
+}
+HOST_WEAK void _delay_us(double us)
+{
+  host_time_us += (unsigned long)us;
+}
+HOST_WEAK void _delay_ms(double ms)
+{
+  host_time_us += (unsigned long)(ms * 1000.0);
+}
+
+HOST_WEAK void cli()
+{
+  SREG &= ~0x80;
+}
+HOST_WEAK void sei()
+{
+  SREG |= 0x80;
+}
+
+HOST_WEAK uint8_t SPIClass::transfer(uint8_t)
+{
+  return 0xFF;
+}
+
+HOST_WEAK void TwoWire::beginTransmission(uint8_t) {}
+HOST_WEAK uint8_t TwoWire::endTransmission(uint8_t)
+{
+  return 0;
+}
+
+HOST_WEAK char *dtostrf(double value, signed char width, unsigned char precision, char *buffer)
+{
+  sprintf(buffer, "%*.*f", width, precision, value);
+  return buffer;
+}
@@ -0,0 +1,8 @@
+// Host stand-in for <pins_arduino.h>.  See Arduino.h in this directory.
+
+#ifndef HOST_STUBS_PINS_ARDUINO_H
+#define HOST_STUBS_PINS_ARDUINO_H
+
+#include <Arduino.h>
+
+#endif  // HOST_STUBS_PINS_ARDUINO_H
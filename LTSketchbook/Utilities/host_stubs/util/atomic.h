@@ -0,0 +1,9 @@
+// Host stand-in for <util/atomic.h>.  Test programs are single threaded.
+
+#ifndef HOST_STUBS_UTIL_ATOMIC_H
+#define HOST_STUBS_UTIL_ATOMIC_H
+
+#define ATOMIC_RESTORESTATE 0
+#define ATOMIC_BLOCK(type) for (int _atomic_once = 1; _atomic_once; _atomic_once = 0)
+
+#endif  // HOST_STUBS_UTIL_ATOMIC_H
@@ -0,0 +1,9 @@
+// Host stand-in for <util/delay.h>.
+
+#ifndef HOST_STUBS_UTIL_DELAY_H
+#define HOST_STUBS_UTIL_DELAY_H
+
+void _delay_us(double us);
+void _delay_ms(double ms);
+
+#endif  // HOST_STUBS_UTIL_DELAY_H
@@ -0,0 +1,8 @@
+// Host stand-in for <wiring_private.h>.  See Arduino.h in this directory.
+
+#ifndef HOST_STUBS_WIRING_PRIVATE_H
+#define HOST_STUBS_WIRING_PRIVATE_H
+
+#include <Arduino.h>
+
+#endif  // HOST_STUBS_WIRING_PRIVATE_H
@@ -599,6 +599,11 @@ void Adafruit_GFX::write(uint8_t c)
 #endif
 }
 
+const unsigned char *Adafruit_GFX::classicFont(void)
+{
+  return font;
+}
+
 // Draw a character
 void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c,
                             uint16_t color, uint16_t bg, uint8_t size)
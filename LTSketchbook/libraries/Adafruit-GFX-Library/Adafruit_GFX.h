@@ -29,7 +29,9 @@ class Adafruit_GFX : public Print
              drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color),
              fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color),
              fillScreen(uint16_t color),
-             invertDisplay(boolean i);
+             invertDisplay(boolean i),
+             drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color,
+                      uint16_t bg, uint8_t size);
 
     // These exist only with Adafruit_GFX (no subclass overrides)
     void
@@ -57,8 +59,6 @@ class Adafruit_GFX : public Print
                           int16_t w, int16_t h, uint16_t color, uint16_t bg),
                drawXBitmap(int16_t x, int16_t y, const uint8_t *bitmap,
                            int16_t w, int16_t h, uint16_t color),
-               drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color,
-                        uint16_t bg, uint8_t size),
                setCursor(int16_t x, int16_t y),
                setTextColor(uint16_t c),
                setTextColor(uint16_t c, uint16_t bg),
@@ -88,6 +88,10 @@ class Adafruit_GFX : public Print
     int16_t getCursorY(void) const;
 
   protected:
+    // 'Classic' 5x7 font table (PROGMEM), for subclasses that render glyphs
+    // themselves.
+    static const unsigned char *classicFont(void);
+
     const int16_t
     WIDTH, HEIGHT;   // This is the 'raw' display w/h - never changes
     int16_t
@@ -24,6 +24,15 @@
 #include "wiring_private.h"
 #include <SPI.h>
 
+// Font pointers are 16 bits on AVR and 32 bits elsewhere (see Adafruit_GFX.cpp)
+#ifndef pgm_read_pointer
+#if !defined(__INT_MAX__) || (__INT_MAX__ > 0xFFFF)
+#define pgm_read_pointer(addr) ((void *)pgm_read_dword(addr))
+#else
+#define pgm_read_pointer(addr) ((void *)pgm_read_word(addr))
+#endif
+#endif
+
 
 // If the SPI library has transaction support, these functions
 // establish settings and protect from interference from other
@@ -137,6 +146,106 @@ void Adafruit_ILI9341::spiwrite(uint8_t c)
 }
 
 
+// Stream len pixels of one color into the current address window.  DC and
+// CS must already be set for data.  On AVR the next byte is loaded into
+// SPDR as soon as SPIF is set, without a function call or SPCR swap per
+// byte; other hardware SPI targets send ILI9341_BURST_SIZE pixels per
+// SPI.transfer() block.
+void Adafruit_ILI9341::writeColor(uint16_t color, uint32_t len)
+{
+
+  uint8_t hi = color >> 8, lo = color;
+
+  if (!hwSPI)
+  {
+    while (len--)
+    {
+      spiwrite(hi);
+      spiwrite(lo);
+    }
+    return;
+  }
+
+#if defined (__AVR__)
+#ifndef SPI_HAS_TRANSACTION
+  uint8_t backupSPCR = SPCR;
+  SPCR = mySPCR;
+#endif
+  while (len--)
+  {
+    SPDR = hi;
+    while (!(SPSR & _BV(SPIF)));
+    SPDR = lo;
+    while (!(SPSR & _BV(SPIF)));
+  }
+#ifndef SPI_HAS_TRANSACTION
+  SPCR = backupSPCR;
+#endif
+#else
+  uint8_t buf[ILI9341_BURST_SIZE * 2];
+  while (len)
+  {
+    uint16_t n = (len > ILI9341_BURST_SIZE) ? ILI9341_BURST_SIZE : len;
+    for (uint16_t i=0; i<n; i++)
+    {
+      buf[2*i]   = hi;
+      buf[2*i+1] = lo;
+    }
+    SPI.transfer(buf, n * 2);   // transfer() overwrites buf with read data
+    len -= n;
+  }
+#endif
+}
+
+// Stream an array of pixels into the current address window.  DC and CS
+// must already be set for data.
+void Adafruit_ILI9341::writePixels(const uint16_t *colors, uint16_t len)
+{
+
+  if (!hwSPI)
+  {
+    while (len--)
+    {
+      spiwrite(*colors >> 8);
+      spiwrite(*colors++);
+    }
+    return;
+  }
+
+#if defined (__AVR__)
+#ifndef SPI_HAS_TRANSACTION
+  uint8_t backupSPCR = SPCR;
+  SPCR = mySPCR;
+#endif
+  while (len--)
+  {
+    uint16_t color = *colors++;
+    SPDR = color >> 8;
+    while (!(SPSR & _BV(SPIF)));
+    SPDR = color;
+    while (!(SPSR & _BV(SPIF)));
+  }
+#ifndef SPI_HAS_TRANSACTION
+  SPCR = backupSPCR;
+#endif
+#else
+  uint8_t buf[ILI9341_BURST_SIZE * 2];
+  while (len)
+  {
+    uint16_t n = (len > ILI9341_BURST_SIZE) ? ILI9341_BURST_SIZE : len;
+    for (uint16_t i=0; i<n; i++)
+    {
+      buf[2*i]   = colors[i] >> 8;
+      buf[2*i+1] = colors[i];
+    }
+    SPI.transfer(buf, n * 2);
+    colors += n;
+    len -= n;
+  }
+#endif
+}
+
+
 void Adafruit_ILI9341::writecommand(uint8_t c)
 {
 #if defined (USE_FAST_PINIO)
@@ -438,8 +547,32 @@ void Adafruit_ILI9341::pushColor(uint16_t color)
   digitalWrite(_cs, LOW);
 #endif
 
-  spiwrite(color >> 8);
-  spiwrite(color);
+  writeColor(color, 1);
+
+#if defined(USE_FAST_PINIO)
+  *csport |= cspinmask;
+#else
+  digitalWrite(_cs, HIGH);
+#endif
+
+  if (hwSPI) spi_end();
+}
+
+// Push a run of pixels into the window set by setAddrWindow() with a single
+// CS assertion, instead of one pushColor() call (and transaction) per pixel.
+void Adafruit_ILI9341::pushColors(const uint16_t *colors, uint16_t len)
+{
+  if (hwSPI) spi_begin();
+
+#if defined(USE_FAST_PINIO)
+  *dcport |=  dcpinmask;
+  *csport &= ~cspinmask;
+#else
+  digitalWrite(_dc, HIGH);
+  digitalWrite(_cs, LOW);
+#endif
+
+  writePixels(colors, len);
 
 #if defined(USE_FAST_PINIO)
   *csport |= cspinmask;
@@ -450,6 +583,186 @@ void Adafruit_ILI9341::pushColor(uint16_t color)
   if (hwSPI) spi_end();
 }
 
+// Draw a w x h character cell as a single address window and stream every
+// pixel in one burst.  The 1-bit packed bitmap (PROGMEM, GFXfont layout) is
+// placed at (bx, by) inside the cell with size bw x bh; its set bits are
+// drawn in 'color' and every other pixel of the cell is filled with 'bg', so
+// the old character is erased and the new one drawn without flicker.
+void Adafruit_ILI9341::drawGlyphCell(int16_t x, int16_t y, int16_t w, int16_t h,
+                                     const uint8_t *bitmap, int16_t bx, int16_t by,
+                                     int16_t bw, int16_t bh, uint16_t color, uint16_t bg)
+{
+
+  if ((w <= 0) || (h <= 0) || (x < 0) || (y < 0) ||
+      ((x + w) > _width) || ((y + h) > _height)) return;
+
+  if (hwSPI) spi_begin();
+  setAddrWindow(x, y, x+w-1, y+h-1);
+
+#if defined(USE_FAST_PINIO)
+  *dcport |=  dcpinmask;
+  *csport &= ~cspinmask;
+#else
+  digitalWrite(_dc, HIGH);
+  digitalWrite(_cs, LOW);
+#endif
+
+  // Pixels are sent as runs of one color
+  uint16_t run_color = bg;
+  uint16_t run = 0;
+  for (int16_t yy=0; yy<h; yy++)
+  {
+    int16_t gy = yy - by;
+    for (int16_t xx=0; xx<w; xx++)
+    {
+      int16_t  gx = xx - bx;
+      uint16_t c  = bg;
+      if ((gy >= 0) && (gy < bh) && (gx >= 0) && (gx < bw))
+      {
+        uint16_t bit = gy * bw + gx;
+        if (pgm_read_byte(&bitmap[bit >> 3]) & (0x80 >> (bit & 7))) c = color;
+      }
+      if (c != run_color)
+      {
+        writeColor(run_color, run);
+        run_color = c;
+        run = 0;
+      }
+      run++;
+    }
+  }
+  writeColor(run_color, run);
+
+#if defined(USE_FAST_PINIO)
+  *csport |= cspinmask;
+#else
+  digitalWrite(_cs, HIGH);
+#endif
+
+  if (hwSPI) spi_end();
+}
+
+// Draw a character with a single address window per glyph instead of one
+// window per pixel.  The classic font is streamed as its full 6x8 (times
+// size) cell, background included.  Custom fonts stay transparent as in
+// Adafruit_GFX: bg is ignored and each horizontal run of set pixels is
+// drawn as one line.  Use drawGlyphCell() to draw a custom font glyph over
+// a filled background.  Transparent text (bg == color), scaled custom
+// fonts and glyphs that are clipped by the screen edge fall back to the
+// generic Adafruit_GFX pixel path.
+void Adafruit_ILI9341::drawChar(int16_t x, int16_t y, unsigned char c,
+                                uint16_t color, uint16_t bg, uint8_t size)
+{
+
+  if (bg == color)
+  {
+    Adafruit_GFX::drawChar(x, y, c, color, bg, size);
+    return;
+  }
+
+  if (!gfxFont)  // 'Classic' built-in font
+  {
+    int16_t w = 6 * size, h = 8 * size;
+    if ((x < 0) || (y < 0) || ((x + w) > _width) || ((y + h) > _height))
+    {
+      Adafruit_GFX::drawChar(x, y, c, color, bg, size);
+      return;
+    }
+
+    if (!_cp437 && (c >= 176)) c++; // Handle 'classic' charset behavior
+
+    const unsigned char *font = classicFont();
+    uint8_t line[6];
+    for (uint8_t i=0; i<5; i++) line[i] = pgm_read_byte(font+(c*5)+i);
+    line[5] = 0x0;
+
+    if (hwSPI) spi_begin();
+    setAddrWindow(x, y, x+w-1, y+h-1);
+
+#if defined(USE_FAST_PINIO)
+    *dcport |=  dcpinmask;
+    *csport &= ~cspinmask;
+#else
+    digitalWrite(_dc, HIGH);
+    digitalWrite(_cs, LOW);
+#endif
+
+    // The font is stored by column; the display is written by row, as
+    // runs of one color.
+    uint16_t run_color = bg;
+    uint16_t run = 0;
+    for (uint8_t j=0; j<8; j++)
+    {
+      for (uint8_t sy=0; sy<size; sy++)
+      {
+        for (uint8_t i=0; i<6; i++)
+        {
+          uint16_t pc = (line[i] & (1 << j)) ? color : bg;
+          if (pc != run_color)
+          {
+            writeColor(run_color, run);
+            run_color = pc;
+            run = 0;
+          }
+          run += size;
+        }
+      }
+    }
+    writeColor(run_color, run);
+
+#if defined(USE_FAST_PINIO)
+    *csport |= cspinmask;
+#else
+    digitalWrite(_cs, HIGH);
+#endif
+
+    if (hwSPI) spi_end();
+  }
+  else     // Custom font, transparent
+  {
+    if (size != 1)
+    {
+      Adafruit_GFX::drawChar(x, y, c, color, bg, size);
+      return;
+    }
+
+    c -= pgm_read_byte(&gfxFont->first);
+    GFXglyph *glyph  = &(((GFXglyph *)pgm_read_pointer(&gfxFont->glyph))[c]);
+    uint8_t  *bitmap = (uint8_t *)pgm_read_pointer(&gfxFont->bitmap);
+
+    uint16_t bo = pgm_read_word(&glyph->bitmapOffset);
+    uint8_t  w  = pgm_read_byte(&glyph->width),
+             h  = pgm_read_byte(&glyph->height);
+    int8_t   xo = pgm_read_byte(&glyph->xOffset),
+             yo = pgm_read_byte(&glyph->yOffset);
+
+    if ((w == 0) || (h == 0)) return;
+    if (((x + xo) < 0) || ((y + yo) < 0) ||
+        ((x + xo + w) > _width) || ((y + yo + h) > _height))
+    {
+      Adafruit_GFX::drawChar(x, y, c + pgm_read_byte(&gfxFont->first), color, bg, size);
+      return;
+    }
+
+    uint16_t bit = 0;
+    for (uint8_t yy=0; yy<h; yy++)
+    {
+      uint8_t run = 0;
+      for (uint8_t xx=0; xx<w; xx++, bit++)
+      {
+        if (pgm_read_byte(&bitmap[bo + (bit >> 3)]) & (0x80 >> (bit & 7)))
+          run++;
+        else if (run)
+        {
+          drawFastHLine(x + xo + xx - run, y + yo + yy, run, color);
+          run = 0;
+        }
+      }
+      if (run) drawFastHLine(x + xo + w - run, y + yo + yy, run, color);
+    }
+  }
+}
+
 void Adafruit_ILI9341::drawPixel(int16_t x, int16_t y, uint16_t color)
 {
 
@@ -492,8 +805,6 @@ void Adafruit_ILI9341::drawFastVLine(int16_t x, int16_t y, int16_t h,
   if (hwSPI) spi_begin();
   setAddrWindow(x, y, x, y+h-1);
 
-  uint8_t hi = color >> 8, lo = color;
-
 #if defined(USE_FAST_PINIO)
   *dcport |=  dcpinmask;
   *csport &= ~cspinmask;
@@ -502,11 +813,7 @@ void Adafruit_ILI9341::drawFastVLine(int16_t x, int16_t y, int16_t h,
   digitalWrite(_cs, LOW);
 #endif
 
-  while (h--)
-  {
-    spiwrite(hi);
-    spiwrite(lo);
-  }
+  writeColor(color, h);
 
 #if defined(USE_FAST_PINIO)
   *csport |= cspinmask;
@@ -528,7 +835,6 @@ void Adafruit_ILI9341::drawFastHLine(int16_t x, int16_t y, int16_t w,
   if (hwSPI) spi_begin();
   setAddrWindow(x, y, x+w-1, y);
 
-  uint8_t hi = color >> 8, lo = color;
 #if defined(USE_FAST_PINIO)
   *dcport |=  dcpinmask;
   *csport &= ~cspinmask;
@@ -536,11 +842,7 @@ void Adafruit_ILI9341::drawFastHLine(int16_t x, int16_t y, int16_t w,
   digitalWrite(_dc, HIGH);
   digitalWrite(_cs, LOW);
 #endif
-  while (w--)
-  {
-    spiwrite(hi);
-    spiwrite(lo);
-  }
+  writeColor(color, w);
 #if defined(USE_FAST_PINIO)
   *csport |= cspinmask;
 #else
@@ -567,8 +869,6 @@ void Adafruit_ILI9341::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
   if (hwSPI) spi_begin();
   setAddrWindow(x, y, x+w-1, y+h-1);
 
-  uint8_t hi = color >> 8, lo = color;
-
 #if defined(USE_FAST_PINIO)
   *dcport |=  dcpinmask;
   *csport &= ~cspinmask;
@@ -577,14 +877,7 @@ void Adafruit_ILI9341::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
   digitalWrite(_cs, LOW);
 #endif
 
-  for (y=h; y>0; y--)
-  {
-    for (x=w; x>0; x--)
-    {
-      spiwrite(hi);
-      spiwrite(lo);
-    }
-  }
+  writeColor(color, (uint32_t)w * h);
 #if defined(USE_FAST_PINIO)
   *csport |= cspinmask;
 #else
@@ -34,6 +34,11 @@
 #define USE_FAST_PINIO
 #endif
 
+// Pixels per SPI.transfer() block on targets without direct SPDR access
+#ifndef ILI9341_BURST_SIZE
+#define ILI9341_BURST_SIZE 32
+#endif
+
 #define ILI9341_TFTWIDTH  240
 #define ILI9341_TFTHEIGHT 320
 
@@ -127,12 +132,18 @@ class Adafruit_ILI9341 : public Adafruit_GFX
     void     begin(void),
              setAddrWindow(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1),
              pushColor(uint16_t color),
+             pushColors(const uint16_t *colors, uint16_t len),
+             drawGlyphCell(int16_t x, int16_t y, int16_t w, int16_t h,
+                           const uint8_t *bitmap, int16_t bx, int16_t by,
+                           int16_t bw, int16_t bh, uint16_t color, uint16_t bg),
              fillScreen(uint16_t color),
              drawPixel(int16_t x, int16_t y, uint16_t color),
              drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color),
              drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color),
              fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
                       uint16_t color),
+             drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color,
+                      uint16_t bg, uint8_t size),
              setRotation(uint8_t r),
              invertDisplay(boolean i);
     uint16_t color565(uint8_t r, uint8_t g, uint8_t b);
@@ -155,6 +166,9 @@ class Adafruit_ILI9341 : public Adafruit_GFX
   private:
     uint8_t  tabcolor;
 
+    void     writeColor(uint16_t color, uint32_t len),
+             writePixels(const uint16_t *colors, uint16_t len);
+
 
 
     boolean  hwSPI;
@@ -0,0 +1,93 @@
+/***************************************************
+  Fill-rate benchmark for the Adafruit ILI9341 Breakout and Shield
+  ----> http://www.adafruit.com/products/1651
+
+  Times the bulk pixel paths of the library (fillScreen, fillRect,
+  drawFastHLine, drawFastVLine, pushColors) against single-pixel
+  pushColor() and prints the result in pixels per second.
+
+  MIT license, all text above must be included in any redistribution
+ ****************************************************/
+
+
+#include "SPI.h"
+#include "Adafruit_GFX.h"
+#include "Adafruit_ILI9341.h"
+
+// For the Adafruit shield, these are the default.
+#define TFT_DC 9
+#define TFT_CS 10
+
+// Use hardware SPI (on Uno, #13, #12, #11) and the above for CS/DC
+Adafruit_ILI9341 tft = Adafruit_ILI9341(TFT_CS, TFT_DC);
+
+// Print one benchmark line: name, time and fill rate
+void printRate(const __FlashStringHelper *name, uint32_t pixels, unsigned long us)
+{
+  Serial.print(name);
+  Serial.print(us);
+  Serial.print(F("\t"));
+  Serial.println((uint32_t)((float)pixels * 1000000.0 / us));
+}
+
+void setup()
+{
+  Serial.begin(9600);
+  Serial.println(F("ILI9341 fill rate"));
+
+  tft.begin();
+
+  Serial.println(F("Benchmark            Time (us)\tPixels/s"));
+  delay(10);
+
+  uint32_t screen = (uint32_t)tft.width() * tft.height();
+  unsigned long start;
+
+  start = micros();
+  tft.fillScreen(ILI9341_BLACK);
+  tft.fillScreen(ILI9341_RED);
+  tft.fillScreen(ILI9341_GREEN);
+  tft.fillScreen(ILI9341_BLUE);
+  printRate(F("Screen fill (x4)     "), 4 * screen, micros() - start);
+  delay(500);
+
+  start = micros();
+  for (uint8_t i=0; i<16; i++) tft.fillRect(60, 100, 120, 120, i & 1 ? ILI9341_YELLOW : ILI9341_MAGENTA);
+  printRate(F("fillRect 120x120 x16 "), 16UL * 120 * 120, micros() - start);
+  delay(500);
+
+  tft.fillScreen(ILI9341_BLACK);
+  start = micros();
+  for (int16_t y=0; y<tft.height(); y++) tft.drawFastHLine(0, y, tft.width(), ILI9341_CYAN);
+  printRate(F("drawFastHLine        "), screen, micros() - start);
+  delay(500);
+
+  start = micros();
+  for (int16_t x=0; x<tft.width(); x++) tft.drawFastVLine(x, 0, tft.height(), ILI9341_RED);
+  printRate(F("drawFastVLine        "), screen, micros() - start);
+  delay(500);
+
+  // A 240 pixel gradient row pushed once per display line
+  uint16_t row[ILI9341_TFTWIDTH];
+  for (uint16_t x=0; x<ILI9341_TFTWIDTH; x++) row[x] = tft.color565(x, 255 - x, x >> 1);
+  start = micros();
+  for (int16_t y=0; y<tft.height(); y++)
+  {
+    tft.setAddrWindow(0, y, tft.width() - 1, y);
+    tft.pushColors(row, tft.width());
+  }
+  printRate(F("pushColors           "), screen, micros() - start);
+  delay(500);
+
+  start = micros();
+  tft.setAddrWindow(0, 0, 63, 63);
+  for (uint16_t i=0; i<64*64; i++) tft.pushColor(row[i % ILI9341_TFTWIDTH]);
+  printRate(F("pushColor 64x64      "), 64UL * 64, micros() - start);
+
+  Serial.println(F("Done!"));
+}
+
+
+void loop(void)
+{
+}
@@ -0,0 +1,287 @@
+/*
+Host test for the streamed ILI9341 drawing paths.
+
+NOT AN ARDUINO SKETCH.  This program builds Adafruit_ILI9341 and Adafruit_GFX
+with g++ against Utilities/host_stubs.  SPI.transfer() and digitalWrite() feed
+a model of the controller that decodes CASET, PASET and RAMWR into a 240x320
+frame buffer and counts the bytes sent.
+
+Text is drawn once through Adafruit_ILI9341::drawChar() and once through the
+generic Adafruit_GFX::drawChar() pixel path, over a frame buffer filled with a
+pattern, for the classic and a GFXfont font at sizes 1 to 3, opaque and
+transparent.  The two frame buffers must be identical, so custom fonts stay
+transparent.  The SPI bytes of both paths are printed.
+
+fillRect(), fillScreen(), the fast lines, pushColors() and pushColor() are
+checked against frame buffers built directly, including clipping at the
+screen edge.  For each the SPI bytes per pixel are printed together with
+the fill rate the SPI clock alone would allow.  The rate on a Linduino is
+lower, since the CPU also has to feed SPDR; examples/fillrate measures it.
+
+  make
+  ./ili9341_test
+
+Copyright 2018(c) Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in
+   the documentation and/or other materials provided with the
+   distribution.
+ - Neither the name of Analog Devices, Inc. nor the names of its
+   contributors may be used to endorse or promote products derived
+   from this software without specific prior written permission.
+ - The use of this software may or may not infringe the patent rights
+   of one or more patent holders.  This license does not release you
+   from the requirement that you obtain separate licenses from these
+   patent holders to use this software.
+ - Use of the software either in source or binary form, must be run
+   on or directly connected to an Analog Devices Inc. component.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <Arduino.h>
+#include <SPI.h>
+#include <Adafruit_ILI9341.h>
+#include <Anonymous_Pro6pt7b.h>
+
+#define TFT_CS  10
+#define TFT_DC  9
+#define BACKGROUND_PATTERN 0x55   // Frame buffer fill, so transparent text shows what it did not draw
+#define SPI_CLOCK_HZ 8000000UL    // Linduino hardware SPI at SPI_CLOCK_DIV2
+
+// Controller model
+static uint16_t frame[ILI9341_TFTHEIGHT][ILI9341_TFTWIDTH];
+static long spi_bytes;
+static uint8_t dc_level = HIGH;
+static uint8_t command;
+static uint8_t params[4];
+static uint8_t param_count;
+static uint16_t x_start, x_end, y_start, y_end, x, y;
+static uint8_t pixel_high;
+static uint8_t pixel_half;
+
+void digitalWrite(uint8_t pin, uint8_t level)
+{
+  if (pin == TFT_DC)
+    dc_level = level;
+  if ((pin == TFT_CS) && (level == LOW))
+    pixel_half = 0;
+}
+
+uint8_t SPIClass::transfer(uint8_t data)
+{
+  spi_bytes++;
+  if (dc_level == LOW)
+  {
+    command = data;
+    param_count = 0;
+    pixel_half = 0;
+    if (command == ILI9341_RAMWR)
+    {
+      x = x_start;
+      y = y_start;
+    }
+    return 0;
+  }
+  if ((command == ILI9341_CASET) || (command == ILI9341_PASET))
+  {
+    if (param_count < 4)
+      params[param_count++] = data;
+    if (param_count == 4)
+    {
+      if (command == ILI9341_CASET)
+      {
+        x_start = (params[0] << 8) | params[1];
+        x_end = (params[2] << 8) | params[3];
+      }
+      else
+      {
+        y_start = (params[0] << 8) | params[1];
+        y_end = (params[2] << 8) | params[3];
+      }
+    }
+  }
+  else if (command == ILI9341_RAMWR)
+  {
+    if (!pixel_half)
+    {
+      pixel_high = data;
+      pixel_half = 1;
+      return 0;
+    }
+    pixel_half = 0;
+    if ((y < ILI9341_TFTHEIGHT) && (x < ILI9341_TFTWIDTH))
+      frame[y][x] = (pixel_high << 8) | data;
+    if (++x > x_end)
+    {
+      x = x_start;
+      y++;
+    }
+  }
+  return 0;
+}
+
+// Draws every character through the generic Adafruit_GFX pixel path
+class GenericText : public Adafruit_ILI9341
+{
+  public:
+    GenericText() : Adafruit_ILI9341(TFT_CS, TFT_DC) {}
+    void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t size)
+    {
+      Adafruit_GFX::drawChar(x, y, c, color, bg, size);
+    }
+};
+
+static int failures;
+
+static long draw_text(Adafruit_ILI9341 &tft, const GFXfont *font, uint8_t size, uint16_t bg, const char *text)
+{
+  memset(frame, BACKGROUND_PATTERN, sizeof(frame));
+  tft.setFont(font);
+  tft.setTextSize(size);
+  tft.setTextColor(ILI9341_WHITE, bg);
+  tft.setCursor(3, font ? 30 : 3);
+  spi_bytes = 0;
+  for (const char *p = text; *p; p++)
+    tft.write(*p);
+  return spi_bytes;
+}
+
+static void test_text()
+{
+  static uint16_t generic_frame[ILI9341_TFTHEIGHT][ILI9341_TFTWIDTH];
+  Adafruit_ILI9341 streamed(TFT_CS, TFT_DC);
+  GenericText generic;
+  const char *text = "-12.3456V +0.125mA";
+  const GFXfont *fonts[2] = {NULL, &Anonymous_Pro6pt7b};
+
+  printf("SPI bytes for \"%s\"           generic  streamed\n", text);
+  for (int f = 0; f < 2; f++)
+    for (uint8_t size = 1; size <= 3; size++)
+      for (int opaque = 0; opaque < 2; opaque++)
+      {
+        uint16_t bg = opaque ? ILI9341_BLUE : ILI9341_WHITE;
+        long generic_bytes = draw_text(generic, fonts[f], size, bg, text);
+        memcpy(generic_frame, frame, sizeof(frame));
+        long streamed_bytes = draw_text(streamed, fonts[f], size, bg, text);
+        int same = (memcmp(generic_frame, frame, sizeof(frame)) == 0);
+        printf("  %-7s size %u %-11s           %8ld  %8ld  %s\n", f ? "GFXfont" : "classic", size,
+               opaque ? "opaque" : "transparent", generic_bytes, streamed_bytes, same ? "ok" : "FAIL");
+        if (!same)
+          failures++;
+      }
+}
+
+static uint16_t expected[ILI9341_TFTHEIGHT][ILI9341_TFTWIDTH];
+
+static void expect_rect(int16_t x0, int16_t y0, int16_t w, int16_t h, uint16_t color)
+{
+  for (int16_t yy = y0; (yy < y0 + h) && (yy < ILI9341_TFTHEIGHT); yy++)
+    for (int16_t xx = x0; (xx < x0 + w) && (xx < ILI9341_TFTWIDTH); xx++)
+      expected[yy][xx] = color;
+}
+
+// Compare the frame buffer with expected and print the SPI cost per pixel
+static void check_fill(const char *name, long pixels)
+{
+  int same = (memcmp(expected, frame, sizeof(frame)) == 0);
+  double bytes_per_pixel = (double)spi_bytes / pixels;
+  printf("  %-26s %6ld  %5.2f  %9.0f  %s\n", name, pixels, bytes_per_pixel,
+         SPI_CLOCK_HZ / 8 / bytes_per_pixel, same ? "ok" : "FAIL");
+  if (!same)
+    failures++;
+}
+
+static void test_fills()
+{
+  Adafruit_ILI9341 tft(TFT_CS, TFT_DC);
+  uint16_t row[ILI9341_TFTWIDTH];
+  uint16_t x0, i;
+  int16_t yy;
+
+  printf("\n                             pixels  bytes  pixels/s at %lu MHz SCK\n", SPI_CLOCK_HZ / 1000000);
+
+  spi_bytes = 0;
+  tft.fillScreen(ILI9341_BLUE);
+  expect_rect(0, 0, ILI9341_TFTWIDTH, ILI9341_TFTHEIGHT, ILI9341_BLUE);
+  check_fill("fillScreen", (long)ILI9341_TFTWIDTH * ILI9341_TFTHEIGHT);
+
+  spi_bytes = 0;
+  tft.fillRect(60, 100, 120, 120, ILI9341_YELLOW);
+  expect_rect(60, 100, 120, 120, ILI9341_YELLOW);
+  check_fill("fillRect 120x120", 120L * 120);
+
+  spi_bytes = 0;
+  tft.fillRect(200, 300, 100, 100, ILI9341_RED);
+  expect_rect(200, 300, 40, 20, ILI9341_RED);
+  check_fill("fillRect clipped", 40L * 20);
+
+  spi_bytes = 0;
+  for (yy = 0; yy < ILI9341_TFTHEIGHT; yy += 2)
+    tft.drawFastHLine(0, yy, ILI9341_TFTWIDTH, ILI9341_CYAN);
+  for (yy = 0; yy < ILI9341_TFTHEIGHT; yy += 2)
+    expect_rect(0, yy, ILI9341_TFTWIDTH, 1, ILI9341_CYAN);
+  check_fill("drawFastHLine", (long)ILI9341_TFTWIDTH * ILI9341_TFTHEIGHT / 2);
+
+  spi_bytes = 0;
+  for (x0 = 1; x0 < ILI9341_TFTWIDTH; x0 += 2)
+    tft.drawFastVLine(x0, 0, ILI9341_TFTHEIGHT, ILI9341_MAGENTA);
+  for (x0 = 1; x0 < ILI9341_TFTWIDTH; x0 += 2)
+    expect_rect(x0, 0, 1, ILI9341_TFTHEIGHT, ILI9341_MAGENTA);
+  check_fill("drawFastVLine", (long)ILI9341_TFTWIDTH * ILI9341_TFTHEIGHT / 2);
+
+  spi_bytes = 0;
+  tft.drawFastHLine(200, 10, 100, ILI9341_GREEN);
+  tft.drawFastVLine(10, 300, 100, ILI9341_GREEN);
+  expect_rect(200, 10, 40, 1, ILI9341_GREEN);
+  expect_rect(10, 300, 1, 20, ILI9341_GREEN);
+  check_fill("fast lines clipped", 40 + 20);
+
+  // The gradient rows of examples/fillrate
+  for (x0 = 0; x0 < ILI9341_TFTWIDTH; x0++)
+    row[x0] = tft.color565(x0, 255 - x0, x0 >> 1);
+  spi_bytes = 0;
+  for (yy = 0; yy < ILI9341_TFTHEIGHT; yy++)
+  {
+    tft.setAddrWindow(0, yy, ILI9341_TFTWIDTH - 1, yy);
+    tft.pushColors(row, ILI9341_TFTWIDTH);
+  }
+  for (yy = 0; yy < ILI9341_TFTHEIGHT; yy++)
+    memcpy(expected[yy], row, sizeof(row));
+  check_fill("pushColors", (long)ILI9341_TFTWIDTH * ILI9341_TFTHEIGHT);
+
+  spi_bytes = 0;
+  tft.setAddrWindow(0, 0, 63, 63);
+  for (i = 0; i < 64 * 64; i++)
+    tft.pushColor(row[i % ILI9341_TFTWIDTH]);
+  for (i = 0; i < 64 * 64; i++)
+    expected[i / 64][i % 64] = row[i % ILI9341_TFTWIDTH];
+  check_fill("pushColor 64x64", 64L * 64);
+}
+
+int main()
+{
+  test_text();
+  test_fills();
+
+  printf("\n%s\n", failures ? "FAILED" : "PASSED");
+  return failures ? 1 : 0;
+}
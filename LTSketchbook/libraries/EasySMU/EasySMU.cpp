@@ -73,6 +73,13 @@ EasySMU::EasySMU(uint8_t EEPROM_I2C_address_param, uint8_t DAC_I2C_address_param
   DAC_I2C_address_=DAC_I2C_address_param;
   ADC_Vsense_I2C_address_=ADC_Vsense_I2C_address_param;
   ADC_Isense_I2C_address_=ADC_Isense_I2C_address_param;
+  adc_ready_=0;
+  Vadc_start_=0;
+  Iadc_start_=0;
+  sample_count_=0;
+  settle_iterations_=0;
+  settle_time_=0;
+  settle_progress_=NULL;
 }
 
 
@@ -117,6 +124,78 @@ int8_t EasySMU::fltSetCommitVoltageSource(float flt_voltage_setting) //Later mak
   return codeSetCommitVoltageSource(code_voltage_setting); //voltageSet handles the <0 and >0xFFFF conditions
 }
 
+int8_t EasySMU::fltSettleVoltageSource(float flt_voltage_setting, float flt_tolerance, uint8_t max_iterations)
+{
+  return SettleSourceSetting(flt_voltage_setting, flt_tolerance, max_iterations, _EASYSMU_SETTLE_VOLTAGE);
+}
+
+int8_t EasySMU::fltSettleCurrentSource(float flt_current_setting, int8_t source_both_sink, float flt_tolerance, uint8_t max_iterations)
+{
+  return SettleSourceSetting(flt_current_setting, flt_tolerance, max_iterations, source_both_sink);
+}
+
+int8_t EasySMU::SettleSourceSetting(float flt_target, float flt_tolerance, uint8_t max_iterations, int8_t source_both_sink)
+{
+  uint8_t voltage_mode=(source_both_sink==_EASYSMU_SETTLE_VOLTAGE);
+  //Smallest useful correction. Steps below half an LSB do not change the DAC code.
+  float flt_lsb=voltage_mode ? eeprom.calibration.voltage_source_LSB : eeprom.calibration.current_source_pullup_LSB;
+  if (flt_lsb<0) flt_lsb=-flt_lsb;
+  uint32_t start_time=millis();
+  float flt_setting=flt_target;
+  float flt_last_setting=0, flt_last_error=0;
+  float flt_slope=1; //d(measured)/d(setting). Calibration makes it close to 1.
+  int8_t ack;
+
+  settle_iterations_=0;
+  while (1)
+  {
+    if (voltage_mode)
+    {
+      ack=fltSetCommitVoltageSource(flt_setting);
+    }
+    else
+    {
+      ack=fltSetCommitCurrentSource(flt_setting, source_both_sink);
+    }
+    MeasureVoltageCurrent();  //Discard the conversions that started before the new setting
+    ack|=MeasureVoltageCurrent();
+    settle_iterations_++;
+    if (ack) break;
+
+    float flt_measured=flt_measured_voltage_;
+    if (!voltage_mode)
+    {
+      //Compare magnitudes; the sign of the measured current depends on whether the output sources or sinks.
+      flt_measured=(source_both_sink==_SINK_ONLY) ? -flt_measured_current_ :
+                   ((source_both_sink==_SOURCE_ONLY) ? flt_measured_current_ : fabs(flt_measured_current_));
+    }
+    if (settle_progress_ != NULL) settle_progress_(settle_iterations_, flt_measured);
+    float flt_error=flt_measured-flt_target;
+    if (fabs(flt_error)<=flt_tolerance)
+    {
+      settle_time_=millis()-start_time;
+      return (0);
+    }
+    if (settle_iterations_>max_iterations) break; //The first pass is the open-loop setting, so this allows max_iterations corrections.
+
+    //Secant slope from the last two points. Fall back to the calibrated slope of 1 when the points are too close, and limit it so a noisy reading cannot throw the setting far away.
+    if (settle_iterations_>1 && (fabs(flt_setting-flt_last_setting)>=flt_lsb))
+    {
+      flt_slope=(flt_error-flt_last_error)/(flt_setting-flt_last_setting);
+      if (flt_slope<0.5) flt_slope=0.5;
+      if (flt_slope>2) flt_slope=2;
+    }
+    float flt_step=flt_error/flt_slope;
+    if (fabs(flt_step)<flt_lsb/2) break; //Within one LSB but outside tolerance. No better setting exists.
+
+    flt_last_setting=flt_setting;
+    flt_last_error=flt_error;
+    flt_setting-=flt_step;
+  }
+  settle_time_=millis()-start_time;
+  return (1);
+}
+
 float EasySMU::fltReadVoltageSourceSetting()    //Later make this a float version of voltageSet with operators, etc.
 {
   return  ( ((float)((int32_t)Vdac_code_-(int32_t)round(eeprom.calibration.voltage_source_offset))*(-1)*eeprom.calibration.voltage_source_LSB ));
@@ -250,10 +329,53 @@ int8_t EasySMU::MeasureVoltageCurrent()
   int8_t ack=0;
   ack  = LTC2485_read(ADC_Isense_I2C_address_, LTC2485_SPEED_1X | LTC2485_R60, &Iadc_code_, LTC2485_TIMEOUT);
   ack |= LTC2485_read(ADC_Vsense_I2C_address_, LTC2485_SPEED_1X | LTC2485_R60, &Vadc_code_, LTC2485_TIMEOUT);
+  ConversionStarted();
 
+  ScaleVoltageCurrent();
+  return (ack);
+}
+
+void EasySMU::ScaleVoltageCurrent()
+{
   flt_measured_current_ = (float)(Iadc_code_+((Vadc_code_*eeprom.calibration.current_measure_output_resistance)-eeprom.calibration.current_measure_offset))*eeprom.calibration.current_measure_LSB; //ireadLSB is Amps/bit
   flt_measured_voltage_ = (float)Vadc_code_*eeprom.calibration.voltage_measure_LSB - (float)eeprom.calibration.voltage_measure_offset*eeprom.calibration.voltage_measure_LSB;
-  return (ack);
+}
+
+int8_t EasySMU::PollVoltageCurrent()
+{
+  uint32_t now=millis();
+
+  //Each successful read starts the next conversion on that ADC.
+  if (((adc_ready_ & _EASYSMU_IADC_READY)==0) && ((now-Iadc_start_) >= _EASYSMU_POLL_TIME))
+  {
+    if (LTC2485_poll(ADC_Isense_I2C_address_, LTC2485_SPEED_1X | LTC2485_R60, &Iadc_code_)==0)
+    {
+      Iadc_start_=now;
+      adc_ready_ |= _EASYSMU_IADC_READY;
+    }
+  }
+  if (((adc_ready_ & _EASYSMU_VADC_READY)==0) && ((now-Vadc_start_) >= _EASYSMU_POLL_TIME))
+  {
+    if (LTC2485_poll(ADC_Vsense_I2C_address_, LTC2485_SPEED_1X | LTC2485_R60, &Vadc_code_)==0)
+    {
+      Vadc_start_=now;
+      adc_ready_ |= _EASYSMU_VADC_READY;
+    }
+  }
+
+  if (adc_ready_ != (_EASYSMU_VADC_READY | _EASYSMU_IADC_READY)) return 0;
+
+  adc_ready_=0;
+  ScaleVoltageCurrent();
+  sample_count_++;
+  return 1;
+}
+
+void EasySMU::ConversionStarted()
+{
+  Vadc_start_=millis();
+  Iadc_start_=Vadc_start_;
+  adc_ready_=0;
 }
 
 void EasySMU::MeasureTemperatureOfADCs()
@@ -269,6 +391,7 @@ void EasySMU::MeasureTemperatureOfADCs()
 
   flt_temperature_of_Iadc_=((float)(uint32_t) temperature_of_Iadc_code)/(uint32_t) eeprom.calibration.temperature_Iadc_code * (25+273) - 273;
   flt_temperature_of_Vadc_=((float)(uint32_t) temperature_of_Vadc_code)/(uint32_t) eeprom.calibration.temperature_Vadc_code * (25+273) - 273;
+  ConversionStarted();
 }
 
 void EasySMU::MeasureTemperatureOfADCs(int32_t *temperature_of_Vadc_code, int32_t *temperature_of_Iadc_code)
@@ -283,6 +406,7 @@ void EasySMU::MeasureTemperatureOfADCs(int32_t *temperature_of_Vadc_code, int32_
 
   flt_temperature_of_Iadc_=((float)(uint32_t) temperature_of_Iadc_code)/(uint32_t) eeprom.calibration.temperature_Iadc_code * (25+273) - 273;
   flt_temperature_of_Vadc_=((float)(uint32_t) temperature_of_Vadc_code)/(uint32_t) eeprom.calibration.temperature_Vadc_code * (25+273) - 273;
+  ConversionStarted();
 }
 
 float EasySMU::MeasureCurrent()
@@ -290,6 +414,7 @@ float EasySMU::MeasureCurrent()
 
   LTC2485_read(ADC_Isense_I2C_address_, LTC2485_SPEED_1X | LTC2485_R60, &Iadc_code_, LTC2485_TIMEOUT);
   LTC2485_read(ADC_Vsense_I2C_address_, LTC2485_SPEED_1X | LTC2485_R60, &Vadc_code_, LTC2485_TIMEOUT);
+  ConversionStarted();
 
   return (float)(Iadc_code_+(int32_t)((Vadc_code_*eeprom.calibration.current_measure_output_resistance)-eeprom.calibration.current_measure_offset))*eeprom.calibration.current_measure_LSB; //ireadLSB is Amps/bit
 
@@ -299,6 +424,8 @@ float EasySMU::MeasureVoltage()  //Remove _fVout if not needed.
 {
 
   LTC2485_read(ADC_Vsense_I2C_address_, LTC2485_SPEED_1X | LTC2485_R60, &Vadc_code_, LTC2485_TIMEOUT);
+  Vadc_start_=millis();
+  adc_ready_=0;   //A current result already read for this sample would pair with the wrong voltage, so read both again.
 
   return (float)(Vadc_code_*eeprom.calibration.voltage_measure_LSB) - (eeprom.calibration.voltage_measure_offset*eeprom.calibration.voltage_measure_LSB);
 
@@ -689,4 +816,4 @@ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
 CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
 OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
-*/
\ No newline at end of file
+*/
\ No newline at end of file
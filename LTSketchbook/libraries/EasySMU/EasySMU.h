@@ -101,6 +101,28 @@ Class Library Header File for EasySMU: I2C Address Translator Demonstration and
 #define _LTC2485_CONVERSION_TIME _LTC2485_CONVERSION_TIME_1X
 //! @}
 
+//! @name Non-blocking measurement (PollVoltageCurrent()).
+//! @{
+//! Start polling an ADC this many milliseconds after its conversion started. Polling earlier would only load the I2C bus with NACKs.
+#define _EASYSMU_POLL_TIME (_LTC2485_CONVERSION_TIME-10)
+//! Bit of adc_ready_ set when the voltage ADC result of the present sample has been read
+#define _EASYSMU_VADC_READY 0x01
+//! Bit of adc_ready_ set when the current ADC result of the present sample has been read
+#define _EASYSMU_IADC_READY 0x02
+//! @}
+
+//! @name Closed-loop source setting (fltSettleVoltageSource(), fltSettleCurrentSource()).
+//! @{
+//! Default maximum number of DAC corrections before giving up
+#define _EASYSMU_SETTLE_MAX_ITERATIONS 6
+//! Default voltage tolerance in volts
+#define _EASYSMU_SETTLE_VOLTAGE_TOLERANCE 0.0002
+//! Default current tolerance in amps
+#define _EASYSMU_SETTLE_CURRENT_TOLERANCE 0.000005
+//! Passed to SettleSourceSetting() in place of _SOURCE_ONLY, _SOURCE_AND_SINK or _SINK_ONLY to settle the voltage source
+#define _EASYSMU_SETTLE_VOLTAGE 2
+//! @}
+
 //! A backup version of the factory calibration is stored at this address. Factory calibration may be recovered from here to override a user calibration.
 #define EEPROM_FACTORY_CAL_STATUS_ADDRESS EEPROM_CAL_STATUS_ADDRESS+sizeof(eeprom_data_union)
 //! Channel ID information returned by *IDN? command
@@ -131,6 +153,15 @@ class EasySMU
 
 {
   private:
+    //! Calculate flt_measured_voltage_ and flt_measured_current_ from Vadc_code_ and Iadc_code_
+    void ScaleVoltageCurrent();
+    //! Secant iteration shared by fltSettleVoltageSource() and fltSettleCurrentSource(). Commits a setting, measures the output, and corrects the setting until the measurement is within tolerance of the target.
+    //! @return 0=converged, 1=I2C failure or not converged within max_iterations
+    int8_t SettleSourceSetting(float flt_target, //!< wanted output (volts or amps)
+                               float flt_tolerance, //!< allowed error of the measured output
+                               uint8_t max_iterations, //!< maximum number of corrections after the first (open-loop) setting
+                               int8_t source_both_sink //!< _SOURCE_ONLY, _SOURCE_AND_SINK or _SINK_ONLY to settle the current source, _EASYSMU_SETTLE_VOLTAGE to settle the voltage source
+                              );
 
   public:
     int8_t present_;                     //!< Indicates if this channel is present. (Useful when the EasySMU class is stored in an array where not every possible channel is populated.)
@@ -145,6 +176,15 @@ class EasySMU
     float flt_measured_voltage_,         //!< measured voltage (in volts)
           flt_measured_current_;         //!< measured current (in amps)
 
+    uint8_t adc_ready_;                  //!< ADC results already read for the sample in progress (_EASYSMU_VADC_READY, _EASYSMU_IADC_READY)
+    uint32_t Vadc_start_,                //!< millis() when the voltage ADC started its present conversion
+             Iadc_start_;                //!< millis() when the current ADC started its present conversion
+    uint32_t sample_count_;              //!< number of voltage/current samples completed by PollVoltageCurrent(), reported by the CHx:MEA:SMP serial command
+
+    uint8_t settle_iterations_;          //!< number of setting/measurement iterations used by the last fltSettleVoltageSource() or fltSettleCurrentSource(): the open-loop setting plus up to max_iterations corrections
+    uint32_t settle_time_;               //!< time in milliseconds taken by the last fltSettleVoltageSource() or fltSettleCurrentSource()
+    void (*settle_progress_)(uint8_t iteration, float flt_measured); //!< called after each settle iteration with its measurement (volts or amps), so a caller can report progress during the ~2 s settle. NULL for none.
+
     float flt_temperature_of_Vadc_,                  //!< Temperature of voltage ADC
           flt_temperature_of_Iadc_;                  //!< current output setting (float)
 
@@ -224,6 +264,15 @@ class EasySMU
     //! @return voltage source setting in volts
     float fltReadVoltageSourceSetting();
 
+    //! Closed-loop version of fltSetCommitVoltageSource(). After the open-loop setting, the output is measured with the voltage ADC and the setting is corrected
+    //! with a secant step until the measured voltage is within flt_tolerance. Each iteration takes two ADC conversions (the first result still belongs to the old setting).
+    //! Afterwards fltReadVoltageSourceSetting() returns the corrected setting, and settle_iterations_ and settle_time_ report the cost.
+    //! @return 0=converged, 1=I2C failure or not converged
+    int8_t fltSettleVoltageSource(float fVoltage, //!< the voltage to be measured at the output
+                                  float flt_tolerance = _EASYSMU_SETTLE_VOLTAGE_TOLERANCE, //!< allowed error in volts
+                                  uint8_t max_iterations = _EASYSMU_SETTLE_MAX_ITERATIONS //!< maximum number of corrections
+                                 );
+
     //! Commit the current source setting. The DACs that set pullup and pulldown current are loaded with the values from Idac_pullup_code_ and Idac_pulldown_code_, and the output changes immediately.
     //! (Other functions such as codeStepCurrentSourceSetting, etc. update the screen but do not actually change the output.)
     //! @return 0=success, 1=failure
@@ -237,6 +286,16 @@ class EasySMU
                                      int8_t up_down_both //!< determines whether output sources current, sinks current, or both. Set to _SOURCE_ONLY, _SOURCE_AND_SINK, or _SINK_ONLY
                                     );
 
+    //! Closed-loop version of fltSetCommitCurrentSource(). Only useful while the output is in current limit (the load draws at least the current setting);
+    //! otherwise the measured current does not follow the setting and this returns 1 after max_iterations.
+    //! Afterwards fltReadCurrentSourceSetting() returns the corrected setting, and settle_iterations_ and settle_time_ report the cost.
+    //! @return 0=converged, 1=I2C failure or not converged
+    int8_t fltSettleCurrentSource(float fCurrent, //!< current in amps to be measured at the output
+                                  int8_t up_down_both, //!< _SOURCE_ONLY, _SOURCE_AND_SINK, or _SINK_ONLY
+                                  float flt_tolerance = _EASYSMU_SETTLE_CURRENT_TOLERANCE, //!< allowed error in amps
+                                  uint8_t max_iterations = _EASYSMU_SETTLE_MAX_ITERATIONS //!< maximum number of corrections
+                                 );
+
     //! Increase or decrease the current source setting by this value in amps. Updates the screen but does not actually change the output. This gives the user time to modify the value before it is driven at the output.
     //! @return none
     void fltStepCurrentSourceSetting(float fltStepSize //!< adjust the current source setting by this value in amps
@@ -250,6 +309,15 @@ class EasySMU
     //! @return 0=success, 1=failure
     int8_t MeasureVoltageCurrent();
 
+    //! Non-blocking version of MeasureVoltageCurrent(). Reads each ADC once its conversion should be finished, without waiting for it.
+    //! Every read starts the next conversion, so calling this for each board in turn keeps all ADCs converting continuously.
+    //! @return 1 if a new voltage/current sample was stored in flt_measured_voltage_ and flt_measured_current_, 0 if conversions are still in progress.
+    int8_t PollVoltageCurrent();
+
+    //! Tell PollVoltageCurrent() that both ADCs have just started a conversion (e.g. after LTC2485_start_all()).
+    //! @return none
+    void ConversionStarted();
+
     //! Measure the voltage (with ADC).
     //! @return voltage in volts
 
@@ -103,10 +103,43 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //#include <SeeedTouchScreen.h>
 //#endif
 
+// Font pointers are 16 bits on AVR and 32 bits elsewhere (same as Adafruit_GFX.cpp).
+#ifndef pgm_read_pointer
+#if !defined(__INT_MAX__) || (__INT_MAX__ > 0xFFFF)
+#define pgm_read_pointer(addr) ((void *)pgm_read_dword(addr))
+#else
+#define pgm_read_pointer(addr) ((void *)pgm_read_word(addr))
+#endif
+#endif
+
 void EasySMU_IOpanel::Init()
 {
   SMUselected_=_SMU0;
   button_pressed_=_NONE;
+
+  // The text font is monospaced, so every character fits in the same cell. Find the cell relative to the cursor from the glyph extents.
+  const GFXfont *font=&Anonymous_Pro6pt7b;
+  const GFXglyph *glyphs=(const GFXglyph *)pgm_read_pointer(&font->glyph);
+  int16_t x_min=0, y_min=0, y_max=0;
+  uint8_t x_advance=0;
+  for (uint8_t i=0; i<=(uint8_t)(pgm_read_byte(&font->last)-pgm_read_byte(&font->first)); i++)
+  {
+    int8_t xo=pgm_read_byte(&glyphs[i].xOffset);
+    int8_t yo=pgm_read_byte(&glyphs[i].yOffset);
+    if (xo<x_min) x_min=xo;
+    if (yo<y_min) y_min=yo;
+    if (yo+pgm_read_byte(&glyphs[i].height)>y_max) y_max=yo+pgm_read_byte(&glyphs[i].height);
+    if (pgm_read_byte(&glyphs[i].xAdvance)>x_advance) x_advance=pgm_read_byte(&glyphs[i].xAdvance);
+  }
+  text_x_offset_=x_min;
+  text_y_offset_=y_min;
+  text_width_=x_advance;
+  text_height_=y_max-y_min;
+  memset(field_text_,'\0',sizeof(field_text_));
+  draw_time_=0;
+  draw_glyphs_=0;
+  frame_time_=0;
+  frame_glyphs_=0;
   //init Display
   lcd.begin();
   lcd.setRotation(1);
@@ -295,24 +328,66 @@ void EasySMU_IOpanel::DisplaySMULabel()
   lcd.setTextColor(ILI9341_WHITE,ILI9341_BLUE);
 }
 
-void EasySMU_IOpanel::OverwriteOldString(uint16_t fg_color, uint16_t bg_color, char *old_string, const char *new_string)
+void EasySMU_IOpanel::OverwriteOldString(uint16_t fg_color, uint16_t bg_color, char *old_string, const char *new_string, int8_t field)
 {
-  //lcd.setCursor(x, y);
   if (enabled_== 0) return;
-  uint16_t new_x, new_y;
-  for (int8_t i=0; (i < 16) && (old_string[i] != '\0') && (new_string[i] != '\0'); i++)
+  uint32_t start_time=micros();
+  int16_t x=lcd.getCursorX();
+  int16_t y=lcd.getCursorY();
+  char *shown=((field>=0) && (field<(_CH3+1)*_FIELDS_PER_CHANNEL)) ? field_text_[field] : NULL;
+  uint8_t old_end=0, new_end=0;
+  for (int8_t i=0; i < 16; i++)
   {
+    if (!old_end && (old_string[i]=='\0')) old_end=1;
+    if (!new_end && (new_string[i]=='\0')) new_end=1;
+    char chr_new=(new_end ? '\0' : new_string[i]);
+    uint8_t cached=((shown!=NULL) && (i<_FIELD_LENGTH));
 
-    new_x=lcd.getCursorX();
-    new_y=lcd.getCursorY();
+    if (new_end && old_end && (!cached || (shown[i]=='\0'))) break;
 
-    lcd.setTextColor(bg_color,bg_color);
-    lcd.print(old_string[i]);
+    if (cached)
+    {
+      // Skip characters that are already on the screen.
+      if (shown[i]!=chr_new)
+      {
+        DrawGlyph(x, y, (chr_new=='\0' ? ' ' : chr_new), fg_color, bg_color);
+        draw_glyphs_++;
+        shown[i]=chr_new;
+      }
+    }
+    else if (!new_end || !old_end)
+    {
+      DrawGlyph(x, y, (chr_new=='\0' ? ' ' : chr_new), fg_color, bg_color);
+      draw_glyphs_++;
+    }
+    x+=text_width_;
+  }
+  lcd.setCursor(x, y);
+  draw_time_+=micros()-start_time;
+}
 
-    lcd.setCursor(new_x, new_y);
-    lcd.setTextColor(fg_color,bg_color);
-    lcd.print(new_string[i]);
+void EasySMU_IOpanel::DrawGlyph(int16_t x, int16_t y, char chr, uint16_t fg_color, uint16_t bg_color)
+{
+  const GFXfont *font=&Anonymous_Pro6pt7b;
+  uint8_t first=pgm_read_byte(&font->first);
+  if (((uint8_t)chr<first) || ((uint8_t)chr>pgm_read_byte(&font->last)))
+  {
+    lcd.fillRect(x+text_x_offset_, y+text_y_offset_, text_width_, text_height_, bg_color);
+    return;
   }
+  const GFXglyph *glyph=&(((const GFXglyph *)pgm_read_pointer(&font->glyph))[(uint8_t)chr-first]);
+  const uint8_t *bitmap=(const uint8_t *)pgm_read_pointer(&font->bitmap)+pgm_read_word(&glyph->bitmapOffset);
+  lcd.drawGlyphCell(x+text_x_offset_, y+text_y_offset_, text_width_, text_height_, bitmap,
+                    (int8_t)pgm_read_byte(&glyph->xOffset)-text_x_offset_, (int8_t)pgm_read_byte(&glyph->yOffset)-text_y_offset_,
+                    pgm_read_byte(&glyph->width), pgm_read_byte(&glyph->height), fg_color, bg_color);
+}
+
+void EasySMU_IOpanel::EndFrame()
+{
+  frame_time_=draw_time_;
+  frame_glyphs_=draw_glyphs_;
+  draw_time_=0;
+  draw_glyphs_=0;
 }
 
 void EasySMU_IOpanel::DisplayVoltageSourceSetting(int16_t channel, float flt_old, float flt_new)
@@ -340,7 +415,7 @@ void EasySMU_IOpanel::DisplayVoltageSourceSetting(int16_t channel, float flt_old
   strcat(str_old,"V");
   dtostrf(flt_new,8,4,str_new);
   strcat(str_new,"V");
-  OverwriteOldString(ILI9341_WHITE,ILI9341_BLUE,str_old,str_new);
+  OverwriteOldString(ILI9341_WHITE,ILI9341_BLUE,str_old,str_new,channel*_FIELDS_PER_CHANNEL+_FIELD_VSET);
 
 
 }
@@ -369,7 +444,7 @@ void EasySMU_IOpanel::DisplayMeasuredVoltage(int16_t channel, float flt_old, flo
   strcat(str_old,"V");
   dtostrf(flt_new,8,4,str_new);
   strcat(str_new,"V");
-  OverwriteOldString(ILI9341_WHITE,ILI9341_BLUE,str_old,str_new);
+  OverwriteOldString(ILI9341_WHITE,ILI9341_BLUE,str_old,str_new,channel*_FIELDS_PER_CHANNEL+_FIELD_VMEAS);
 
 }
 
@@ -469,7 +544,7 @@ void EasySMU_IOpanel::DisplayCurrentSourceSetting(int16_t channel, float flt_old
   {
     AddLeadingSign('-',str_new,16);
   }
-  OverwriteOldString(ILI9341_WHITE,ILI9341_BLUE,str_old,str_new);
+  OverwriteOldString(ILI9341_WHITE,ILI9341_BLUE,str_old,str_new,channel*_FIELDS_PER_CHANNEL+_FIELD_ISET);
 }
 
 void EasySMU_IOpanel::DisplayMeasuredCurrent(int16_t channel, float flt_old, float flt_new)
@@ -495,6 +570,6 @@ void EasySMU_IOpanel::DisplayMeasuredCurrent(int16_t channel, float flt_old, flo
   strcat(str_old,"mA");
   dtostrf(flt_new*1000,7,3,str_new);
   strcat(str_new,"mA");
-  OverwriteOldString(ILI9341_WHITE,ILI9341_BLUE,str_old,str_new);
+  OverwriteOldString(ILI9341_WHITE,ILI9341_BLUE,str_old,str_new,channel*_FIELDS_PER_CHANNEL+_FIELD_IMEAS);
 }
 
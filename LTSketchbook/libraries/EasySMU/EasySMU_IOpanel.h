@@ -209,6 +209,17 @@ enum { _SMU0=_CH0, _SMU1=_CH1, _SMU2=_CH2, _SMU3=_CH3, _VPLUS, _VMINUS, _VPLUSPL
 #define _TEXT_TOP_MID  48
 //! @}
 
+//! @name Text fields whose on-screen characters are cached so only changed glyphs are redrawn
+//! @{
+#define _FIELD_NONE -1 //!< text is not cached, every glyph is redrawn
+#define _FIELD_VSET 0
+#define _FIELD_VMEAS 1
+#define _FIELD_ISET 2
+#define _FIELD_IMEAS 3
+#define _FIELDS_PER_CHANNEL 4
+#define _FIELD_LENGTH 10 //!< characters cached per field. Characters beyond this are always redrawn.
+//! @}
+
 /*!The EasySMU_IOpanel class provides an interface between the EasySMU and a touchscreen.
 
 [User Guide](http://www.linear.com/docs/58670 "EasySMU User Guide") \n
@@ -225,18 +236,29 @@ class EasySMU_IOpanel
     uint16_t text_height_;
     int16_t text_x_offset_;
     int16_t text_y_offset_;
+    char field_text_[(_CH3+1)*_FIELDS_PER_CHANNEL][_FIELD_LENGTH]; //!< characters presently drawn in each cached text field
+    uint32_t draw_time_;  //!< microseconds spent drawing text since the last EndFrame()
+    uint16_t draw_glyphs_;  //!< glyphs redrawn since the last EndFrame()
     //! Draw text at the x and y pixel location
     void DrawText(  int16_t x, //!< horizontal location in pixels
                     int16_t y, //!< vertical location in pixels
                     const char *sDisplay //!< string to display
                  );
-    //! Clear old text and write new text. The Adafruit library does not contain a fast way to clear an area of the screen, so this overwrites old characters with the background color.
-    //! To reduce the flashing of clearing the entire string before writing the new string, this function clears and writes a single character at a time.
+    //! Clear old text and write new text. Each character is drawn as one cell (background and glyph together) in a single address window, so there is no flashing and no separate erase pass.
+    //! If field is a cached text field, only the characters that differ from what is presently on the screen are redrawn.
     void OverwriteOldString(uint16_t fg_color, //!< foreground color
                             uint16_t bg_color, //!< background color
                             char *old_string, //!< the *old_string to be cleared
-                            const char *new_string //!< the *new_string to be written
+                            const char *new_string, //!< the *new_string to be written
+                            int8_t field = _FIELD_NONE //!< cached text field index (channel*_FIELDS_PER_CHANNEL + _FIELD_xxx), or _FIELD_NONE
                            );
+    //! Draw a single character cell of the text font at the cursor location x, y.
+    void DrawGlyph(int16_t x, //!< horizontal cursor location in pixels
+                   int16_t y, //!< vertical cursor (baseline) location in pixels
+                   char chr, //!< character to draw. Characters outside the font are drawn as a blank cell.
+                   uint16_t fg_color, //!< foreground color
+                   uint16_t bg_color //!< background color
+                  );
     //! Used to put a '+' or '-' in front of a number (at the correct location)
     void AddLeadingSign(char chrSign, //!< '+' or '-'
                         char *string, //!< *string contains a text form of the number that will have leading sign character placed in front
@@ -265,6 +287,11 @@ class EasySMU_IOpanel
     int button_pressed_; //!< stores the value of the button pressed (from enum)
     int SMUselected_; //!< stores which SMU channel is selected on the TFT display
     uint8_t enabled_; //!< indicates if the TFT is enabled. 1=enabled, 0=disabled. (TFT may be disabled to reduce noise in the SMU output caused by SPI communication.)
+    uint32_t frame_time_; //!< microseconds spent drawing text during the last frame (see EndFrame())
+    uint16_t frame_glyphs_; //!< number of glyphs redrawn during the last frame
+
+    //! Mark the end of a UI frame (one pass of the main loop). Latches the accumulated drawing time and glyph count into frame_time_ and frame_glyphs_ and restarts the count.
+    void EndFrame();
 
     //! Draw the SMU labels. The selected channel will be green.
     void DisplaySMULabel() ;
@@ -127,6 +127,54 @@ void LTC23XX_read(uint8_t cs_pin, uint32_t config_word, uint8_t data_array[24])
   spi_transfer_block(cs_pin, tx_array, data_array, 24);
 }
 
+// Each channel occupies 3 bytes of the frame, channel 0 first
+uint8_t LTC23XX_frame_length(uint32_t config_word)
+{
+  int8_t channel;
+
+  for (channel = 7; channel > 0; --channel)
+  {
+    if ((config_word >> (channel * 3)) & SOFTSPAN)
+      break;
+  }
+  return (channel + 1) * 3;
+}
+
+// Captures repeated frames with a fixed configuration into one array per channel. The
+// configuration occupies the first 3 bytes of each frame, so tx_array is built only once.
+uint32_t LTC23XX_scan(uint8_t cs_pin, uint32_t config_word, uint16_t num_frames, uint32_t *channel_data[8])
+{
+  uint8_t tx_array[24];
+  uint8_t rx_array[24];
+  uint8_t length = LTC23XX_frame_length(config_word);
+  uint32_t channel_word;
+  uint32_t start_time;
+  uint16_t frame;
+  int8_t pos;
+  uint8_t channel;
+
+  memset(tx_array, 0, sizeof(tx_array));
+  tx_array[length - 1] = (uint8_t)(config_word >> 16);
+  tx_array[length - 2] = (uint8_t)(config_word >> 8);
+  tx_array[length - 3] = (uint8_t)(config_word);
+
+  spi_transfer_block(cs_pin, tx_array, rx_array, length);   // Load the configuration, data is from the old one
+
+  start_time = micros();
+  for (frame = 0; frame < num_frames; ++frame)
+  {
+    spi_transfer_block(cs_pin, tx_array, rx_array, length);
+    for (pos = length - 1; pos >= 2; pos -= 3)
+    {
+      channel_word = ((uint32_t)rx_array[pos] << 16) | ((uint32_t)rx_array[pos - 1] << 8) | rx_array[pos - 2];
+      channel = (channel_word & CHANNEL_NUMBER) >> 3;
+      if (channel_data[channel] != NULL)
+        channel_data[channel][frame] = (channel_word & 0xFFFFC0) >> 6;
+    }
+  }
+  return micros() - start_time;
+}
+
 int32_t sign_extend_17(uint32_t data)
 {
   uint8_t sign;
@@ -177,3 +225,59 @@ float LTC23XX_voltage_calculator(uint32_t data, uint8_t channel_configuration)
   return voltage;
 }
 
+
+//! @name Fixed-point lsb weights
+//! LSB weight in microvolts for each channel configuration, scaled by 2^LTC23XX_UV_SHIFT.
+//! Mirrors the constants used by LTC23XX_voltage_calculator().
+//! @{
+#define LTC23XX_UV_SHIFT 24
+#define LTC23XX_UV_WEIGHT(span, bits) ((int32_t)((span) * 1000000.0 * 16777216.0 / (bits) + 0.5))
+static const int32_t LTC23XX_uV_multiplier[8] =
+{
+  0,                                              // Disable Channel
+  LTC23XX_UV_WEIGHT(1.25 * VREF / 1.000, POW2_18),
+  LTC23XX_UV_WEIGHT(1.25 * VREF / 1.024, POW2_17),
+  LTC23XX_UV_WEIGHT(1.25 * VREF / 1.000, POW2_17),
+  LTC23XX_UV_WEIGHT(2.50 * VREF / 1.024, POW2_18),
+  LTC23XX_UV_WEIGHT(2.50 * VREF / 1.000, POW2_18),
+  LTC23XX_UV_WEIGHT(2.50 * VREF / 1.024, POW2_17),
+  LTC23XX_UV_WEIGHT(2.50 * VREF, POW2_17)
+};
+//! Configurations that return 2's complement data
+#define LTC23XX_BIPOLAR_CONFIGS 0xCC
+//! @}
+
+// Converts an array of codes from one channel configuration to microvolts with integer math only
+void LTC23XX_codes_to_uV(const uint32_t *data, int32_t *uV, uint16_t length, uint8_t channel_configuration)
+{
+  int32_t multiplier;
+  int32_t data_signed;
+  uint8_t bipolar;
+  uint16_t i;
+
+  channel_configuration &= SOFTSPAN;
+  multiplier = LTC23XX_uV_multiplier[channel_configuration];
+  bipolar = (LTC23XX_BIPOLAR_CONFIGS >> channel_configuration) & 0x01;
+
+  for (i = 0; i < length; i++)
+  {
+    data_signed = bipolar ? sign_extend_17(data[i]) : (int32_t)data[i];
+    uV[i] = (int32_t)(((int64_t)data_signed * multiplier + ((int32_t)1 << (LTC23XX_UV_SHIFT - 1))) >> LTC23XX_UV_SHIFT);
+  }
+}
+
+// Decodes each 24 bit channel word (18 bit data + 3 bit channel number + 3 bit config)
+// and converts it to microvolts
+void LTC23XX_frame_to_uV(const uint8_t data_array[24], int32_t uV[8])
+{
+  uint32_t channel_data;
+  uint32_t code;
+  int8_t pos;
+
+  for (pos = 23; pos >= 2; pos -= 3)
+  {
+    channel_data = ((uint32_t)data_array[pos] << 16) | ((uint32_t)data_array[pos - 1] << 8) | data_array[pos - 2];
+    code = (channel_data & 0xFFFFC0) >> 6;
+    LTC23XX_codes_to_uV(&code, &uV[(channel_data & CHANNEL_NUMBER) >> 3], 1, channel_data & SOFTSPAN);
+  }
+}
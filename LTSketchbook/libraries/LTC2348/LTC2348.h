@@ -129,9 +129,38 @@ void LTC23XX_read(uint8_t cs_pin,         //!< Chip select
                   uint8_t data_array[24]    //!< Data array to read in 24 bytes of data from 8 channels
                  );
 
+//! Returns the number of bytes that must be clocked each frame to read every enabled channel.
+//! Channels are shifted out in order, so trailing disabled channels are not clocked.
+uint8_t LTC23XX_frame_length(uint32_t config_word   //!< 3 bytes of configuration data for 8 channels
+                            );
+
+//! Captures num_frames frames with the same configuration, storing the 18 bit code of each
+//! enabled channel in that channel's array: channel_data[channel][frame]. Channels whose
+//! pointer is NULL are not stored. The frame that loads the configuration is discarded.
+//! @return Returns the capture time in microseconds.
+uint32_t LTC23XX_scan(uint8_t cs_pin,               //!< Chip select
+                      uint32_t config_word,         //!< 3 bytes of configuration data for 8 channels
+                      uint16_t num_frames,          //!< Number of frames to capture
+                      uint32_t *channel_data[8]     //!< One array of num_frames codes per channel, or NULL
+                     );
+
 //! Calculates the voltage from ADC output data depending on the channel configuration
 float LTC23XX_voltage_calculator(uint32_t data,             //!< 24 bits of ADC output data for a single channel
                                  uint8_t channel_configuration      //!< 3 bits of channel configuration data
                                 );
 
-#endif
\ No newline at end of file
+//! Converts an array of 18 bit ADC codes sharing one channel configuration to microvolts,
+//! using a fixed-point lsb weight instead of floating point math.
+void LTC23XX_codes_to_uV(const uint32_t *data,             //!< Array of 18 bit ADC codes
+                         int32_t *uV,                      //!< Array overwritten with voltages in microvolts
+                         uint16_t length,                  //!< Number of codes to convert
+                         uint8_t channel_configuration     //!< 3 bits of channel configuration data
+                        );
+
+//! Decodes a 24 byte frame returned by LTC23XX_read() and converts every channel to microvolts.
+//! Each result is stored at the index given by the channel number embedded in the frame.
+void LTC23XX_frame_to_uV(const uint8_t data_array[24],     //!< 24 bytes of data read by LTC23XX_read()
+                         int32_t uV[8]                     //!< Overwritten with voltages in microvolts, indexed by channel
+                        );
+
+#endif
\ No newline at end of file
@@ -130,6 +130,51 @@ void LTC2373_configure(uint8_t cs, uint32_t adc_configure)
 }
 
 
+// Programs a sequence of 8 bit control words in one frame. spi_transfer_block() sends the
+// last array element first, so the commands are loaded in reverse.
+void LTC2373_load_sequence(uint8_t cs, const uint8_t *adc_commands, uint8_t length)
+{
+  uint8_t tx[LTC2373_MAX_SEQUENCE_LENGTH];
+  uint8_t rx[LTC2373_MAX_SEQUENCE_LENGTH];
+  uint8_t i;
+
+  if (length > LTC2373_MAX_SEQUENCE_LENGTH)
+    length = LTC2373_MAX_SEQUENCE_LENGTH;
+  for (i = 0; i < length; i++)
+    tx[length - 1 - i] = adc_commands[i] | LTC2373_SEQUENCER_BIT;
+
+  spi_transfer_block(cs, tx, rx, length);
+}
+
+
+// Reads complete sequences into one array per sequence entry. CS is driven through its port
+// register and no command array is built per read, to keep the time between conversions short.
+uint32_t LTC2373_scan(uint8_t cs, uint8_t length, uint16_t num_frames, uint32_t *results[])
+{
+  volatile uint8_t *cs_port = portOutputRegister(digitalPinToPort(cs));
+  uint8_t cs_mask = digitalPinToBitMask(cs);
+  LT_union_int32_4bytes data;
+  uint32_t start_time;
+  uint16_t frame;
+  uint8_t entry;
+
+  start_time = micros();
+  for (frame = 0; frame < num_frames; frame++)
+  {
+    for (entry = 0; entry < length; entry++)
+    {
+      *cs_port &= ~cs_mask;               //! 1) Pull CS low
+      data.LT_byte[3] = SPI.transfer(0);  //! 2) Read 32 bits, MSB first
+      data.LT_byte[2] = SPI.transfer(0);
+      data.LT_byte[1] = SPI.transfer(0);
+      data.LT_byte[0] = SPI.transfer(0);
+      *cs_port |= cs_mask;                //! 3) Pull CS high
+      results[entry][frame] = data.LT_uint32;
+    }
+  }
+  return(micros() - start_time);
+}
+
 // Calculates the voltage corresponding to an adc code, given the reference voltage (in volts)
 float LTC2373_code_to_voltage(uint8_t adc_command, uint32_t adc_code, float vref)
 {
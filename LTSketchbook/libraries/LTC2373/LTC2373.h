@@ -147,6 +147,26 @@ void LTC2373_configure(uint8_t cs,
                        uint32_t adc_command
                       );
 
+//! Maximum number of configurations held by the sequencer
+#define LTC2373_MAX_SEQUENCE_LENGTH 16
+
+//! Loads a sequence of ADC commands into the sequencer with a single SPI frame.
+//! The sequencer bit is set on every command.
+//! @return void
+void LTC2373_load_sequence(uint8_t cs,                    //!< Chip Select Pin
+                           const uint8_t *adc_commands,   //!< Commands from LTC2373_build_command(), in conversion order
+                           uint8_t length                 //!< Number of commands (1 to LTC2373_MAX_SEQUENCE_LENGTH)
+                          );
+
+//! Captures num_frames complete passes through a sequence loaded by LTC2373_load_sequence().
+//! Results are stored one array per sequence entry: results[entry][frame].
+//! @return Returns the capture time in microseconds.
+uint32_t LTC2373_scan(uint8_t cs,                 //!< Chip Select Pin
+                      uint8_t length,             //!< Sequence length
+                      uint16_t num_frames,        //!< Number of complete sequences to capture
+                      uint32_t *results[]         //!< length arrays of num_frames codes each
+                     );
+
 //! Calculates the LTC2373 input voltage given the binary data and lsb weight.
 //! @return Floating point voltage
 float LTC2373_code_to_voltage(uint8_t adc_command,
@@ -141,8 +141,42 @@ float LTC2380_code_to_voltage(int32_t adc_code, uint8_t gain_compression, float
     vref = 0.8*vref;
 
   voltage = (float)adc_code;
-  voltage = voltage / (pow(2,31)-1);    //! 2) This calculates the input as a fraction of the reference voltage (dimensionless)
+  voltage = voltage / 2147483647.0;    //! 2) This calculates the input as a fraction of the reference voltage (dimensionless)
   voltage = voltage * vref + 0.1;           //! 3) Multiply fraction by Vref to get the actual voltage at the input (in volts)
 
   return(voltage);
 }
+
+// Builds the fixed-point equivalent of LTC2380_code_to_voltage(). The full scale is folded into
+// a single multiplier with the largest shift that keeps it within an int32_t.
+void LTC2380_set_uV_scale(uint8_t gain_compression, float vref, LTC2380_uV_scale *scale)
+{
+  float multiplier;
+  uint8_t shift = 31;
+
+  if (gain_compression == 1)
+    vref = 0.8*vref;
+
+  multiplier = fabs(vref) * 1000000.0;  // Full scale in uV. Dividing by 2^31 instead of 2^31-1 is off by < 1ppb.
+  while ((shift < 62) && (multiplier > 0) && (multiplier < 1073741824.0))
+  {
+    multiplier *= 2;
+    shift++;
+  }
+  scale->multiplier = (int32_t)((vref < 0) ? -multiplier - 0.5 : multiplier + 0.5);
+  scale->shift = shift;
+  scale->offset_uV = 100000;  // Matches the 0.1V offset applied by LTC2380_code_to_voltage()
+}
+
+// Converts an array of adc codes in 2's complement to microvolts using integer math only
+void LTC2380_codes_to_uV(const int32_t *adc_code, int32_t *uV, uint16_t length, const LTC2380_uV_scale *scale)
+{
+  int32_t multiplier = scale->multiplier;
+  uint8_t shift = scale->shift;
+  int32_t offset_uV = scale->offset_uV;
+  int64_t rounding = (int64_t)1 << (shift - 1);
+  uint16_t i;
+
+  for (i = 0; i < length; i++)
+    uV[i] = (int32_t)(((int64_t)adc_code[i] * multiplier + rounding) >> shift) + offset_uV;
+}
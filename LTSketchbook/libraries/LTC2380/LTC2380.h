@@ -138,6 +138,31 @@ float LTC2380_code_to_voltage(int32_t adc_code,                   //!< Raw ADC c
                               float vref              //!< Reference voltage
                              );
 
+//! Fixed-point scale for converting LTC2380 codes to microvolts without floating point math.
+//! microvolts = ((adc_code * multiplier) >> shift) + offset_uV, using a 32x32->64 bit product.
+typedef struct
+{
+  int32_t multiplier;   //!< Full scale in microvolts divided by 2^31-1, multiplied by 2^shift
+  uint8_t shift;        //!< Right shift applied to the 64 bit product
+  int32_t offset_uV;    //!< Offset added after scaling (in microvolts)
+} LTC2380_uV_scale;
+
+//! Builds the microvolt scale matching LTC2380_code_to_voltage() for one gain compression / vref setting.
+//! @return Void
+void LTC2380_set_uV_scale(uint8_t gain_compression,   //!< 1 if gain compression is enabled
+                          float vref,                 //!< Reference voltage
+                          LTC2380_uV_scale *scale     //!< Overwritten with the fixed-point scale
+                         );
+
+//! Converts an array of LTC2380 codes to microvolts using a precomputed scale. adc_code and uV
+//! may point to the same array to convert in place.
+//! @return Void
+void LTC2380_codes_to_uV(const int32_t *adc_code,         //!< Array of raw ADC codes
+                         int32_t *uV,                     //!< Array overwritten with voltages in microvolts
+                         uint16_t length,                 //!< Number of codes to convert
+                         const LTC2380_uV_scale *scale    //!< Scale from LTC2380_set_uV_scale()
+                        );
+
 #endif  //  LTC2380_H
 
 
@@ -59,25 +59,48 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "LT_SPI.h"
 #include "LTC2380_24.h"
 #include <SPI.h>
-#include "UserInterface.h"
 
-// Reads from a SPI LTC2380-XX device that has no configuration word and a 32 bit output word in 2's complement format.
-void LTC2380_read(int32_t *ptr_adc_code, int16_t *ptr_cycles)
-{
-  int N;
-  int negative;
+static volatile uint8_t *LTC2380_cnv_port;  // Output register of the CNV pin
+static uint8_t LTC2380_cnv_mask;            // Bit mask of the CNV pin within LTC2380_cnv_port
+static uint16_t LTC2380_continuous_n;       // Averaging depth used by LTC2380_read_continuous()
 
-  Serial.print("\nEnter the number of CNV pulses: ");
-  while (Serial.available());
-  N = read_int();
-  while (N--)       // PB2 (CS) pin is connected to CNV pin.
+// Issues CNV pulses back to back. Interrupts are disabled within a burst so the conversion
+// spacing is not stretched by the millis() timer or serial interrupts, and restored between
+// bursts so those interrupts are not lost. The port is read inside the critical section, so
+// an ISR that writes other pins of the same port between bursts is not undone.
+// Does nothing until LTC2380_init_cnv() has set up the pin.
+static void LTC2380_pulse_cnv(uint16_t n)
+{
+  volatile uint8_t *port = LTC2380_cnv_port;
+  uint8_t mask = LTC2380_cnv_mask;
+  uint8_t sreg = SREG;
+  uint8_t high;
+  uint8_t low;
+  uint8_t burst;
+
+  if (port == NULL)
+    return;
+  while (n)
   {
-    PORTB |=  B00000100;  // Pull CNV pin high
-    __asm__("nop\n\t");
-    PORTB &=  B11111011;  // Pull CNV pin low
-    __asm__("nop\n\t");
+    burst = (n > LTC2380_CNV_BURST) ? LTC2380_CNV_BURST : n;
+    n -= burst;
+    cli();
+    high = *port | mask;
+    low = high & ~mask;
+    while (burst--)
+    {
+      *port = high;         // Pull CNV pin high
+      __asm__("nop\n\t");
+      *port = low;          // Pull CNV pin low
+      __asm__("nop\n\t");
+    }
+    SREG = sreg;            // Pending interrupts run here
   }
+}
 
+// Clocks out the 24-bit result and the 16-bit conversion count.
+static void LTC2380_read_result(int32_t *ptr_adc_code, int16_t *ptr_cycles)
+{
   LT_union_int16_2bytes cycles;    // LTC2380 data and command
   cycles.LT_uint16 = 0;            // Set to zero, not necessary but avoids random data in scope shots.
 
@@ -94,15 +117,52 @@ void LTC2380_read(int32_t *ptr_adc_code, int16_t *ptr_cycles)
   cycles.LT_byte[1] = spi_read(0);
   cycles.LT_byte[0] = spi_read(0);
 
-  negative = (data.LT_byte[2] & 0x80) != 0;
-  if (negative)
+  if (data.LT_byte[2] & 0x80)
   {
     data.LT_byte[3] = 0xFF;
   }
   *ptr_adc_code = data.LT_int32;
   *ptr_cycles = cycles.LT_int16;
+}
 
-  return;
+// Configures the CNV pin and caches its port register and mask
+void LTC2380_init_cnv(uint8_t cnv_pin)
+{
+  pinMode(cnv_pin, OUTPUT);
+  output_low(cnv_pin);
+  LTC2380_cnv_port = portOutputRegister(digitalPinToPort(cnv_pin));
+  LTC2380_cnv_mask = digitalPinToBitMask(cnv_pin);
+}
+
+// Reads from a SPI LTC2380-XX device that has no configuration word and a 32 bit output word in 2's complement format.
+void LTC2380_read(uint16_t n, int32_t *ptr_adc_code, int16_t *ptr_cycles)
+{
+  LTC2380_pulse_cnv(n);
+  LTC2380_read_result(ptr_adc_code, ptr_cycles);
+}
+
+// Issues the pulses for the first average of a continuous run
+void LTC2380_start_continuous(uint16_t n)
+{
+  if (n == 0)
+    n = 1;
+  LTC2380_continuous_n = n;
+  LTC2380_pulse_cnv(n);
+}
+
+// Starts the first conversion of the next average, reads the previous average while that
+// conversion runs, then completes the next average.
+void LTC2380_read_continuous(int32_t *ptr_adc_code, int16_t *ptr_cycles)
+{
+  if ((LTC2380_continuous_n == 0) || (LTC2380_cnv_port == NULL))
+  {
+    *ptr_adc_code = 0;
+    *ptr_cycles = 0;
+    return;
+  }
+  LTC2380_pulse_cnv(1);
+  LTC2380_read_result(ptr_adc_code, ptr_cycles);
+  LTC2380_pulse_cnv(LTC2380_continuous_n - 1);
 }
 
 // Calculates the voltage corresponding to an adc code in 2's complement, given the reference voltage (in volts)
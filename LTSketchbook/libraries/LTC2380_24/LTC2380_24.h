@@ -65,13 +65,42 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define LTC2380_ADDRESS             0x00
 //!@}
 
+//! CNV pulses issued per critical section. Interrupts are re-enabled between bursts so that
+//! millis()/micros() and Serial keep up during deep averages; 64 pulses take about 40us at 16MHz.
+#ifndef LTC2380_CNV_BURST
+#define LTC2380_CNV_BURST           64
+#endif
+
 
-//! Reads the LTC2380 and returns 32-bit data in 2's complement format
+//! Configures the CNV pin as an output and caches its port register and bit mask, so later
+//! reads can pulse CNV with single register writes.
 //! @return void
-void LTC2380_read(int32_t *ptr_adc_code,    //!< Returns code read from ADC (from previous conversion)
-                  int16_t *ptr_cycles
+void LTC2380_init_cnv(uint8_t cnv_pin   //!< Pin connected to CNV (QUIKEVAL_CS on the DC2289A)
+                     );
+
+//! Issues n CNV pulses in bursts of LTC2380_CNV_BURST with interrupts disabled, then reads the averaged 24-bit result and the
+//! number of conversions averaged. LTC2380_init_cnv() must be called first.
+//! @return void
+void LTC2380_read(uint16_t n,               //!< Number of conversions to average (averaging depth)
+                  int32_t *ptr_adc_code,    //!< Returns the averaged code, sign extended to 32 bits
+                  int16_t *ptr_cycles       //!< Returns the number of conversions averaged, minus one
                  );
 
+//! Starts continuous averaging: issues the n CNV pulses for the first average. Subsequent
+//! averages are produced by LTC2380_read_continuous().
+//! @return void
+void LTC2380_start_continuous(uint16_t n    //!< Number of conversions to average (averaging depth)
+                             );
+
+//! Returns the average accumulated since the previous call and immediately starts the next one.
+//! The first CNV pulse of the next average is issued before the result is clocked out, so the
+//! ADC converts while the previous average is read. If LTC2380_init_cnv() or
+//! LTC2380_start_continuous() has not been called, no CNV pulses are issued and both results are zero.
+//! @return void
+void LTC2380_read_continuous(int32_t *ptr_adc_code,   //!< Returns the averaged code, sign extended to 32 bits
+                             int16_t *ptr_cycles      //!< Returns the number of conversions averaged, minus one
+                            );
+
 
 //! Calculates the LTC2380 input voltage given the binary data and lsb weight.
 //! @return Floating point voltage
@@ -66,6 +66,30 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "LT_I2C.h"
 #include "LTC2485.h"
 
+// Converts the 32-bit word read from the LTC2485 into a 24-bit code
+static void LTC2485_code(LT_union_int32_4bytes *data, int32_t *adc_code)
+{
+  if (data->LT_byte[3]==0xC0)
+  {
+
+    *adc_code= 2147483647; //Positive Overflow
+    return;
+  }
+
+  if (data->LT_byte[3]==0x3F)
+  {
+    *adc_code=-2147483648; //Negative Overflow
+    return;
+  }
+
+  data->LT_byte[3]=data->LT_byte[3] & 0x7F; //Remove sign bit
+
+  data->LT_int32 = data->LT_int32 << 1; //shift left by one bit to restore two's complement
+
+  data->LT_int32/=256;  //Convert back to 24 bit value from 32 bits.
+  *adc_code=data->LT_int32;
+}
+
 // Reads from LTC2485
 int8_t LTC2485_read(uint8_t i2c_address, uint8_t adc_command, int32_t *adc_code, uint16_t eoc_timeout)
 {
@@ -84,25 +108,28 @@ int8_t LTC2485_read(uint8_t i2c_address, uint8_t adc_command, int32_t *adc_code,
       delay(1);
   }
 
-  if (data.LT_byte[3]==0xC0)
-  {
+  LTC2485_code(&data, adc_code);
 
-    *adc_code= 2147483647; //Positive Overflow
-    return (ack);
-  }
+  return (ack); // Success
+}
 
-  if (data.LT_byte[3]==0x3F)
-  {
-    *adc_code=-2147483648; //Negative Overflow
-    return (ack);
-  }
+// Reads from LTC2485 if a conversion result is ready
+int8_t LTC2485_poll(uint8_t i2c_address, uint8_t adc_command, int32_t *adc_code)
+{
+  int8_t ack;
+  LT_union_int32_4bytes data;
 
-  data.LT_byte[3]=data.LT_byte[3] & 0x7F; //Remove sign bit
+  ack = i2c_read_block_data(i2c_address, adc_command, 4, data.LT_byte);
+  if (ack)
+    return (1); // Still converting
 
-  data.LT_int32 = data.LT_int32 << 1; //shift left by one bit to restore two's complement
+  LTC2485_code(&data, adc_code);
 
-  data.LT_int32/=256;  //Convert back to 24 bit value from 32 bits.
-  *adc_code=data.LT_int32;
+  return (0);
+}
 
-  return (ack); // Success
+// Starts a conversion on all LTC2485s that answer to the global address
+int8_t LTC2485_start_all(uint8_t i2c_global_address, uint8_t adc_command)
+{
+  return (i2c_write_byte(i2c_global_address, adc_command));
 }
@@ -122,4 +122,22 @@ int8_t LTC2485_read(uint8_t i2c_address, //!< I2C address (7-bit format) for par
                     uint16_t eoc_timeout //!< Timeout in ms
                    );
 
-#endif  // LTC2485_H
\ No newline at end of file
+//! Tries once to read a conversion result from the LTC2485, without waiting for end of conversion.
+//! A successful read also starts the next conversion with adc_command, so polling several
+//! LTC2485s in turn keeps all of them converting back-to-back.
+//! @return  0=result read into adc_code and next conversion started, 1=conversion still in progress (no acknowledge).
+int8_t LTC2485_poll(uint8_t i2c_address, //!< I2C address (7-bit format) for part
+                    uint8_t adc_command, //!< Command byte written to LTC2485. Example: (LTC2485_R60  | LTC2485_SPEED_2X)
+                    int32_t *adc_code    //!< Conversion code read from LTC2485. Unchanged if the conversion is still in progress.
+                   );
+
+//! Starts a conversion on every LTC2485 that answers to the global address, at the same time.
+//! Parts that are still converting ignore the global address, so call this when all of them are idle (e.g. at power-up).
+//! Parts connected directly to the bus use LTC2485_I2C_GLOBAL_ADDRESS. Behind an address translator such as the LTC4316
+//! the global address is translated too, so each translated segment needs its own call with its translated global address.
+//! @return  Returns the state of the acknowledge bit after the I2C address write. 0=acknowledge, 1=no acknowledge.
+int8_t LTC2485_start_all(uint8_t i2c_global_address, //!< Global I2C address (7-bit format) as seen from the master, e.g. LTC2485_I2C_GLOBAL_ADDRESS
+                         uint8_t adc_command         //!< Command byte for the conversion that is started. Example: (LTC2485_R60  | LTC2485_SPEED_2X)
+                        );
+
+#endif  // LTC2485_H
\ No newline at end of file
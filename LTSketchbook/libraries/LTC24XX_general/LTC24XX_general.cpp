@@ -261,6 +261,70 @@ void LTC24XX_SPI_2ch_ping_pong_24bit_data(uint8_t cs, uint8_t *adc_channel, int3
 }
 
 
+// Initializes a Ping-Pong acquisition object
+void LTC24XX_ping_pong_init(LTC24XX_ping_pong *pp, uint8_t cs, uint8_t data_bits)
+{
+  memset(pp, 0, sizeof(LTC24XX_ping_pong));
+  pp->cs = cs;
+  pp->data_bits = data_bits;
+  pp->last_channel = 0xFF;
+}
+
+// Reads a conversion if EOC is low, then timestamps and queues it by channel
+int8_t LTC24XX_ping_pong_poll(LTC24XX_ping_pong *pp)
+{
+  uint8_t channel;
+  uint8_t next;
+  int32_t code;
+
+  output_low(pp->cs);                       //! 1) Pull CS low to check EOC
+  if (input(MISO) != 0)                     //! 2) Conversion still in progress
+  {
+    output_high(pp->cs);
+    return(-1);
+  }
+  output_high(pp->cs);
+
+  if (pp->data_bits == 24)                  //! 3) Read data and channel
+    LTC24XX_SPI_2ch_ping_pong_24bit_data(pp->cs, &channel, &code);
+  else
+    LTC24XX_SPI_2ch_ping_pong_32bit_data(pp->cs, &channel, &code);
+
+  if (channel == pp->last_channel)          //! 4) The other channel's conversion was missed
+    pp->missed_alternations++;
+  pp->last_channel = channel;
+  pp->latest_code[channel] = code;
+  pp->latest_time[channel] = micros();
+
+  next = (pp->head[channel] + 1) & (LTC24XX_PING_PONG_BUFFER_SIZE - 1);
+  if (next == pp->tail[channel])            //! 5) Queue the code, dropping it if the buffer is full
+  {
+    pp->overflows[channel]++;
+  }
+  else
+  {
+    pp->buffer[channel][pp->head[channel]] = code;
+    pp->head[channel] = next;
+  }
+  return(channel);
+}
+
+// Returns the number of codes queued for a channel
+uint8_t LTC24XX_ping_pong_available(LTC24XX_ping_pong *pp, uint8_t channel)
+{
+  return((pp->head[channel] - pp->tail[channel]) & (LTC24XX_PING_PONG_BUFFER_SIZE - 1));
+}
+
+// Removes the oldest queued code for a channel
+int8_t LTC24XX_ping_pong_read(LTC24XX_ping_pong *pp, uint8_t channel, int32_t *code)
+{
+  if (pp->tail[channel] == pp->head[channel])
+    return(1);
+  *code = pp->buffer[channel][pp->tail[channel]];
+  pp->tail[channel] = (pp->tail[channel] + 1) & (LTC24XX_PING_PONG_BUFFER_SIZE - 1);
+  return(0);
+}
+
 //I2C functions
 
 //! Reads from LTC24XX ADC that accepts an 8 bit configuration and returns a 24 bit result.
@@ -436,3 +500,79 @@ void LTC24XX_calibrate_voltage(int32_t zero_code, int32_t fs_code, float zero_vo
   temp_offset = (temp_offset > (floor(temp_offset) + 0.5)) ? ceil(temp_offset) : floor(temp_offset);    //! 5) Round
   *LTC24XX_offset_code = (int32_t)temp_offset;                                                          //! 6) Cast as int32_t
 }
+
+// Picks the largest shift that keeps the scaled lsb weight within an int32_t, so the
+// fixed-point result carries as much of the float lsb precision as possible.
+static void LTC24XX_set_uV_scale(float lsb_uV, int32_t offset, uint8_t zero_check, LTC24XX_uV_scale *scale)
+{
+  uint8_t shift = 0;
+  float magnitude = fabs(lsb_uV);
+
+  if (magnitude > 0)
+  {
+    while ((shift < 62) && (magnitude < 1073741824.0))  // Stop once doubling would pass 2^31
+    {
+      magnitude *= 2;
+      shift++;
+    }
+  }
+  scale->offset = offset;
+  scale->multiplier = (int32_t)((lsb_uV < 0) ? -magnitude - 0.5 : magnitude + 0.5);
+  scale->shift = shift;
+  scale->zero_check = zero_check;
+}
+
+// Builds the fixed-point equivalent of LTC24XX_SE_code_to_voltage()
+void LTC24XX_SE_uV_scale(float vref, LTC24XX_uV_scale *scale)
+{
+  LTC24XX_set_uV_scale(vref * 1000000.0 / 268435456.0, 0x20000000, 0, scale);
+}
+
+// Builds the fixed-point equivalent of LTC24XX_diff_code_to_voltage()
+void LTC24XX_diff_uV_scale(float vref, LTC24XX_uV_scale *scale)
+{
+#ifndef SKIP_EZDRIVE_2X_ZERO_CHECK
+  LTC24XX_set_uV_scale(vref * 1000000.0 / 536870912.0, 0x20000000, 1, scale);
+#else
+  LTC24XX_set_uV_scale(vref * 1000000.0 / 536870912.0, 0x20000000, 0, scale);
+#endif
+}
+
+// Builds the fixed-point equivalent of LTC24XX_diff_code_to_calibrated_voltage()
+void LTC24XX_calibrated_uV_scale(float LTC24XX_lsb, int32_t LTC24XX_offset_code, LTC24XX_uV_scale *scale)
+{
+#ifndef SKIP_EZDRIVE_2X_ZERO_CHECK
+  LTC24XX_set_uV_scale(LTC24XX_lsb * 1000000.0, 536870912 - LTC24XX_offset_code, 1, scale);
+#else
+  LTC24XX_set_uV_scale(LTC24XX_lsb * 1000000.0, 536870912 - LTC24XX_offset_code, 0, scale);
+#endif
+}
+
+// Converts a single adc code to microvolts using a precomputed scale
+int32_t LTC24XX_code_to_uV(int32_t adc_code, const LTC24XX_uV_scale *scale)
+{
+  int32_t uV;
+  LTC24XX_codes_to_uV(&adc_code, &uV, 1, scale);
+  return(uV);
+}
+
+// Converts an array of adc codes to microvolts. Only integer math is used in the loop, which avoids
+// the soft-float divide and multiply per sample on AVR.
+void LTC24XX_codes_to_uV(const int32_t *adc_code, int32_t *uV, uint16_t length, const LTC24XX_uV_scale *scale)
+{
+  int32_t offset = scale->offset;
+  int32_t multiplier = scale->multiplier;
+  uint8_t shift = scale->shift;
+  uint8_t zero_check = scale->zero_check;
+  int64_t rounding = (shift > 0) ? ((int64_t)1 << (shift - 1)) : 0;
+  int32_t code;
+  uint16_t i;
+
+  for (i = 0; i < length; i++)
+  {
+    code = adc_code[i];
+    if (zero_check && (code == 0x00000000))
+      code = 0x20000000;
+    uV[i] = (int32_t)(((int64_t)(code - offset) * multiplier + rounding) >> shift);  //! 1) Remove offset, 2) Scale by lsb weight
+  }
+}
@@ -338,6 +338,57 @@ void LTC24XX_SPI_2ch_ping_pong_24bit_data(uint8_t cs,           //!< Chip Select
     int32_t *code         //!< 4 byte conversion code read from LTC24XX
                                          );
 
+//! @name Ping-Pong dual channel acquisition
+//! Depth of each per-channel ring buffer. Must be a power of 2.
+//! @{
+#ifndef LTC24XX_PING_PONG_BUFFER_SIZE
+#define LTC24XX_PING_PONG_BUFFER_SIZE 16
+#endif
+//! @}
+
+//! Acquisition state for a two channel "Ping-Pong" ADC. The ADC alternates channels on every
+//! conversion; this keeps the latest code and timestamp for each channel, counts conversions
+//! where the expected alternation did not happen, and queues codes in per-channel ring buffers.
+typedef struct
+{
+  uint8_t cs;                                                 //!< Chip Select pin
+  uint8_t data_bits;                                          //!< 24 or 32 bit output word
+  uint8_t last_channel;                                       //!< Channel of the previous conversion, 0xFF if none yet
+  int32_t latest_code[2];                                     //!< Most recent code for each channel
+  uint32_t latest_time[2];                                    //!< micros() timestamp of the most recent code for each channel
+  uint16_t missed_alternations;                               //!< Number of times the same channel was read twice in a row
+  uint16_t overflows[2];                                      //!< Codes dropped because a channel buffer was full
+  uint8_t head[2];                                            //!< Ring buffer write index for each channel
+  uint8_t tail[2];                                            //!< Ring buffer read index for each channel
+  int32_t buffer[2][LTC24XX_PING_PONG_BUFFER_SIZE];           //!< Per-channel ring buffers of codes
+} LTC24XX_ping_pong;
+
+//! Initializes a Ping-Pong acquisition object.
+//! @return void
+void LTC24XX_ping_pong_init(LTC24XX_ping_pong *pp,   //!< Acquisition object to initialize
+                            uint8_t cs,              //!< Chip Select pin
+                            uint8_t data_bits        //!< 24 for LTC2436 type parts, 32 for LTC2412 type parts
+                           );
+
+//! Checks EOC without waiting. If a conversion is ready it is read, timestamped and queued.
+//! Call as often as possible to acquire at the converter's full Ping-Pong rate.
+//! @return Returns the channel read (0 or 1), or -1 if no conversion was ready.
+int8_t LTC24XX_ping_pong_poll(LTC24XX_ping_pong *pp  //!< Acquisition object
+                             );
+
+//! Returns the number of codes queued for a channel.
+//! @return Number of codes in the channel ring buffer.
+uint8_t LTC24XX_ping_pong_available(LTC24XX_ping_pong *pp,   //!< Acquisition object
+                                    uint8_t channel          //!< Channel (0 or 1)
+                                   );
+
+//! Removes the oldest queued code for a channel.
+//! @return Returns 0=successful, 1=unsuccessful (buffer empty)
+int8_t LTC24XX_ping_pong_read(LTC24XX_ping_pong *pp,   //!< Acquisition object
+                              uint8_t channel,         //!< Channel (0 or 1)
+                              int32_t *code            //!< Returns the oldest code for the channel
+                             );
+
 // Read functions for I2C interface ADCs with a 32 bit output word. These functions are used with both
 // Single-ended and differential parts, as there is no interpretation of the data done in
 // the function. Also note that these functions can be used for devices that have shorter output lengths,
@@ -439,6 +490,52 @@ void LTC24XX_calibrate_voltage(int32_t zero_code,             //!< Measured code
                                int32_t *LTC24XX_offset_code   //!< Overwritten with offset code (zero code)
                               );
 
+//! Fixed-point scale for converting LTC24XX codes to microvolts without floating point math.
+//! Computed once per channel configuration, then applied to whole buffers of codes:
+//! microvolts = ((adc_code - offset) * multiplier) >> shift, using a 32x32->64 bit product.
+typedef struct
+{
+  int32_t offset;       //!< Code subtracted before scaling (offset binary zero and calibrated offset)
+  int32_t multiplier;   //!< LSB weight in microvolts, multiplied by 2^shift
+  uint8_t shift;        //!< Right shift applied to the 64 bit product
+  uint8_t zero_check;   //!< If 1, a code of 0x00000000 is treated as zero volts (2X mode correction)
+} LTC24XX_uV_scale;
+
+//! Builds the microvolt scale matching LTC24XX_SE_code_to_voltage().
+//! @return Void
+void LTC24XX_SE_uV_scale(float vref,                 //!< Reference voltage
+                         LTC24XX_uV_scale *scale     //!< Overwritten with the fixed-point scale
+                        );
+
+//! Builds the microvolt scale matching LTC24XX_diff_code_to_voltage().
+//! @return Void
+void LTC24XX_diff_uV_scale(float vref,               //!< Reference voltage
+                           LTC24XX_uV_scale *scale   //!< Overwritten with the fixed-point scale
+                          );
+
+//! Builds the microvolt scale matching LTC24XX_diff_code_to_calibrated_voltage(), using the lsb
+//! and offset code produced by LTC24XX_calibrate_voltage().
+//! @return Void
+void LTC24XX_calibrated_uV_scale(float LTC24XX_lsb,              //!< LSB weight (in volts)
+                                 int32_t LTC24XX_offset_code,    //!< The calibrated offset code
+                                 LTC24XX_uV_scale *scale         //!< Overwritten with the fixed-point scale
+                                );
+
+//! Converts a single ADC code to microvolts using a precomputed scale.
+//! @return Returns voltage in microvolts.
+int32_t LTC24XX_code_to_uV(int32_t adc_code,                  //!< Code read from ADC
+                           const LTC24XX_uV_scale *scale       //!< Scale from one of the LTC24XX_*_uV_scale() functions
+                          );
+
+//! Converts an array of ADC codes to microvolts using a precomputed scale. adc_code and uV
+//! may point to the same array to convert in place.
+//! @return Void
+void LTC24XX_codes_to_uV(const int32_t *adc_code,             //!< Array of codes read from ADC
+                         int32_t *uV,                         //!< Array overwritten with voltages in microvolts
+                         uint16_t length,                     //!< Number of codes to convert
+                         const LTC24XX_uV_scale *scale        //!< Scale from one of the LTC24XX_*_uV_scale() functions
+                        );
+
 
 
 // I2C Addresses for 8/16 channel parts (LTC2495/7/9)
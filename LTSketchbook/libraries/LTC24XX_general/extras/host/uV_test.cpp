@@ -0,0 +1,281 @@
+/*
+Host test for the fixed-point microvolt kernels.
+
+NOT AN ARDUINO SKETCH.  This program builds LTC24XX_general, LTC2380 and
+LTC2348 with g++ against Utilities/host_stubs and compares every integer
+kernel with the float conversion it replaces:
+
+  LTC24XX_codes_to_uV()   vs LTC24XX_SE_code_to_voltage(),
+                             LTC24XX_diff_code_to_voltage() and
+                             LTC24XX_diff_code_to_calibrated_voltage()
+  LTC2380_codes_to_uV()   vs LTC2380_code_to_voltage()
+  LTC23XX_codes_to_uV()   vs LTC23XX_voltage_calculator() for all 8 softspans
+  LTC23XX_frame_to_uV()   vs a frame decoded channel by channel
+
+Edge codes (zero, full scale, the sign boundary and the EZDrive 0x00000000
+code) are checked along with pseudo-random ones.  A kernel fails if it is
+further than MAX_ERROR_UV from the float result, which is about the rounding
+error of the float path itself at full scale.
+
+The program then times both paths over a buffer of codes.  Those numbers are
+for the host CPU, where float is cheap; on the AVR the integer path also
+avoids the soft-float library.
+
+  make
+  ./uV_test
+
+Copyright 2018(c) Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in
+   the documentation and/or other materials provided with the
+   distribution.
+ - Neither the name of Analog Devices, Inc. nor the names of its
+   contributors may be used to endorse or promote products derived
+   from this software without specific prior written permission.
+ - The use of this software may or may not infringe the patent rights
+   of one or more patent holders.  This license does not release you
+   from the requirement that you obtain separate licenses from these
+   patent holders to use this software.
+ - Use of the software either in source or binary form, must be run
+   on or directly connected to an Analog Devices Inc. component.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <Arduino.h>
+#include <time.h>
+#include "LTC24XX_general.h"
+#include "LTC2380.h"
+#include "LTC2348.h"
+
+#define MAX_ERROR_UV 2.0
+#define RANDOM_CODES 200000
+#define BENCH_LENGTH 256
+#define BENCH_PASSES 4000
+
+// The kernels under test never touch the bus, but the libraries link against it
+void spi_transfer_block(uint8_t, uint8_t *, uint8_t *, uint8_t) {}
+int8_t i2c_read_block_data(uint8_t, uint8_t, uint8_t, uint8_t *)
+{
+  return 0;
+}
+int8_t i2c_read_block_data(uint8_t, uint8_t, uint8_t *)
+{
+  return 0;
+}
+int8_t i2c_two_byte_command_read_block(uint8_t, uint16_t, uint8_t, uint8_t *)
+{
+  return 0;
+}
+
+static uint32_t rng_state = 1;
+
+static uint32_t rng()
+{
+  rng_state ^= rng_state << 13;
+  rng_state ^= rng_state >> 17;
+  rng_state ^= rng_state << 5;
+  return rng_state;
+}
+
+static int failures;
+
+static void report(const char *name, double worst)
+{
+  printf("%-44s worst %.3f uV  %s\n", name, worst, worst <= MAX_ERROR_UV ? "ok" : "FAIL");
+  if (worst > MAX_ERROR_UV)
+    failures++;
+}
+
+static double error_uV(int32_t uV, float volts)
+{
+  return fabs((double)uV - (double)volts * 1000000.0);
+}
+
+// LTC24XX codes are offset binary in bits 29..0, plus the EZDrive zero code
+static int32_t ltc24xx_code(long i)
+{
+  static const int32_t edge[] = {0x00000000, 0x00000001, 0x10000000, 0x1FFFFFFF, 0x20000000,
+                                 0x20000001, 0x2FFFFFFF, 0x30000000, 0x3FFFFFFF
+                                };
+  if (i < (long)(sizeof(edge) / sizeof(edge[0])))
+    return edge[i];
+  return rng() & 0x3FFFFFFF;
+}
+
+static void test_ltc24xx()
+{
+  const float vrefs[] = {1.25, 2.5, 4.096, 5.0};
+  char name[64];
+
+  for (uint8_t v = 0; v < sizeof(vrefs) / sizeof(vrefs[0]); v++)
+  {
+    float vref = vrefs[v];
+    float lsb;
+    int32_t offset_code;
+    LTC24XX_uV_scale se, diff, cal;
+    double worst_se = 0, worst_diff = 0, worst_cal = 0;
+
+    LTC24XX_SE_uV_scale(vref, &se);
+    LTC24XX_diff_uV_scale(vref, &diff);
+    LTC24XX_calibrate_voltage(0x20000123, 0x2FFF0000, 0.0001, vref * 0.49, &lsb, &offset_code);
+    LTC24XX_calibrated_uV_scale(lsb, offset_code, &cal);
+
+    for (long i = 0; i < RANDOM_CODES; i++)
+    {
+      int32_t code = ltc24xx_code(i);
+      worst_se = max(worst_se, error_uV(LTC24XX_code_to_uV(code, &se), LTC24XX_SE_code_to_voltage(code, vref)));
+      worst_diff = max(worst_diff, error_uV(LTC24XX_code_to_uV(code, &diff), LTC24XX_diff_code_to_voltage(code, vref)));
+      worst_cal = max(worst_cal, error_uV(LTC24XX_code_to_uV(code, &cal),
+                                          LTC24XX_diff_code_to_calibrated_voltage(code, lsb, offset_code)));
+    }
+    sprintf(name, "LTC24XX single-ended, vref %.3f", vref);
+    report(name, worst_se);
+    sprintf(name, "LTC24XX differential, vref %.3f", vref);
+    report(name, worst_diff);
+    sprintf(name, "LTC24XX calibrated, vref %.3f", vref);
+    report(name, worst_cal);
+  }
+}
+
+static void test_ltc2380()
+{
+  const float vrefs[] = {2.5, 4.096, 5.0};
+  char name[64];
+
+  for (uint8_t gain_compression = 0; gain_compression < 2; gain_compression++)
+    for (uint8_t v = 0; v < sizeof(vrefs) / sizeof(vrefs[0]); v++)
+    {
+      LTC2380_uV_scale scale;
+      double worst = 0;
+
+      LTC2380_set_uV_scale(gain_compression, vrefs[v], &scale);
+      for (long i = 0; i < RANDOM_CODES; i++)
+      {
+        int32_t code = (i == 0) ? INT32_MAX : (i == 1) ? INT32_MIN + 1 : (i == 2) ? 0 : (int32_t)rng();
+        int32_t uV;
+        LTC2380_codes_to_uV(&code, &uV, 1, &scale);
+        worst = max(worst, error_uV(uV, LTC2380_code_to_voltage(code, gain_compression, vrefs[v])));
+      }
+      sprintf(name, "LTC2380, gain compression %u, vref %.3f", gain_compression, vrefs[v]);
+      report(name, worst);
+    }
+}
+
+static void test_ltc23xx()
+{
+  char name[64];
+
+  for (uint8_t config = 0; config < 8; config++)
+  {
+    double worst = 0;
+
+    for (uint32_t code = 0; code < 262144; code++)
+    {
+      int32_t uV;
+      LTC23XX_codes_to_uV(&code, &uV, 1, config);
+      worst = max(worst, error_uV(uV, LTC23XX_voltage_calculator(code, config)));
+    }
+    sprintf(name, "LTC23XX softspan %u, all 18 bit codes", config);
+    report(name, worst);
+  }
+}
+
+// Packs one 24 bit word per channel in the order LTC23XX_read() stores them
+static void test_ltc23xx_frame()
+{
+  uint8_t frame[24];
+  uint32_t code[8];
+  int32_t uV[8];
+  double worst = 0;
+
+  for (int pass = 0; pass < 1000; pass++)
+  {
+    for (uint8_t channel = 0; channel < 8; channel++)
+    {
+      uint8_t config = (channel + pass) & 0x07;
+      uint32_t word;
+      int8_t pos = 23 - 3 * channel;
+
+      code[channel] = rng() & 0x3FFFF;
+      word = (code[channel] << 6) | ((uint32_t)channel << 3) | config;
+      frame[pos] = word >> 16;
+      frame[pos - 1] = word >> 8;
+      frame[pos - 2] = word;
+    }
+    LTC23XX_frame_to_uV(frame, uV);
+    for (uint8_t channel = 0; channel < 8; channel++)
+      worst = max(worst, error_uV(uV[channel], LTC23XX_voltage_calculator(code[channel], (channel + pass) & 0x07)));
+  }
+  report("LTC23XX_frame_to_uV, 1000 random frames", worst);
+}
+
+static double seconds()
+{
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+// volatile sinks keep the compiler from discarding either loop
+static volatile float float_sink;
+static volatile int32_t int_sink;
+
+static void bench()
+{
+  static int32_t code[BENCH_LENGTH];
+  static int32_t uV[BENCH_LENGTH];
+  LTC24XX_uV_scale scale;
+  double t0, t_float, t_fixed;
+  float sum = 0;
+
+  for (int i = 0; i < BENCH_LENGTH; i++)
+    code[i] = ltc24xx_code(i + 16);
+  LTC24XX_diff_uV_scale(5.0, &scale);
+
+  t0 = seconds();
+  for (int pass = 0; pass < BENCH_PASSES; pass++)
+    for (int i = 0; i < BENCH_LENGTH; i++)
+      sum += LTC24XX_diff_code_to_voltage(code[i], 5.0);
+  t_float = seconds() - t0;
+  float_sink = sum;
+
+  t0 = seconds();
+  for (int pass = 0; pass < BENCH_PASSES; pass++)
+  {
+    LTC24XX_codes_to_uV(code, uV, BENCH_LENGTH, &scale);
+    int_sink = uV[pass % BENCH_LENGTH];
+  }
+  t_fixed = seconds() - t0;
+
+  printf("\nHost timing, %d x %d LTC24XX differential codes:\n", BENCH_PASSES, BENCH_LENGTH);
+  printf("  LTC24XX_diff_code_to_voltage()  %6.2f ns/code\n", t_float * 1e9 / BENCH_PASSES / BENCH_LENGTH);
+  printf("  LTC24XX_codes_to_uV()           %6.2f ns/code\n", t_fixed * 1e9 / BENCH_PASSES / BENCH_LENGTH);
+}
+
+int main()
+{
+  test_ltc24xx();
+  test_ltc2380();
+  test_ltc23xx();
+  test_ltc23xx_frame();
+  bench();
+  printf("\n%s\n", failures ? "FAILED" : "PASSED");
+  return failures ? 1 : 0;
+}
@@ -71,6 +71,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <Wire.h>
 #include <stdint.h>
 #include <SPI.h>
+#include "LTC2508.h"
 
 // Calculates the output voltage from the given digital code and reference voltage
 float LTC2508_code_to_voltage(int32_t code, float vref)
@@ -94,6 +95,30 @@ void send_pulses(uint8_t pin, uint16_t num_of_pulses)
   output_low(pin);                        // Leave CS low
 }
 
+// Decodes the DF value from the configuration word W7:W0
+static uint16_t LTC2508_decode_DF(uint8_t config)
+{
+  uint16_t DF;
+  switch (config)
+  {
+    case 0x85:
+      DF = 256;
+      break;
+    case 0xA5:
+      DF = 1024;
+      break;
+    case 0xC5:
+      DF = 4096;
+      break;
+    case 0xE5:
+      DF = 16384;
+      break;
+    default:
+      DF = 0;
+  }
+  return DF;
+}
+
 // Reads 5 bytes of data on SPI - D31:D0 + W7:W0
 uint32_t LTC2508_read_data(uint8_t QUIKEVAL_CS, uint16_t *DF)
 {
@@ -109,22 +134,29 @@ uint32_t LTC2508_read_data(uint8_t QUIKEVAL_CS, uint16_t *DF)
   code = (code << 8) | rx[2];
   code = (code << 8) | rx[1];
 
-  switch (rx[0])
-  {
-    case 0x85:
-      *DF = 256;
-      break;
-    case 0xA5:
-      *DF = 1024;
-      break;
-    case 0xC5:
-      *DF = 4096;
-      break;
-    case 0xE5:
-      *DF = 16384;
-      break;
-    default:
-      *DF = 0;
-  }
+  *DF = LTC2508_decode_DF(rx[0]);
   return code;
-}
\ No newline at end of file
+}
+
+// Starts the Timer1 MCLK, no faster than the DRL interrupt can read 5 byte words
+uint16_t LTC2508_mclk_timer_start(uint16_t mclk_period, uint16_t DF)
+{
+  return LTC25XX_mclk_timer_start(mclk_period, DF, LTC2508_WORD_BYTES);
+}
+
+// Attaches the DRL interrupt for 5 byte words
+void LTC2508_stream_start(uint8_t drl_pin)
+{
+  LTC25XX_stream_start(drl_pin, LTC2508_WORD_BYTES);
+}
+
+// Removes the oldest queued output word and decodes its DF
+uint8_t LTC2508_stream_read(uint32_t *code, uint16_t *DF)
+{
+  uint8_t config;
+
+  if (LTC25XX_stream_read(code, &config))
+    return 1;
+  *DF = LTC2508_decode_DF(config);
+  return 0;
+}
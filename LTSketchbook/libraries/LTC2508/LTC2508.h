@@ -59,6 +59,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef LTC2508_H
 #define LTC2508_H
 
+#include "LTC25XX_stream.h"
+
 #define SNEAKER_PORT_ADDRESS  0x20
 #define MCLK_pin        QUIKEVAL_CS
 #define CONFIG_DF_256     0x8000
@@ -78,4 +80,30 @@ void send_pulses(uint8_t pin, uint16_t num_of_pulses);
 //! Reads 5 bytes of data on SPI - D31:D0 + W7:W0
 uint32_t LTC2508_read_data(uint8_t QUIKEVAL_CS, uint16_t *DF);
 
-#endif
\ No newline at end of file
+//! @name Timer driven MCLK and streaming reader
+//! The MCLK timer and DRL ring buffer are shared with the LTC2512 in LTC25XX_stream. Stop them
+//! with LTC25XX_mclk_timer_stop() and LTC25XX_stream_stop(), restart the filter with
+//! LTC25XX_sync(), and check for dropped words with LTC25XX_stream_overflows().
+//! @{
+#define LTC2508_WORD_BYTES            5       //!< Bytes per output word: D31:D0 + W7:W0
+//! @}
+
+//! Starts continuous MCLK on the QuikEval CS pin using Timer1 hardware PWM. The period is
+//! lengthened if needed so the DRL interrupt can read each output word at the current SPI
+//! clock before DF more MCLK periods produce the next one.
+//! @return The MCLK period used, in Timer1 ticks
+uint16_t LTC2508_mclk_timer_start(uint16_t mclk_period,   //!< Requested MCLK period in Timer1 ticks (LTC25XX_MCLK_PERIOD_1MHZ = 1MHz)
+                                  uint16_t DF             //!< Down-sampling factor the ADC is configured for
+                                 );
+
+//! Attaches the DRL interrupt and starts queueing filtered output words.
+void LTC2508_stream_start(uint8_t drl_pin   //!< Pin connected to DRL, must support external interrupts
+                         );
+
+//! Removes the oldest filtered output word from the ring buffer.
+//! @return 0 if a word was returned, 1 if the buffer was empty
+uint8_t LTC2508_stream_read(uint32_t *code,   //!< Returns the output code (D31:D0)
+                           uint16_t *DF      //!< Returns the DF decoded from W7:W0, 0 if invalid
+                          );
+
+#endif
\ No newline at end of file
@@ -71,6 +71,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <Wire.h>
 #include <stdint.h>
 #include <SPI.h>
+#include "LTC2512.h"
 
 // Calculates the output voltage from the given digital code and reference voltage
 float LTC2512_code_to_voltage(int32_t code, float vref)
@@ -97,6 +98,30 @@ void send_pulses(uint8_t pin, uint16_t num_of_pulses)
   output_low(pin);                        // Leave CS low
 }
 
+// Decodes the DF value from the configuration word W7:W0
+static uint16_t LTC2512_decode_DF(uint8_t config)
+{
+  uint16_t DF;
+  switch (config)
+  {
+    case 0x26:
+      DF = 4;
+      break;
+    case 0x36:
+      DF = 8;
+      break;
+    case 0x46:
+      DF = 16;
+      break;
+    case 0x56:
+      DF = 32;
+      break;
+    default:
+      DF = 0;
+  }
+  return DF;
+}
+
 // Reads 4 bytes of data on SPI - D23:D0 + W7:W0
 uint32_t LTC2512_read_data(uint8_t QUIKEVAL_CS, uint16_t *DF)
 {
@@ -111,22 +136,29 @@ uint32_t LTC2512_read_data(uint8_t QUIKEVAL_CS, uint16_t *DF)
   code = (code << 8) | rx[2];
   code = (code << 8) | rx[1];
   code = code & 0xFFFFFF;
-  switch (rx[0])
-  {
-    case 0x26:
-      *DF = 4;
-      break;
-    case 0x36:
-      *DF = 8;
-      break;
-    case 0x46:
-      *DF = 16;
-      break;
-    case 0x56:
-      *DF = 32;
-      break;
-    default:
-      *DF = 0;
-  }
+  *DF = LTC2512_decode_DF(rx[0]);
   return code;
-}
\ No newline at end of file
+}
+
+// Starts the Timer1 MCLK, no faster than the DRL interrupt can read 4 byte words
+uint16_t LTC2512_mclk_timer_start(uint16_t mclk_period, uint16_t DF)
+{
+  return LTC25XX_mclk_timer_start(mclk_period, DF, LTC2512_WORD_BYTES);
+}
+
+// Attaches the DRL interrupt for 4 byte words
+void LTC2512_stream_start(uint8_t drl_pin)
+{
+  LTC25XX_stream_start(drl_pin, LTC2512_WORD_BYTES);
+}
+
+// Removes the oldest queued output word and decodes its DF
+uint8_t LTC2512_stream_read(uint32_t *code, uint16_t *DF)
+{
+  uint8_t config;
+
+  if (LTC25XX_stream_read(code, &config))
+    return 1;
+  *DF = LTC2512_decode_DF(config);
+  return 0;
+}
@@ -59,6 +59,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef LTC2512_H
 #define LTC2512_H
 
+#include "LTC25XX_stream.h"
+
 
 #define SNEAKER_PORT_ADDRESS  0x20
 #define MCLK_pin        QUIKEVAL_CS
@@ -80,4 +82,30 @@ void send_pulses(uint8_t pin, uint16_t num_of_pulses);
 //! Reads 4 bytes of data on SPI - D23:D0 + W7:W0
 uint32_t LTC2512_read_data(uint8_t QUIKEVAL_CS, uint16_t *DF);
 
-#endif
\ No newline at end of file
+//! @name Timer driven MCLK and streaming reader
+//! The MCLK timer and DRL ring buffer are shared with the LTC2508 in LTC25XX_stream. Stop them
+//! with LTC25XX_mclk_timer_stop() and LTC25XX_stream_stop(), restart the filter with
+//! LTC25XX_sync(), and check for dropped words with LTC25XX_stream_overflows().
+//! @{
+#define LTC2512_WORD_BYTES            4       //!< Bytes per output word: D23:D0 + W7:W0
+//! @}
+
+//! Starts continuous MCLK on the QuikEval CS pin using Timer1 hardware PWM. The period is
+//! lengthened if needed so the DRL interrupt can read each output word at the current SPI
+//! clock before DF more MCLK periods produce the next one.
+//! @return The MCLK period used, in Timer1 ticks
+uint16_t LTC2512_mclk_timer_start(uint16_t mclk_period,   //!< Requested MCLK period in Timer1 ticks (LTC25XX_MCLK_PERIOD_1MHZ = 1MHz)
+                                  uint16_t DF             //!< Down-sampling factor the ADC is configured for
+                                 );
+
+//! Attaches the DRL interrupt and starts queueing filtered output words.
+void LTC2512_stream_start(uint8_t drl_pin   //!< Pin connected to DRL, must support external interrupts
+                         );
+
+//! Removes the oldest filtered output word from the ring buffer.
+//! @return 0 if a word was returned, 1 if the buffer was empty
+uint8_t LTC2512_stream_read(uint32_t *code,   //!< Returns the output code (D23:D0)
+                           uint16_t *DF      //!< Returns the DF decoded from W7:W0, 0 if invalid
+                          );
+
+#endif
\ No newline at end of file
@@ -0,0 +1,222 @@
+/*!
+LTC25XX_stream: Timer driven MCLK and DRL streaming reader shared by the LTC2508 and LTC2512.
+
+Copyright 2018(c) Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in
+   the documentation and/or other materials provided with the
+   distribution.
+ - Neither the name of Analog Devices, Inc. nor the names of its
+   contributors may be used to endorse or promote products derived
+   from this software without specific prior written permission.
+ - The use of this software may or may not infringe the patent rights
+   of one or more patent holders.  This license does not release you
+   from the requirement that you obtain separate licenses from these
+   patent holders to use this software.
+ - Use of the software either in source or binary form, must be run
+   on or directly connected to an Analog Devices Inc. component.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//! @ingroup Analog_to_Digital_Converters
+//! @{
+//! @defgroup LTC25XX_stream LTC25XX_stream : Timer driven MCLK and DRL streaming reader for the LTC2508 and LTC2512.
+
+//! @}
+
+/*! @file
+    @ingroup LTC25XX_stream
+    Library for the LTC2508/LTC2512 timer driven MCLK and DRL streaming reader.
+*/
+
+#include <Arduino.h>
+#include "LT_SPI.h"
+#include "Linduino.h"
+#include <stdint.h>
+#include <SPI.h>
+#include "LTC25XX_stream.h"
+
+//! One filtered output word queued by the DRL interrupt
+struct LTC25XX_stream_entry
+{
+  uint32_t code;    //!< Output code
+  uint8_t config;   //!< Configuration word W7:W0
+};
+
+static LTC25XX_stream_entry LTC25XX_stream_buffer[LTC25XX_STREAM_BUFFER_SIZE];
+static volatile uint8_t LTC25XX_stream_head = 0;       // Next slot written by the interrupt
+static volatile uint8_t LTC25XX_stream_tail = 0;       // Next slot read by LTC25XX_stream_read()
+static volatile uint16_t LTC25XX_stream_overflow_count = 0;
+static uint8_t LTC25XX_stream_bytes = 4;               // Bytes per output word, including W7:W0
+static uint8_t LTC25XX_drl_flag = 0;                   // EIFR bit of the DRL interrupt
+
+// DRL falling edge: the next filtered output word is ready. SPDR is used directly because
+// digitalWrite() on the CS pin would disconnect the Timer1 MCLK output.
+static void LTC25XX_drl_ISR()
+{
+  uint8_t head = LTC25XX_stream_head;
+  uint8_t next = (head + 1) & (LTC25XX_STREAM_BUFFER_SIZE - 1);
+  uint32_t code = 0;
+  uint8_t config;
+  uint8_t i;
+
+  if (next == LTC25XX_stream_tail)
+  {
+    LTC25XX_stream_overflow_count++;   // Buffer full, drop the word
+    return;
+  }
+
+  for (i = 1; i < LTC25XX_stream_bytes; i++)
+    code = (code << 8) | (uint8_t)spi_read(0);
+  config = spi_read(0);
+
+  // If DRL fell again the next word replaced this one part way through the read, and the
+  // bytes already clocked out belong to neither word. Drop both.
+  if (EIFR & LTC25XX_drl_flag)
+  {
+    EIFR = LTC25XX_drl_flag;
+    LTC25XX_stream_overflow_count += 2;
+    return;
+  }
+
+  LTC25XX_stream_buffer[head].code = code;
+  LTC25XX_stream_buffer[head].config = config;
+  LTC25XX_stream_head = next;
+}
+
+// Returns the number of CPU cycles per SCK period set by spi_enable()
+static uint8_t LTC25XX_spi_divider()
+{
+  static const uint8_t divider[4] = {4, 16, 64, 128};
+  uint8_t spi_divider = divider[SPCR & (_BV(SPR1) | _BV(SPR0))];
+
+  if (SPSR & _BV(SPI2X))
+    spi_divider >>= 1;
+  return spi_divider;
+}
+
+// Finds the shortest MCLK period that leaves the DRL interrupt 3/4 of each output word period
+uint16_t LTC25XX_min_mclk_period(uint16_t DF, uint8_t word_bytes)
+{
+  uint32_t isr_cycles;
+  uint32_t period;
+
+  if (DF == 0)
+    DF = 1;
+  isr_cycles = (uint32_t)word_bytes * (8 * LTC25XX_spi_divider() + LTC25XX_SPI_BYTE_OVERHEAD)
+               + LTC25XX_DRL_ISR_OVERHEAD;
+  period = (isr_cycles * 4 / 3 + DF - 1) / DF;
+  if (period < LTC25XX_MCLK_PERIOD_1MHZ)
+    period = LTC25XX_MCLK_PERIOD_1MHZ;
+  return (period > 0xFFFF) ? 0xFFFF : period;
+}
+
+// Starts MCLK using Timer1 fast PWM (mode 15, TOP = OCR1A) with the output on OC1B
+uint16_t LTC25XX_mclk_timer_start(uint16_t mclk_period, uint16_t DF, uint8_t word_bytes)
+{
+  uint16_t min_period = LTC25XX_min_mclk_period(DF, word_bytes);
+
+  if (mclk_period < min_period)
+    mclk_period = min_period;
+
+  pinMode(QUIKEVAL_CS, OUTPUT);
+  TCCR1B = 0;                                         // Stop Timer1 while configuring
+  TCNT1 = 0;
+  OCR1A = mclk_period - 1;                            // MCLK period
+  OCR1B = LTC25XX_MCLK_HIGH_TICKS - 1;                // MCLK high time
+  TCCR1A = _BV(COM1B1) | _BV(WGM11) | _BV(WGM10);     // Non-inverting output on OC1B
+  TCCR1B = _BV(WGM13) | _BV(WGM12) | _BV(CS10);       // No prescaler, start MCLK
+  return mclk_period;
+}
+
+// Stops the Timer1 MCLK and leaves the pin low
+void LTC25XX_mclk_timer_stop()
+{
+  TCCR1B = 0;
+  TCCR1A = 0;
+  output_low(QUIKEVAL_CS);
+}
+
+// Restarts the digital filter with a SYNC pulse while MCLK is stopped
+void LTC25XX_sync(uint8_t sync_pin)
+{
+  uint8_t tccr1b = TCCR1B;
+
+  TCCR1B = tccr1b & ~(_BV(CS12) | _BV(CS11) | _BV(CS10));   // Pause MCLK
+  pinMode(sync_pin, OUTPUT);
+  output_high(sync_pin);
+  output_low(sync_pin);
+
+  noInterrupts();
+  LTC25XX_stream_head = 0;
+  LTC25XX_stream_tail = 0;
+  LTC25XX_stream_overflow_count = 0;
+  interrupts();
+
+  TCNT1 = 0;
+  TCCR1B = tccr1b;                                    // Resume MCLK at the start of a period
+}
+
+// Attaches the DRL interrupt
+void LTC25XX_stream_start(uint8_t drl_pin, uint8_t word_bytes)
+{
+  uint8_t interrupt = digitalPinToInterrupt(drl_pin);
+
+  LTC25XX_stream_bytes = word_bytes;
+  LTC25XX_drl_flag = _BV(interrupt);                  // INTFn is bit n of EIFR
+  pinMode(drl_pin, INPUT);
+  EIFR = LTC25XX_drl_flag;                            // Forget edges from before the stream started
+  attachInterrupt(interrupt, LTC25XX_drl_ISR, FALLING);
+}
+
+// Detaches the DRL interrupt
+void LTC25XX_stream_stop(uint8_t drl_pin)
+{
+  detachInterrupt(digitalPinToInterrupt(drl_pin));
+}
+
+// Returns the number of queued output words
+uint8_t LTC25XX_stream_available()
+{
+  return (LTC25XX_stream_head - LTC25XX_stream_tail) & (LTC25XX_STREAM_BUFFER_SIZE - 1);
+}
+
+// Removes the oldest queued output word
+uint8_t LTC25XX_stream_read(uint32_t *code, uint8_t *config)
+{
+  uint8_t tail = LTC25XX_stream_tail;
+
+  if (tail == LTC25XX_stream_head)
+    return 1;
+  *code = LTC25XX_stream_buffer[tail].code;
+  *config = LTC25XX_stream_buffer[tail].config;
+  LTC25XX_stream_tail = (tail + 1) & (LTC25XX_STREAM_BUFFER_SIZE - 1);
+  return 0;
+}
+
+// Returns the number of dropped output words
+uint16_t LTC25XX_stream_overflows()
+{
+  uint16_t count;
+  noInterrupts();
+  count = LTC25XX_stream_overflow_count;
+  interrupts();
+  return count;
+}
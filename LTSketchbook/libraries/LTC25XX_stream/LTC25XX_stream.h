@@ -0,0 +1,123 @@
+/*!
+LTC25XX_stream: Timer driven MCLK and DRL streaming reader shared by the LTC2508 and LTC2512.
+
+@verbatim
+
+The LTC2508-32 and LTC2512-24 produce one filtered output word every DF
+MCLK periods and signal it by pulling DRL low. This library generates
+MCLK with Timer1 and reads each word in the DRL interrupt into a ring
+buffer. The part libraries add their word length and DF decoding.
+
+@endverbatim
+
+Copyright 2018(c) Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in
+   the documentation and/or other materials provided with the
+   distribution.
+ - Neither the name of Analog Devices, Inc. nor the names of its
+   contributors may be used to endorse or promote products derived
+   from this software without specific prior written permission.
+ - The use of this software may or may not infringe the patent rights
+   of one or more patent holders.  This license does not release you
+   from the requirement that you obtain separate licenses from these
+   patent holders to use this software.
+ - Use of the software either in source or binary form, must be run
+   on or directly connected to an Analog Devices Inc. component.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*! @file
+    @ingroup LTC25XX_stream
+    Header for the LTC2508/LTC2512 timer driven MCLK and DRL streaming reader
+*/
+
+#ifndef LTC25XX_STREAM_H
+#define LTC25XX_STREAM_H
+
+#include <stdint.h>
+
+//! @name Timer driven MCLK and streaming reader
+//! MCLK is generated by Timer1 on OC1B, which is the QuikEval CS pin (Arduino pin 10) on the
+//! Linduino. Filtered output words are read in the DRL interrupt and queued in a ring buffer.
+//! DRL is not on the QuikEval connector; it must be wired to an external interrupt pin.
+//! The ring buffer size must be a power of 2.
+//! @{
+#define LTC25XX_MCLK_PERIOD_1MHZ       16      //!< Timer1 ticks per MCLK period for 1MHz at 16MHz F_CPU
+#define LTC25XX_MCLK_HIGH_TICKS        4       //!< Timer1 ticks MCLK is held high at the start of each period
+#define LTC25XX_SPI_BYTE_OVERHEAD      24      //!< CPU cycles spi_read() adds to each byte's 8 SCK periods
+#define LTC25XX_DRL_ISR_OVERHEAD       200     //!< CPU cycles of the DRL interrupt outside of spi_read()
+#ifndef LTC25XX_STREAM_BUFFER_SIZE
+#define LTC25XX_STREAM_BUFFER_SIZE     32
+#endif
+//! @}
+
+#if (LTC25XX_STREAM_BUFFER_SIZE & (LTC25XX_STREAM_BUFFER_SIZE - 1)) != 0
+#error "LTC25XX_STREAM_BUFFER_SIZE must be a power of 2"
+#endif
+
+//! Returns the shortest MCLK period, in Timer1 ticks, at which the DRL interrupt can read every
+//! output word at the current SPI clock before the next one replaces it. The interrupt may use
+//! at most 3/4 of each output word period, so the rest of the sketch keeps running.
+//! @return MCLK period in Timer1 ticks, never less than LTC25XX_MCLK_PERIOD_1MHZ
+uint16_t LTC25XX_min_mclk_period(uint16_t DF,          //!< Down-sampling factor the ADC is configured for
+                                 uint8_t word_bytes    //!< Bytes read per output word, including W7:W0
+                                );
+
+//! Starts continuous MCLK on the QuikEval CS pin using Timer1 hardware PWM. The period is
+//! clamped to LTC25XX_min_mclk_period(), so the SPI port must be configured first.
+//! @return The MCLK period used, in Timer1 ticks
+uint16_t LTC25XX_mclk_timer_start(uint16_t mclk_period,  //!< Requested MCLK period in Timer1 ticks (16 = 1MHz)
+                                  uint16_t DF,           //!< Down-sampling factor the ADC is configured for
+                                  uint8_t word_bytes     //!< Bytes read per output word, including W7:W0
+                                 );
+
+//! Stops the Timer1 MCLK and returns the pin to normal output, left low.
+void LTC25XX_mclk_timer_stop();
+
+//! Stops MCLK, sends a SYNC pulse to restart the digital filter, clears the ring buffer,
+//! then restarts MCLK from the beginning of a period so SYNC stays aligned with MCLK.
+void LTC25XX_sync(uint8_t sync_pin     //!< Pin connected to SYNC (QUIKEVAL_GPIO on the DC2222)
+                 );
+
+//! Attaches the DRL interrupt and starts queueing filtered output words.
+void LTC25XX_stream_start(uint8_t drl_pin,     //!< Pin connected to DRL, must support external interrupts
+                          uint8_t word_bytes   //!< Bytes read per output word, including W7:W0
+                         );
+
+//! Detaches the DRL interrupt. Words already in the ring buffer can still be read.
+void LTC25XX_stream_stop(uint8_t drl_pin    //!< Pin connected to DRL
+                        );
+
+//! Returns the number of filtered output words waiting in the ring buffer.
+uint8_t LTC25XX_stream_available();
+
+//! Removes the oldest filtered output word from the ring buffer.
+//! @return 0 if a word was returned, 1 if the buffer was empty
+uint8_t LTC25XX_stream_read(uint32_t *code,    //!< Returns the output code, without W7:W0
+                            uint8_t *config    //!< Returns the configuration word W7:W0
+                           );
+
+//! Returns the number of output words dropped, either because the ring buffer was full or
+//! because DRL fell again while a word was being read. A word interrupted that way is
+//! discarded together with the one that interrupted it, as both were clocked out partly.
+uint16_t LTC25XX_stream_overflows();
+
+#endif
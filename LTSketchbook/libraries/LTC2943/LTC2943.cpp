@@ -183,5 +183,118 @@ int8_t LTC2943_register_set_clear_bits(uint8_t i2c_address, uint8_t register_add
   return(ack);
 }
 
+// Converts the counts to uAh. The 96-bit product counts * scale is formed in two 64-bit halves.
+static int64_t LTC2943_accumulator_total(const LTC2943_accumulator *acc)
+{
+  uint64_t counts, product_lo, product_hi, total;
+
+  counts = (acc->counts < 0) ? -(uint64_t)acc->counts : (uint64_t)acc->counts;
+  product_lo = (uint64_t)(uint32_t)counts * acc->scale;
+  product_hi = (counts >> 32) * acc->scale;
+  if (acc->shift >= 32)
+    total = (product_hi + (product_lo >> 32)) >> (acc->shift - 32);
+  else
+    total = (product_hi << (32 - acc->shift)) + (product_lo >> acc->shift);
+  return(acc->base + ((acc->counts < 0) ? -(int64_t)total : (int64_t)total));
+}
+
+// Sets the charge scale and the update interval from the resistor and prescalar
+static void LTC2943_accumulator_set_scale(LTC2943_accumulator *acc)
+{
+  float lsb, interval;
+  uint8_t shift = 0;
+
+  lsb = 1000*LTC2943_code_to_mAh(1, acc->resistor, acc->prescalar);
+  while ((shift < 63) && (lsb < 2147483648.0))
+  {
+    lsb = lsb * 2;
+    shift++;
+  }
+  acc->scale = (uint32_t)lsb;
+  acc->shift = shift;
+
+  // At full scale current the register moves FULLSCALE_CURRENT*4096/(CHARGE_lsb*50E-3*prescalar*3600)
+  // counts per second whatever the resistor. Update before it has moved a quarter of its range.
+  interval = 16384E3*(LTC2943_CHARGE_lsb*50E-3*acc->prescalar*3600)/(LTC2943_FULLSCALE_CURRENT*4096);
+  if (interval > 2147483647.0)
+    interval = 2147483647.0;
+  acc->interval = (uint32_t)interval;
+}
+
+// Starts 64-bit accumulation from the current accumulated charge register
+int8_t LTC2943_accumulator_init(LTC2943_accumulator *acc, uint8_t i2c_address, float resistor, uint16_t prescalar)
+// The function returns the state of the acknowledge bit after the I2C address write. 0=acknowledge, 1=no acknowledge.
+{
+  int8_t ack;
+
+  memset(acc, 0, sizeof(LTC2943_accumulator));
+  acc->i2c_address = i2c_address;
+  acc->resistor = resistor;
+  acc->prescalar = prescalar;
+  LTC2943_accumulator_set_scale(acc);
+
+  ack = LTC2943_read_16_bits(i2c_address, LTC2943_ACCUM_CHARGE_MSB_REG, &acc->last);
+  acc->last_update = millis();
+  return(ack);
+}
+
+// Adds the change in the accumulated charge register since the last update
+int8_t LTC2943_accumulator_update(LTC2943_accumulator *acc)
+// The function returns the state of the acknowledge bit after the I2C address write. 0=acknowledge, 1=no acknowledge.
+{
+  int8_t ack;
+  uint16_t code;
+
+  ack = LTC2943_read_16_bits(acc->i2c_address, LTC2943_ACCUM_CHARGE_MSB_REG, &code);
+  if (ack)
+    return(ack);
 
+  acc->counts += (int16_t)(code - acc->last);
+  acc->last = code;
+  acc->last_update = millis();
+  return(ack);
+}
+
+// Changes the prescalar, converting the charge counted at the old one first
+int8_t LTC2943_accumulator_set_prescalar(LTC2943_accumulator *acc, uint16_t prescalar)
+// The function returns the state of the acknowledge bit after the I2C address write. 0=acknowledge, 1=no acknowledge.
+{
+  int8_t ack;
+  uint8_t prescalar_mode = LTC2943_PRESCALAR_M_1;
+  uint16_t m;
+
+  // Prescalar values step by 4, and the mode codes step by 0x08
+  for (m = 1; (m < prescalar) && (prescalar_mode < LTC2943_PRESCALAR_M_4096); m = m << 2)
+    prescalar_mode += LTC2943_PRESCALAR_M_4;
+
+  ack = LTC2943_accumulator_update(acc);
+  // The prescalar field is control register bits [5:3]
+  ack |= LTC2943_register_set_clear_bits(acc->i2c_address, LTC2943_CONTROL_REG, prescalar_mode, LTC2943_PRESCALAR_M_4096 | LTC2943_PRESCALAR_M_4);
+  acc->base = LTC2943_accumulator_total(acc);
+  acc->counts = 0;
+  acc->prescalar = m;
+  LTC2943_accumulator_set_scale(acc);
+  return(ack);
+}
+
+// Updates each accumulator whose interval has elapsed
+int8_t LTC2943_accumulator_service(LTC2943_accumulator *acc, uint8_t count)
+// The function returns the OR of the acknowledge bits of the updates made. 0=acknowledge, 1=no acknowledge.
+{
+  int8_t ack = 0;
+  uint8_t i;
+
+  for (i = 0; i < count; i++)
+  {
+    if ((uint32_t)(millis() - acc[i].last_update) >= acc[i].interval)
+      ack |= LTC2943_accumulator_update(&acc[i]);
+  }
+  return(ack);
+}
+
+// Returns the net charge in uAh
+int64_t LTC2943_accumulator_uAh(const LTC2943_accumulator *acc)
+{
+  return(LTC2943_accumulator_total(acc));
+}
 
@@ -273,4 +273,54 @@ float LTC2944_code_to_kelvin_temperature(uint16_t adc_code           //!< The RA
 float LTC2944_code_to_celcius_temperature(uint16_t adc_code          //!< The RAW ADC value
                                          );
 
+//! Charge accumulated from one LTC2944, extended to 64 bits.
+//! The 16-bit accumulated charge register is read as a signed change from the last update,
+//! so it must be updated before the charge moves by half its range. LTC2944_accumulator_service()
+//! does this for any number of gauges at the interval worked out for full scale current.
+typedef struct
+{
+  uint8_t i2c_address;          //!< I2C address of the LTC2944
+  float resistor;               //!< The sense resistor value
+  uint16_t prescalar;           //!< The prescalar value
+  uint16_t last;                //!< Accumulated charge register at the last update
+  int64_t counts;               //!< Counts accumulated since the prescalar was last set
+  int64_t base;                 //!< Charge converted at earlier prescalars, in uAh
+  uint32_t scale;               //!< uAh per count, times 2^shift
+  uint8_t shift;                //!< Binary point of scale
+  uint32_t interval;            //!< Longest time between updates that cannot miss a wrap, in ms
+  uint32_t last_update;         //!< millis() at the last update
+} LTC2944_accumulator;
+
+//! Starts 64-bit accumulation from the current accumulated charge register.
+//! @return The function returns the state of the acknowledge bit after the I2C address write. 0=acknowledge, 1=no acknowledge.
+int8_t LTC2944_accumulator_init(LTC2944_accumulator *acc,   //!< Accumulator to start
+                                uint8_t i2c_address,        //!< Register address for the LTC2944
+                                float resistor,             //!< The sense resistor value
+                                uint16_t prescalar          //!< The prescalar value the LTC2944 is running with
+                               );
+
+//! Reads the accumulated charge register and adds the change since the last update to the 64-bit total.
+//! Call LTC2944_accumulator_init() again after writing the accumulated charge register.
+//! @return The function returns the state of the acknowledge bit after the I2C address write. 0=acknowledge, 1=no acknowledge.
+int8_t LTC2944_accumulator_update(LTC2944_accumulator *acc  //!< Accumulator to update
+                                 );
+
+//! Changes the LTC2944 prescalar without losing charge. Counts taken at the old prescalar are
+//! converted before the new prescalar is written to the control register.
+//! @return The function returns the state of the acknowledge bit after the I2C address write. 0=acknowledge, 1=no acknowledge.
+int8_t LTC2944_accumulator_set_prescalar(LTC2944_accumulator *acc,  //!< Accumulator to rescale
+                                         uint16_t prescalar          //!< New prescalar value, 1 to 4096
+                                        );
+
+//! Updates every accumulator in the array whose interval has elapsed.
+//! @return The OR of the acknowledge bits of the updates made. 0=acknowledge, 1=no acknowledge.
+int8_t LTC2944_accumulator_service(LTC2944_accumulator *acc,  //!< Array of accumulators
+                                   uint8_t count              //!< Number of accumulators in the array
+                                  );
+
+//! Net charge since LTC2944_accumulator_init(), positive when charging
+//! @return Charge in uAh
+int64_t LTC2944_accumulator_uAh(const LTC2944_accumulator *acc //!< Accumulator to read
+                                );
+
 #endif  // LTC2944_H
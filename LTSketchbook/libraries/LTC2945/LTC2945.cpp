@@ -158,6 +158,46 @@ int8_t LTC2945_read_24_bits(uint8_t i2c_address, uint8_t adc_command, int32_t *a
   return(ack);
 }
 
+// Reads the LTC2945 register map into a snapshot
+int8_t LTC2945_read_snapshot(uint8_t i2c_address, LTC2945_snapshot *snapshot)
+// The function returns the state of the acknowledge bit after the I2C address write. 0=acknowledge, 1=no acknowledge.
+{
+  int8_t ack = 0;
+
+  snapshot->reg[LTC2945_FAULT_CoR_REG] = 0;
+  ack |= i2c_read_register_block(i2c_address, LTC2945_CONTROL_REG, LTC2945_FAULT_CoR_REG, snapshot->reg);
+  ack |= i2c_read_register_block(i2c_address, LTC2945_POWER_MSB2_REG, LTC2945_SNAPSHOT_SIZE - LTC2945_POWER_MSB2_REG, snapshot->reg + LTC2945_POWER_MSB2_REG);
+  return(ack);
+}
+
+// Combines length snapshot bytes, MSB first, starting at adc_command
+static uint32_t LTC2945_snapshot_code(const LTC2945_snapshot *snapshot, uint8_t adc_command, uint8_t length)
+{
+  uint32_t code = 0;
+
+  while (length--)
+    code = (code << 8) | snapshot->reg[adc_command++];
+  return(code);
+}
+
+// Extracts a 12-bit adc_code from a snapshot
+uint16_t LTC2945_snapshot_12_bits(const LTC2945_snapshot *snapshot, uint8_t adc_command)
+{
+  return(LTC2945_snapshot_code(snapshot, adc_command, 2) >> 4);
+}
+
+// Extracts a 16-bit adc_code from a snapshot
+uint16_t LTC2945_snapshot_16_bits(const LTC2945_snapshot *snapshot, uint8_t adc_command)
+{
+  return(LTC2945_snapshot_code(snapshot, adc_command, 2));
+}
+
+// Extracts a 24-bit adc_code from a snapshot
+uint32_t LTC2945_snapshot_24_bits(const LTC2945_snapshot *snapshot, uint8_t adc_command)
+{
+  return(LTC2945_snapshot_code(snapshot, adc_command, 3));
+}
+
 // Calculate the LTC2945 VIN voltage
 float LTC2945_VIN_code_to_voltage(uint16_t adc_code, float LTC2945_VIN_lsb)
 // Returns the VIN Voltage in Volts
@@ -435,4 +435,41 @@ float LTC2945_code_to_ADIN_power(int32_t adc_code,                      //!< The
                                  float resistor,                        //!< The resistor value
                                  float LTC2945_ADIN_DELTA_SENSE_lsb     //!< Power lsb weight
                                 );
+
+//! Number of registers held in a snapshot, LTC2945_CONTROL_REG through LTC2945_MIN_ADIN_THRESHOLD_LSB_REG (0x31)
+#define LTC2945_SNAPSHOT_SIZE 0x32
+
+//! Copy of the LTC2945 register map, read with LTC2945_read_snapshot().
+//! Registers are stored at their own address, so the *_REG defines index reg[] directly.
+//! LTC2945_FAULT_CoR_REG is skipped because reading it clears the faults; its byte reads as zero.
+typedef struct
+{
+  uint8_t reg[LTC2945_SNAPSHOT_SIZE];   //!< Register contents, indexed by register address
+} LTC2945_snapshot;
+
+//! Reads the LTC2945 register map into a snapshot with two auto-incrementing block reads,
+//! one either side of the clear-on-read fault register.
+//! @return The function returns the state of the acknowledge bit after the I2C address write. 0=acknowledge, 1=no acknowledge.
+int8_t LTC2945_read_snapshot(uint8_t i2c_address,         //!< Register address for the LTC2945
+                             LTC2945_snapshot *snapshot    //!< Snapshot that will be filled from the LTC2945
+                            );
+
+//! Extracts a 12-bit adc_code from a snapshot, as LTC2945_read_12_bits() would read it
+//! @return The 12-bit code starting at adc_command
+uint16_t LTC2945_snapshot_12_bits(const LTC2945_snapshot *snapshot,  //!< Snapshot read with LTC2945_read_snapshot()
+                                  uint8_t adc_command                //!< The "command byte" of the first register
+                                 );
+
+//! Extracts a 16-bit adc_code from a snapshot, as LTC2945_read_16_bits() would read it
+//! @return The 16-bit code starting at adc_command
+uint16_t LTC2945_snapshot_16_bits(const LTC2945_snapshot *snapshot,  //!< Snapshot read with LTC2945_read_snapshot()
+                                  uint8_t adc_command                //!< The "command byte" of the first register
+                                 );
+
+//! Extracts a 24-bit adc_code from a snapshot, as LTC2945_read_24_bits() would read it
+//! @return The 24-bit code starting at adc_command
+uint32_t LTC2945_snapshot_24_bits(const LTC2945_snapshot *snapshot,  //!< Snapshot read with LTC2945_read_snapshot()
+                                  uint8_t adc_command                //!< The "command byte" of the first register
+                                 );
+
 #endif  // LTC2945_H
@@ -190,6 +190,54 @@ int8_t LTC2946_read_32_bits(uint8_t i2c_address, uint8_t adc_command, uint32_t *
   return(ack);
 }
 
+// Reads the LTC2946 register map into a snapshot
+int8_t LTC2946_read_snapshot(uint8_t i2c_address, LTC2946_snapshot *snapshot)
+// The function returns the state of the acknowledge bit after the I2C address write. 0=acknowledge, 1=no acknowledge.
+{
+  int8_t ack = 0;
+
+  snapshot->reg[LTC2946_FAULT1_REG] = 0;
+  snapshot->reg[LTC2946_FAULT2_REG] = 0;
+  ack |= i2c_read_register_block(i2c_address, LTC2946_CTRLA_REG, LTC2946_FAULT1_REG, snapshot->reg);
+  ack |= i2c_read_register_block(i2c_address, LTC2946_POWER_MSB2_REG, LTC2946_FAULT2_REG - LTC2946_POWER_MSB2_REG, snapshot->reg + LTC2946_POWER_MSB2_REG);
+  ack |= i2c_read_register_block(i2c_address, LTC2946_GPIO3_CTRL_REG, LTC2946_SNAPSHOT_SIZE - LTC2946_GPIO3_CTRL_REG, snapshot->reg + LTC2946_GPIO3_CTRL_REG);
+  return(ack);
+}
+
+// Combines length snapshot bytes, MSB first, starting at adc_command
+static uint32_t LTC2946_snapshot_code(const LTC2946_snapshot *snapshot, uint8_t adc_command, uint8_t length)
+{
+  uint32_t code = 0;
+
+  while (length--)
+    code = (code << 8) | snapshot->reg[adc_command++];
+  return(code);
+}
+
+// Extracts a 12-bit adc_code from a snapshot
+uint16_t LTC2946_snapshot_12_bits(const LTC2946_snapshot *snapshot, uint8_t adc_command)
+{
+  return(LTC2946_snapshot_code(snapshot, adc_command, 2) >> 4);
+}
+
+// Extracts a 16-bit adc_code from a snapshot
+uint16_t LTC2946_snapshot_16_bits(const LTC2946_snapshot *snapshot, uint8_t adc_command)
+{
+  return(LTC2946_snapshot_code(snapshot, adc_command, 2));
+}
+
+// Extracts a 24-bit adc_code from a snapshot
+uint32_t LTC2946_snapshot_24_bits(const LTC2946_snapshot *snapshot, uint8_t adc_command)
+{
+  return(LTC2946_snapshot_code(snapshot, adc_command, 3));
+}
+
+// Extracts a 32-bit adc_code from a snapshot
+uint32_t LTC2946_snapshot_32_bits(const LTC2946_snapshot *snapshot, uint8_t adc_command)
+{
+  return(LTC2946_snapshot_code(snapshot, adc_command, 4));
+}
+
 // Calculate the LTC2946 VIN voltage
 float LTC2946_VIN_code_to_voltage(uint16_t adc_code, float LTC2946_VIN_lsb)
 // Returns the VIN Voltage in Volts
@@ -257,3 +305,170 @@ float LTC2946_code_to_time(float time_code, float LTC2946_TIME_lsb)
   return seconds;
 }
 
+// Converts an lsb in micro-units to a 32-bit fixed-point scale, keeping as many bits as possible
+static void LTC2946_counter_set_lsb(LTC2946_counter *counter, float lsb)
+{
+  uint8_t shift = 0;
+
+  if (lsb >= 4294967295.0)
+  {
+    counter->scale = 0xFFFFFFFF;
+    counter->shift = 0;
+    return;
+  }
+  while ((shift < 63) && (lsb < 2147483648.0))
+  {
+    lsb = lsb * 2;
+    shift++;
+  }
+  counter->scale = (uint32_t)lsb;
+  counter->shift = shift;
+}
+
+// Converts the counts to micro-units. The 96-bit product counts * scale is formed in two 64-bit halves.
+static uint64_t LTC2946_counter_total(const LTC2946_counter *counter)
+{
+  uint64_t product_lo, product_hi;
+
+  product_lo = (uint64_t)(uint32_t)counter->counts * counter->scale;
+  product_hi = (counter->counts >> 32) * counter->scale;
+  if (counter->shift >= 32)
+    return(counter->base + ((product_hi + (product_lo >> 32)) >> (counter->shift - 32)));
+  return(counter->base + (product_hi << (32 - counter->shift)) + (product_lo >> counter->shift));
+}
+
+// Converts the counts taken so far into the base before the scale is changed
+static void LTC2946_counter_fold(LTC2946_counter *counter)
+{
+  counter->base = LTC2946_counter_total(counter);
+  counter->counts = 0;
+}
+
+// Adds the change in a 32-bit register to the 64-bit count
+static void LTC2946_counter_add(LTC2946_counter *counter, uint32_t code, uint8_t reset)
+{
+  if (reset)
+    counter->counts += code;
+  else
+    counter->counts += (uint32_t)(code - counter->last);
+  counter->last = code;
+}
+
+// Sets the energy, charge and time scales and the update interval from the lsb values
+static void LTC2946_accumulator_set_scale(LTC2946_accumulator *acc, float LTC2946_TIME_lsb)
+{
+  float interval;
+
+  LTC2946_counter_set_lsb(&acc->energy, LTC2946_code_to_energy(1, acc->resistor, acc->power_lsb, LTC2946_TIME_lsb)*1E6/3600);
+  LTC2946_counter_set_lsb(&acc->charge, LTC2946_code_to_coulombs(1, acc->resistor, acc->delta_sense_lsb, LTC2946_TIME_lsb)*1E6/3600);
+  LTC2946_counter_set_lsb(&acc->time, LTC2946_TIME_lsb*1E3);
+
+  // ENERGY and CHARGE grow by at most 256 counts per time lsb, so 2^23 time lsbs
+  // fill half of their 32-bit range.
+  interval = LTC2946_TIME_lsb*1E3*8388608;
+  if (interval > 2147483647.0)
+    interval = 2147483647.0;
+  acc->interval = (uint32_t)interval;
+}
+
+// Reads ENERGY, CHARGE and TIME_COUNTER with one block read
+static int8_t LTC2946_accumulator_read(uint8_t i2c_address, uint32_t *energy, uint32_t *charge, uint32_t *time)
+{
+  int8_t ack;
+  uint8_t data[12];
+
+  // TIME_COUNTER in data[0..3], CHARGE in data[4..7], ENERGY in data[8..11], MSB first
+  ack = i2c_read_register_block(i2c_address, LTC2946_TIME_COUNTER_MSB3_REG, (uint8_t) 12, data);
+  *time = ((uint32_t)data[0] << 24) | ((uint32_t)data[1] << 16) | ((uint32_t)data[2] << 8) | data[3];
+  *charge = ((uint32_t)data[4] << 24) | ((uint32_t)data[5] << 16) | ((uint32_t)data[6] << 8) | data[7];
+  *energy = ((uint32_t)data[8] << 24) | ((uint32_t)data[9] << 16) | ((uint32_t)data[10] << 8) | data[11];
+  return(ack);
+}
+
+// Starts 64-bit accumulation from the current ENERGY, CHARGE and TIME_COUNTER registers
+int8_t LTC2946_accumulator_init(LTC2946_accumulator *acc, uint8_t i2c_address, float resistor, float LTC2946_Power_lsb, float LTC2946_DELTA_SENSE_lsb, float LTC2946_TIME_lsb)
+// The function returns the state of the acknowledge bit after the I2C address write. 0=acknowledge, 1=no acknowledge.
+{
+  int8_t ack;
+
+  memset(acc, 0, sizeof(LTC2946_accumulator));
+  acc->i2c_address = i2c_address;
+  acc->resistor = resistor;
+  acc->power_lsb = LTC2946_Power_lsb;
+  acc->delta_sense_lsb = LTC2946_DELTA_SENSE_lsb;
+  LTC2946_accumulator_set_scale(acc, LTC2946_TIME_lsb);
+
+  ack = LTC2946_accumulator_read(i2c_address, &acc->energy.last, &acc->charge.last, &acc->time.last);
+  acc->last_update = millis();
+  return(ack);
+}
+
+// Adds the change in the accumulator registers since the last update
+int8_t LTC2946_accumulator_update(LTC2946_accumulator *acc)
+// The function returns the state of the acknowledge bit after the I2C address write. 0=acknowledge, 1=no acknowledge.
+{
+  int8_t ack;
+  uint8_t reset;
+  uint32_t energy, charge, time;
+
+  ack = LTC2946_accumulator_read(acc->i2c_address, &energy, &charge, &time);
+  if (ack)
+    return(ack);
+
+  // Between updates the time counter moves forward by far less than half its range.
+  // Anything more means it went backwards: the accumulators were reset and everything
+  // in them is new.
+  reset = ((uint32_t)(time - acc->time.last) >= 0x80000000);
+  LTC2946_counter_add(&acc->energy, energy, reset);
+  LTC2946_counter_add(&acc->charge, charge, reset);
+  LTC2946_counter_add(&acc->time, time, reset);
+  acc->last_update = millis();
+  return(ack);
+}
+
+// Rescales the accumulator for a new time lsb
+int8_t LTC2946_accumulator_set_time_lsb(LTC2946_accumulator *acc, float LTC2946_TIME_lsb)
+// The function returns the state of the acknowledge bit after the I2C address write. 0=acknowledge, 1=no acknowledge.
+{
+  int8_t ack;
+
+  ack = LTC2946_accumulator_update(acc);
+  LTC2946_counter_fold(&acc->energy);
+  LTC2946_counter_fold(&acc->charge);
+  LTC2946_counter_fold(&acc->time);
+  LTC2946_accumulator_set_scale(acc, LTC2946_TIME_lsb);
+  return(ack);
+}
+
+// Updates each accumulator whose interval has elapsed
+int8_t LTC2946_accumulator_service(LTC2946_accumulator *acc, uint8_t count)
+// The function returns the OR of the acknowledge bits of the updates made. 0=acknowledge, 1=no acknowledge.
+{
+  int8_t ack = 0;
+  uint8_t i;
+
+  for (i = 0; i < count; i++)
+  {
+    if ((uint32_t)(millis() - acc[i].last_update) >= acc[i].interval)
+      ack |= LTC2946_accumulator_update(&acc[i]);
+  }
+  return(ack);
+}
+
+// Returns the total energy in uWh
+uint64_t LTC2946_accumulator_uWh(const LTC2946_accumulator *acc)
+{
+  return(LTC2946_counter_total(&acc->energy));
+}
+
+// Returns the total charge in uAh
+uint64_t LTC2946_accumulator_uAh(const LTC2946_accumulator *acc)
+{
+  return(LTC2946_counter_total(&acc->charge));
+}
+
+// Returns the total time in ms
+uint64_t LTC2946_accumulator_ms(const LTC2946_accumulator *acc)
+{
+  return(LTC2946_counter_total(&acc->time));
+}
@@ -682,4 +682,120 @@ float LTC2946_code_to_time(float time_code,             //!< Time adc code
                           );
 
 
+//! Number of registers held in a snapshot, LTC2946_CTRLA_REG through LTC2946_CLK_DIV_REG (0x43)
+#define LTC2946_SNAPSHOT_SIZE 0x44
+
+//! Copy of the LTC2946 register map, read with LTC2946_read_snapshot().
+//! Registers are stored at their own address, so the *_REG defines index reg[] directly.
+//! LTC2946_FAULT1_REG and LTC2946_FAULT2_REG are skipped because reading them can clear the
+//! faults (CTRLB cleared-on-read); their bytes read as zero.
+typedef struct
+{
+  uint8_t reg[LTC2946_SNAPSHOT_SIZE];   //!< Register contents, indexed by register address
+} LTC2946_snapshot;
+
+//! Reads the LTC2946 register map into a snapshot with three auto-incrementing block reads,
+//! around the two fault registers.
+//! @return The function returns the state of the acknowledge bit after the I2C address write. 0=acknowledge, 1=no acknowledge.
+int8_t LTC2946_read_snapshot(uint8_t i2c_address,         //!< Register address for the LTC2946
+                             LTC2946_snapshot *snapshot    //!< Snapshot that will be filled from the LTC2946
+                            );
+
+//! Extracts a 12-bit adc_code from a snapshot, as LTC2946_read_12_bits() would read it
+//! @return The 12-bit code starting at adc_command
+uint16_t LTC2946_snapshot_12_bits(const LTC2946_snapshot *snapshot,  //!< Snapshot read with LTC2946_read_snapshot()
+                                  uint8_t adc_command                //!< The "command byte" of the first register
+                                 );
+
+//! Extracts a 16-bit adc_code from a snapshot, as LTC2946_read_16_bits() would read it
+//! @return The 16-bit code starting at adc_command
+uint16_t LTC2946_snapshot_16_bits(const LTC2946_snapshot *snapshot,  //!< Snapshot read with LTC2946_read_snapshot()
+                                  uint8_t adc_command                //!< The "command byte" of the first register
+                                 );
+
+//! Extracts a 24-bit adc_code from a snapshot, as LTC2946_read_24_bits() would read it
+//! @return The 24-bit code starting at adc_command
+uint32_t LTC2946_snapshot_24_bits(const LTC2946_snapshot *snapshot,  //!< Snapshot read with LTC2946_read_snapshot()
+                                  uint8_t adc_command                //!< The "command byte" of the first register
+                                 );
+
+//! Extracts a 32-bit adc_code from a snapshot, as LTC2946_read_32_bits() would read it
+//! @return The 32-bit code starting at adc_command
+uint32_t LTC2946_snapshot_32_bits(const LTC2946_snapshot *snapshot,  //!< Snapshot read with LTC2946_read_snapshot()
+                                  uint8_t adc_command                //!< The "command byte" of the first register
+                                 );
+
+//! One LTC2946 accumulator register extended to 64 bits
+typedef struct
+{
+  uint32_t last;        //!< Register contents at the last update
+  uint64_t counts;      //!< Counts accumulated since the scale was last set
+  uint64_t base;        //!< Total converted at earlier scales, in micro-units
+  uint32_t scale;       //!< Micro-units per count, times 2^shift
+  uint8_t shift;        //!< Binary point of scale
+} LTC2946_counter;
+
+//! Energy, charge and time accumulated from one LTC2946.
+//! The 32-bit ENERGY, CHARGE and TIME_COUNTER registers are read together and extended to 64 bits,
+//! so the totals survive register wrap-around as long as LTC2946_accumulator_update() is called
+//! at least once every interval milliseconds.
+typedef struct
+{
+  uint8_t i2c_address;          //!< I2C address of the LTC2946
+  float resistor;               //!< Sense resistor value
+  float power_lsb;              //!< Power lsb in W
+  float delta_sense_lsb;        //!< Delta sense lsb in V
+  LTC2946_counter energy;       //!< ENERGY register, converted to uWh
+  LTC2946_counter charge;       //!< CHARGE register, converted to uAh
+  LTC2946_counter time;         //!< TIME_COUNTER register, converted to ms
+  uint32_t interval;            //!< Longest time between updates that cannot miss a wrap, in ms
+  uint32_t last_update;         //!< millis() at the last update
+} LTC2946_accumulator;
+
+//! Starts 64-bit accumulation from the current ENERGY, CHARGE and TIME_COUNTER registers.
+//! @return The function returns the state of the acknowledge bit after the I2C address write. 0=acknowledge, 1=no acknowledge.
+int8_t LTC2946_accumulator_init(LTC2946_accumulator *acc,      //!< Accumulator to start
+                                uint8_t i2c_address,           //!< Register address for the LTC2946
+                                float resistor,                //!< The resistor value
+                                float LTC2946_Power_lsb,       //!< Power lsb
+                                float LTC2946_DELTA_SENSE_lsb, //!< Delta sense lsb
+                                float LTC2946_TIME_lsb         //!< Time lsb
+                               );
+
+//! Reads the accumulator registers and adds the change since the last update to the 64-bit totals.
+//! A time counter that has gone backwards is taken as an accumulator reset, so accumulators may be
+//! cleared through CTRLB at any time without losing what was counted up to the last update.
+//! @return The function returns the state of the acknowledge bit after the I2C address write. 0=acknowledge, 1=no acknowledge.
+int8_t LTC2946_accumulator_update(LTC2946_accumulator *acc  //!< Accumulator to update
+                                 );
+
+//! Changes the time lsb after the LTC2946 clock or CLK_DIV has been changed.
+//! Counts taken at the old time base are converted before the new scale is applied.
+//! @return The function returns the state of the acknowledge bit after the I2C address write. 0=acknowledge, 1=no acknowledge.
+int8_t LTC2946_accumulator_set_time_lsb(LTC2946_accumulator *acc, //!< Accumulator to rescale
+                                        float LTC2946_TIME_lsb    //!< New time lsb
+                                       );
+
+//! Updates every accumulator in the array whose interval has elapsed.
+//! Call this from loop() to keep any number of LTC2946s on the bus from wrapping.
+//! @return The OR of the acknowledge bits of the updates made. 0=acknowledge, 1=no acknowledge.
+int8_t LTC2946_accumulator_service(LTC2946_accumulator *acc,  //!< Array of accumulators
+                                   uint8_t count              //!< Number of accumulators in the array
+                                  );
+
+//! Total energy since LTC2946_accumulator_init()
+//! @return Energy in uWh
+uint64_t LTC2946_accumulator_uWh(const LTC2946_accumulator *acc //!< Accumulator to read
+                                );
+
+//! Total charge since LTC2946_accumulator_init()
+//! @return Charge in uAh
+uint64_t LTC2946_accumulator_uAh(const LTC2946_accumulator *acc //!< Accumulator to read
+                                );
+
+//! Time counted by the LTC2946 since LTC2946_accumulator_init()
+//! @return Time in ms
+uint64_t LTC2946_accumulator_ms(const LTC2946_accumulator *acc  //!< Accumulator to read
+                               );
+
 #endif  // LTC2946_H
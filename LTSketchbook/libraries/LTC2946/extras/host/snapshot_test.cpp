@@ -0,0 +1,382 @@
+/*
+Host test for the I2C power monitor register snapshots.
+
+NOT AN ARDUINO SKETCH.  This program builds LTC2945, LTC2946, LTC2947,
+LTC2992 and LTC4282 with g++ against Utilities/host_stubs and replaces the
+LT_I2C routines with a simulated register-file device.  The device
+auto-increments its register pointer, counts bus transactions and bytes, and
+can mark registers as clear-on-read.
+
+For 100 random register maps per part, every <part>_snapshot_N_bits() decode
+must match the matching <part>_read_N_bits(), the LTC2945, LTC2946 and
+LTC2947 snapshots must never read their clear-on-read registers, and each snapshot
+must take the expected number of transactions.  The DC2156 (LTC2946) and
+DC2024A (LTC4282) continuous-mode refresh is done both ways and the bus
+cost is printed.
+
+  make
+  ./snapshot_test
+
+Copyright 2018(c) Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in
+   the documentation and/or other materials provided with the
+   distribution.
+ - Neither the name of Analog Devices, Inc. nor the names of its
+   contributors may be used to endorse or promote products derived
+   from this software without specific prior written permission.
+ - The use of this software may or may not infringe the patent rights
+   of one or more patent holders.  This license does not release you
+   from the requirement that you obtain separate licenses from these
+   patent holders to use this software.
+ - Use of the software either in source or binary form, must be run
+   on or directly connected to an Analog Devices Inc. component.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "LT_I2C.h"
+#include "LTC2945.h"
+#include "LTC2946.h"
+#include "LTC2947.h"
+#include "LTC2992.h"
+#include "LTC4282.h"
+
+#define ROUNDS  100
+
+// Simulated register-file device
+static uint8_t regs[256];
+static bool cor_reg[256];       // Clear-on-read registers
+static int transactions;
+static int bus_bytes;
+static int cor_reads;
+static int failures;
+
+#define CHECK(c) do { if (!(c)) { printf("FAIL line %d: %s\n", __LINE__, #c); failures++; } } while (0)
+
+static uint8_t sim_read(uint8_t reg)
+{
+  if (cor_reg[reg])
+    cor_reads++;
+  bus_bytes++;
+  return regs[reg];
+}
+
+static void sim_fill()
+{
+  for (int i = 0; i < 256; i++)
+    regs[i] = rand();
+}
+
+static void sim_reset()
+{
+  transactions = 0;
+  bus_bytes = 0;
+  cor_reads = 0;
+}
+
+// Each register access costs the address, the command and a repeated start
+// address on top of the data bytes.  i2c_read_block_data() fills the array
+// last to first and i2c_read_register_block() first to last, like LT_I2C.
+int8_t i2c_read_byte_data(uint8_t, uint8_t command, uint8_t *value)
+{
+  transactions++;
+  bus_bytes += 3;
+  *value = sim_read(command);
+  return 0;
+}
+
+int8_t i2c_read_word_data(uint8_t, uint8_t command, uint16_t *value)
+{
+  transactions++;
+  bus_bytes += 3;
+  *value = sim_read(command) << 8;
+  *value |= sim_read(command + 1);
+  return 0;
+}
+
+int8_t i2c_read_block_data(uint8_t, uint8_t command, uint8_t length, uint8_t *values)
+{
+  transactions++;
+  bus_bytes += 3;
+  for (int i = length - 1; i >= 0; i--)
+    values[i] = sim_read(command++);
+  return 0;
+}
+
+int8_t i2c_read_register_block(uint8_t, uint8_t command, uint8_t length, uint8_t *values)
+{
+  transactions++;
+  bus_bytes += 3;
+  for (int i = 0; i < length; i++)
+    values[i] = sim_read(command++);
+  return 0;
+}
+
+int8_t i2c_write_byte_data(uint8_t, uint8_t, uint8_t)
+{
+  return 0;
+}
+
+int8_t i2c_write_word_data(uint8_t, uint8_t, uint16_t)
+{
+  return 0;
+}
+
+int8_t i2c_write_block_data(uint8_t, uint8_t, uint8_t, uint8_t *)
+{
+  return 0;
+}
+
+// Low level calls used by LTC2947_I2CRdBlock().  A transaction is counted
+// at the write address, so the repeated start for the read phase is free.
+static int i2c_state;
+static uint8_t i2c_pointer;
+
+int8_t i2c_start()
+{
+  i2c_state = 0;
+  return 0;
+}
+
+int8_t i2c_repeated_start()
+{
+  i2c_state = 0;
+  return 0;
+}
+
+void i2c_stop() {}
+
+int8_t i2c_write(uint8_t data)
+{
+  if (i2c_state == 0)
+  {
+    if (!(data & 1))
+      transactions++;
+    i2c_state = (data & 1) ? 2 : 1;
+    bus_bytes++;
+  }
+  else if (i2c_state == 1)
+  {
+    i2c_pointer = data;
+    i2c_state = 3;
+    bus_bytes++;
+  }
+  return 0;
+}
+
+uint8_t i2c_read(int8_t)
+{
+  return sim_read(i2c_pointer++);
+}
+
+// DC2156 continuous mode: power, current, voltages, ADIN with their min and
+// max, the accumulators and the VIN threshold.  FAULT1 and FAULT2 clear on
+// read when CTRLB enables it, so the snapshot skips them.
+static void test_ltc2946()
+{
+  const uint8_t r24[] = {LTC2946_POWER_MSB2_REG, LTC2946_MAX_POWER_MSB2_REG, LTC2946_MIN_POWER_MSB2_REG};
+  const uint8_t r12[] = {LTC2946_DELTA_SENSE_MSB_REG, LTC2946_MAX_DELTA_SENSE_MSB_REG, LTC2946_MIN_DELTA_SENSE_MSB_REG,
+                         LTC2946_VIN_MSB_REG, LTC2946_MAX_VIN_MSB_REG, LTC2946_MIN_VIN_MSB_REG,
+                         LTC2946_ADIN_MSB_REG, LTC2946_MAX_ADIN_MSB_REG, LTC2946_MIN_ADIN_MSB_REG
+                        };
+  const uint8_t r32[] = {LTC2946_ENERGY_MSB3_REG, LTC2946_CHARGE_MSB3_REG, LTC2946_TIME_COUNTER_MSB3_REG};
+
+  for (int round = 0; round < ROUNDS; round++)
+  {
+    uint32_t a24[3], a32[3];
+    uint16_t a12[9], a16;
+    LTC2946_snapshot snap;
+
+    sim_fill();
+    sim_reset();
+    for (int i = 0; i < 3; i++)
+      LTC2946_read_24_bits(0x6F, r24[i], &a24[i]);
+    for (int i = 0; i < 9; i++)
+      LTC2946_read_12_bits(0x6F, r12[i], &a12[i]);
+    for (int i = 0; i < 3; i++)
+      LTC2946_read_32_bits(0x6F, r32[i], &a32[i]);
+    LTC2946_read_16_bits(0x6F, LTC2946_MAX_VIN_THRESHOLD_MSB_REG, &a16);
+    int old_transactions = transactions;
+    int old_bytes = bus_bytes;
+
+    sim_reset();
+    cor_reg[LTC2946_FAULT1_REG] = true;
+    cor_reg[LTC2946_FAULT2_REG] = true;
+    CHECK(LTC2946_read_snapshot(0x6F, &snap) == 0);
+    cor_reg[LTC2946_FAULT1_REG] = false;
+    cor_reg[LTC2946_FAULT2_REG] = false;
+    CHECK(transactions == 3);
+    CHECK(cor_reads == 0);
+    CHECK(snap.reg[LTC2946_FAULT1_REG] == 0 && snap.reg[LTC2946_FAULT2_REG] == 0);
+    for (int i = 0; i < 3; i++)
+      CHECK(LTC2946_snapshot_24_bits(&snap, r24[i]) == a24[i]);
+    for (int i = 0; i < 9; i++)
+      CHECK(LTC2946_snapshot_12_bits(&snap, r12[i]) == a12[i]);
+    for (int i = 0; i < 3; i++)
+      CHECK(LTC2946_snapshot_32_bits(&snap, r32[i]) == a32[i]);
+    CHECK(LTC2946_snapshot_16_bits(&snap, LTC2946_MAX_VIN_THRESHOLD_MSB_REG) == a16);
+    for (int i = 0; i < LTC2946_SNAPSHOT_SIZE; i++)
+      if (i != LTC2946_FAULT1_REG && i != LTC2946_FAULT2_REG)
+        CHECK(snap.reg[i] == regs[i]);
+    if (round == 0)
+      printf("LTC2946 refresh: %d transactions, %d bus bytes -> %d transactions, %d bus bytes\n",
+             old_transactions, old_bytes, transactions, bus_bytes);
+  }
+}
+
+// DC2024A continuous mode: the four measurements with their min and max,
+// the alert log, the tick counter and the meter.
+static void test_ltc4282()
+{
+  const uint8_t r16[] = {LTC4282_VSOURCE_MSB_REG, LTC4282_VSOURCE_MAX_MSB_REG, LTC4282_VSOURCE_MIN_MSB_REG,
+                         LTC4282_VGPIO_MSB_REG, LTC4282_VGPIO_MAX_MSB_REG, LTC4282_VGPIO_MIN_MSB_REG,
+                         LTC4282_VSENSE_MSB_REG, LTC4282_VSENSE_MAX_MSB_REG, LTC4282_VSENSE_MIN_MSB_REG,
+                         LTC4282_POWER_MSB_REG, LTC4282_POWER_MAX_MSB_REG, LTC4282_POWER_MIN_MSB_REG
+                        };
+
+  for (int round = 0; round < ROUNDS; round++)
+  {
+    uint16_t a16[12];
+    uint32_t ticks;
+    uint64_t meter;
+    uint8_t log;
+    LTC4282_snapshot snap;
+
+    sim_fill();
+    sim_reset();
+    LTC4282_read(0x41, LTC4282_ADC_ALERT_LOG_REG, &log);
+    for (int i = 0; i < 12; i++)
+      LTC4282_read_16_bits(0x41, r16[i], &a16[i]);
+    LTC4282_read_32_bits(0x41, LTC4282_TICK_COUNTER_MSB3_REG, &ticks);
+    LTC4282_read_48_bits(0x41, LTC4282_METER_MSB5_REG, &meter);
+    int old_transactions = transactions;
+    int old_bytes = bus_bytes;
+
+    sim_reset();
+    CHECK(LTC4282_read_snapshot(0x41, &snap) == 0);
+    CHECK(transactions == 1);
+    CHECK(snap.reg[LTC4282_ADC_ALERT_LOG_REG] == log);
+    for (int i = 0; i < 12; i++)
+      CHECK(LTC4282_snapshot_16_bits(&snap, r16[i]) == a16[i]);
+    CHECK(LTC4282_snapshot_32_bits(&snap, LTC4282_TICK_COUNTER_MSB3_REG) == ticks);
+    CHECK(LTC4282_snapshot_48_bits(&snap, LTC4282_METER_MSB5_REG) == meter);
+    if (round == 0)
+      printf("LTC4282 refresh: %d transactions, %d bus bytes -> %d transaction, %d bus bytes\n",
+             old_transactions, old_bytes, transactions, bus_bytes);
+  }
+}
+
+// The fault register clears on read, so the snapshot skips it.
+static void test_ltc2945()
+{
+  cor_reg[LTC2945_FAULT_CoR_REG] = true;
+  for (int round = 0; round < ROUNDS; round++)
+  {
+    LTC2945_snapshot snap;
+    uint16_t vin;
+    int32_t power;
+
+    sim_fill();
+    sim_reset();
+    CHECK(LTC2945_read_snapshot(0x6F, &snap) == 0);
+    CHECK(transactions == 2);
+    CHECK(cor_reads == 0);
+    CHECK(snap.reg[LTC2945_FAULT_CoR_REG] == 0);
+    for (int i = 0; i < LTC2945_SNAPSHOT_SIZE; i++)
+      if (i != LTC2945_FAULT_CoR_REG)
+        CHECK(snap.reg[i] == regs[i]);
+    LTC2945_read_12_bits(0x6F, LTC2945_VIN_MSB_REG, &vin);
+    CHECK(LTC2945_snapshot_12_bits(&snap, LTC2945_VIN_MSB_REG) == vin);
+    LTC2945_read_24_bits(0x6F, LTC2945_MAX_POWER_MSB2_REG, &power);
+    CHECK(LTC2945_snapshot_24_bits(&snap, LTC2945_MAX_POWER_MSB2_REG) == (uint32_t)power);
+  }
+  cor_reg[LTC2945_FAULT_CoR_REG] = false;
+}
+
+// Both channels and the sums.
+static void test_ltc2992()
+{
+  const uint8_t r12[] = {LTC2992_SENSE1_MSB_REG, LTC2992_DELTA_SENSE2_MSB_REG, LTC2992_GPIO4_MSB_REG, LTC2992_MIN_ISUM_MSB_REG};
+  const uint8_t r24[] = {LTC2992_POWER1_MSB2_REG, LTC2992_MAX_POWER2_MSB2_REG, LTC2992_PSUM_MSB1_REG};
+
+  for (int round = 0; round < ROUNDS; round++)
+  {
+    LTC2992_snapshot snap;
+
+    sim_fill();
+    sim_reset();
+    CHECK(LTC2992_read_snapshot(0x6F, &snap) == 0);
+    CHECK(transactions == 1);
+    for (int i = 0; i < 4; i++)
+    {
+      uint16_t value;
+      LTC2992_read_12_bits(0x6F, r12[i], &value);
+      CHECK(LTC2992_snapshot_12_bits(&snap, r12[i]) == value);
+    }
+    for (int i = 0; i < 3; i++)
+    {
+      uint32_t value;
+      LTC2992_read_24_bits(0x6F, r24[i], &value);
+      CHECK(LTC2992_snapshot_24_bits(&snap, r24[i]) == value);
+    }
+  }
+}
+
+// LTC2947 over I2C.  The STATUS register clears on read and is not part of
+// the snapshot.
+static void test_ltc2947()
+{
+  LTC2947_InitI2C(0x5C);
+  cor_reg[LTC2947_REG_STATUS] = true;
+  for (int round = 0; round < ROUNDS; round++)
+  {
+    LTC2947_Snapshot snap;
+    float current, power, voltage, temperature, vcc;
+
+    sim_fill();
+    sim_reset();
+    CHECK(LTC2947_Read_Snapshot(&snap) == 0);
+    CHECK(transactions == 2);
+    CHECK(cor_reads == 0);
+    LTC2947_Read_I_P_V_TEMP_VCC(&current, &power, &voltage, &temperature, &vcc);
+    CHECK((float)(LTC2947_3BytesToInt32(LTC2947_Snapshot_Bytes(&snap, LTC2947_VAL_I)) * LTC2947_LSB_I * 1e-3) == current);
+    CHECK((float)(LTC2947_2BytesToInt16(LTC2947_Snapshot_Bytes(&snap, LTC2947_VAL_VDVCC)) * LTC2947_LSB_VDVCC * 1e-3) == vcc);
+    CHECK(memcmp(LTC2947_Snapshot_Bytes(&snap, LTC2947_VAL_TB2), &regs[LTC2947_VAL_TB2], 4) == 0);
+    CHECK(memcmp(LTC2947_Snapshot_Bytes(&snap, LTC2947_VAL_VDVCCMIN), &regs[LTC2947_VAL_VDVCCMIN], 2) == 0);
+    CHECK(LTC2947_Snapshot_Bytes(&snap, LTC2947_REG_STATUS) == NULL);
+    CHECK(LTC2947_Snapshot_Bytes(&snap, 0xA6) == NULL);
+  }
+  cor_reg[LTC2947_REG_STATUS] = false;
+}
+
+int main()
+{
+  srand(47);
+  test_ltc2946();
+  test_ltc4282();
+  test_ltc2945();
+  test_ltc2992();
+  test_ltc2947();
+  printf(failures ? "FAILED (%d checks)\n" : "PASSED\n", failures);
+  return failures != 0;
+}
@@ -668,3 +668,23 @@ void LTC2947_Read_C_E_TB(boolean accuSet1, double *C, double *E, double *TB)
   // calc time in seconds
   *TB = LTC2947_4BytesToUInt32(bytes + 6 + 6) * LTC2947_LSB_TB1;
 }
+
+int8_t LTC2947_Read_Snapshot(LTC2947_Snapshot *snapshot)
+{
+  int8_t ret;
+
+  // C1[47:0] E1[47:0] TB1[31:0] C2[47:0] E2[47:0] TB2[31:0] and the min/max tracking registers
+  ret = LTC2947_RD_BYTES(LTC2947_VAL_C1, LTC2947_SNAPSHOT_ACCU_SIZE, snapshot->accu);
+  // I[23:0] P[23:0] V[15:0] TEMP[15:0] VDVCC[15:0]
+  ret |= LTC2947_RD_BYTES(LTC2947_VAL_I, LTC2947_SNAPSHOT_MEAS_SIZE, snapshot->meas);
+  return ret;
+}
+
+uint8_t *LTC2947_Snapshot_Bytes(LTC2947_Snapshot *snapshot, uint8_t address)
+{
+  if (address < LTC2947_SNAPSHOT_ACCU_SIZE)
+    return snapshot->accu + address;
+  if (address >= LTC2947_VAL_I && address < LTC2947_VAL_I + LTC2947_SNAPSHOT_MEAS_SIZE)
+    return snapshot->meas + (address - LTC2947_VAL_I);
+  return NULL;
+}
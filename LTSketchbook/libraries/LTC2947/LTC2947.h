@@ -1440,6 +1440,36 @@ void LTC2947_Read_C_E_TB(
   double *TB      //!< Time in s
 );
 
+//! Size of the accumulator and tracking block of a snapshot (C1 at 0x00 through VDVCCMIN at 0x5B)
+#define LTC2947_SNAPSHOT_ACCU_SIZE 0x5C
+//! Size of the measurement block of a snapshot (I at 0x90 through VDVCC at 0xA5)
+#define LTC2947_SNAPSHOT_MEAS_SIZE 0x16
+
+//! Copy of LTC2947's page 0 results taken by LTC2947_Read_Snapshot.
+//! The STAT* registers are not included because reading them clears them.
+typedef struct
+{
+  uint8_t accu[LTC2947_SNAPSHOT_ACCU_SIZE]; //!< C1, E1, TB1, C2, E2, TB2 and the min/max tracking registers, addresses 0x00 to 0x5B
+  uint8_t meas[LTC2947_SNAPSHOT_MEAS_SIZE]; //!< I, P, V, TEMP and VDVCC, addresses 0x90 to 0xA5
+} LTC2947_Snapshot;
+
+//! Reads accumulators, min/max tracking and the latest measurements from the device
+//! with two block transfers instead of one transfer per quantity.
+//! Make sure LTC2947's page 0 is selected before calling this function.
+//! Use LTC2947_SetPageSelect to change page if necessary
+//! @return 0 if successful, 1 if not successful
+int8_t LTC2947_Read_Snapshot(
+  LTC2947_Snapshot *snapshot //!< Snapshot to be filled
+);
+
+//! Locates a page 0 value inside a snapshot, e.g.
+//! LTC2947_3BytesToInt32(LTC2947_Snapshot_Bytes(&snapshot, LTC2947_VAL_I))
+//! @return Pointer to the MSB of the value at address, or NULL if the snapshot does not hold it
+uint8_t *LTC2947_Snapshot_Bytes(
+  LTC2947_Snapshot *snapshot, //!< Snapshot read with LTC2947_Read_Snapshot
+  uint8_t address             //!< Page 0 address of the value (LTC2947_VAL_*)
+);
+
 //! read single byte from SPI interface
 //! @return always 0
 int8_t LTC2947_SpiRdByte(
@@ -0,0 +1,284 @@
+/*!
+LTC294X Scheduler: Polls any number of LTC2941/LTC2942/LTC2943/LTC2944 Battery Gas Gauges.
+
+@verbatim
+
+A sweep writes each gauge's control register to start a conversion, waits
+one conversion time and then reads every gauge with one block read. The
+LTC2942 and LTC2943/LTC2944 manual modes clear the ADC mode bits when the
+conversion is done, so a gauge that is still converting is left for the
+next call to LTC294X_scheduler_run() instead of being waited for.
+
+@endverbatim
+
+http://www.linear.com/product/LTC2941
+http://www.linear.com/product/LTC2942
+http://www.linear.com/product/LTC2943
+http://www.linear.com/product/LTC2944
+
+
+Copyright 2018(c) Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in
+   the documentation and/or other materials provided with the
+   distribution.
+ - Neither the name of Analog Devices, Inc. nor the names of its
+   contributors may be used to endorse or promote products derived
+   from this software without specific prior written permission.
+ - The use of this software may or may not infringe the patent rights
+   of one or more patent holders.  This license does not release you
+   from the requirement that you obtain separate licenses from these
+   patent holders to use this software.
+ - Use of the software either in source or binary form, must be run
+   on or directly connected to an Analog Devices Inc. component.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//! @ingroup Power_Monitors
+//! @{
+//! @defgroup LTC294X_Scheduler LTC294X_Scheduler: Polls any number of LTC2941/LTC2942/LTC2943/LTC2944 Battery Gas Gauges
+//! @}
+
+/*! @file
+   @ingroup LTC294X_Scheduler
+   Library for LTC294X Scheduler: Polls any number of LTC2941/LTC2942/LTC2943/LTC2944 Battery Gas Gauges
+*/
+
+#include <Arduino.h>
+#include <stdint.h>
+#include <string.h>
+#include "Linduino.h"
+#include "LT_I2C.h"
+#include "LTC294X_Scheduler.h"
+
+//! Part specific details, indexed by LTC294X_LTC2941 through LTC294X_LTC2944
+typedef struct
+{
+  uint8_t snapshot_size;    //!< Registers read from STATUS onward
+  uint8_t alert_mask;       //!< Status register bits that are alerts
+  uint8_t one_shot;         //!< Bit n set if ADC mode n (control bits [7:6]) converts once and then clears
+  uint8_t conversion_time;  //!< Time for one manual conversion, in ms
+} LTC294X_part;
+
+static const LTC294X_part LTC294X_parts[] =
+{
+  { 0x08, 0x3F, 0x00,  0 },   // LTC2941: no ADC, charge only
+  { 0x10, 0x3F, 0x06, 15 },   // LTC2942: manual voltage (0x80) or manual temperature (0x40)
+  { 0x18, 0x7F, 0x02, 70 },   // LTC2943: manual mode (0x40) converts voltage, current and temperature
+  { 0x18, 0x7F, 0x02, 70 }    // LTC2944: as LTC2943
+};
+
+// Switches the mux to channel, if it is not already there
+static int8_t LTC294X_select(LTC294X_scheduler *sched, uint8_t channel)
+{
+  int8_t ack;
+
+  if ((channel == LTC294X_NO_MUX) || (sched->select_channel == NULL) || (channel == sched->channel))
+    return(0);
+  ack = sched->select_channel(channel);
+  sched->channel = ack ? LTC294X_NO_MUX : channel;
+  return(ack);
+}
+
+// Returns 1 if the gauge was told to make a conversion that clears its ADC mode bits when done
+static uint8_t LTC294X_one_shot(const LTC294X_gauge *gauge)
+{
+  return((LTC294X_parts[gauge->part].one_shot >> ((gauge->control & LTC294X_ADC_MODE_MASK) >> 6)) & 1);
+}
+
+// Writes each gauge's control register, which starts its conversion
+static void LTC294X_start_conversions(LTC294X_scheduler *sched)
+{
+  uint8_t i;
+  LTC294X_gauge *gauge;
+
+  for (i = 0; i < sched->count; i++)
+  {
+    gauge = &sched->gauge[(sched->next + i) % sched->count];
+    gauge->ack = LTC294X_select(sched, gauge->mux_channel);
+    if (!gauge->ack && (gauge->part != LTC294X_LTC2941))
+      gauge->ack = i2c_write_byte_data(gauge->i2c_address, LTC294X_CONTROL_REG, gauge->control);
+    gauge->pending = !gauge->ack;
+    gauge->busy = 0;
+  }
+  sched->sweep_start = millis();
+}
+
+// Reads one gauge. The gauge stays pending if its conversion has not finished.
+static void LTC294X_read_gauge(LTC294X_scheduler *sched, LTC294X_gauge *gauge)
+{
+  uint8_t data[LTC294X_SNAPSHOT_SIZE];
+  uint8_t length = LTC294X_parts[gauge->part].snapshot_size;
+  uint8_t address, control;
+
+  gauge->ack = LTC294X_select(sched, gauge->mux_channel);
+
+  // A gauge already seen converting is checked with a one byte read
+  if (!gauge->ack && gauge->busy)
+  {
+    gauge->ack = i2c_read_byte_data(gauge->i2c_address, LTC294X_CONTROL_REG, &control);
+    if (!gauge->ack && (control & LTC294X_ADC_MODE_MASK))
+      return;
+  }
+  if (!gauge->ack)
+    gauge->ack = i2c_read_register_block(gauge->i2c_address, LTC294X_STATUS_REG, length, data);
+  if (gauge->ack)
+  {
+    gauge->pending = 0;
+    gauge->busy = 0;
+    return;
+  }
+
+  if (LTC294X_one_shot(gauge) && (data[LTC294X_CONTROL_REG] & LTC294X_ADC_MODE_MASK))
+  {
+    gauge->busy = 1;
+    return;
+  }
+  memcpy(gauge->reg, data, length);
+  gauge->alarm = gauge->reg[LTC294X_STATUS_REG] & LTC294X_parts[gauge->part].alert_mask;
+  gauge->pending = 0;
+  gauge->busy = 0;
+
+  // Release ALCC if this gauge is the one holding it low
+  if (gauge->alarm)
+    i2c_read_byte(LTC294X_I2C_ALERT_RESPONSE, &address);
+}
+
+// Reads every pending gauge, those in alarm first
+// Returns 1 when no gauge is left pending
+static uint8_t LTC294X_read_gauges(LTC294X_scheduler *sched)
+{
+  uint8_t i, pass, remaining = 0;
+  LTC294X_gauge *gauge;
+
+  for (pass = 0; pass < 2; pass++)
+  {
+    for (i = 0; i < sched->count; i++)
+    {
+      gauge = &sched->gauge[(sched->next + i) % sched->count];
+      if (!gauge->pending || ((pass == 0) != (gauge->alarm != 0)))
+        continue;
+      LTC294X_read_gauge(sched, gauge);
+      if (gauge->pending)
+        remaining++;
+    }
+  }
+  if (remaining == 0)
+    return(1);
+
+  if ((uint32_t)(millis() - sched->sweep_start) < (uint32_t)sched->conversion_time * LTC294X_CONVERSION_TIMEOUT)
+    return(0);
+  for (i = 0; i < sched->count; i++)
+  {
+    if (sched->gauge[i].pending)
+    {
+      sched->gauge[i].pending = 0;
+      sched->gauge[i].busy = 0;
+      sched->gauge[i].ack = 1;
+    }
+  }
+  return(1);
+}
+
+// Sets up the scheduler
+void LTC294X_scheduler_init(LTC294X_scheduler *sched, LTC294X_gauge *gauge, uint8_t count, int8_t (*select_channel)(uint8_t channel), int8_t alert_pin, uint32_t sweep_period)
+{
+  uint8_t i;
+
+  sched->gauge = gauge;
+  sched->count = count;
+  sched->select_channel = select_channel;
+  sched->alert_pin = alert_pin;
+  sched->sweep_period = sweep_period;
+  sched->phase = LTC294X_PHASE_IDLE;
+  sched->channel = LTC294X_NO_MUX;
+  sched->next = 0;
+  sched->sweeps = 0;
+  sched->sweep_time = 0;
+  sched->conversion_time = 0;
+  for (i = 0; i < count; i++)
+  {
+    gauge[i].alarm = 0;
+    gauge[i].pending = 0;
+    gauge[i].busy = 0;
+    gauge[i].ack = 0;
+    if (LTC294X_one_shot(&gauge[i]) && (LTC294X_parts[gauge[i].part].conversion_time > sched->conversion_time))
+      sched->conversion_time = LTC294X_parts[gauge[i].part].conversion_time;
+  }
+  // Start the first sweep on the first call to LTC294X_scheduler_run()
+  sched->sweep_start = millis() - sweep_period;
+
+  // ALCC is open drain
+  if (alert_pin >= 0)
+    pinMode(alert_pin, INPUT_PULLUP);
+}
+
+// Advances the scheduler without blocking
+uint8_t LTC294X_scheduler_run(LTC294X_scheduler *sched)
+{
+  switch (sched->phase)
+  {
+    case LTC294X_PHASE_IDLE:
+      if (((uint32_t)(millis() - sched->sweep_start) < sched->sweep_period)
+          && ((sched->alert_pin < 0) || (digitalRead(sched->alert_pin) == HIGH)))
+        return(0);
+      sched->sweep_begin = millis();
+      LTC294X_start_conversions(sched);
+      sched->phase = LTC294X_PHASE_CONVERT;
+      return(0);
+
+    case LTC294X_PHASE_CONVERT:
+      if ((uint32_t)(millis() - sched->sweep_start) < sched->conversion_time)
+        return(0);
+      sched->phase = LTC294X_PHASE_READ;
+    // fall through
+
+    case LTC294X_PHASE_READ:
+      if (!LTC294X_read_gauges(sched))
+        return(0);
+      sched->phase = LTC294X_PHASE_IDLE;
+      sched->next = (sched->count > 1) ? (sched->next + 1) % sched->count : 0;
+      sched->sweeps++;
+      sched->sweep_time = millis() - sched->sweep_begin;
+      return(1);
+  }
+  return(0);
+}
+
+// Runs one whole sweep, waiting for it to finish
+int8_t LTC294X_scheduler_sweep(LTC294X_scheduler *sched)
+{
+  uint8_t i;
+  int8_t ack = 0;
+
+  if (sched->phase == LTC294X_PHASE_IDLE)
+    sched->sweep_start = millis() - sched->sweep_period;
+  while (!LTC294X_scheduler_run(sched))
+    ;
+  for (i = 0; i < sched->count; i++)
+    ack |= sched->gauge[i].ack;
+  return(ack);
+}
+
+// Extracts a 16-bit code from the registers of the last read
+uint16_t LTC294X_gauge_16_bits(const LTC294X_gauge *gauge, uint8_t register_address)
+{
+  return(((uint16_t)gauge->reg[register_address] << 8) | gauge->reg[register_address + 1]);
+}
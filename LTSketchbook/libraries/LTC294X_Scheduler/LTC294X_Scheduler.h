@@ -0,0 +1,184 @@
+/*!
+LTC294X Scheduler: Polls any number of LTC2941/LTC2942/LTC2943/LTC2944 Battery Gas Gauges.
+
+@verbatim
+
+The gas gauges share their STATUS, CONTROL and accumulated charge register
+layout, so one scheduler can sweep a mixed set of them. Gauges at the same
+I2C address may sit on different channels of an I2C mux; the mux is
+switched through a callback supplied by the sketch.
+
+A sweep starts a conversion on every gauge, waits one conversion time, then
+reads each gauge's registers with a single block read. The conversions run
+in parallel, so the conversion time is paid once per sweep, but the bus
+traffic is paid per gauge. At the 100kHz set by i2c_enable() a mux switch
+and control register write take about 0.5ms, and a mux switch and 24 byte
+block read about 2.6ms. Twelve LTC2943s behind a mux therefore sweep in
+about 70ms + 12 x 3.1ms = 107ms. The measured duration of the last sweep
+is kept in sweep_time. A gauge whose conversion is still running when it is
+read is then polled by reading CONTROL alone, about 0.4ms, and gets its
+block read once the conversion has finished. Gauges that reported an alert on the previous sweep
+are read first, and an asserted ALCC line starts a sweep straight away.
+
+    LTC294X_gauge gauge[12];
+    LTC294X_scheduler sched;
+
+    for (i = 0; i < 12; i++)
+    {
+      gauge[i].part = LTC294X_LTC2943;
+      gauge[i].i2c_address = LTC2943_I2C_ADDRESS;
+      gauge[i].mux_channel = i;
+      gauge[i].control = LTC2943_MANUAL_MODE | LTC2943_PRESCALAR_M_4096 | LTC2943_ALERT_MODE;
+    }
+    LTC294X_scheduler_init(&sched, gauge, 12, select_mux_channel, ALCC_PIN, 1000);
+
+    if (LTC294X_scheduler_run(&sched))   // Call from loop(), returns 1 when a sweep has finished
+    {
+      voltage = LTC2943_code_to_voltage(LTC294X_gauge_16_bits(&gauge[0], LTC2943_VOLTAGE_MSB_REG));
+      Serial.print(F("Sweep time (ms): "));
+      Serial.println(sched.sweep_time);
+    }
+
+@endverbatim
+
+http://www.linear.com/product/LTC2941
+http://www.linear.com/product/LTC2942
+http://www.linear.com/product/LTC2943
+http://www.linear.com/product/LTC2944
+
+
+Copyright 2018(c) Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in
+   the documentation and/or other materials provided with the
+   distribution.
+ - Neither the name of Analog Devices, Inc. nor the names of its
+   contributors may be used to endorse or promote products derived
+   from this software without specific prior written permission.
+ - The use of this software may or may not infringe the patent rights
+   of one or more patent holders.  This license does not release you
+   from the requirement that you obtain separate licenses from these
+   patent holders to use this software.
+ - Use of the software either in source or binary form, must be run
+   on or directly connected to an Analog Devices Inc. component.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*! @file
+    @ingroup LTC294X_Scheduler
+    Header for LTC294X Scheduler: Polls any number of LTC2941/LTC2942/LTC2943/LTC2944 Battery Gas Gauges
+*/
+
+#ifndef LTC294X_SCHEDULER_H
+#define LTC294X_SCHEDULER_H
+
+#include <stdint.h>
+
+/*! @name Gas Gauge Parts
+@{ */
+#define LTC294X_LTC2941             0
+#define LTC294X_LTC2942             1
+#define LTC294X_LTC2943             2
+#define LTC294X_LTC2944             3
+//! @}
+
+/*! @name Common Registers
+@{ */
+#define LTC294X_STATUS_REG          0x00
+#define LTC294X_CONTROL_REG         0x01
+#define LTC294X_ADC_MODE_MASK       0xC0    //!< ADC mode bits of the control register
+#define LTC294X_I2C_ALERT_RESPONSE  0x0C
+//! @}
+
+//! Registers held for each gauge, STATUS through the LTC2943/LTC2944 TEMPERATURE_THRESH_LOW register
+#define LTC294X_SNAPSHOT_SIZE       0x18
+//! mux_channel value for a gauge that is not behind a mux
+#define LTC294X_NO_MUX              0xFF
+//! Conversions that have not finished after this many conversion times are given up on
+#define LTC294X_CONVERSION_TIMEOUT  4
+
+/*! @name Scheduler Phases
+@{ */
+#define LTC294X_PHASE_IDLE          0   //!< Waiting for the next sweep
+#define LTC294X_PHASE_CONVERT       1   //!< Conversions started, waiting for them to finish
+#define LTC294X_PHASE_READ          2   //!< Reading the gauges
+//! @}
+
+//! One gas gauge polled by the scheduler. Fill in part, i2c_address, mux_channel and control before
+//! calling LTC294X_scheduler_init().
+typedef struct
+{
+  uint8_t part;                         //!< LTC294X_LTC2941, LTC294X_LTC2942, LTC294X_LTC2943 or LTC294X_LTC2944
+  uint8_t i2c_address;                  //!< I2C address of the gauge
+  uint8_t mux_channel;                  //!< Mux channel the gauge is behind, or LTC294X_NO_MUX
+  uint8_t control;                      //!< Control register value written at the start of each sweep
+  uint8_t reg[LTC294X_SNAPSHOT_SIZE];   //!< Registers from the last good read, indexed by register address
+  uint8_t alarm;                        //!< Status register alert bits from the last good read
+  uint8_t pending;                      //!< 1 while this sweep's conversion has not been read
+  uint8_t busy;                         //!< 1 once a read found the conversion still running; it is then polled through CONTROL alone
+  int8_t ack;                           //!< 0 if the last sweep read the gauge, 1 if it failed
+} LTC294X_gauge;
+
+//! Round-robin scheduler for a set of gas gauges
+typedef struct
+{
+  LTC294X_gauge *gauge;                 //!< Array of gauges
+  uint8_t count;                        //!< Number of gauges in the array
+  int8_t (*select_channel)(uint8_t channel);  //!< Switches the mux, returns 0 on acknowledge. NULL if there is no mux
+  int8_t alert_pin;                     //!< Pin wired to the ALCC line, or -1
+  uint16_t conversion_time;             //!< Time allowed for the conversions, in ms
+  uint32_t sweep_period;                //!< Time from the start of one sweep to the start of the next, in ms
+  uint8_t phase;                        //!< LTC294X_PHASE_IDLE, _CONVERT or _READ
+  uint8_t channel;                      //!< Mux channel currently selected
+  uint8_t next;                         //!< Gauge the next sweep starts from
+  uint32_t sweep_start;                 //!< millis() at the start of the last sweep
+  uint32_t sweep_begin;                 //!< millis() before the first control register write of the last sweep
+  uint32_t sweep_time;                  //!< Time the last finished sweep took, first control write to last read, in ms
+  uint32_t sweeps;                      //!< Number of sweeps finished
+} LTC294X_scheduler;
+
+//! Sets up the scheduler. The conversion time is set for the slowest part in the gauge array that
+//! makes one-shot conversions, and may be changed afterwards. While the ALCC line is held low
+//! sweeps run back to back.
+void LTC294X_scheduler_init(LTC294X_scheduler *sched,           //!< Scheduler to set up
+                            LTC294X_gauge *gauge,               //!< Array of gauges to poll
+                            uint8_t count,                      //!< Number of gauges in the array
+                            int8_t (*select_channel)(uint8_t channel), //!< Mux channel switch, or NULL if there is no mux
+                            int8_t alert_pin,                   //!< Pin wired to the ALCC line, or -1
+                            uint32_t sweep_period               //!< Time between the starts of sweeps, in ms
+                           );
+
+//! Advances the scheduler without blocking. Call it from loop().
+//! @return 1 when a sweep has just finished and every gauge's reg and ack are up to date, 0 otherwise
+uint8_t LTC294X_scheduler_run(LTC294X_scheduler *sched          //!< Scheduler to run
+                             );
+
+//! Runs one whole sweep right away, waiting for it to finish.
+//! @return The OR of the gauges' acknowledge states. 0=acknowledge, 1=no acknowledge.
+int8_t LTC294X_scheduler_sweep(LTC294X_scheduler *sched         //!< Scheduler to run
+                              );
+
+//! Extracts a 16-bit code from the registers of the last read
+//! @return The 16-bit code starting at register_address
+uint16_t LTC294X_gauge_16_bits(const LTC294X_gauge *gauge,      //!< Gauge read by the scheduler
+                               uint8_t register_address         //!< The MSB register of the code
+                              );
+
+#endif  // LTC294X_SCHEDULER_H
@@ -0,0 +1,331 @@
+/*
+Host test for the LTC294X gas gauge scheduler.
+
+NOT AN ARDUINO SKETCH.  This program builds LTC294X_Scheduler with g++
+against Utilities/host_stubs and replaces the LT_I2C routines with twelve
+simulated LTC2943s behind an I2C mux.  Every I2C call advances the clock by
+its bus time at 100kHz, 9 bit times per byte plus start and stop, and the
+sketch loop costs 100us per LTC294X_scheduler_run() call.  A manual
+conversion takes 70ms from its control register write.
+
+It checks that:
+
+  a sweep of twelve gauges takes about 70ms + 12 x 3.1ms, and every gauge
+  gets one block read with its new conversion,
+  a gauge holding ALCC low starts a sweep before the sweep period, is
+  answered through the alert response address, and is read first next time,
+  a gauge that converts 30ms late gets one block read that finds it busy,
+  one-byte CONTROL polls, then one block read with the new conversion,
+  a gauge missing from the mux fails without stalling the others,
+  a gauge that never finishes times out after 4 conversion times with a
+  single block read.
+
+The sweep time, block reads, CONTROL polls and bus time of each sweep are
+printed.
+
+  make
+  ./scheduler_test
+
+Copyright 2018(c) Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in
+   the documentation and/or other materials provided with the
+   distribution.
+ - Neither the name of Analog Devices, Inc. nor the names of its
+   contributors may be used to endorse or promote products derived
+   from this software without specific prior written permission.
+ - The use of this software may or may not infringe the patent rights
+   of one or more patent holders.  This license does not release you
+   from the requirement that you obtain separate licenses from these
+   patent holders to use this software.
+ - Use of the software either in source or binary form, must be run
+   on or directly connected to an Analog Devices Inc. component.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <Arduino.h>
+#include "LT_I2C.h"
+#include "LTC2943.h"
+#include "LTC294X_Scheduler.h"
+
+#define GAUGES          12
+#define ALCC_PIN        7
+#define SWEEP_PERIOD    1000
+#define CONVERSION_US   70000UL
+#define LOOP_US         100
+
+// Simulated LTC2943s.  The mux channel selects one of them.
+typedef struct
+{
+  uint8_t reg[LTC294X_SNAPSHOT_SIZE];
+  unsigned long done_at;        // host_time_us the running conversion finishes, 0 if none
+  unsigned long extra_us;       // added to the conversion time
+  bool never_finishes;
+  bool alerting;                // holding ALCC low
+  uint8_t conversions;
+} sim_gauge;
+
+static sim_gauge sim[GAUGES];
+static int sim_channel = -1;
+static int alcc = HIGH;
+static int block_reads[GAUGES], control_reads[GAUGES], read_order[GAUGES * 4], reads;
+static unsigned long bus_us;
+static int failures;
+
+static void check(int ok, const char *what)
+{
+  if (!ok)
+  {
+    printf("FAIL: %s\n", what);
+    failures++;
+  }
+}
+
+// One transaction of length bytes, address included
+static void bus(int length)
+{
+  unsigned long us = length * 90 + 20;
+  host_time_us += us;
+  bus_us += us;
+}
+
+static sim_gauge *sim_selected(uint8_t address)
+{
+  if ((sim_channel < 0) || (address != LTC2943_I2C_ADDRESS))
+    return NULL;
+  return &sim[sim_channel];
+}
+
+static void sim_update(sim_gauge *g)
+{
+  if (g->done_at && !g->never_finishes && (host_time_us >= g->done_at))
+  {
+    g->reg[LTC294X_CONTROL_REG] &= ~LTC294X_ADC_MODE_MASK;
+    g->conversions++;
+    g->reg[LTC2943_VOLTAGE_MSB_REG] = (g - sim) + 1;
+    g->reg[LTC2943_VOLTAGE_MSB_REG + 1] = g->conversions;
+    g->done_at = 0;
+  }
+}
+
+int8_t i2c_write_byte_data(uint8_t address, uint8_t command, uint8_t value)
+{
+  sim_gauge *g = sim_selected(address);
+
+  bus(3);
+  if (g == NULL)
+    return 1;
+  g->reg[command] = value;
+  if ((command == LTC294X_CONTROL_REG) && ((value & LTC294X_ADC_MODE_MASK) == LTC2943_MANUAL_MODE))
+    g->done_at = host_time_us + CONVERSION_US + g->extra_us;
+  return 0;
+}
+
+int8_t i2c_read_byte_data(uint8_t address, uint8_t command, uint8_t *value)
+{
+  sim_gauge *g = sim_selected(address);
+
+  bus(4);
+  if (g == NULL)
+    return 1;
+  sim_update(g);
+  control_reads[sim_channel]++;
+  *value = g->reg[command];
+  return 0;
+}
+
+int8_t i2c_read_register_block(uint8_t address, uint8_t command, uint8_t length, uint8_t *values)
+{
+  sim_gauge *g = sim_selected(address);
+
+  bus(3 + length);
+  if (g == NULL)
+    return 1;
+  sim_update(g);
+  block_reads[sim_channel]++;
+  if (reads < GAUGES * 4)
+    read_order[reads++] = sim_channel;
+  memcpy(values, &g->reg[command], length);
+  return 0;
+}
+
+// Alert response address: the gauge holding ALCC answers and lets go
+int8_t i2c_read_byte(uint8_t address, uint8_t *value)
+{
+  bus(2);
+  if ((address != LTC294X_I2C_ALERT_RESPONSE) || (sim_channel < 0) || !sim[sim_channel].alerting)
+    return 1;
+  sim[sim_channel].alerting = false;
+  alcc = HIGH;
+  *value = LTC2943_I2C_ADDRESS << 1;
+  return 0;
+}
+
+int digitalRead(uint8_t pin)
+{
+  return (pin == ALCC_PIN) ? alcc : HIGH;
+}
+
+// Mux with channels 0 to GAUGES - 1
+static int8_t select_mux_channel(uint8_t channel)
+{
+  bus(2);
+  if (channel >= GAUGES)
+  {
+    sim_channel = -1;
+    return 1;
+  }
+  sim_channel = channel;
+  return 0;
+}
+
+static LTC294X_gauge gauge[GAUGES];
+static LTC294X_scheduler sched;
+
+// Runs the scheduler from the sketch loop until a sweep finishes
+static void run_sweep(const char *name)
+{
+  int blocks = 0, polls = 0;
+
+  memset(block_reads, 0, sizeof(block_reads));
+  memset(control_reads, 0, sizeof(control_reads));
+  reads = 0;
+  bus_us = 0;
+  for (long calls = 0; !LTC294X_scheduler_run(&sched); calls++)
+  {
+    host_time_us += LOOP_US;
+    if (calls > 100000)
+    {
+      check(0, "sweep finishes");
+      return;
+    }
+  }
+  for (int i = 0; i < GAUGES; i++)
+  {
+    blocks += block_reads[i];
+    polls += control_reads[i];
+  }
+  printf("  %-24s %5lu ms %6d %6d %7.1f ms\n", name, (unsigned long)sched.sweep_time, blocks, polls, bus_us / 1000.0);
+}
+
+// Runs the sketch loop for 100ms after a sweep, well inside the sweep period
+static void idle()
+{
+  for (int i = 0; i < 1000; i++)
+  {
+    check(!LTC294X_scheduler_run(&sched), "no sweep before the period");
+    host_time_us += LOOP_US;
+  }
+  check(sched.phase == LTC294X_PHASE_IDLE, "idle between sweeps");
+}
+
+int main()
+{
+  uint8_t conversions[GAUGES];
+  uint32_t last_begin;
+  bool fresh;
+  int i;
+
+  for (i = 0; i < GAUGES; i++)
+  {
+    gauge[i].part = LTC294X_LTC2943;
+    gauge[i].i2c_address = LTC2943_I2C_ADDRESS;
+    gauge[i].mux_channel = i;
+    gauge[i].control = LTC2943_MANUAL_MODE | LTC2943_PRESCALAR_M_4096 | LTC2943_ALERT_MODE;
+  }
+  host_time_us = 5000000UL;
+  LTC294X_scheduler_init(&sched, gauge, GAUGES, select_mux_channel, ALCC_PIN, SWEEP_PERIOD);
+  check(sched.conversion_time == 70, "conversion time of the LTC2943");
+  printf("%d LTC2943s behind a mux, 100kHz\n", GAUGES);
+  printf("  %-24s %8s %6s %6s %10s\n", "sweep", "time", "blocks", "polls", "bus");
+
+  // Every gauge converts in time: one block read each
+  run_sweep("all in time");
+  check(sched.sweep_time >= 100 && sched.sweep_time <= 112, "sweep time about 70ms + 12 x 3.1ms");
+  fresh = true;
+  for (i = 0; i < GAUGES; i++)
+  {
+    fresh &= (block_reads[i] == 1) && (control_reads[i] == 0) && (gauge[i].ack == 0);
+    fresh &= (LTC294X_gauge_16_bits(&gauge[i], LTC2943_VOLTAGE_MSB_REG) == (((i + 1) << 8) | sim[i].conversions));
+  }
+  check(fresh, "one block read of each gauge with its new conversion");
+  idle();
+
+  // Gauge 9 pulls ALCC low: the sweep starts at once and answers the alert
+  last_begin = sched.sweep_begin;
+  sim[9].reg[LTC294X_STATUS_REG] = 0x02;
+  sim[9].alerting = true;
+  alcc = LOW;
+  run_sweep("ALCC low");
+  check(sched.sweeps == 2, "ALCC sweep finished");
+  check(sched.sweep_begin - last_begin < SWEEP_PERIOD / 2, "ALCC starts a sweep before the period");
+  check(gauge[9].alarm == 0x02, "gauge 9 alarm read");
+  check(alcc == HIGH, "ALCC released through the alert response address");
+  sim[9].reg[LTC294X_STATUS_REG] = 0;
+  idle();
+  run_sweep("after the alarm");
+  check(read_order[0] == 9, "gauge in alarm read first");
+  check(gauge[9].alarm == 0, "gauge 9 alarm cleared");
+  idle();
+
+  // Gauge 3 converts 30ms late: busy once, then CONTROL polls only
+  sim[3].extra_us = 30000UL;
+  for (i = 0; i < GAUGES; i++)
+    conversions[i] = sim[i].conversions;
+  run_sweep("gauge 3 30ms late");
+  check(block_reads[3] == 2, "late gauge: one busy and one good block read");
+  check(control_reads[3] > 0, "late gauge polled through CONTROL");
+  fresh = true;
+  for (i = 0; i < GAUGES; i++)
+  {
+    if (i != 3)
+      fresh &= (block_reads[i] == 1) && (control_reads[i] == 0);
+    fresh &= (gauge[i].ack == 0) && (gauge[i].reg[LTC2943_VOLTAGE_MSB_REG + 1] == conversions[i] + 1);
+  }
+  check(fresh, "every gauge read with its new conversion");
+  check(sched.sweep_time >= 100 && sched.sweep_time <= 112, "late gauge does not lengthen the sweep past its conversion");
+  sim[3].extra_us = 0;
+  idle();
+
+  // Gauge 11 missing from the mux
+  gauge[11].mux_channel = GAUGES;
+  run_sweep("gauge 11 missing");
+  check(gauge[11].ack == 1, "missing gauge fails");
+  fresh = true;
+  for (i = 0; i < GAUGES - 1; i++)
+    fresh &= (gauge[i].ack == 0);
+  check(fresh, "other gauges still read");
+  gauge[11].mux_channel = 11;
+  idle();
+
+  // Gauge 5 never finishes its conversion
+  sim[5].never_finishes = true;
+  run_sweep("gauge 5 stuck");
+  check(gauge[5].ack == 1, "stuck gauge times out");
+  check(block_reads[5] == 1, "stuck gauge gets a single block read");
+  check(sched.sweep_time >= 4 * 70 && sched.sweep_time <= 4 * 70 + 10, "timeout after 4 conversion times");
+  check(gauge[4].ack == 0 && gauge[6].ack == 0, "other gauges read while one is stuck");
+  sim[5].never_finishes = false;
+
+  printf(failures ? "FAILED (%d checks)\n" : "PASSED\n", failures);
+  return failures != 0;
+}
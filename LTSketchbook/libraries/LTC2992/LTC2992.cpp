@@ -221,6 +221,44 @@ int8_t LTC2992_read_24_bits(uint8_t i2c_address, uint8_t adc_command, uint32_t *
   return(ack);
 }
 
+// Reads the LTC2992 register map into a snapshot
+int8_t LTC2992_read_snapshot(uint8_t i2c_address, LTC2992_snapshot *snapshot)
+// The function returns the state of the acknowledge bit after the I2C address write. 0=acknowledge, 1=no acknowledge.
+{
+  int8_t ack;
+
+  ack = i2c_read_register_block(i2c_address, LTC2992_CTRLA_REG, LTC2992_SNAPSHOT_SIZE, snapshot->reg);
+  return(ack);
+}
+
+// Combines length snapshot bytes, MSB first, starting at adc_command
+static uint32_t LTC2992_snapshot_code(const LTC2992_snapshot *snapshot, uint8_t adc_command, uint8_t length)
+{
+  uint32_t code = 0;
+
+  while (length--)
+    code = (code << 8) | snapshot->reg[adc_command++];
+  return(code);
+}
+
+// Extracts a 12-bit adc_code from a snapshot
+uint16_t LTC2992_snapshot_12_bits(const LTC2992_snapshot *snapshot, uint8_t adc_command)
+{
+  return(LTC2992_snapshot_code(snapshot, adc_command, 2) >> 4);
+}
+
+// Extracts a 16-bit adc_code from a snapshot
+uint16_t LTC2992_snapshot_16_bits(const LTC2992_snapshot *snapshot, uint8_t adc_command)
+{
+  return(LTC2992_snapshot_code(snapshot, adc_command, 2));
+}
+
+// Extracts a 24-bit adc_code from a snapshot
+uint32_t LTC2992_snapshot_24_bits(const LTC2992_snapshot *snapshot, uint8_t adc_command)
+{
+  return(LTC2992_snapshot_code(snapshot, adc_command, 3));
+}
+
 // Calculate the LTC2992 SENSE voltage
 float LTC2992_SENSE_code_to_voltage(uint16_t adc_code, float LTC2992_SENSE_lsb)
 // Returns the SENSE Voltage in Volts
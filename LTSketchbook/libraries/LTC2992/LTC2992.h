@@ -729,5 +729,39 @@ float LTC2992_code_to_power_sum(int32_t adc_code,             //!< The ADC value
                                 float resistor,       //!< The Resistor Value
                                 float LTC2992_Power_lsb);    //!< Power LSB Weight
 
+//! Number of registers held in a snapshot, LTC2992_CTRLA_REG through LTC2992_GPIO4_CFG_REG (0x97)
+#define LTC2992_SNAPSHOT_SIZE 0x98
+
+//! Copy of the LTC2992 register map, read with LTC2992_read_snapshot().
+//! Registers are stored at their own address, so the *_REG defines index reg[] directly.
+typedef struct
+{
+  uint8_t reg[LTC2992_SNAPSHOT_SIZE];   //!< Register contents, indexed by register address
+} LTC2992_snapshot;
+
+//! Reads the whole LTC2992 register map into a snapshot with one auto-incrementing block read.
+//! @return The function returns the state of the acknowledge bit after the I2C address write. 0=acknowledge, 1=no acknowledge.
+int8_t LTC2992_read_snapshot(uint8_t i2c_address,         //!< Register address for the LTC2992
+                             LTC2992_snapshot *snapshot    //!< Snapshot that will be filled from the LTC2992
+                            );
+
+//! Extracts a 12-bit adc_code from a snapshot, as LTC2992_read_12_bits() would read it
+//! @return The 12-bit code starting at adc_command
+uint16_t LTC2992_snapshot_12_bits(const LTC2992_snapshot *snapshot,  //!< Snapshot read with LTC2992_read_snapshot()
+                                  uint8_t adc_command                //!< The "command byte" of the first register
+                                 );
+
+//! Extracts a 16-bit adc_code from a snapshot, as LTC2992_read_16_bits() would read it
+//! @return The 16-bit code starting at adc_command
+uint16_t LTC2992_snapshot_16_bits(const LTC2992_snapshot *snapshot,  //!< Snapshot read with LTC2992_read_snapshot()
+                                  uint8_t adc_command                //!< The "command byte" of the first register
+                                 );
+
+//! Extracts a 24-bit adc_code from a snapshot, as LTC2992_read_24_bits() would read it
+//! @return The 24-bit code starting at adc_command
+uint32_t LTC2992_snapshot_24_bits(const LTC2992_snapshot *snapshot,  //!< Snapshot read with LTC2992_read_snapshot()
+                                  uint8_t adc_command                //!< The "command byte" of the first register
+                                 );
+
 #endif  // LTC2945_H
 
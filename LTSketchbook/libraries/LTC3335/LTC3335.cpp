@@ -129,13 +129,39 @@ static boolean ltc3335_counter_test_last;                              //!<  val
 //! @name Counter Test Variables
 //! Variables used to count edges per second when the Counter Test feature is turned on, providing an instantaneous measurement of the battery current.
 #if LTC3335_USE_CURRENT_MEASUREMENT == true
+#if LTC3335_USE_EDGE_CAPTURE == false
 static uint16_t ltc3335_hw_timer_last;                                 //!<  last value of the hardware timer accessed by LTC3335 driver.
 static uint16_t ltc3335_hw_counter_last;                               //!<  last value of the hardware counter accessed by LTC3335 driver.
+#endif // #if LTC3335_USE_EDGE_CAPTURE == false
 static uint32_t ltc3335_counter_test_edge_count;                       //!<  the number of rising edges on the /IRQ pin since the Counter Test results were last cleared.
 static uint32_t ltc3335_counter_test_time;                             //!<  the amount of timer ticks since the Counter Test results were last cleared.
+#if LTC3335_USE_SOFTWARE_CORRECTION == true
+static uint16_t ltc3335_current_scale_vbat;                            //!<  battery voltage that ltc3335_current_scale was calculated for.
+static uint32_t ltc3335_current_scale;                                 //!<  corrected uA * timer ticks per edge, 0 if not calculated yet.
+#endif // #if LTC3335_USE_SOFTWARE_CORRECTION == true
 #endif // #if LTC3335_USE_CURRENT_MEASUREMENT == true
 //! @}
 
+//! @name Edge Capture Variables
+//! Ring buffer of /IRQ edges timestamped by the capture interrupt.  Each entry holds the time of a captured edge
+//! and the number of edges since the Counter Test results were last cleared.  The interrupt captures one edge out
+//! of every ltc3335_capture_step, adjusting the step to keep captures about LTC3335_CAPTURE_PERIOD apart.
+//! @{
+#if LTC3335_USE_EDGE_CAPTURE == true
+typedef struct
+{
+  uint32_t time;                                                       //!<  timer value when the edge occurred.
+  uint32_t edges;                                                      //!<  number of edges up to and including this one.
+} LTC3335_CAPTURE_TYPE;
+static volatile LTC3335_CAPTURE_TYPE ltc3335_capture_buffer[LTC3335_CAPTURE_BUFFER_SIZE];  //!<  captured edges.
+static volatile uint8_t ltc3335_capture_head;                          //!<  index of the newest captured edge.
+static volatile uint8_t ltc3335_capture_entries;                       //!<  number of captured edges in the buffer.
+static volatile uint16_t ltc3335_capture_counter;                      //!<  hardware counter value of the newest captured edge.
+static volatile uint16_t ltc3335_capture_next;                         //!<  hardware counter value of the next edge to capture.
+static volatile uint16_t ltc3335_capture_step;                         //!<  number of edges from one capture to the next.
+#endif // #if LTC3335_USE_EDGE_CAPTURE == true
+//! @}
+
 //! @name
 //!
 #if LTC3335_USE_SOFTWARE_CORRECTION == true
@@ -153,6 +179,12 @@ static int8_t ltc3335_set_register(uint8_t subaddress, uint8_t *ltc3335_data);
 static int8_t ltc3335_get_register(uint8_t subaddress, uint8_t *ltc3335_data);
 static uint8_t ltc3335_encode_register_a(boolean enabled, LTC3335_OUTPUT_VOLTAGE_TYPE voltage, uint8_t prescaler);
 static void ltc3335_decode_register_a(uint8_t register_a);
+#if LTC3335_USE_EDGE_CAPTURE == true
+static void ltc3335_capture_window(void);
+#endif // #if LTC3335_USE_EDGE_CAPTURE == true
+#if (LTC3335_USE_CURRENT_MEASUREMENT == true) && (LTC3335_USE_SOFTWARE_CORRECTION == true)
+static uint32_t ltc3335_get_current_scale(uint16_t vbat);
+#endif // #if (LTC3335_USE_CURRENT_MEASUREMENT == true) && (LTC3335_USE_SOFTWARE_CORRECTION == true)
 
 //-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
 // Global Functions
@@ -377,8 +409,13 @@ int8_t LTC3335_Set_Counter_Test(boolean enabled)
   // when the test is started should not be counted.
   if (enabled == true)
   {
+#if LTC3335_USE_EDGE_CAPTURE == true
+    // Start capturing edges when test is started.
+    LTC3335_Reset_Counter_Test_Current();
+#else
     // Take initial readings when test is started.
     LTC3335_Counter_Test_Current_Task();
+#endif // #if LTC3335_USE_EDGE_CAPTURE == true
   }
   else
   {
@@ -397,8 +434,27 @@ int8_t LTC3335_Reset_Counter_Test_Current(void)
 {
   ltc3335_counter_test_edge_count = 0;
   ltc3335_counter_test_time = 0;
+#if LTC3335_USE_EDGE_CAPTURE == true
+  // Restart the buffer from the present count, and capture the next edge if the Counter Test is on.
+  noInterrupts();
+  LTC3335_CAPTURE_STOP();
+  ltc3335_capture_head = 0;
+  ltc3335_capture_entries = 1;
+  ltc3335_capture_buffer[0].time = LTC3335_TIMER_GET();
+  ltc3335_capture_buffer[0].edges = 0;
+  ltc3335_capture_counter = LTC3335_COUNTER_GET();
+  ltc3335_capture_step = 1;
+  ltc3335_capture_next = ltc3335_capture_counter + 1;
+  if (ltc3335_counter_test_last == true)
+  {
+    LTC3335_CAPTURE_SET(ltc3335_capture_next);
+    LTC3335_CAPTURE_START();
+  }
+  interrupts();
+#else
   ltc3335_hw_timer_last = LTC3335_TIMER_GET();
   ltc3335_hw_counter_last = LTC3335_COUNTER_GET();
+#endif // #if LTC3335_USE_EDGE_CAPTURE == true
 
   return 0;
 }
@@ -408,6 +464,7 @@ int8_t LTC3335_Reset_Counter_Test_Current(void)
 // Task that must be run periodically at a rate faster than LTC3335_MIN_CURRENT_TASK_RATE.
 void LTC3335_Counter_Test_Current_Task(void)
 {
+#if LTC3335_USE_EDGE_CAPTURE == false
   if (ltc3335_counter_test_last == true)
   {
     // Get new timer and counter values
@@ -422,14 +479,58 @@ void LTC3335_Counter_Test_Current_Task(void)
     ltc3335_hw_timer_last = hw_timer_new;
     ltc3335_hw_counter_last = hw_counter_new;
   }
+#endif // #if LTC3335_USE_EDGE_CAPTURE == false
 
   return;
 }
 
+#if LTC3335_USE_EDGE_CAPTURE == true
+// Timestamps an edge on the /IRQ pin, when the hardware counter reaches the count set by LTC3335_CAPTURE_SET().
+ISR(LTC3335_CAPTURE_VECTOR)
+{
+  uint16_t hw_counter = ltc3335_capture_next;
+  uint32_t time = LTC3335_TIMER_GET();
+  uint32_t interval = time - ltc3335_capture_buffer[ltc3335_capture_head].time;
+  uint8_t head = (ltc3335_capture_head + 1) & (LTC3335_CAPTURE_BUFFER_SIZE - 1);
+
+  // Add the edge to the buffer, overwriting the oldest one if full.
+  ltc3335_capture_buffer[head].time = time;
+  ltc3335_capture_buffer[head].edges = ltc3335_capture_buffer[ltc3335_capture_head].edges + (uint16_t)(hw_counter - ltc3335_capture_counter);
+  ltc3335_capture_head = head;
+  if (ltc3335_capture_entries < LTC3335_CAPTURE_BUFFER_SIZE)
+  {
+    ltc3335_capture_entries++;
+  }
+  ltc3335_capture_counter = hw_counter;
+
+  // Capture more or fewer edges to keep captures about LTC3335_CAPTURE_PERIOD apart.
+  if ((interval < LTC3335_CAPTURE_PERIOD / 2) && (ltc3335_capture_step < (1U << (LTC3335_COUNTER_SIZE - 2))))
+  {
+    ltc3335_capture_step <<= 1;
+  }
+  else if ((interval > LTC3335_CAPTURE_PERIOD * 2) && (ltc3335_capture_step > 1))
+  {
+    ltc3335_capture_step >>= 1;
+  }
+
+  // If the counter has already reached the next count, capture the next edge instead, as the compare would not match until the counter wraps.
+  ltc3335_capture_next = hw_counter + ltc3335_capture_step;
+  if ((uint16_t)(LTC3335_COUNTER_GET() - hw_counter) >= ltc3335_capture_step)
+  {
+    ltc3335_capture_next = LTC3335_COUNTER_GET() + 1;
+  }
+  LTC3335_CAPTURE_SET(ltc3335_capture_next);
+}
+#endif // #if LTC3335_USE_EDGE_CAPTURE == true
+
 #if LTC3335_USE_SOFTWARE_CORRECTION == false
 // Calculates the battery current from the number of edges on the /IRQ pins over a period of time accumulated in LTC3335_Counter_Test_Current_Task.
 int8_t LTC3335_Get_Counter_Test_Current(uint16_t *microamps)
 {
+#if LTC3335_USE_EDGE_CAPTURE == true
+  ltc3335_capture_window();
+#endif // #if LTC3335_USE_EDGE_CAPTURE == true
+
   if ((ltc3335_counter_test_last == true) && ((ltc3335_counter_test_time != 0)))
   {
     if (ltc3335_counter_test_edge_count != 0)
@@ -462,14 +563,15 @@ int8_t LTC3335_Get_Counter_Test_Current(uint16_t *microamps)
 // LTC3335_Counter_Test_Current_Task accounting for the resolution available at the current battery voltage, output voltage, and ipeak.
 int8_t LTC3335_Get_Counter_Test_Current(uint16_t *microamps, uint16_t vbat)
 {
+#if LTC3335_USE_EDGE_CAPTURE == true
+  ltc3335_capture_window();
+#endif // #if LTC3335_USE_EDGE_CAPTURE == true
 
   if ((ltc3335_counter_test_last == true) && ((ltc3335_counter_test_time != 0)))
   {
     if (ltc3335_counter_test_edge_count != 0)
     {
-      int16_t temp16 = LTC3335_Get_Software_Correction_Factor(vbat);
-      uint64_t uAs = (uint64_t)(1LL * LTC3335_IPEAK_MA * UA_PER_MA * LTC3335_TFS * LTC3335_TIMER_COUNTS_PER_SEC) * ltc3335_counter_test_edge_count;
-      uAs += ((uAs * temp16 + (1L << 15)) >> 16) | (temp16 < 0 ? 0xFFFF000000000000LL : 0);
+      uint64_t uAs = (uint64_t)ltc3335_get_current_scale(vbat) * ltc3335_counter_test_edge_count;
       uAs += ltc3335_counter_test_time / 2;
       uAs /= ltc3335_counter_test_time;
       if (uAs >= (1L << 16))
@@ -534,3 +636,57 @@ static void ltc3335_decode_register_a(uint8_t register_a)
   ltc3335_prescaler_last = register_a & MASK(4, 0);
   return;
 }
+
+#if LTC3335_USE_EDGE_CAPTURE == true
+// Sets the Counter Test edges and time from the captured edges.  The edges are counted from the oldest
+// captured edge to the newest one, so that both ends of the measurement are timestamped edges.  If no edge
+// has been captured for longer than that, the current has fallen, and the edges are counted from the newest
+// captured edge up to now.
+static void ltc3335_capture_window(void)
+{
+  uint8_t oldest;
+  uint8_t entries;
+  uint32_t first_time, first_edges;
+  uint32_t last_time, last_edges;
+  uint32_t now_time, now_edges;
+
+  noInterrupts();
+  entries = ltc3335_capture_entries;
+  oldest = (ltc3335_capture_head + 1 - entries) & (LTC3335_CAPTURE_BUFFER_SIZE - 1);
+  first_time = ltc3335_capture_buffer[oldest].time;
+  first_edges = ltc3335_capture_buffer[oldest].edges;
+  last_time = ltc3335_capture_buffer[ltc3335_capture_head].time;
+  last_edges = ltc3335_capture_buffer[ltc3335_capture_head].edges;
+  now_edges = last_edges + (uint16_t)(LTC3335_COUNTER_GET() - ltc3335_capture_counter);
+  now_time = LTC3335_TIMER_GET();
+  interrupts();
+
+  if ((entries > 1) && ((now_time - last_time) <= (last_time - first_time)))
+  {
+    ltc3335_counter_test_edge_count = last_edges - first_edges;
+    ltc3335_counter_test_time = last_time - first_time;
+  }
+  else
+  {
+    ltc3335_counter_test_edge_count = now_edges - last_edges;
+    ltc3335_counter_test_time = now_time - last_time;
+  }
+  return;
+}
+#endif // #if LTC3335_USE_EDGE_CAPTURE == true
+
+#if (LTC3335_USE_CURRENT_MEASUREMENT == true) && (LTC3335_USE_SOFTWARE_CORRECTION == true)
+// Returns the charge of one edge on the /IRQ pin in uA * timer ticks, corrected for the battery voltage.
+// The correction factor is interpolated from LTC3335_Software_Correction_Table only when vbat changes.
+static uint32_t ltc3335_get_current_scale(uint16_t vbat)
+{
+  if ((ltc3335_current_scale == 0) || (vbat != ltc3335_current_scale_vbat))
+  {
+    int16_t temp16 = LTC3335_Get_Software_Correction_Factor(vbat);
+    int32_t scale = (int32_t)(1LL * LTC3335_IPEAK_MA * UA_PER_MA * LTC3335_TFS * LTC3335_TIMER_COUNTS_PER_SEC);
+    ltc3335_current_scale = scale + ((1LL * scale * temp16 + (1L << 15)) >> 16);
+    ltc3335_current_scale_vbat = vbat;
+  }
+  return ltc3335_current_scale;
+}
+#endif // #if (LTC3335_USE_CURRENT_MEASUREMENT == true) && (LTC3335_USE_SOFTWARE_CORRECTION == true)
@@ -161,8 +161,19 @@ typedef struct
 #define  LTC3335_TIMER_COUNTS_PER_IQ_MAS  ((uint32_t)(LTC3335_TIMER_COUNTS_PER_SEC/(LTC3335_IQ * MA_PER_A)))
 
 //! LTC3335_Counter_Test_Current_Task() must be called often more often than this rate for hardware counter to not overflow
+//! unless LTC3335_USE_EDGE_CAPTURE is set.
 #define  LTC3335_MIN_CURRENT_TASK_RATE  ((1LL << LTC3335_COUNTER_SIZE) * 2 * LTC3335_TFS)
 
+//! Verify that the edge capture has the Counter Test edges to capture.
+#if (LTC3335_USE_EDGE_CAPTURE == true) && (LTC3335_USE_CURRENT_MEASUREMENT == false)
+#error LTC3335_USE_EDGE_CAPTURE requires LTC3335_USE_CURRENT_MEASUREMENT.
+#endif
+
+//! Verify that the capture buffer index can wrap with a mask.
+#if (LTC3335_USE_EDGE_CAPTURE == true) && ((LTC3335_CAPTURE_BUFFER_SIZE & (LTC3335_CAPTURE_BUFFER_SIZE - 1)) != 0)
+#error LTC3335_CAPTURE_BUFFER_SIZE must be a power of 2.
+#endif
+
 // Value of IPEAK in mA, used in calculations of coulomb count and current.
 #if LTC3335_IPEAK_CONFIGURATION == LTC3335_IPEAK_CONFIGURATION_5MA
 #define LTC3335_IPEAK_MA  5                   //!< mA = 5mA, used in calculations of coulomb count and current.
@@ -274,7 +285,8 @@ int8_t LTC3335_Get_Counter_Test_Current(uint16_t *microamps,            //!< Poi
 int8_t LTC3335_Reset_Counter_Test_Current(void);
 
 //! Task that must be run periodically, for the edges and time to be stored for the
-//! LTC3335 Counter Test feature.
+//! LTC3335 Counter Test feature.  Does nothing if LTC3335_USE_EDGE_CAPTURE is set, as the
+//! edges are then timestamped by an interrupt.
 //! @return TRUE if the LTC3335 communication was successful.
 void LTC3335_Counter_Test_Current_Task(void);
 #endif // LTC3335_USE_CURRENT_MEASUREMENT == true
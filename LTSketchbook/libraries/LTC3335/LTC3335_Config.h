@@ -98,6 +98,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define LTC3335_ALARM_CAPACITY            0.9*LTC3335_CAPACITY              //!< in mAh, the capacity at which the alarm should be activated.
 
 #define LTC3335_USE_CURRENT_MEASUREMENT   true                              //!< Set to true to use the /IRQ pin to measure the battery current real time.
+#define LTC3335_USE_EDGE_CAPTURE          true                              //!< Set to true to timestamp /IRQ edges from an interrupt, so that LTC3335_Counter_Test_Current_Task() need not be called.
+#define LTC3335_CAPTURE_PERIOD            (LTC3335_TIMER_COUNTS_PER_SEC/10) //!< in timer counts, the time between captured edges that the edge capture aims for.
+#define LTC3335_CAPTURE_BUFFER_SIZE       16                                //!< Number of captured edges kept, a power of 2.  Current is averaged over this many captures.
 
 #define LTC3335_USE_SOFTWARE_CORRECTION   false                             //!< Set to true to use software correction of coulomb count and current measurement.
 #define LTC3335_VBAT_TYP                  3600                              //!< in mV, the nominal battery voltage expected for the majority of the battery discharge.
@@ -133,6 +136,16 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define LTC3335_COUNTER_SIZE              16
 //! @}
 
+//! @name Edge Capture Definitions
+//! @{
+//! Macros to interrupt when the hardware counter reaches a value, defined to use the ATMega328P Timer1 output compare A interrupt.
+//! The interrupt timestamps the edge with LTC3335_TIMER_GET().
+#define LTC3335_CAPTURE_VECTOR            TIMER1_COMPA_vect
+#define LTC3335_CAPTURE_SET(count)        OCR1A = (count)
+#define LTC3335_CAPTURE_START()           { TIFR1 = (1<<OCF1A); TIMSK1 |= (1<<OCIE1A); }
+#define LTC3335_CAPTURE_STOP()            { TIMSK1 &= ~(1<<OCIE1A); }
+//! @}
+
 //! @name Hardware Initialization
 //! @{
 //! Macro to init micro hardware that is used by LTC3335 driver.
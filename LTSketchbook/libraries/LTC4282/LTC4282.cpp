@@ -164,6 +164,44 @@ int8_t LTC4282_read_48_bits(uint8_t i2c_address, uint8_t adc_command, uint64_t *
   return(ack);
 }
 
+// Reads the LTC4282 register map into a snapshot
+int8_t LTC4282_read_snapshot(uint8_t i2c_address, LTC4282_snapshot *snapshot)
+// The function returns the state of the acknowledge bit after the I2C address write. 0=acknowledge, 1=no acknowledge.
+{
+  int8_t ack;
+
+  ack = i2c_read_register_block(i2c_address, LTC4282_CONTROL_MSB_REG, LTC4282_SNAPSHOT_SIZE, snapshot->reg);
+  return(ack);
+}
+
+// Combines length snapshot bytes, MSB first, starting at adc_command
+static uint64_t LTC4282_snapshot_code(const LTC4282_snapshot *snapshot, uint8_t adc_command, uint8_t length)
+{
+  uint64_t code = 0;
+
+  while (length--)
+    code = (code << 8) | snapshot->reg[adc_command++];
+  return(code);
+}
+
+// Extracts a 16-bit adc_code from a snapshot
+uint16_t LTC4282_snapshot_16_bits(const LTC4282_snapshot *snapshot, uint8_t adc_command)
+{
+  return(LTC4282_snapshot_code(snapshot, adc_command, 2));
+}
+
+// Extracts a 32-bit adc_code from a snapshot
+uint32_t LTC4282_snapshot_32_bits(const LTC4282_snapshot *snapshot, uint8_t adc_command)
+{
+  return(LTC4282_snapshot_code(snapshot, adc_command, 4));
+}
+
+// Extracts a 48-bit adc_code from a snapshot
+uint64_t LTC4282_snapshot_48_bits(const LTC4282_snapshot *snapshot, uint8_t adc_command)
+{
+  return(LTC4282_snapshot_code(snapshot, adc_command, 6));
+}
+
 // Convert ADC code to VGPIO
 float LTC4282_code_to_VGPIO(uint16_t code)
 // Returns floating point value of GPIO Voltage
@@ -290,4 +328,4 @@ uint8_t LTC4282_power_to_code_alarm(float power, float resistor, float fullscale
 {
   uint8_t code = (power*255.0*255.0*resistor/(256*.04*fullscaleVoltage));
   return code;
-}
\ No newline at end of file
+}
\ No newline at end of file
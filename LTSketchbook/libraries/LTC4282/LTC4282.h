@@ -737,4 +737,38 @@ uint8_t LTC4282_power_to_code_alarm(float power,    //!< Power value to be conve
                                     float fullscaleVoltage              //!< Fullsvale voltage value to convert voltage into alarm code
                                    );
 
+//! Number of registers held in a snapshot, LTC4282_CONTROL_MSB_REG through LTC4282_EE_SPARE_LSB_REG (0x4F)
+#define LTC4282_SNAPSHOT_SIZE 0x50
+
+//! Copy of the LTC4282 register map, read with LTC4282_read_snapshot().
+//! Registers are stored at their own address, so the *_REG defines index reg[] directly.
+typedef struct
+{
+  uint8_t reg[LTC4282_SNAPSHOT_SIZE];   //!< Register contents, indexed by register address
+} LTC4282_snapshot;
+
+//! Reads the whole LTC4282 register map into a snapshot with one auto-incrementing block read.
+//! @return The function returns the state of the acknowledge bit after the I2C address write. 0=acknowledge, 1=no acknowledge.
+int8_t LTC4282_read_snapshot(uint8_t i2c_address,         //!< Register address for the LTC4282
+                             LTC4282_snapshot *snapshot    //!< Snapshot that will be filled from the LTC4282
+                            );
+
+//! Extracts a 16-bit adc_code from a snapshot, as LTC4282_read_16_bits() would read it
+//! @return The 16-bit code starting at adc_command
+uint16_t LTC4282_snapshot_16_bits(const LTC4282_snapshot *snapshot,  //!< Snapshot read with LTC4282_read_snapshot()
+                                  uint8_t adc_command                //!< The "command byte" of the first register
+                                 );
+
+//! Extracts a 32-bit adc_code from a snapshot, as LTC4282_read_32_bits() would read it
+//! @return The 32-bit code starting at adc_command
+uint32_t LTC4282_snapshot_32_bits(const LTC4282_snapshot *snapshot,  //!< Snapshot read with LTC4282_read_snapshot()
+                                  uint8_t adc_command                //!< The "command byte" of the first register
+                                 );
+
+//! Extracts a 48-bit adc_code from a snapshot, as LTC4282_read_48_bits() would read it
+//! @return The 48-bit code starting at adc_command
+uint64_t LTC4282_snapshot_48_bits(const LTC4282_snapshot *snapshot,  //!< Snapshot read with LTC4282_read_snapshot()
+                                  uint8_t adc_command                //!< The "command byte" of the first register
+                                 );
+
 #endif
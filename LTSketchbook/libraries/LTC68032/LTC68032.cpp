@@ -335,36 +335,3 @@ uint8_t pec8_calc(uint8_t len, uint8_t *data)
   return (remainder);
 
 }
-
-
-//! Writes an array of bytes out of the SPI port
-void spi_write_array(uint8_t len, // Option: Number of bytes to be written on the SPI port
-                     uint8_t data[] //Array of bytes to be written on the SPI port
-                    )
-{
-  for (uint8_t i = 0; i < len; i++)
-  {
-    spi_write((int8_t)data[i]);
-  }
-}
-
-
-//!Writes and read a set number of bytes using the SPI port.
-void spi_write_read(uint8_t tx_Data[],//array of data to be written on SPI port
-                    uint8_t tx_len, //length of the tx data arry
-                    uint8_t *rx_data,//Input: array that will store the data read by the SPI port
-                    uint8_t rx_len //Option: number of bytes to be read from the SPI port
-                   )
-{
-  for (uint8_t i = 0; i < tx_len; i++)
-  {
-    spi_write(tx_Data[i]);
-
-  }
-
-  for (uint8_t i = 0; i < rx_len; i++)
-  {
-    rx_data[i] = (uint8_t)spi_read(0xFF);
-  }
-
-}
@@ -50,6 +50,8 @@ Copyright 2015 Linear Technology Corp. (LTC)
 #ifndef LTC68032_H
 #define LTC68032_H
 
+#include "bms_hardware.h" //!< spi_write_array() and spi_write_read() are shared with the LTC681x libraries
+
 
 #ifndef LTC6803_CS
 #define LTC6803_CS QUIKEVAL_CS
@@ -98,18 +100,4 @@ uint8_t pec8_calc(uint8_t len,          //!< the length of the data array
                   uint8_t *data         //!< data array
                  );
 
-//! Writes an array of bytes out of the SPI port
-//! @return void
-void spi_write_array(uint8_t length,      //!< length of the data array being written on the SPI port
-                     uint8_t *data        //!< the data array to be written on the SPI port
-                    );
-
-//! Writes and read a set number of bytes using the SPI port.
-//! @return void
-void spi_write_read(uint8_t *TxData,      //!< array of data to be written on the SPI port
-                    uint8_t TXlen,        //!< length of the tx_data array
-                    uint8_t *rx_data,     //!< array that read data will be written too.
-                    uint8_t RXlen       //!< number of bytes to be read from the SPI port.
-                   );
-
 #endif
\ No newline at end of file
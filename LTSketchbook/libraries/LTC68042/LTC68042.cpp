@@ -73,11 +73,12 @@ Copyright 2013 Linear Technology Corp. (LTC)
 #include "LTC68042.h"
 #include <SPI.h>
 
-/*
-   ADC control Variables for LTC6804
-*/
-
 
+/*!
+  The LTC6804-2 network as seen by the LTC681x core. Conversions are broadcast, registers
+  are read and written one IC at a time at addresses 0 to total_ic-1.
+*/
+static isospi_chain LTC6804_chain = {LTC6804_CS, 0, IC_LTC6804, NULL, NULL, true};
 
 /*!
   6804 conversion command variables.
@@ -86,21 +87,30 @@ uint8_t ADCV[2]; //!< Cell Voltage conversion command.
 uint8_t ADAX[2]; //!< GPIO conversion command.
 
 
+/* Selects the LTC6804 network in the LTC681x core and wakes its isoSPI port up */
+static void LTC6804_select(uint8_t total_ic)
+{
+  LTC6804_chain.total_ic = total_ic;
+  LTC681x_select_chain(&LTC6804_chain);
+  wakeup_idle(); //This will guarantee that the LTC6804 isoSPI port is awake. This command can be removed.
+}
+
+
 /*!
   \brief This function will initialize all 6804 variables and the SPI port.
 
-  input:
-  ------
-  IC: number of ICs being controlled. The address of the ICs in a LTC6804-2 network will start at 0 and continue in an ascending order.
+  This function will initialize the Linduino to communicate with the LTC6804 with a 1MHz SPI clock.
+  The Function also intializes the ADCV and ADAX commands to convert all cell and GPIO voltages in
+  the Normal ADC mode.
 */
 void LTC6804_initialize()
 {
   quikeval_SPI_connect();
-  spi_enable(SPI_CLOCK_DIV16);
+  spi_enable(SPI_CLOCK_DIV16); // This will set the Linduino to have a 1MHz Clock
   set_adc(MD_NORMAL,DCP_DISABLED,CELL_CH_ALL,AUX_CH_ALL);
 }
 
-/*!******************************************************************************************************************
+/*!*******************************************************************************************************************
  \brief Maps  global ADC control variables to the appropriate control bytes for each of the different ADC commands
 
 @param[in] uint8_t MD The adc conversion mode
@@ -108,11 +118,13 @@ void LTC6804_initialize()
 @param[in] uint8_t CH Determines which cells are measured during an ADC conversion command
 @param[in] uint8_t CHG Determines which GPIO channels are measured during Auxiliary conversion command
 
- Command Code: \n
-      |command  |  10   |   9   |   8   |   7   |   6   |   5   |   4   |   3   |   2   |   1   |   0   |
-      |-----------|-------|-------|-------|-------|-------|-------|-------|-------|-------|-------|-------|
-      |ADCV:      |   0   |   1   | MD[1] | MD[2] |   1   |   1   |  DCP  |   0   | CH[2] | CH[1] | CH[0] |
-      |ADAX:      |   1   |   0   | MD[1] | MD[2] |   1   |   1   |  DCP  |   0   | CHG[2]| CHG[1]| CHG[0]|
+Command Code:
+-------------
+
+|command  |  15   |  14   |  13   |  12   |  11   |  10   |   9   |   8   |   7   |   6   |   5   |   4   |   3   |   2   |   1   |   0   |
+|-----------|-------|-------|-------|-------|-------|-------|-------|-------|-------|-------|-------|-------|-------|-------|-------|-------|
+|ADCV:      |   0   |   0   |   0   |   0   |   0   |   0   |   1   | MD[1] | MD[2] |   1   |   1   |  DCP  |   0   | CH[2] | CH[1] | CH[0] |
+|ADAX:      |   0   |   0   |   0   |   0   |   0   |   1   |   0   | MD[1] | MD[2] |   1   |   1   |  DCP  |   0   | CHG[2]| CHG[1]| CHG[0]|
  ******************************************************************************************************************/
 void set_adc(uint8_t MD, //ADC Mode
              uint8_t DCP, //Discharge Permit
@@ -135,99 +147,34 @@ void set_adc(uint8_t MD, //ADC Mode
 }
 
 
-/*!*********************************************************************************************
+/*!
   \brief Starts cell voltage conversion
 
-  Starts ADC conversions of the LTC6804 Cpin inputs.
-  The type of ADC conversion done is set using the associated global variables:
- |Variable|Function                                      |
- |--------|----------------------------------------------|
- | MD     | Determines the filter corner of the ADC      |
- | CH     | Determines which cell channels are converted |
- | DCP    | Determines if Discharge is Permitted       |
-
-***********************************************************************************************/
+  Broadcasts the ADCV command set up by set_adc() to every LTC6804.
+*/
 void LTC6804_adcv()
 {
-
-  uint8_t cmd[4];
-  uint16_t temp_pec;
-
-  //1
-  cmd[0] = ADCV[0];
-  cmd[1] = ADCV[1];
-
-  //2
-  temp_pec = pec15_calc(2, ADCV);
-  cmd[2] = (uint8_t)(temp_pec >> 8);
-  cmd[3] = (uint8_t)(temp_pec);
-
-  //3
-  wakeup_idle (); //This will guarantee that the LTC6804 isoSPI port is awake. This command can be removed.
-
-  //4
-  output_low(LTC6804_CS);
-  spi_write_array(4,cmd);
-  output_high(LTC6804_CS);
-
+  LTC6804_select(LTC6804_chain.total_ic);
+  cmd_68(ADCV);
 }
-/*
-  LTC6804_adcv Function sequence:
-
-  1. Load adcv command into cmd array
-  2. Calculate adcv cmd PEC and load pec into cmd array
-  3. wakeup isoSPI port, this step can be removed if isoSPI status is previously guaranteed
-  4. send broadcast adcv command to LTC6804 stack
-*/
-
 
-/*!******************************************************************************************************
- \brief Start an GPIO Conversion
 
-  Starts an ADC conversions of the LTC6804 GPIO inputs.
-  The type of ADC conversion done is set using the associated global variables:
- |Variable|Function                                      |
- |--------|----------------------------------------------|
- | MD     | Determines the filter corner of the ADC      |
- | CHG    | Determines which GPIO channels are converted |
+/*!
+  \brief Start an GPIO Conversion
 
-*********************************************************************************************************/
+  Broadcasts the ADAX command set up by set_adc() to every LTC6804.
+*/
 void LTC6804_adax()
 {
-  uint8_t cmd[4];
-  uint16_t temp_pec;
-
-  cmd[0] = ADAX[0];
-  cmd[1] = ADAX[1];
-  temp_pec = pec15_calc(2, ADAX);
-  cmd[2] = (uint8_t)(temp_pec >> 8);
-  cmd[3] = (uint8_t)(temp_pec);
-
-  wakeup_idle (); //This will guarantee that the LTC6804 isoSPI port is awake. This command can be removed.
-  output_low(LTC6804_CS);
-  spi_write_array(4,cmd);
-  output_high(LTC6804_CS);
-
+  LTC6804_select(LTC6804_chain.total_ic);
+  cmd_68(ADAX);
 }
-/*
-  LTC6804_adax Function sequence:
-
-  1. Load adax command into cmd array
-  2. Calculate adax cmd PEC and load pec into cmd array
-  3. wakeup isoSPI port, this step can be removed if isoSPI status is previously guaranteed
-  4. send broadcast adax command to LTC6804 stack
-*/
 
 
 /***********************************************//**
  \brief Reads and parses the LTC6804 cell voltage registers.
 
- The function is used to read the cell codes of the LTC6804.
- This function will send the requested read commands parse the data
- and store the cell voltages in cell_codes variable.
-
-
-@param[in] uint8_t reg; This controls which cell voltage register is read back.
+ @param[in] uint8_t reg; This controls which cell voltage register is read back.
 
           0: Read back all Cell registers
 
@@ -239,112 +186,48 @@ void LTC6804_adax()
 
           4: Read back cell group D
 
-@param[in] uint8_t total_ic; This is the number of ICs in the network
-
+ @param[in] uint8_t total_ic; This is the number of ICs in the network, at addresses 0 to total_ic-1
 
-@param[out] uint16_t cell_codes[]; An array of the parsed cell codes from lowest to highest. The cell codes will
+ @param[out] uint16_t cell_codes[]; An array of the parsed cell codes from lowest to highest. The cell codes will
   be stored in the cell_codes[] array in the following format:
-  |  cell_codes[0]| cell_codes[1] |  cell_codes[2]|    .....     |  cell_codes[11]|  cell_codes[12]| cell_codes[13] |  .....   |
-  |---------------|----------------|--------------|--------------|----------------|----------------|----------------|----------|
-  |IC1 Cell 1     |IC1 Cell 2      |IC1 Cell 3    |    .....     |  IC1 Cell 12   |IC2 Cell 1      |IC2 Cell 2      | .....    |
+  |  cell_codes[0][0]| cell_codes[0][1] |  cell_codes[0][2]|    .....     |  cell_codes[0][11]|  cell_codes[1][0] | cell_codes[1][1]|  .....   |
+  |------------------|------------------|------------------|--------------|-------------------|-------------------|-----------------|----------|
+  |IC1 Cell 1        |IC1 Cell 2        |IC1 Cell 3        |    .....     |  IC1 Cell 12      |IC2 Cell 1         |IC2 Cell 2       | .....    |
 
- @return int8_t, PEC Status.
+  @return int8_t, PEC Status.
 
-  0: No PEC error detected
+    0: No PEC error detected
 
-  -1: PEC error detected, retry read
+    -1: PEC error detected, retry read
  *************************************************/
-uint8_t LTC6804_rdcv(uint8_t reg,
-                     uint8_t total_ic,
-                     uint16_t cell_codes[][12]
+uint8_t LTC6804_rdcv(uint8_t reg, // Controls which cell voltage register is read back.
+                     uint8_t total_ic, // the number of ICs in the system
+                     uint16_t cell_codes[][12] // Array of the parsed cell codes
                     )
 {
-
-  const uint8_t NUM_RX_BYT = 8;
-  const uint8_t BYT_IN_REG = 6;
-  const uint8_t CELL_IN_REG = 3;
-
   uint8_t *cell_data;
+  uint8_t ic_pec[4];
   int8_t pec_error = 0;
-  uint16_t parsed_cell;
-  uint16_t received_pec;
-  uint16_t data_pec;
-  uint8_t data_counter=0; //data counter
+
   cell_data = (uint8_t *) malloc((NUM_RX_BYT*total_ic)*sizeof(uint8_t));
-  //1.a
-  if (reg == 0)
+  for (uint8_t cell_reg = 1; cell_reg<5; cell_reg++)                    //executes once for each of the LTC6804 cell voltage registers
   {
-    //a.i
-    for (uint8_t cell_reg = 1; cell_reg<5; cell_reg++)               //executes once for each of the LTC6804 cell voltage registers
+    if (reg != 0 && reg != cell_reg)
     {
-      data_counter = 0;
-      LTC6804_rdcv_reg(cell_reg, total_ic,cell_data);
-      for (uint8_t current_ic = 0 ; current_ic < total_ic; current_ic++) // executes for every LTC6804 in the stack
-      {
-        // current_ic is used as an IC counter
-        //a.ii
-        for (uint8_t current_cell = 0; current_cell<CELL_IN_REG; current_cell++)                  // This loop parses the read back data. Loops
-        {
-          // once for each cell voltages in the register
-          parsed_cell = cell_data[data_counter] + (cell_data[data_counter + 1] << 8);
-          cell_codes[current_ic][current_cell  + ((cell_reg - 1) * CELL_IN_REG)] = parsed_cell;
-          data_counter = data_counter + 2;
-        }
-        //a.iii
-        received_pec = (cell_data[data_counter] << 8) + cell_data[data_counter+1];
-        data_pec = pec15_calc(BYT_IN_REG, &cell_data[current_ic * NUM_RX_BYT ]);
-        if (received_pec != data_pec)
-        {
-          pec_error = -1;
-        }
-        data_counter=data_counter+2;
-      }
+      continue;
     }
-  }
-//1.b
-  else
-  {
-    //b.i
-
-    LTC6804_rdcv_reg(reg, total_ic,cell_data);
-    for (uint8_t current_ic = 0 ; current_ic < total_ic; current_ic++) // executes for every LTC6804 in the stack
+    LTC6804_rdcv_reg(cell_reg, total_ic, cell_data);                //Reads a single Cell voltage register
+    for (uint8_t current_ic = 0 ; current_ic < total_ic; current_ic++)      // executes for every LTC6804
     {
-      // current_ic is used as an IC counter
-      //b.ii
-      for (uint8_t current_cell = 0; current_cell < CELL_IN_REG; current_cell++)                    // This loop parses the read back data. Loops
-      {
-        // once for each cell voltage in the register
-        parsed_cell = cell_data[data_counter] + (cell_data[data_counter+1]<<8);
-        cell_codes[current_ic][current_cell + ((reg - 1) * CELL_IN_REG)] = 0x0000FFFF & parsed_cell;
-        data_counter= data_counter + 2;
-      }
-      //b.iii
-      received_pec = (cell_data[data_counter] << 8 )+ cell_data[data_counter + 1];
-      data_pec = pec15_calc(BYT_IN_REG, &cell_data[current_ic * NUM_RX_BYT]);
-      if (received_pec != data_pec)
+      if (parse_cells(current_ic, cell_reg, cell_data, &cell_codes[current_ic][0], ic_pec) != 0)
       {
         pec_error = -1;
       }
     }
   }
   free(cell_data);
-//2
   return(pec_error);
 }
-/*
-  LTC6804_rdcv Sequence
-
-  1. Switch Statement:
-    a. Reg = 0
-      i. Read cell voltage registers A-D for every IC in the stack
-      ii. Parse raw cell voltage data in cell_codes array
-      iii. Check the PEC of the data read back vs the calculated PEC for each read register command
-    b. Reg != 0
-      i.Read single cell voltage register for all ICs in stack
-      ii. Parse raw cell voltage data in cell_codes array
-      iii. Check the PEC of the data read back vs the calculated PEC for each read register command
-  2. Return pec_error flag
-*/
 
 
 /***********************************************//**
@@ -364,75 +247,24 @@ uint8_t LTC6804_rdcv(uint8_t reg,
 
           4: Read back cell group D
 
- @param[in] uint8_t total_ic; This is the number of ICs in the network
+ @param[in] uint8_t total_ic; This is the number of ICs in the network, at addresses 0 to total_ic-1
 
- @param[out] uint8_t *data; An array of the unparsed cell codes
+ @param[out] uint8_t *data; An array of the unparsed cell codes, 8 bytes per IC
  *************************************************/
-void LTC6804_rdcv_reg(uint8_t reg,
-                      uint8_t total_ic,
-                      uint8_t *data
+void LTC6804_rdcv_reg(uint8_t reg, //Determines which cell voltage register is read back
+                      uint8_t total_ic, //the number of ICs in the
+                      uint8_t *data //An array of the unparsed cell codes
                      )
 {
-  uint8_t cmd[4];
-  uint16_t temp_pec;
-
-  //1
-  if (reg == 1)
-  {
-    cmd[1] = 0x04;
-    cmd[0] = 0x00;
-  }
-  else if (reg == 2)
-  {
-    cmd[1] = 0x06;
-    cmd[0] = 0x00;
-  }
-  else if (reg == 3)
-  {
-    cmd[1] = 0x08;
-    cmd[0] = 0x00;
-  }
-  else if (reg == 4)
-  {
-    cmd[1] = 0x0A;
-    cmd[0] = 0x00;
-  }
-
-  //2
-
-
-  //3
-  wakeup_idle (); //This will guarantee that the LTC6804 isoSPI port is awake. This command can be removed.
-
-  //4
-  for (int current_ic = 0; current_ic<total_ic; current_ic++)
-  {
-    cmd[0] = 0x80 + (current_ic<<3); //Setting address
-    temp_pec = pec15_calc(2, cmd);
-    cmd[2] = (uint8_t)(temp_pec >> 8);
-    cmd[3] = (uint8_t)(temp_pec);
-    output_low(LTC6804_CS);
-    spi_write_read(cmd,4,&data[current_ic*8],8);
-    output_high(LTC6804_CS);
-  }
+  LTC6804_select(total_ic);
+  LTC681x_rdcv_reg(reg, total_ic, data);
 }
-/*
-  LTC6804_rdcv_reg Function Process:
-  1. Determine Command and initialize command array
-  2. Calculate Command PEC
-  3. Wake up isoSPI, this step is optional
-  4. Send Global Command to LTC6804 stack
-*/
 
 
 /***********************************************************************************//**
  \brief Reads and parses the LTC6804 auxiliary registers.
 
- The function is used
- to read the  parsed GPIO codes of the LTC6804. This function will send the requested
- read commands parse the data and store the gpio voltages in aux_codes variable
-
- @param[in] uint8_t reg; This controls which GPIO voltage register is read back.
+@param[in] uint8_t reg; This controls which GPIO voltage register is read back.
 
           0: Read back all auxiliary registers
 
@@ -440,91 +272,40 @@ void LTC6804_rdcv_reg(uint8_t reg,
 
           2: Read back auxiliary group B
 
+@param[in] uint8_t total_ic; This is the number of ICs in the network, at addresses 0 to total_ic-1
 
- @param[in] uint8_t total_ic; This is the number of ICs in the network
+ @param[out] uint16_t aux_codes[][6]; A two dimensional array of the gpio voltage codes. The GPIO codes will
+ be stored in the aux_codes[][6] array in the following format:
+ |  aux_codes[0][0]| aux_codes[0][1] |  aux_codes[0][2]|  aux_codes[0][3]|  aux_codes[0][4]|  aux_codes[0][5]| aux_codes[1][0] |aux_codes[1][1]|  .....    |
+ |-----------------|-----------------|-----------------|-----------------|-----------------|-----------------|-----------------|---------------|-----------|
+ |IC1 GPIO1        |IC1 GPIO2        |IC1 GPIO3        |IC1 GPIO4        |IC1 GPIO5        |IC1 Vref2        |IC2 GPIO1        |IC2 GPIO2      |  .....    |
 
- @param[out] uint8_t aux_codes[]; An array of the aux codes from lowest to highest. The GPIO codes will
- be stored in the aux_codes[] array in the following format:
- |  aux_codes[0]| aux_codes[1] |  aux_codes[2]|  aux_codes[3]|  aux_codes[4]|  aux_codes[5]| aux_codes[6] |aux_codes[7]|  .....    |
- |--------------|--------------|--------------|--------------|--------------|--------------|--------------|------------|-----------|
- |IC1 GPIO1     |IC1 GPIO2     |IC1 GPIO3     |IC1 GPIO4     |IC1 GPIO5     |IC1 Vref2     |IC2 GPIO1     |IC2 GPIO2   |  .....    |
-
-
- @return int8_t, PEC Status.
+@return  int8_t, PEC Status
 
   0: No PEC error detected
 
-  -1: PEC error detected, retry read
+ -1: PEC error detected, retry read
  *************************************************/
-int8_t LTC6804_rdaux(uint8_t reg,
-                     uint8_t total_ic,
-                     uint16_t aux_codes[][6]
+int8_t LTC6804_rdaux(uint8_t reg, //Determines which GPIO voltage register is read back.
+                     uint8_t total_ic,//the number of ICs in the system
+                     uint16_t aux_codes[][6]//A two dimensional array of the gpio voltage codes.
                     )
 {
-
-
-  const uint8_t NUM_RX_BYT = 8;
-  const uint8_t BYT_IN_REG = 6;
-  const uint8_t GPIO_IN_REG = 3;
-
   uint8_t *data;
-  uint8_t data_counter = 0;
+  uint8_t ic_pec[2];
   int8_t pec_error = 0;
-  uint16_t received_pec;
-  uint16_t data_pec;
+
   data = (uint8_t *) malloc((NUM_RX_BYT*total_ic)*sizeof(uint8_t));
-  //1.a
-  if (reg == 0)
+  for (uint8_t gpio_reg = 1; gpio_reg<3; gpio_reg++)                //executes once for each of the LTC6804 aux voltage registers
   {
-    //a.i
-    for (uint8_t gpio_reg = 1; gpio_reg<3; gpio_reg++)           //executes once for each of the LTC6804 aux voltage registers
+    if (reg != 0 && reg != gpio_reg)
     {
-      data_counter = 0;
-      LTC6804_rdaux_reg(gpio_reg, total_ic,data);
-      for (uint8_t current_ic = 0 ; current_ic < total_ic; current_ic++) // This loop executes once for each LTC6804
-      {
-        // current_ic is used as an IC counter
-        //a.ii
-        for (uint8_t current_gpio = 0; current_gpio< GPIO_IN_REG; current_gpio++) // This loop parses GPIO voltages stored in the register
-        {
-
-          aux_codes[current_ic][current_gpio +((gpio_reg-1)*GPIO_IN_REG)] = data[data_counter] + (data[data_counter+1]<<8);
-          data_counter=data_counter+2;
-
-        }
-        //a.iii
-        received_pec = (data[data_counter]<<8)+ data[data_counter+1];
-        data_pec = pec15_calc(BYT_IN_REG, &data[current_ic*NUM_RX_BYT]);
-        if (received_pec != data_pec)
-        {
-          pec_error = -1;
-        }
-
-        data_counter=data_counter+2;
-      }
-
-
+      continue;
     }
-
-  }
-  else
-  {
-    //b.i
-    LTC6804_rdaux_reg(reg, total_ic, data);
-    for (int current_ic = 0 ; current_ic < total_ic; current_ic++) // executes for every LTC6804 in the stack
+    LTC6804_rdaux_reg(gpio_reg, total_ic, data);                 //Reads the raw auxiliary register data into the data[] array
+    for (uint8_t current_ic = 0 ; current_ic < total_ic; current_ic++)      // executes for every LTC6804
     {
-      // current_ic is used as an IC counter
-      //b.ii
-      for (int current_gpio = 0; current_gpio<GPIO_IN_REG; current_gpio++)  // This loop parses the read back data. Loops
-      {
-        // once for each aux voltage in the register
-        aux_codes[current_ic][current_gpio +((reg-1)*GPIO_IN_REG)] = 0x0000FFFF & (data[data_counter] + (data[data_counter+1]<<8));
-        data_counter=data_counter+2;
-      }
-      //b.iii
-      received_pec = (data[data_counter]<<8) + data[data_counter+1];
-      data_pec = pec15_calc(6, &data[current_ic*8]);
-      if (received_pec != data_pec)
+      if (parse_cells(current_ic, gpio_reg, data, &aux_codes[current_ic][0], ic_pec) != 0)
       {
         pec_error = -1;
       }
@@ -533,20 +314,6 @@ int8_t LTC6804_rdaux(uint8_t reg,
   free(data);
   return (pec_error);
 }
-/*
-  LTC6804_rdaux Sequence
-
-  1. Switch Statement:
-    a. Reg = 0
-      i. Read GPIO voltage registers A-D for every IC in the stack
-      ii. Parse raw GPIO voltage data in cell_codes array
-      iii. Check the PEC of the data read back vs the calculated PEC for each read register command
-    b. Reg != 0
-      i.Read single GPIO voltage register for all ICs in stack
-      ii. Parse raw GPIO voltage data in cell_codes array
-      iii. Check the PEC of the data read back vs the calculated PEC for each read register command
-  2. Return pec_error flag
-*/
 
 
 /***********************************************//**
@@ -562,61 +329,19 @@ int8_t LTC6804_rdaux(uint8_t reg,
 
           2: Read back auxiliary group B
 
+@param[in] uint8_t total_ic; This is the number of ICs in the network, at addresses 0 to total_ic-1
 
- @param[in] uint8_t total_ic; This is the number of ICs in the stack
-
- @param[out] uint8_t *data; An array of the unparsed aux codes
+@param[out] uint8_t *data; An array of the unparsed aux codes, 8 bytes per IC
  *************************************************/
-void LTC6804_rdaux_reg(uint8_t reg,
-                       uint8_t total_ic,
-                       uint8_t *data
+void LTC6804_rdaux_reg(uint8_t reg, //Determines which GPIO voltage register is read back
+                       uint8_t total_ic, //The number of ICs in the system
+                       uint8_t *data //Array of the unparsed auxiliary codes
                       )
 {
-  uint8_t cmd[4];
-  uint16_t cmd_pec;
-
-  //1
-  if (reg == 1)
-  {
-    cmd[1] = 0x0C;
-    cmd[0] = 0x00;
-  }
-  else if (reg == 2)
-  {
-    cmd[1] = 0x0e;
-    cmd[0] = 0x00;
-  }
-  else
-  {
-    cmd[1] = 0x0C;
-    cmd[0] = 0x00;
-  }
-  //2
-  cmd_pec = pec15_calc(2, cmd);
-  cmd[2] = (uint8_t)(cmd_pec >> 8);
-  cmd[3] = (uint8_t)(cmd_pec);
-
-  //3
-  wakeup_idle (); //This will guarantee that the LTC6804 isoSPI port is awake, this command can be removed.
-  //4
-  for (int current_ic = 0; current_ic<total_ic; current_ic++)
-  {
-    cmd[0] = 0x80 + (current_ic<<3); //Setting address
-    cmd_pec = pec15_calc(2, cmd);
-    cmd[2] = (uint8_t)(cmd_pec >> 8);
-    cmd[3] = (uint8_t)(cmd_pec);
-    output_low(LTC6804_CS);
-    spi_write_read(cmd,4,&data[current_ic*8],8);
-    output_high(LTC6804_CS);
-  }
+  LTC6804_select(total_ic);
+  LTC681x_rdaux_reg((reg == 2) ? 2 : 1, total_ic, data);
 }
-/*
-  LTC6804_rdaux_reg Function Process:
-  1. Determine Command and initialize command array
-  2. Calculate Command PEC
-  3. Wake up isoSPI, this step is optional
-  4. Send Global Command to LTC6804 stack
-*/
+
 
 /********************************************************//**
  \brief Clears the LTC6804 cell voltage registers
@@ -627,34 +352,9 @@ void LTC6804_rdaux_reg(uint8_t reg,
 ************************************************************/
 void LTC6804_clrcell()
 {
-  uint8_t cmd[4];
-  uint16_t cmd_pec;
-
-  //1
-  cmd[0] = 0x07;
-  cmd[1] = 0x11;
-
-  //2
-  cmd_pec = pec15_calc(2, cmd);
-  cmd[2] = (uint8_t)(cmd_pec >> 8);
-  cmd[3] = (uint8_t)(cmd_pec );
-
-  //3
-  wakeup_idle (); //This will guarantee that the LTC6804 isoSPI port is awake. This command can be removed.
-
-  //4
-  output_low(LTC6804_CS);
-  spi_write_read(cmd,4,0,0);
-  output_high(LTC6804_CS);
+  LTC6804_select(LTC6804_chain.total_ic);
+  LTC681x_clrcell();
 }
-/*
-  LTC6804_clrcell Function sequence:
-
-  1. Load clrcell command into cmd array
-  2. Calculate clrcell cmd PEC and load pec into cmd array
-  3. wakeup isoSPI port, this step can be removed if isoSPI status is previously guaranteed
-  4. send broadcast clrcell command to LTC6804 stack
-*/
 
 
 /***********************************************************//**
@@ -666,194 +366,63 @@ void LTC6804_clrcell()
 ***************************************************************/
 void LTC6804_clraux()
 {
-  uint8_t cmd[4];
-  uint16_t cmd_pec;
-
-  //1
-  cmd[0] = 0x07;
-  cmd[1] = 0x12;
-
-  //2
-  cmd_pec = pec15_calc(2, cmd);
-  cmd[2] = (uint8_t)(cmd_pec >> 8);
-  cmd[3] = (uint8_t)(cmd_pec);
-
-  //3
-  wakeup_idle (); //This will guarantee that the LTC6804 isoSPI port is awake.This command can be removed.
-  //4
-  output_low(LTC6804_CS);
-  spi_write_read(cmd,4,0,0);
-  output_high(LTC6804_CS);
+  LTC6804_select(LTC6804_chain.total_ic);
+  LTC681x_clraux();
 }
-/*
-  LTC6804_clraux Function sequence:
-
-  1. Load clraux command into cmd array
-  2. Calculate clraux cmd PEC and load pec into cmd array
-  3. wakeup isoSPI port, this step can be removed if isoSPI status is previously guaranteed
-  4. send broadcast clraux command to LTC6804 stack
-*/
 
 
 /*****************************************************//**
  \brief Write the LTC6804 configuration register
 
- This command will write the configuration registers of the stacks
- connected in a stack stack. The configuration is written in descending
- order so the last device's configuration is written first.
+ @param[in] uint8_t total_ic; This is the number of ICs in the network, at addresses 0 to total_ic-1
 
-
-@param[in] uint8_t total_ic; The number of ICs being written.
-
-@param[in] uint8_t *config an array of the configuration data that will be written, the array should contain the 6 bytes for each
- IC in the stack. The lowest IC in the stack should be the first 6 byte block in the array. The array should
+ @param[in] uint8_t config[][6] is a two dimensional array of the configuration data that will be written, the array should contain the 6 bytes for each
+ IC. The lowest IC should be the first 6 byte block in the array. The array should
  have the following format:
- |  config[0]| config[1] |  config[2]|  config[3]|  config[4]|  config[5]| config[6] |  config[7]|  config[8]|  .....    |
- |-----------|-----------|-----------|-----------|-----------|-----------|-----------|-----------|-----------|-----------|
- |IC1 CFGR0  |IC1 CFGR1  |IC1 CFGR2  |IC1 CFGR3  |IC1 CFGR4  |IC1 CFGR5  |IC2 CFGR0  |IC2 CFGR1  | IC2 CFGR2 |  .....    |
-
- The function will calculate the needed PEC codes for the write data
- and then transmit data to the ICs on a stack.
+ |  config[0][0]| config[0][1] |  config[0][2]|  config[0][3]|  config[0][4]|  config[0][5]| config[1][0] |  config[1][1]|  config[1][2]|  .....    |
+ |--------------|--------------|--------------|--------------|--------------|--------------|--------------|--------------|--------------|-----------|
+ |IC1 CFGR0     |IC1 CFGR1     |IC1 CFGR2     |IC1 CFGR3     |IC1 CFGR4     |IC1 CFGR5     |IC2 CFGR0     |IC2 CFGR1     | IC2 CFGR2    |  .....    |
 ********************************************************/
-void LTC6804_wrcfg(uint8_t total_ic,uint8_t config[][6])
+void LTC6804_wrcfg(uint8_t total_ic, //The number of ICs being written to
+                   uint8_t config[][6] //A two dimensional array of the configuration data that will be written
+                  )
 {
-  const uint8_t BYTES_IN_REG = 6;
-  const uint8_t CMD_LEN = 4+(8*total_ic);
-  uint8_t *cmd;
-  uint16_t temp_pec;
-  uint8_t cmd_index; //command counter
-
-  cmd = (uint8_t *)malloc(CMD_LEN*sizeof(uint8_t));
-  //1
-  cmd[0] = 0x00;
-  cmd[1] = 0x01;
-  cmd[2] = 0x3d;
-  cmd[3] = 0x6e;
-
-  //2
-  cmd_index = 4;
-  for (uint8_t current_ic = 0; current_ic < total_ic ; current_ic++)       // executes for each LTC6804 in stack,
-  {
-    for (uint8_t current_byte = 0; current_byte < BYTES_IN_REG; current_byte++) // executes for each byte in the CFGR register
-    {
-      // i is the byte counter
+  uint8_t cmd[2] = {0x00, 0x01};
 
-      cmd[cmd_index] = config[current_ic][current_byte];    //adding the config data to the array to be sent
-      cmd_index = cmd_index + 1;
-    }
-    //3
-    temp_pec = (uint16_t)pec15_calc(BYTES_IN_REG, &config[current_ic][0]);// calculating the PEC for each board
-    cmd[cmd_index] = (uint8_t)(temp_pec >> 8);
-    cmd[cmd_index + 1] = (uint8_t)temp_pec;
-    cmd_index = cmd_index + 2;
-  }
-
-  //4
-  wakeup_idle ();                                //This will guarantee that the LTC6804 isoSPI port is awake.This command can be removed.
-  //5
-  for (int current_ic = 0; current_ic<total_ic; current_ic++)
-  {
-    cmd[0] = 0x80 + (current_ic<<3); //Setting address
-    temp_pec = pec15_calc(2, cmd);
-    cmd[2] = (uint8_t)(temp_pec >> 8);
-    cmd[3] = (uint8_t)(temp_pec);
-    output_low(LTC6804_CS);
-    spi_write_array(4,cmd);
-    spi_write_array(8,&cmd[4+(8*current_ic)]);
-    output_high(LTC6804_CS);
-  }
-  free(cmd);
+  LTC6804_select(total_ic);
+  write_68(total_ic, cmd, &config[0][0]);
 }
-/*
-  1. Load cmd array with the write configuration command and PEC
-  2. Load the cmd with LTC6804 configuration data
-  3. Calculate the pec for the LTC6804 configuration data being transmitted
-  4. wakeup isoSPI port, this step can be removed if isoSPI status is previously guaranteed
-  5. Write configuration of each LTC6804 on the stack
 
-*/
 
 /*!******************************************************
- \brief Reads configuration registers of a LTC6804 stack
+ \brief Reads configuration registers of a LTC6804
 
+ @param[in] uint8_t total_ic; This is the number of ICs in the network, at addresses 0 to total_ic-1
 
+ @param[out] uint8_t r_config[][8] is a two dimensional array that the function stores the read configuration data. The configuration data for each IC
+ is stored in blocks of 8 bytes with the configuration data of the lowest IC on the stack in the first 8 bytes
+ block of the array, the second IC in the second 8 byte etc. Below is an table illustrating the array organization:
 
+ |r_config[0][0]|r_config[0][1]|r_config[0][2]|r_config[0][3]|r_config[0][4]|r_config[0][5]|r_config[0][6]  |r_config[0][7] |r_config[1][0]|r_config[1][1]|  .....    |
+ |--------------|--------------|--------------|--------------|--------------|--------------|----------------|---------------|--------------|--------------|-----------|
+ |IC1 CFGR0     |IC1 CFGR1     |IC1 CFGR2     |IC1 CFGR3     |IC1 CFGR4     |IC1 CFGR5     |IC1 PEC High    |IC1 PEC Low    |IC2 CFGR0     |IC2 CFGR1     |  .....    |
 
-@param[in] uint8_t total_ic: number of ICs in the stack
-
-@param[out] uint8_t *r_config: array that the function will write configuration data to. The configuration data for each IC
-is stored in blocks of 8 bytes with the configuration data of the lowest IC on the stack in the first 8 bytes
-of the array, the second IC in the second 8 byte etc. Below is an table illustrating the array organization:
-
-|r_config[0]|r_config[1]|r_config[2]|r_config[3]|r_config[4]|r_config[5]|r_config[6]  |r_config[7] |r_config[8]|r_config[9]|  .....    |
-|-----------|-----------|-----------|-----------|-----------|-----------|-------------|------------|-----------|-----------|-----------|
-|IC1 CFGR0  |IC1 CFGR1  |IC1 CFGR2  |IC1 CFGR3  |IC1 CFGR4  |IC1 CFGR5  |IC1 PEC High |IC1 PEC Low |IC2 CFGR0  |IC2 CFGR1  |  .....    |
-
+ @return int8_t, PEC Status.
 
-@return int8_t PEC Status.
   0: Data read back has matching PEC
 
   -1: Data read back has incorrect PEC
 ********************************************************/
-int8_t LTC6804_rdcfg(uint8_t total_ic, uint8_t r_config[][8])
+int8_t LTC6804_rdcfg(uint8_t total_ic, //Number of ICs in the system
+                     uint8_t r_config[][8] //A two dimensional array that the function stores the read configuration data.
+                    )
 {
-  const uint8_t BYTES_IN_REG = 8;
+  uint8_t cmd[2] = {0x00, 0x02};
 
-  uint8_t cmd[4];
-  uint8_t *rx_data;
-  int8_t pec_error = 0;
-  uint16_t data_pec;
-  uint16_t received_pec;
-  rx_data = (uint8_t *) malloc((8*total_ic)*sizeof(uint8_t));
-  //1
-  cmd[0] = 0x00;
-  cmd[1] = 0x02;
-  cmd[2] = 0x2b;
-  cmd[3] = 0x0A;
-
-  //2
-  wakeup_idle (); //This will guarantee that the LTC6804 isoSPI port is awake. This command can be removed.
-  //3
-  for (int current_ic = 0; current_ic<total_ic; current_ic++)
-  {
-    cmd[0] = 0x80 + (current_ic<<3); //Setting address
-    data_pec = pec15_calc(2, cmd);
-    cmd[2] = (uint8_t)(data_pec >> 8);
-    cmd[3] = (uint8_t)(data_pec);
-    output_low(LTC6804_CS);
-    spi_write_read(cmd,4,&rx_data[current_ic*8],8);
-    output_high(LTC6804_CS);
-  }
-
-  for (uint8_t current_ic = 0; current_ic < total_ic; current_ic++) //executes for each LTC6804 in the stack
-  {
-    //4.a
-    for (uint8_t current_byte = 0; current_byte < BYTES_IN_REG; current_byte++)
-    {
-      r_config[current_ic][current_byte] = rx_data[current_byte + (current_ic*BYTES_IN_REG)];
-    }
-    //4.b
-    received_pec = (r_config[current_ic][6]<<8) + r_config[current_ic][7];
-    data_pec = pec15_calc(6, &r_config[current_ic][0]);
-    if (received_pec != data_pec)
-    {
-      pec_error = -1;
-    }
-  }
-  free(rx_data);
-  //5
-  return(pec_error);
+  LTC6804_select(total_ic);
+  return(read_68(total_ic, cmd, &r_config[0][0]));
 }
-/*
-  1. Load cmd array with the write configuration command and PEC
-  2. wakeup isoSPI port, this step can be removed if isoSPI status is previously guaranteed
-  3. read configuration of each LTC6804 on the stack
-  4. For each LTC6804 in the stack
-    a. load configuration data into r_config array
-    b. calculate PEC of received data and compare against calculated PEC
-  5. Return PEC Error
 
-*/
 
 /*!****************************************************
   \brief Wake isoSPI up from idle state
@@ -861,11 +430,11 @@ int8_t LTC6804_rdcfg(uint8_t total_ic, uint8_t r_config[][8])
  *****************************************************/
 void wakeup_idle()
 {
-  output_low(LTC6804_CS);
-  delayMicroseconds(10); //Guarantees the isoSPI will be in ready mode
-  output_high(LTC6804_CS);
+  LTC681x_select_chain(&LTC6804_chain);
+  wakeup_idle(1);
 }
 
+
 /*!****************************************************
   \brief Wake the LTC6804 from the sleep state
 
@@ -873,79 +442,7 @@ void wakeup_idle()
  *****************************************************/
 void wakeup_sleep()
 {
-  output_low(LTC6804_CS);
-  delay(1); // Guarantees the LTC6804 will be in standby
-  output_high(LTC6804_CS);
-}
-/*!**********************************************************
- \brief calaculates  and returns the CRC15
-
-
-@param[in]  uint8_t len: the length of the data array being passed to the function
-
-@param[in]  uint8_t data[] : the array of data that the PEC will be generated from
-
-
-@return  The calculated pec15 as an unsigned int16_t
-***********************************************************/
-uint16_t pec15_calc(uint8_t len, uint8_t *data)
-{
-  uint16_t remainder,addr;
-
-  remainder = 16;//initialize the PEC
-  for (uint8_t i = 0; i<len; i++) // loops for each byte in data array
-  {
-    addr = ((remainder>>7)^data[i])&0xff;//calculate PEC table address
-    remainder = (remainder<<8)^crc15Table[addr];
-  }
-  return(remainder*2);//The CRC15 has a 0 in the LSB so the remainder must be multiplied by 2
-}
-
-
-/*!
- \brief Writes an array of bytes out of the SPI port
-
- @param[in] uint8_t len length of the data array being written on the SPI port
- @param[in] uint8_t data[] the data array to be written on the SPI port
-
-*/
-void spi_write_array(uint8_t len, // Option: Number of bytes to be written on the SPI port
-                     uint8_t data[] //Array of bytes to be written on the SPI port
-                    )
-{
-  for (uint8_t i = 0; i < len; i++)
-  {
-    spi_write((char)data[i]);
-  }
+  cs_low(LTC6804_CS);
+  delay_m(1); // Guarantees the LTC6804 will be in standby
+  cs_high(LTC6804_CS);
 }
-/*!
- \brief Writes and read a set number of bytes using the SPI port.
-
-@param[in] uint8_t tx_data[] array of data to be written on the SPI port
-@param[in] uint8_t tx_len length of the tx_data array
-@param[out] uint8_t rx_data array that read data will be written too.
-@param[in] uint8_t rx_len number of bytes to be read from the SPI port.
-
-*/
-
-void spi_write_read(uint8_t tx_Data[],//array of data to be written on SPI port
-                    uint8_t tx_len, //length of the tx data arry
-                    uint8_t *rx_data,//Input: array that will store the data read by the SPI port
-                    uint8_t rx_len //Option: number of bytes to be read from the SPI port
-                   )
-{
-  for (uint8_t i = 0; i < tx_len; i++)
-  {
-    spi_write(tx_Data[i]);
-
-  }
-
-  for (uint8_t i = 0; i < rx_len; i++)
-  {
-    rx_data[i] = (uint8_t)spi_read(0xFF);
-  }
-
-}
-
-
-
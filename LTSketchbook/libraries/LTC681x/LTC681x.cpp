@@ -50,14 +50,37 @@
 #include <Arduino.h>
 #endif
 
+/* Chain selected by LTC681x_select_chain(). NULL is the single chain on CS_PIN. */
+static isospi_chain *active_chain = NULL;
+static uint8_t active_cs_pin = CS_PIN;
+
+/* Returns the selected chain's scratch buffer if it holds len bytes, else allocates one */
+static uint8_t *scratch_alloc(uint16_t len)
+{
+	if ((active_chain != NULL) && (active_chain->scratch != NULL) && (len <= LTC681x_SCRATCH_SIZE(active_chain->total_ic)))
+	{
+		return(active_chain->scratch);
+	}
+	return((uint8_t *)malloc(len*sizeof(uint8_t)));
+}
+
+/* Releases a buffer returned by scratch_alloc() */
+static void scratch_free(uint8_t *data)
+{
+	if ((active_chain == NULL) || (data != active_chain->scratch))
+	{
+		free(data);
+	}
+}
+
 /* Wake isoSPI up from IDlE state and enters the READY state */
 void wakeup_idle(uint8_t total_ic) //Number of ICs in the system
 {
 	for (int i =0; i<total_ic; i++)
 	{
-	   cs_low(CS_PIN);
+	   cs_low(active_cs_pin);
 	   spi_read_byte(0xff);//Guarantees the isoSPI will be in ready mode
-	   cs_high(CS_PIN);
+	   cs_high(active_cs_pin);
 	}
 }
 
@@ -66,9 +89,9 @@ void wakeup_sleep(uint8_t total_ic) //Number of ICs in the system
 {
 	for (int i =0; i<total_ic; i++)
 	{
-	   cs_low(CS_PIN);
+	   cs_low(active_cs_pin);
 	   delay_u(300); // Guarantees the LTC681x will be in standby
-	   cs_high(CS_PIN);
+	   cs_high(active_cs_pin);
 	   delay_u(10);
 	}
 }
@@ -86,9 +109,47 @@ void cmd_68(uint8_t tx_cmd[2]) //The command to be transmitted
 	cmd[2] = (uint8_t)(cmd_pec >> 8);
 	cmd[3] = (uint8_t)(cmd_pec);
 	
-	cs_low(CS_PIN);
+	cs_low(active_cs_pin);
 	spi_write_array(4,cmd);
-	cs_high(CS_PIN);
+	cs_high(active_cs_pin);
+}
+
+/*
+Sends a read command and reads one register group of every IC into data[], 8 bytes per IC.
+Addressed chains are read one IC at a time, daisy chains in one transfer.
+*/
+static void transfer_68(uint8_t total_ic, // Number of ICs in the daisy chain
+                        uint8_t tx_cmd[2], // The command to be transmitted
+                        uint8_t *data // total_ic*8 bytes of unparsed data
+                       )
+{
+	const uint8_t REG_LEN = 8;
+	uint8_t cmd[4];
+	uint16_t cmd_pec;
+
+	cmd[0] = tx_cmd[0];
+	cmd[1] = tx_cmd[1];
+	if (active_chain == NULL || !active_chain->addressed)
+	{
+		cmd_pec = pec15_calc(2, cmd);
+		cmd[2] = (uint8_t)(cmd_pec >> 8);
+		cmd[3] = (uint8_t)(cmd_pec);
+		cs_low(active_cs_pin);
+		spi_write_read(cmd, 4, data, (REG_LEN*total_ic));
+		cs_high(active_cs_pin);
+		return;
+	}
+
+	for (uint8_t current_ic = 0; current_ic < total_ic; current_ic++)
+	{
+		cmd[0] = 0x80 + (current_ic<<3) + (tx_cmd[0] & 0x07); //Setting address
+		cmd_pec = pec15_calc(2, cmd);
+		cmd[2] = (uint8_t)(cmd_pec >> 8);
+		cmd[3] = (uint8_t)(cmd_pec);
+		cs_low(active_cs_pin);
+		spi_write_read(cmd, 4, &data[current_ic*REG_LEN], REG_LEN);
+		cs_high(active_cs_pin);
+	}
 }
 
 /* 
@@ -107,6 +168,30 @@ void write_68(uint8_t total_ic, //Number of ICs to be written to
 	uint16_t cmd_pec;
 	uint8_t cmd_index;
 	
+	if (active_chain != NULL && active_chain->addressed)
+	{
+		uint8_t frame[12];
+		for (uint8_t current_ic = 0; current_ic < total_ic; current_ic++)  // Addressed ICs are written one at a time
+		{
+			frame[0] = 0x80 + (current_ic<<3) + (tx_cmd[0] & 0x07); //Setting address
+			frame[1] = tx_cmd[1];
+			cmd_pec = pec15_calc(2, frame);
+			frame[2] = (uint8_t)(cmd_pec >> 8);
+			frame[3] = (uint8_t)(cmd_pec);
+			for (uint8_t current_byte = 0; current_byte < BYTES_IN_REG; current_byte++)
+			{
+				frame[4+current_byte] = data[(current_ic*6)+current_byte];
+			}
+			data_pec = (uint16_t)pec15_calc(BYTES_IN_REG, &data[current_ic*6]);
+			frame[10] = (uint8_t)(data_pec >> 8);
+			frame[11] = (uint8_t)data_pec;
+			cs_low(active_cs_pin);
+			spi_write_array(12, frame);
+			cs_high(active_cs_pin);
+		}
+		return;
+	}
+
 	cmd = (uint8_t *)malloc(CMD_LEN*sizeof(uint8_t));
 	cmd[0] = tx_cmd[0];
 	cmd[1] = tx_cmd[1];
@@ -129,9 +214,9 @@ void write_68(uint8_t total_ic, //Number of ICs to be written to
 		cmd_index = cmd_index + 2;
 	}
 	
-	cs_low(CS_PIN);
+	cs_low(active_cs_pin);
 	spi_write_array(CMD_LEN, cmd);
-	cs_high(CS_PIN);
+	cs_high(active_cs_pin);
 	
 	free(cmd);
 }
@@ -142,31 +227,14 @@ int8_t read_68( uint8_t total_ic, // Number of ICs in the system
 				uint8_t *rx_data // Data to be read
 				)
 {
-	const uint8_t BYTES_IN_REG = 8;
-	uint8_t cmd[4];
-	uint8_t data[256];
 	int8_t pec_error = 0;
-	uint16_t cmd_pec;
 	uint16_t data_pec;
 	uint16_t received_pec;
 	
-	cmd[0] = tx_cmd[0];
-	cmd[1] = tx_cmd[1];
-	cmd_pec = pec15_calc(2, cmd);
-	cmd[2] = (uint8_t)(cmd_pec >> 8);
-	cmd[3] = (uint8_t)(cmd_pec);
-	
-	cs_low(CS_PIN);
-	spi_write_read(cmd, 4, data, (BYTES_IN_REG*total_ic));         //Transmits the command and reads the configuration data of all ICs on the daisy chain into rx_data[] array
-	cs_high(CS_PIN);                                         
+	transfer_68(total_ic, tx_cmd, rx_data);                        //Transmits the command and reads the register data of all ICs on the daisy chain into rx_data[]
 
-	for (uint8_t current_ic = 0; current_ic < total_ic; current_ic++) //Executes for each LTC681x in the daisy chain and packs the data
-	{																//into the rx_data array as well as check the received data for any bit errors
-		for (uint8_t current_byte = 0; current_byte < BYTES_IN_REG; current_byte++)
-		{
-			rx_data[(current_ic*8)+current_byte] = data[current_byte + (current_ic*BYTES_IN_REG)];
-		}
-		
+	for (uint8_t current_ic = 0; current_ic < total_ic; current_ic++) //Executes for each LTC681x in the daisy chain and checks the received data for any bit errors
+	{
 		received_pec = (rx_data[(current_ic*8)+6]<<8) + rx_data[(current_ic*8)+7];
 		data_pec = pec15_calc(6, &rx_data[current_ic*8]);
 		
@@ -179,6 +247,162 @@ int8_t read_68( uint8_t total_ic, // Number of ICs in the system
 	return(pec_error);
 }
 
+/* Initializes a chain context and the register limits of its ICs */
+void LTC681x_init_chain(isospi_chain *chain, // Chain context to be initialized
+                        uint8_t cs_pin, // Chip select of the chain's isoSPI interface
+                        uint8_t total_ic, // Number of ICs in the daisy chain
+                        uint16_t variant, // IC_LTC6810, IC_LTC6811, IC_LTC6812, IC_LTC6813 or IC_LTC6804
+                        cell_asic *ic, // Array of total_ic ICs
+                        uint8_t *scratch // LTC681x_SCRATCH_SIZE(total_ic) bytes, or NULL
+                       )
+{
+	chain->cs_pin = cs_pin;
+	chain->total_ic = total_ic;
+	chain->variant = variant;
+	chain->ic = ic;
+	chain->scratch = scratch;
+	chain->addressed = false;
+	LTC681x_init_reg_limits(total_ic, ic, variant);
+	cs_init(cs_pin);
+}
+
+/* Sets the register limits of the ICs for the given variant */
+void LTC681x_init_reg_limits(uint8_t total_ic, // Number of ICs in the system
+                             cell_asic *ic, // A two dimensional array that will store the data
+                             uint16_t variant // IC_LTC6810, IC_LTC6811, IC_LTC6812, IC_LTC6813 or IC_LTC6804
+                            )
+{
+	register_cfg cfg;
+
+	switch (variant)
+	{
+		case IC_LTC6810:
+			cfg.cell_channels = 6;
+			cfg.aux_channels = 6;
+			cfg.num_cv_reg = 2;
+			cfg.num_gpio_reg = 2;
+			cfg.num_stat_reg = 3;
+			break;
+		case IC_LTC6811:
+			cfg.cell_channels = 12;
+			cfg.aux_channels = 6;
+			cfg.num_cv_reg = 4;
+			cfg.num_gpio_reg = 2;
+			cfg.num_stat_reg = 3;
+			break;
+		case IC_LTC6804:
+			cfg.cell_channels = 12;
+			cfg.aux_channels = 6;
+			cfg.num_cv_reg = 4;
+			cfg.num_gpio_reg = 2;
+			cfg.num_stat_reg = 2;
+			break;
+		case IC_LTC6812:
+			cfg.cell_channels = 15;
+			cfg.aux_channels = 9;
+			cfg.num_cv_reg = 5;
+			cfg.num_gpio_reg = 4;
+			cfg.num_stat_reg = 2;
+			break;
+		case IC_LTC6813:
+		default:
+			cfg.cell_channels = 18;
+			cfg.aux_channels = 9;
+			cfg.num_cv_reg = 6;
+			cfg.num_gpio_reg = 4;
+			cfg.num_stat_reg = 2;
+			break;
+	}
+	cfg.stat_channels = 4;
+	for (uint8_t cic = 0; cic < total_ic; cic++)
+	{
+		ic[cic].ic_reg = cfg;
+	}
+}
+
+/* Selects the chain that the functions without a chain argument talk to */
+void LTC681x_select_chain(isospi_chain *chain) // Chain to be selected, or NULL for CS_PIN
+{
+	active_chain = chain;
+	active_cs_pin = (chain != NULL) ? chain->cs_pin : CS_PIN;
+}
+
+/* Wakes the isoSPI of a chain from IDLE state */
+void LTC681x_chain_wakeup_idle(isospi_chain *chain) // Chain context
+{
+	LTC681x_select_chain(chain);
+	wakeup_idle(chain->total_ic);
+}
+
+/* Writes the CFGRA register of every IC of a chain */
+void LTC681x_chain_wrcfg(isospi_chain *chain) // Chain context
+{
+	LTC681x_select_chain(chain);
+	LTC681x_wrcfg(chain->total_ic, chain->ic);
+}
+
+/* Starts cell voltage conversion on a chain without waiting for it */
+void LTC681x_chain_adcv(isospi_chain *chain, // Chain context
+                        uint8_t MD, // ADC Mode
+                        uint8_t DCP, // Discharge Permit
+                        uint8_t CH // Cell Channels to be measured
+                       )
+{
+	LTC681x_select_chain(chain);
+	LTC681x_adcv(MD, DCP, CH);
+}
+
+/* Starts a GPIO and Vref2 conversion on a chain without waiting for it */
+void LTC681x_chain_adax(isospi_chain *chain, // Chain context
+                        uint8_t MD, // ADC Mode
+                        uint8_t CHG // GPIO Channels to be measured
+                       )
+{
+	LTC681x_select_chain(chain);
+	LTC681x_adax(MD, CHG);
+}
+
+/* Polls the ADC of a chain once */
+uint8_t LTC681x_chain_pladc(isospi_chain *chain) // Chain context
+{
+	LTC681x_select_chain(chain);
+	return(LTC681x_pladc());
+}
+
+/* Blocks until the ADC of a chain has finished its conversion */
+uint32_t LTC681x_chain_pollAdc(isospi_chain *chain) // Chain context
+{
+	LTC681x_select_chain(chain);
+	return(LTC681x_pollAdc());
+}
+
+/* Reads and parses the cell voltage registers of a chain */
+uint8_t LTC681x_chain_rdcv(isospi_chain *chain, // Chain context
+                           uint8_t reg // Controls which cell voltage register is read back.
+                          )
+{
+	LTC681x_select_chain(chain);
+	return(LTC681x_rdcv(reg, chain->total_ic, chain->ic));
+}
+
+/* Reads and parses the auxiliary registers of a chain */
+int8_t LTC681x_chain_rdaux(isospi_chain *chain, // Chain context
+                           uint8_t reg // Determines which GPIO voltage register is read back.
+                          )
+{
+	LTC681x_select_chain(chain);
+	return(LTC681x_rdaux(reg, chain->total_ic, chain->ic));
+}
+
+/* Reads and parses the stat registers of a chain */
+int8_t LTC681x_chain_rdstat(isospi_chain *chain, // Chain context
+                            uint8_t reg // Determines which Stat register is read back.
+                           )
+{
+	LTC681x_select_chain(chain);
+	return(LTC681x_rdstat(reg, chain->total_ic, chain->ic));
+}
+
 /* Calculates  and returns the CRC15 */
 uint16_t pec15_calc(uint8_t len, //Number of bytes that will be used to calculate a PEC
                     uint8_t *data //Array of data that will be used to calculate  a PEC
@@ -441,7 +665,7 @@ uint8_t LTC681x_rdcv(uint8_t reg, // Controls which cell voltage register is rea
 	int8_t pec_error = 0;
 	uint8_t *cell_data;
 	uint8_t c_ic = 0;
-	cell_data = (uint8_t *) malloc((NUM_RX_BYT*total_ic)*sizeof(uint8_t));
+	cell_data = scratch_alloc(NUM_RX_BYT*total_ic);
 
 	if (reg == 0)
 	{
@@ -479,13 +703,13 @@ uint8_t LTC681x_rdcv(uint8_t reg, // Controls which cell voltage register is rea
 			{
 			c_ic = total_ic - current_ic - 1;
 			}
-			pec_error = pec_error + parse_cells(current_ic,reg, &cell_data[8*c_ic],
+			pec_error = pec_error + parse_cells(current_ic,reg, cell_data,
 											  &ic[c_ic].cells.c_codes[0],
 											  &ic[c_ic].cells.pec_match[0]);
 		}
 	}
 	LTC681x_check_pec(total_ic,CELL,ic);
-	free(cell_data);
+	scratch_free(cell_data);
 
 	return(pec_error);
 }
@@ -503,7 +727,7 @@ int8_t LTC681x_rdaux(uint8_t reg, //Determines which GPIO voltage register is re
 	uint8_t *data;
 	int8_t pec_error = 0;
 	uint8_t c_ic =0;
-	data = (uint8_t *) malloc((NUM_RX_BYT*total_ic)*sizeof(uint8_t));
+	data = scratch_alloc(NUM_RX_BYT*total_ic);
 
 	if (reg == 0)
 	{
@@ -546,7 +770,7 @@ int8_t LTC681x_rdaux(uint8_t reg, //Determines which GPIO voltage register is re
 		}
 	}
 	LTC681x_check_pec(total_ic,AUX,ic);
-	free(data);
+	scratch_free(data);
 
 	return (pec_error);
 }
@@ -573,7 +797,7 @@ int8_t LTC681x_rdstat(uint8_t reg, //Determines which Stat  register is read bac
 	uint16_t data_pec;
 	uint8_t c_ic = 0;
 	
-	data = (uint8_t *) malloc((12*total_ic)*sizeof(uint8_t));
+	data = scratch_alloc(12*total_ic);
 	
 	if (reg == 0)
 	{
@@ -685,7 +909,7 @@ int8_t LTC681x_rdstat(uint8_t reg, //Determines which Stat  register is read bac
 	}
 	LTC681x_check_pec(total_ic,STAT,ic);
 	
-	free(data);
+	scratch_free(data);
 	
 	return (pec_error);
 }
@@ -696,9 +920,7 @@ void LTC681x_rdcv_reg(uint8_t reg, //Determines which cell voltage register is r
                       uint8_t *data //An array of the unparsed cell codes
                      )
 {
-	const uint8_t REG_LEN = 8; //Number of bytes in each ICs register + 2 bytes for the PEC
-	uint8_t cmd[4];
-	uint16_t cmd_pec;
+	uint8_t cmd[2];
 
 	if (reg == 1)     //1: RDCVA
 	{
@@ -731,13 +953,7 @@ void LTC681x_rdcv_reg(uint8_t reg, //Determines which cell voltage register is r
 		cmd[0] = 0x00;
 	}
 
-	cmd_pec = pec15_calc(2, cmd);
-	cmd[2] = (uint8_t)(cmd_pec >> 8);
-	cmd[3] = (uint8_t)(cmd_pec);
-
-	cs_low(CS_PIN);
-	spi_write_read(cmd,4,data,(REG_LEN*total_ic));
-	cs_high(CS_PIN);
+	transfer_68(total_ic, cmd, data);
 }
 
 /*
@@ -750,9 +966,7 @@ void LTC681x_rdaux_reg(uint8_t reg, //Determines which GPIO voltage register is
                        uint8_t *data //Array of the unparsed auxiliary codes
                       )
 {
-	const uint8_t REG_LEN = 8; // Number of bytes in the register + 2 bytes for the PEC
-	uint8_t cmd[4];
-	uint16_t cmd_pec;
+	uint8_t cmd[2];
 
 	if (reg == 1)     //Read back auxiliary group A
 	{
@@ -780,13 +994,7 @@ void LTC681x_rdaux_reg(uint8_t reg, //Determines which GPIO voltage register is
 		cmd[0] = 0x00;
 	}
 
-	cmd_pec = pec15_calc(2, cmd);
-	cmd[2] = (uint8_t)(cmd_pec >> 8);
-	cmd[3] = (uint8_t)(cmd_pec);
-
-	cs_low(CS_PIN);
-	spi_write_read(cmd,4,data,(REG_LEN*total_ic));
-	cs_high(CS_PIN);
+	transfer_68(total_ic, cmd, data);
 }
 
 /*
@@ -799,9 +1007,7 @@ void LTC681x_rdstat_reg(uint8_t reg, //Determines which stat register is read ba
                         uint8_t *data //Array of the unparsed stat codes
                        )
 {
-	const uint8_t REG_LEN = 8; // number of bytes in the register + 2 bytes for the PEC
-	uint8_t cmd[4];
-	uint16_t cmd_pec;
+	uint8_t cmd[2];
 
 	if (reg == 1)     //Read back status group A
 	{
@@ -820,13 +1026,7 @@ void LTC681x_rdstat_reg(uint8_t reg, //Determines which stat register is read ba
 		cmd[0] = 0x00;
 	}
 
-	cmd_pec = pec15_calc(2, cmd);
-	cmd[2] = (uint8_t)(cmd_pec >> 8);
-	cmd[3] = (uint8_t)(cmd_pec);
-
-	cs_low(CS_PIN);
-	spi_write_read(cmd,4,data,(REG_LEN*total_ic));
-	cs_high(CS_PIN);
+	transfer_68(total_ic, cmd, data);
 }
 
 /* Helper function that parses voltage measurement registers */
@@ -887,10 +1087,10 @@ uint8_t LTC681x_pladc()
 	cmd[2] = (uint8_t)(cmd_pec >> 8);
 	cmd[3] = (uint8_t)(cmd_pec);
 	
-	cs_low(CS_PIN);
+	cs_low(active_cs_pin);
 	spi_write_array(4,cmd);
 	adc_state = spi_read_byte(0xFF);
-	cs_high(CS_PIN);
+	cs_high(active_cs_pin);
 	
 	return(adc_state);
 }
@@ -910,7 +1110,7 @@ uint32_t LTC681x_pollAdc()
 	cmd[2] = (uint8_t)(cmd_pec >> 8);
 	cmd[3] = (uint8_t)(cmd_pec);
 	
-	cs_low(CS_PIN);
+	cs_low(active_cs_pin);
 	spi_write_array(4,cmd);
 	while ((counter<200000)&&(finished == 0))
 	{
@@ -924,7 +1124,7 @@ uint32_t LTC681x_pollAdc()
 			counter = counter + 10;
 		}
 	}
-	cs_high(CS_PIN);
+	cs_high(active_cs_pin);
 	
 	return(counter);
 }
@@ -1586,6 +1786,162 @@ void LTC681x_run_openwire_single(uint8_t total_ic, // Number of ICs in the daisy
 	Serial.println("\n");
 }
 
+/*
+Reads the cell registers after the last ADOW conversion of a phase. Pull-up codes are
+stored, pull-down codes are compared with them. Returns -1 on a PEC error.
+*/
+static int8_t openwire_read(uint8_t total_ic, // Number of ICs in the daisy chain
+                            cell_asic *ic, // A two dimensional array of the ICs' data
+                            openwire_state *ow, // Open wire state of the chain
+                            bool pull_up // true after the pull-up phase
+                           )
+{
+	const uint16_t OPENWIRE_THRESHOLD = 4000;
+	uint8_t *data;
+	uint8_t c_ic = 0;
+	int8_t pec_error = 0;
+
+	data = scratch_alloc(NUM_RX_BYT*total_ic);
+	for (uint8_t cell_reg = 1; cell_reg<ic[0].ic_reg.num_cv_reg+1; cell_reg++)
+	{
+		LTC681x_rdcv_reg(cell_reg, total_ic, data);
+		for (uint8_t current_ic = 0; current_ic<total_ic; current_ic++)
+		{
+			uint8_t *reg = &data[current_ic*NUM_RX_BYT];
+
+			if (ic->isospi_reverse == false)
+			{
+				c_ic = current_ic;
+			}
+			else
+			{
+				c_ic = total_ic - current_ic - 1;
+			}
+			if ((uint16_t)((reg[6]<<8) | reg[7]) != pec15_calc(6, reg))
+			{
+				pec_error = -1;
+				continue;
+			}
+			for (uint8_t n = 0; n < 3; n++)
+			{
+				uint8_t cell = (cell_reg-1)*3 + n;
+				uint16_t code = reg[2*n] + (reg[2*n+1]<<8);
+				uint16_t *up = &ow->ic[c_ic].pull_up[cell];
+
+				if (cell >= ic[c_ic].ic_reg.cell_channels) break;
+				if (pull_up) *up = code;
+				else if ((code < *up) && ((*up - code) > OPENWIRE_THRESHOLD)) ow->ic[c_ic].found |= (uint32_t)1<<(cell+1);
+			}
+		}
+	}
+	scratch_free(data);
+	return(pec_error);
+}
+
+/* Publishes the open inputs of a finished check, with the same system_open_wire result as LTC681x_run_openwire_single() */
+static void openwire_finish(uint8_t total_ic, // Number of ICs in the daisy chain
+                            cell_asic *ic, // A two dimensional array that will store the data
+                            openwire_state *ow // Open wire state of the chain
+                           )
+{
+	for (uint8_t cic = 0; cic < total_ic; cic++)
+	{
+		const uint8_t N_CHANNELS = ic[cic].ic_reg.cell_channels;
+		openwire_ic *owic = &ow->ic[cic];
+
+		ic[cic].system_open_wire = 0xFFFF;
+		for (uint8_t wire = 1; wire <= N_CHANNELS; wire++)
+		{
+			if ((owic->found>>wire) & 0x01) ic[cic].system_open_wire = wire;
+		}
+		if (owic->pull_up[0] == 0)
+		{
+			owic->found |= 0x01;
+			ic[cic].system_open_wire = 0;
+		}
+		if (owic->pull_up[N_CHANNELS-1] == 0) //checking the Pull up value of the top measured channel
+		{
+			owic->found |= (uint32_t)1<<N_CHANNELS;
+			ic[cic].system_open_wire = N_CHANNELS;
+		}
+		owic->open_wires = owic->found;
+	}
+}
+
+/* Initializes the incremental open wire check and starts the first check */
+void LTC681x_openwire_init(uint8_t total_ic, // Number of ICs in the daisy chain
+                           openwire_state *ow, // Open wire state to be initialized
+                           openwire_ic *ow_ic, // Array of total_ic entries used by the state
+                           uint8_t md, // ADC mode of the ADOW conversions
+                           uint8_t interval // Normal scans between two ADOW conversions
+                          )
+{
+	for (uint8_t cic = 0; cic < total_ic; cic++)
+	{
+		ow_ic[cic].found = 0;
+		ow_ic[cic].open_wires = 0;
+	}
+	ow->ic = ow_ic;
+	ow->md = md;
+	ow->interval = interval;
+	ow->pending = false;
+	LTC681x_openwire_start(ow);
+}
+
+/* Starts a new incremental open wire check */
+void LTC681x_openwire_start(openwire_state *ow) // Open wire state
+{
+	ow->step = 0;
+	ow->wait = 0;
+	ow->running = true;
+}
+
+/* Advances the incremental open wire check by at most one ADOW conversion */
+uint8_t LTC681x_openwire_step(uint8_t total_ic, // Number of ICs in the daisy chain
+                              cell_asic *ic, // A two dimensional array that will store the result
+                              openwire_state *ow // Open wire state of the chain
+                             )
+{
+	if (ow->pending)
+	{
+		wakeup_idle(total_ic);
+		if (LTC681x_pladc() == 0) return(OPENWIRE_ADC_BUSY);
+		ow->pending = false;
+		ow->step++;
+		ow->wait = (ow->interval > 0) ? ow->interval-1 : 0; // the scan after this call is the first one
+		if ((ow->step % OPENWIRE_CONVERSIONS) != 0) return(OPENWIRE_ADC_FREE);
+
+		// Last conversion of a phase. Read it before a normal scan overwrites the cell registers.
+		if (openwire_read(total_ic, ic, ow, (ow->step == OPENWIRE_CONVERSIONS)) != 0)
+		{
+			ow->step = 0; // PEC error, repeat the check
+			return(OPENWIRE_ADC_FREE);
+		}
+		if (ow->step < 2*OPENWIRE_CONVERSIONS) return(OPENWIRE_ADC_FREE);
+		openwire_finish(total_ic, ic, ow);
+		ow->running = false;
+		return(OPENWIRE_RESULT);
+	}
+
+	if (!ow->running) return(OPENWIRE_ADC_FREE);
+	if (ow->wait > 0)
+	{
+		ow->wait--;
+		return(OPENWIRE_ADC_FREE);
+	}
+	if (ow->step == 0)
+	{
+		for (uint8_t cic = 0; cic < total_ic; cic++)
+		{
+			ow->ic[cic].found = 0;
+		}
+	}
+	wakeup_idle(total_ic);
+	LTC681x_adow(ow->md, (ow->step < OPENWIRE_CONVERSIONS) ? PULL_UP_CURRENT : PULL_DOWN_CURRENT, CELL_CH_ALL, DCP_DISABLED);
+	ow->pending = true;
+	return(OPENWIRE_ADC_BUSY);
+}
+
 /* Runs open wire for GPIOs */
 void LTC681x_run_gpio_openwire(uint8_t total_ic, // Number of ICs in the daisy chain
 								cell_asic ic[] // A two dimensional array that will store the data
@@ -1887,9 +2243,9 @@ void LTC681x_stsctrl()
     cmd[2] = (uint8_t)(cmd_pec >> 8);
     cmd[3] = (uint8_t)(cmd_pec);
     
-    cs_low(CS_PIN);
+    cs_low(active_cs_pin);
     spi_write_array(4,cmd);          
-    cs_high(CS_PIN);
+    cs_high(active_cs_pin);
 }
 
 /*
@@ -1986,13 +2342,13 @@ void LTC681x_stcomm(uint8_t len) //Length of data to be transmitted
 	cmd[2] = (uint8_t)(cmd_pec >> 8);
 	cmd[3] = (uint8_t)(cmd_pec);
 
-	cs_low(CS_PIN);
+	cs_low(active_cs_pin);
 	spi_write_array(4,cmd);
 	for (int i = 0; i<len*3; i++)
 	{
 	  spi_read_byte(0xFF);
 	}
-	cs_high(CS_PIN);
+	cs_high(active_cs_pin);
 }
 
 /* Helper function that increments PEC counters */
@@ -2181,3 +2537,581 @@ void LTC681x_set_cfgr_ov(uint8_t nIC, cell_asic *ic,uint16_t ov)
 	ic[nIC].config.tx_data[2] = ic[nIC].config.tx_data[2]&0x0F;
 	ic[nIC].config.tx_data[2] = ic[nIC].config.tx_data[2]|((0x000F & tmp)<<4);
 }
+
+/* Sets or clears one bit of a register byte */
+static void balance_bit(uint8_t *reg, uint8_t bit, bool on)
+{
+	if (on) *reg = *reg | (0x01<<bit);
+	else *reg = *reg & (~(0x01<<bit));
+}
+
+/* Copies the cells to be bled into the DCC bits of CFGRA/CFGRB and the PWM nibbles of PWM A/B */
+static void balance_set_registers(cell_asic *ic, uint32_t dcc, const balance_cfg *cfg)
+{
+	for (uint8_t cell = 0; cell < ic->ic_reg.cell_channels; cell++)
+	{
+		bool on = (dcc>>cell) & 0x01;
+		uint8_t *pwm;
+
+		if (cell < 8) balance_bit(&ic->config.tx_data[4], cell, on);
+		else if (cell < 12) balance_bit(&ic->config.tx_data[5], cell-8, on);
+		else if (cell < 16) balance_bit(&ic->configb.tx_data[0], cell-8, on);
+		else balance_bit(&ic->configb.tx_data[1], cell-16, on);
+
+		if (cfg->pwm_duty != 0)
+		{
+			if (cell < 12) pwm = &ic->pwm.tx_data[cell/2];
+			else pwm = &ic->pwmb.tx_data[(cell-12)/2];
+			if (cell & 0x01) *pwm = (*pwm & 0x0F) | ((on ? cfg->pwm_duty : 0)<<4);
+			else *pwm = (*pwm & 0xF0) | (on ? cfg->pwm_duty : 0);
+		}
+	}
+}
+
+/* Writes the PWM/S control register group B of LTC6812 and LTC6813 chains */
+static void balance_wrpsb(uint8_t total_ic, // Number of ICs in the daisy chain
+                          cell_asic *ic // A two dimensional array that stores the data to be written
+                         )
+{
+	uint8_t cmd[2] = {0x00, 0x1C};
+	uint8_t write_buffer[256];
+	uint8_t write_count = 0;
+	uint8_t c_ic = 0;
+
+	for (uint8_t current_ic = 0; current_ic<total_ic; current_ic++)
+	{
+		if (ic->isospi_reverse == false)
+		{
+			c_ic = current_ic;
+		}
+		else
+		{
+			c_ic = total_ic - current_ic - 1;
+		}
+
+		for (uint8_t data = 0; data<3; data++)
+		{
+			write_buffer[write_count++] = ic[c_ic].pwmb.tx_data[data];
+		}
+		for (uint8_t data = 3; data<6; data++)
+		{
+			write_buffer[write_count++] = ic[c_ic].sctrlb.tx_data[data];
+		}
+	}
+	write_68(total_ic, cmd, write_buffer);
+}
+
+/* Returns true if an IC is too hot to balance */
+static bool balance_ic_hot(cell_asic *ic, const balance_cfg *cfg)
+{
+	if ((cfg->max_itmp != 0) && (ic->stat.stat_codes[1] > cfg->max_itmp)) return(true);
+	for (uint8_t gpio = 0; gpio < 9; gpio++)
+	{
+		if (((cfg->ntc_mask>>gpio) & 0x01) && (ic->aux.a_codes[gpio] < cfg->min_ntc)) return(true);
+	}
+	return(false);
+}
+
+/* Returns the number of bits set */
+static uint8_t balance_count(uint32_t dcc)
+{
+	uint8_t count = 0;
+	for (; dcc != 0; dcc &= dcc-1) count++;
+	return(count);
+}
+
+/* Writes the register groups whose DCC bits changed. Returns the number of bytes written. */
+static uint16_t balance_write(uint8_t total_ic, cell_asic *ic, const balance_cfg *cfg, uint32_t changed)
+{
+	const uint16_t WRITE_LEN = 4+(8*total_ic); // write_68() command, data and PECs
+	uint16_t spi_bytes = 0;
+
+	if (changed & 0x00000FFF)
+	{
+		LTC681x_wrcfg(total_ic, ic);
+		spi_bytes += WRITE_LEN;
+		if (cfg->pwm_duty != 0)
+		{
+			LTC681x_wrpwm(total_ic, 0, ic);
+			spi_bytes += WRITE_LEN;
+		}
+	}
+	if ((changed & 0xFFFFF000) && (ic[0].ic_reg.cell_channels > 12))
+	{
+		LTC681x_wrcfgb(total_ic, ic);
+		spi_bytes += WRITE_LEN;
+		if (cfg->pwm_duty != 0)
+		{
+			balance_wrpsb(total_ic, ic);
+			spi_bytes += WRITE_LEN;
+		}
+	}
+	return(spi_bytes);
+}
+
+/* Initializes the balancing state of a chain */
+void LTC681x_balance_init(uint8_t total_ic, // Number of ICs in the daisy chain
+                          balance_state *state, // Balancing state to be initialized
+                          balance_ic *bal_ic // Array of total_ic entries used by the state
+                         )
+{
+	for (uint8_t cic = 0; cic < total_ic; cic++)
+	{
+		bal_ic[cic].dcc = 0;
+		bal_ic[cic].written_dcc = 0;
+	}
+	state->ic = bal_ic;
+	state->written = false;
+	state->bleeding = 0;
+	state->spread = 0;
+	state->spi_bytes = 0;
+}
+
+/* Selects the cells to bleed and writes the register groups that changed */
+uint8_t LTC681x_balance_update(uint8_t total_ic, // Number of ICs in the daisy chain
+                               cell_asic *ic, // A two dimensional array with the latest readings
+                               const balance_cfg *cfg, // Balancing policy
+                               balance_state *state // Balancing state of the chain
+                              )
+{
+	uint16_t lowest = 0xFFFF;
+	uint16_t highest = 0;
+	uint32_t changed = 0;
+
+	// Lowest and highest cell of the chain, ignoring registers with PEC errors
+	for (uint8_t cic = 0; cic < total_ic; cic++)
+	{
+		for (uint8_t cell = 0; cell < ic[cic].ic_reg.cell_channels; cell++)
+		{
+			if (ic[cic].cells.pec_match[cell/3] != 0) continue;
+			if (ic[cic].cells.c_codes[cell] < lowest) lowest = ic[cic].cells.c_codes[cell];
+			if (ic[cic].cells.c_codes[cell] > highest) highest = ic[cic].cells.c_codes[cell];
+		}
+	}
+	if (lowest > highest) return(state->bleeding); // no valid reading, keep the current state
+	state->spread = highest - lowest;
+	state->bleeding = 0;
+
+	for (uint8_t cic = 0; cic < total_ic; cic++)
+	{
+		uint32_t dcc = 0;
+		uint32_t candidates = 0;
+		uint8_t count;
+
+		if (!balance_ic_hot(&ic[cic], cfg))
+		{
+			for (uint8_t cell = 0; cell < ic[cic].ic_reg.cell_channels; cell++)
+			{
+				uint32_t bit = (uint32_t)1<<cell;
+				uint16_t limit = lowest + cfg->threshold;
+
+				if (ic[cic].cells.pec_match[cell/3] != 0)
+				{
+					dcc |= state->ic[cic].dcc & bit; // no new reading, keep the cell's state
+					continue;
+				}
+				if (state->ic[cic].dcc & bit) limit -= cfg->hysteresis;
+				if ((ic[cic].cells.c_codes[cell] > limit) && (ic[cic].cells.c_codes[cell] >= cfg->min_cell)) candidates |= bit;
+			}
+
+			// Highest cells first, skipping the neighbours of cells already chosen. Cells that are
+			// already bled go first so the selection, and the registers, do not change every cycle.
+			count = balance_count(dcc);
+			while ((candidates != 0) && ((cfg->max_per_ic == 0) || (count < cfg->max_per_ic)))
+			{
+				uint32_t pool = (candidates & state->ic[cic].dcc) ? (candidates & state->ic[cic].dcc) : candidates;
+				uint8_t best = 0;
+				uint32_t bit;
+				for (uint8_t cell = 0; cell < ic[cic].ic_reg.cell_channels; cell++)
+				{
+					if (((pool>>cell) & 0x01) && (!((pool>>best) & 0x01) || (ic[cic].cells.c_codes[cell] > ic[cic].cells.c_codes[best]))) best = cell;
+				}
+				bit = (uint32_t)1<<best;
+				candidates &= ~bit;
+				if (!cfg->allow_adjacent && (dcc & ((bit<<1) | (bit>>1)))) continue;
+				dcc |= bit;
+				count++;
+			}
+		}
+
+		state->ic[cic].dcc = dcc;
+		state->bleeding += balance_count(dcc);
+		changed |= dcc ^ state->ic[cic].written_dcc;
+		balance_set_registers(&ic[cic], dcc, cfg);
+	}
+
+	if (!state->written) changed = 0xFFFFFFFF;
+	state->spi_bytes = balance_write(total_ic, ic, cfg, changed);
+	for (uint8_t cic = 0; cic < total_ic; cic++)
+	{
+		state->ic[cic].written_dcc = state->ic[cic].dcc;
+	}
+	state->written = true;
+	return(state->bleeding);
+}
+
+/* Stops bleeding every cell of the chain */
+void LTC681x_balance_stop(uint8_t total_ic, // Number of ICs in the daisy chain
+                          cell_asic *ic, // A two dimensional array that will store the data
+                          const balance_cfg *cfg, // Balancing policy
+                          balance_state *state // Balancing state of the chain
+                         )
+{
+	for (uint8_t cic = 0; cic < total_ic; cic++)
+	{
+		state->ic[cic].dcc = 0;
+		state->ic[cic].written_dcc = 0;
+		balance_set_registers(&ic[cic], 0, cfg);
+	}
+	state->spi_bytes = balance_write(total_ic, ic, cfg, 0xFFFFFFFF);
+	state->written = true;
+	state->bleeding = 0;
+}
+
+/* Copies the cell codes into one contiguous array */
+uint16_t LTC681x_snapshot_cells(uint16_t total_ic, // Number of ICs in the daisy chain
+                                cell_asic *ic, // A two dimensional array with the latest readings
+                                uint16_t *codes, // total_ic*cell_channels entries
+                                uint8_t *pec_errors // total_ic entries, or NULL
+                               )
+{
+	uint16_t n = 0;
+
+	for (uint16_t cic = 0; cic < total_ic; cic++)
+	{
+		for (uint8_t cell = 0; cell < ic[cic].ic_reg.cell_channels; cell++)
+		{
+			codes[n++] = ic[cic].cells.c_codes[cell];
+		}
+		if (pec_errors != NULL)
+		{
+			pec_errors[cic] = 0;
+			for (uint8_t reg = 0; reg < ic[cic].ic_reg.num_cv_reg; reg++)
+			{
+				pec_errors[cic] = pec_errors[cic] + ic[cic].cells.pec_match[reg];
+			}
+		}
+	}
+	return(n);
+}
+
+/* Copies the aux codes into one contiguous array */
+uint16_t LTC681x_snapshot_aux(uint16_t total_ic, // Number of ICs in the daisy chain
+                              cell_asic *ic, // A two dimensional array with the latest readings
+                              uint16_t *codes, // total_ic*aux_channels entries
+                              uint8_t *pec_errors // total_ic entries, or NULL
+                             )
+{
+	uint16_t n = 0;
+
+	for (uint16_t cic = 0; cic < total_ic; cic++)
+	{
+		for (uint8_t channel = 0; channel < ic[cic].ic_reg.aux_channels; channel++)
+		{
+			codes[n++] = ic[cic].aux.a_codes[channel];
+		}
+		if (pec_errors != NULL)
+		{
+			pec_errors[cic] = 0;
+			for (uint8_t reg = 0; reg < ic[cic].ic_reg.num_gpio_reg; reg++)
+			{
+				pec_errors[cic] = pec_errors[cic] + ic[cic].aux.pec_match[reg];
+			}
+		}
+	}
+	return(n);
+}
+
+/* Computes the statistics of a block of codes */
+void LTC681x_snapshot_stats(const uint16_t *codes, // Codes
+                            uint16_t count, // Number of codes
+                            uint16_t high, // Codes above this are counted as over
+                            uint16_t low, // Codes below this are counted as under
+                            snapshot_stats *stats // Result
+                           )
+{
+	uint16_t lowest = 0xFFFF;
+	uint16_t highest = 0;
+	uint32_t sum = 0;
+	uint16_t over = 0;
+	uint16_t under = 0;
+	uint16_t i;
+
+	// Branch free so that it vectorizes; the positions are found afterwards
+	for (i = 0; i < count; i++)
+	{
+		uint16_t code = codes[i];
+		lowest = (code < lowest) ? code : lowest;
+		highest = (code > highest) ? code : highest;
+		sum += code;
+		over += (code > high);
+		under += (code < low);
+	}
+
+	stats->min = lowest;
+	stats->max = highest;
+	stats->sum = sum;
+	stats->over = over;
+	stats->under = under;
+	stats->pec_errors = 0;
+	stats->min_index = 0;
+	stats->max_index = 0;
+	if (count == 0)
+	{
+		stats->min = 0;
+		stats->mean = 0;
+		stats->delta = 0;
+		stats->flags = 0;
+		return;
+	}
+	stats->mean = sum/count;
+	stats->delta = highest - lowest;
+	for (i = 0; codes[i] != lowest; i++);
+	stats->min_index = i;
+	for (i = 0; codes[i] != highest; i++);
+	stats->max_index = i;
+	stats->flags = 0;
+	if (over > 0) stats->flags |= SNAPSHOT_OVER;
+	if (under > 0) stats->flags |= SNAPSHOT_UNDER;
+}
+
+/* Computes the statistics of every module and of the whole stack */
+uint8_t LTC681x_snapshot_module_stats(const uint16_t *codes, // Codes of the snapshot
+                                      uint16_t modules, // Number of modules
+                                      uint8_t per_module, // Codes per module
+                                      const uint8_t *pec_errors, // PEC errors per module, or NULL
+                                      uint16_t high, // Codes above this are counted as over
+                                      uint16_t low, // Codes below this are counted as under
+                                      snapshot_stats *module, // modules entries, or NULL
+                                      snapshot_stats *stack // Statistics of the whole stack
+                                     )
+{
+	snapshot_stats one;
+	uint16_t count = modules*per_module;
+
+	stack->min = 0xFFFF;
+	stack->max = 0;
+	stack->sum = 0;
+	stack->min_index = 0;
+	stack->max_index = 0;
+	stack->over = 0;
+	stack->under = 0;
+	stack->pec_errors = 0;
+	stack->flags = 0;
+
+	for (uint16_t m = 0; m < modules; m++)
+	{
+		snapshot_stats *st = (module != NULL) ? &module[m] : &one;
+		uint16_t first = m*per_module;
+
+		LTC681x_snapshot_stats(&codes[first], per_module, high, low, st);
+		if (pec_errors != NULL && pec_errors[m] > 0)
+		{
+			st->pec_errors = pec_errors[m];
+			st->flags |= SNAPSHOT_PEC;
+		}
+
+		if (per_module > 0 && st->min < stack->min)
+		{
+			stack->min = st->min;
+			stack->min_index = first + st->min_index;
+		}
+		if (per_module > 0 && st->max > stack->max)
+		{
+			stack->max = st->max;
+			stack->max_index = first + st->max_index;
+		}
+		stack->sum += st->sum;
+		stack->over += st->over;
+		stack->under += st->under;
+		stack->pec_errors += st->pec_errors;
+		stack->flags |= st->flags;
+	}
+
+	if (count == 0)
+	{
+		stack->min = 0;
+		stack->mean = 0;
+		stack->delta = 0;
+	}
+	else
+	{
+		stack->mean = stack->sum/count;
+		stack->delta = stack->max - stack->min;
+	}
+	return(stack->flags);
+}
+
+/* Reads registers of count ICs starting at first, forward or through the reverse port of the ring */
+static void ring_read(isospi_ring *ring, uint8_t type, uint8_t reg, uint8_t first, uint8_t count, bool reverse)
+{
+	cell_asic *ic = &ring->chain->ic[first];
+	bool isospi_reverse = ic->isospi_reverse;
+
+	if (count == 0)
+	{
+		return;
+	}
+	LTC681x_select_chain(ring->chain);
+	if (reverse)
+	{
+		active_cs_pin = ring->reverse_cs_pin;
+		wakeup_idle(count);
+		ring->reverse_reads++;
+	}
+	ic->isospi_reverse = reverse; // The IC at the far end answers first
+	if (type == CELL) LTC681x_rdcv(reg, count, ic);
+	else LTC681x_rdaux(reg, count, ic);
+	ic->isospi_reverse = isospi_reverse;
+	active_cs_pin = ring->chain->cs_pin;
+}
+
+/* Returns true if the registers of an IC failed PEC in the last read */
+static bool ring_failed(cell_asic *ic, uint8_t type, uint8_t reg)
+{
+	uint8_t *pec_match = (type == CELL) ? ic->cells.pec_match : ic->aux.pec_match;
+	uint8_t num_reg = (type == CELL) ? ic->ic_reg.num_cv_reg : ic->ic_reg.num_gpio_reg;
+
+	if (reg != 0)
+	{
+		return(pec_match[reg-1] != 0);
+	}
+	for (uint8_t i = 0; i < num_reg; i++)
+	{
+		if (pec_match[i] != 0) return(true);
+	}
+	return(false);
+}
+
+/* Reads one register type around the ring, finding and following breaks */
+static int8_t ring_scan(isospi_ring *ring, uint8_t type, uint8_t reg)
+{
+	uint8_t total_ic = ring->chain->total_ic;
+	cell_asic *ic = ring->chain->ic;
+	uint8_t seen;
+	int8_t failed = 0;
+
+	if (ring->break_at < total_ic && (ring->probe_interval == 0 || ++ring->probe < ring->probe_interval))
+	{
+		ring_read(ring, type, reg, 0, ring->break_at, false);
+		ring_read(ring, type, reg, ring->break_at, total_ic - ring->break_at, true);
+	}
+	else
+	{
+		ring->probe = 0;
+		ring_read(ring, type, reg, 0, total_ic, false);
+
+		// A broken link loses every IC above it, so only a failing top segment is a break
+		seen = total_ic;
+		while (seen > 0 && ring_failed(&ic[seen-1], type, reg))
+		{
+			seen--;
+		}
+		if (seen < total_ic)
+		{
+			ring_read(ring, type, reg, seen, total_ic - seen, true);
+		}
+
+		ring->suspect_count = (seen == ring->suspect && ring->suspect_count < 255) ? ring->suspect_count + 1 : 1;
+		ring->suspect = seen;
+		if (seen == total_ic)
+		{
+			ring->break_at = total_ic;
+		}
+		else if (ring->suspect_count >= ring->confirm)
+		{
+			ring->break_at = seen;
+		}
+	}
+
+	for (uint8_t cic = 0; cic < total_ic; cic++)
+	{
+		if (ring_failed(&ic[cic], type, reg)) failed++;
+	}
+	return(failed);
+}
+
+/* Sends a command through the reverse port too when the ring may be open */
+static bool ring_open(isospi_ring *ring)
+{
+	return(ring->break_at < ring->chain->total_ic || ring->suspect < ring->chain->total_ic);
+}
+
+/* Initializes a redundant isoSPI ring */
+void LTC681x_ring_init(isospi_ring *ring, // Ring context to be initialized
+                       isospi_chain *chain, // Forward side of the ring
+                       uint8_t reverse_cs_pin, // Chip select of the isoSPI interface at the far end
+                       uint8_t confirm, // Scans that must see the same break before it is latched
+                       uint8_t probe_interval // Scans between two full forward reads while the ring is open
+                      )
+{
+	ring->chain = chain;
+	ring->reverse_cs_pin = reverse_cs_pin;
+	ring->confirm = (confirm > 0) ? confirm : 1;
+	ring->probe_interval = probe_interval;
+	ring->break_at = chain->total_ic;
+	ring->suspect = chain->total_ic;
+	ring->suspect_count = 0;
+	ring->probe = 0;
+	ring->reverse_reads = 0;
+	cs_init(reverse_cs_pin);
+}
+
+/* Wakes the isoSPI of the ring from IDLE state */
+void LTC681x_ring_wakeup_idle(isospi_ring *ring) // Ring context
+{
+	LTC681x_chain_wakeup_idle(ring->chain);
+	if (ring_open(ring))
+	{
+		active_cs_pin = ring->reverse_cs_pin;
+		wakeup_idle(ring->chain->total_ic);
+		active_cs_pin = ring->chain->cs_pin;
+	}
+}
+
+/* Starts cell voltage conversion from one or both ends of the ring */
+void LTC681x_ring_adcv(isospi_ring *ring, // Ring context
+                       uint8_t MD, // ADC Mode
+                       uint8_t DCP, // Discharge Permit
+                       uint8_t CH // Cell Channels to be measured
+                      )
+{
+	LTC681x_chain_adcv(ring->chain, MD, DCP, CH);
+	if (ring_open(ring))
+	{
+		active_cs_pin = ring->reverse_cs_pin;
+		LTC681x_adcv(MD, DCP, CH);
+		active_cs_pin = ring->chain->cs_pin;
+	}
+}
+
+/* Starts a GPIO and Vref2 conversion from one or both ends of the ring */
+void LTC681x_ring_adax(isospi_ring *ring, // Ring context
+                       uint8_t MD, // ADC Mode
+                       uint8_t CHG // GPIO Channels to be measured
+                      )
+{
+	LTC681x_chain_adax(ring->chain, MD, CHG);
+	if (ring_open(ring))
+	{
+		active_cs_pin = ring->reverse_cs_pin;
+		LTC681x_adax(MD, CHG);
+		active_cs_pin = ring->chain->cs_pin;
+	}
+}
+
+/* Reads the cell voltage registers around the ring */
+int8_t LTC681x_ring_rdcv(isospi_ring *ring, // Ring context
+                         uint8_t reg // Cell voltage register to read, 0 for all
+                        )
+{
+	return(ring_scan(ring, CELL, reg));
+}
+
+/* Reads the aux registers around the ring */
+int8_t LTC681x_ring_rdaux(isospi_ring *ring, // Ring context
+                          uint8_t reg // Aux register to read, 0 for all
+                         )
+{
+	return(ring_scan(ring, AUX, reg));
+}
@@ -56,7 +56,11 @@
 #include <Arduino.h>
 #endif
 
-#define IC_LTC6813
+#define IC_LTC6810 6810
+#define IC_LTC6811 6811
+#define IC_LTC6812 6812
+#define IC_LTC6813 6813
+#define IC_LTC6804 6804 //!< Register compatible with the LTC6811, without CFGRB, S control, PWM and COMM extensions
 
 #define MD_422HZ_1KHZ 0
 #define MD_27KHZ_14KHZ 1
@@ -111,7 +115,9 @@
 #define STAT 3
 #define CFGR 0
 #define CFGRB 4
-#define CS_PIN 10
+#define CS_PIN 10 //!< Chip select used until LTC681x_select_chain() selects a chain
+
+#define LTC681x_SCRATCH_SIZE(total_ic) (12*(total_ic)) //!< Bytes needed for the scratch buffer of a chain of total_ic ICs
 
 /*! Cell Voltage data structure. */
 typedef struct
@@ -186,6 +192,111 @@ typedef struct
   long system_open_wire;
 } cell_asic;
 
+/*! isoSPI daisy chain context. One per chip select. */
+typedef struct
+{
+  uint8_t cs_pin;     //!< Chip select of the chain's isoSPI interface
+  uint8_t total_ic;   //!< Number of ICs in the daisy chain
+  uint16_t variant;   //!< IC_LTC6810, IC_LTC6811, IC_LTC6812, IC_LTC6813 or IC_LTC6804
+  cell_asic *ic;      //!< Data of the ICs in the daisy chain
+  uint8_t *scratch;   //!< LTC681x_SCRATCH_SIZE(total_ic) bytes for register reads, or NULL to allocate them on each read
+  bool addressed;     //!< Addressable parts (LTC6804-2, LTC6811-2) at addresses 0 to total_ic-1: registers are read and written one IC at a time
+} isospi_chain;
+
+#define BALANCE_ITMP_CODE(celsius) (((celsius)+276)*76) //!< ITMP status code of a die temperature in degrees C
+
+/*! Cell balancing policy used by LTC681x_balance_update(). Voltages are 100uV cell codes. */
+typedef struct
+{
+  uint16_t threshold;      //!< Bleed a cell that is more than this above the lowest cell of the chain
+  uint16_t hysteresis;     //!< Keep bleeding until the cell is within threshold-hysteresis of the lowest cell
+  uint16_t min_cell;       //!< Never bleed a cell below this voltage
+  uint8_t max_per_ic;      //!< Most cells bled at once on one IC, highest cells first. 0 for no limit.
+  bool allow_adjacent;     //!< Allow two neighbouring cells to be bled at the same time
+  uint8_t pwm_duty;        //!< PWM duty (1-15, in 1/15 steps) written for bled cells, or 0 to leave the PWM registers alone
+  uint16_t max_itmp;       //!< Stop balancing an IC whose ITMP status code is above this (see BALANCE_ITMP_CODE()). 0 disables.
+  uint16_t ntc_mask;       //!< Aux codes that are NTC thermistors, bit 0 for a_codes[0] (GPIO1)
+  uint16_t min_ntc;        //!< Stop balancing an IC with a thermistor code below this (NTC to ground is hot)
+} balance_cfg;
+
+/*! Per IC cell balancing state. */
+typedef struct
+{
+  uint32_t dcc;            //!< Cells selected for bleeding, bit 0 for cell 1
+  uint32_t written_dcc;    //!< Cells bled according to the last register writes
+} balance_ic;
+
+/*! Cell balancing state of one chain. */
+typedef struct
+{
+  balance_ic *ic;          //!< total_ic entries
+  bool written;            //!< false until the registers have been written once
+  uint8_t bleeding;        //!< Number of cells bled after the last update
+  uint16_t spread;         //!< Highest minus lowest cell code seen by the last update
+  uint16_t spi_bytes;      //!< Bytes written by the last update, 0 if nothing changed
+} balance_state;
+
+#define OPENWIRE_CONVERSIONS 3  //!< ADOW conversions per pull-up or pull-down phase, as in LTC681x_run_openwire_single()
+
+#define OPENWIRE_ADC_FREE 0     //!< LTC681x_openwire_step(): the ADC is free for a normal scan
+#define OPENWIRE_ADC_BUSY 1     //!< LTC681x_openwire_step(): an ADOW conversion is running, skip the normal scan
+#define OPENWIRE_RESULT 2       //!< LTC681x_openwire_step(): a check has finished, the ADC is free
+
+/*! Per IC working set of the incremental open wire check. */
+typedef struct
+{
+  uint16_t pull_up[18];   //!< Cell codes after the pull-up conversions
+  uint32_t found;         //!< Open inputs found so far by the running check
+  uint32_t open_wires;    //!< Open inputs found by the last complete check, bit n for Cn
+} openwire_ic;
+
+/*! Incremental open wire check state of one chain. */
+typedef struct
+{
+  openwire_ic *ic;        //!< total_ic entries
+  uint8_t md;             //!< ADC mode of the ADOW conversions
+  uint8_t interval;       //!< Normal scans between two ADOW conversions
+  uint8_t wait;           //!< Normal scans left before the next ADOW conversion
+  uint8_t step;           //!< ADOW conversions finished in the current check
+  bool pending;           //!< An ADOW conversion is running
+  bool running;           //!< A check is in progress
+} openwire_state;
+
+#define SNAPSHOT_OVER 0x01    //!< snapshot_stats.flags: a code is above the high limit
+#define SNAPSHOT_UNDER 0x02   //!< snapshot_stats.flags: a code is below the low limit
+#define SNAPSHOT_PEC 0x04     //!< snapshot_stats.flags: a register group was read with a PEC error
+
+/*! Statistics of a block of codes, see LTC681x_snapshot_stats(). */
+typedef struct
+{
+  uint16_t min;           //!< Lowest code
+  uint16_t max;           //!< Highest code
+  uint16_t mean;          //!< Average code, rounded down
+  uint16_t delta;         //!< Highest minus lowest code
+  uint32_t sum;           //!< Sum of the codes
+  uint16_t min_index;     //!< Position of the first lowest code
+  uint16_t max_index;     //!< Position of the first highest code
+  uint16_t over;          //!< Codes above the high limit
+  uint16_t under;         //!< Codes below the low limit
+  uint16_t pec_errors;    //!< Register groups read with a PEC error
+  uint8_t flags;          //!< SNAPSHOT_OVER, SNAPSHOT_UNDER and SNAPSHOT_PEC
+} snapshot_stats;
+
+/*! Redundant isoSPI ring: a daisy chain of reversible parts (LTC6812, LTC6813) whose last
+    IC is wired back to a second isoSPI interface, so it can be reached from both ends. */
+typedef struct
+{
+  isospi_chain *chain;    //!< Forward side of the ring: chip select of port A, ICs and scratch buffer
+  uint8_t reverse_cs_pin; //!< Chip select of the isoSPI interface at the far end of the ring
+  uint8_t confirm;        //!< Scans that must see the same break before it is latched
+  uint8_t probe_interval; //!< While the ring is open, scans between two full forward reads that look for a repaired link. 0 never looks.
+  uint8_t break_at;       //!< Latched break: IC break_at and above are read through the reverse port. total_ic while the ring is closed.
+  uint8_t suspect;        //!< Break seen by the last scan, total_ic if none. 0 is between the host and the first IC.
+  uint8_t suspect_count;  //!< Consecutive scans that saw the same break
+  uint8_t probe;          //!< Scans since the last full forward read
+  uint16_t reverse_reads; //!< Register reads that went through the reverse port
+} isospi_ring;
+
 /*!
  Wake isoSPI up from IDlE state and enters the READY state
  @return void
@@ -223,6 +334,109 @@ int8_t read_68( uint8_t total_ic, //!< Number of ICs in the daisy chain
                 uint8_t tx_cmd[2], //!< 2 byte array containing the BMS command to be sent
                 uint8_t *rx_data); //!< Array that the read back data will be stored in.
 				
+/*!
+ Initializes a chain context and the register limits of its ICs for the given variant.
+ The chip select is driven high and configured as an output.
+ @return void
+ */
+void LTC681x_init_chain(isospi_chain *chain, //!< Chain context to be initialized
+                        uint8_t cs_pin, //!< Chip select of the chain's isoSPI interface
+                        uint8_t total_ic, //!< Number of ICs in the daisy chain
+                        uint16_t variant, //!< IC_LTC6810, IC_LTC6811, IC_LTC6812, IC_LTC6813 or IC_LTC6804
+                        cell_asic *ic, //!< Array of total_ic ICs
+                        uint8_t *scratch //!< LTC681x_SCRATCH_SIZE(total_ic) bytes, or NULL
+                       );
+
+/*!
+ Sets the register limits of the ICs for the given variant at run time.
+ Does the same as the LTC681x variant libraries' init_reg_limits functions.
+ @return void
+ */
+void LTC681x_init_reg_limits(uint8_t total_ic, //!< Number of ICs in the daisy chain
+                             cell_asic *ic, //!< A two dimensional array that will store the data
+                             uint16_t variant //!< IC_LTC6810, IC_LTC6811, IC_LTC6812, IC_LTC6813 or IC_LTC6804
+                            );
+
+/*!
+ Selects the chain that the functions without a chain argument talk to.
+ Passing NULL selects the single chain on CS_PIN.
+ @return void
+ */
+void LTC681x_select_chain(isospi_chain *chain //!< Chain to be selected, or NULL
+                         );
+
+/*!
+ Wakes the isoSPI of a chain from IDLE state.
+ @return void
+ */
+void LTC681x_chain_wakeup_idle(isospi_chain *chain //!< Chain context
+                              );
+
+/*!
+ Writes the CFGRA register of every IC of a chain.
+ @return void
+ */
+void LTC681x_chain_wrcfg(isospi_chain *chain //!< Chain context
+                        );
+
+/*!
+ Starts cell voltage conversion on a chain. Returns without waiting, so other
+ chains can be started or read while the conversion runs.
+ @return void
+ */
+void LTC681x_chain_adcv(isospi_chain *chain, //!< Chain context
+                        uint8_t MD, //!< ADC conversion Mode
+                        uint8_t DCP, //!< Controls if Discharge is permitted during conversion
+                        uint8_t CH //!< Sets which Cell channels are converted
+                       );
+
+/*!
+ Starts a GPIO and Vref2 conversion on a chain without waiting for it.
+ @return void
+ */
+void LTC681x_chain_adax(isospi_chain *chain, //!< Chain context
+                        uint8_t MD, //!< ADC Conversion Mode
+                        uint8_t CHG //!< Sets which GPIO channels are converted
+                       );
+
+/*!
+ Polls the ADC of a chain once.
+ @returns uint8_t adc_state, 0 while the conversion is still running
+ */
+uint8_t LTC681x_chain_pladc(isospi_chain *chain //!< Chain context
+                           );
+
+/*!
+ Blocks until the ADC of a chain has finished its conversion.
+ @returns uint32_t counter The approximate time it took for the ADC function to complete.
+ */
+uint32_t LTC681x_chain_pollAdc(isospi_chain *chain //!< Chain context
+                              );
+
+/*!
+ Reads and parses the cell voltage registers of a chain.
+ @return uint8_t, PEC Status. 0: No PEC error detected
+ */
+uint8_t LTC681x_chain_rdcv(isospi_chain *chain, //!< Chain context
+                           uint8_t reg //!< Controls which cell voltage register is read back.
+                          );
+
+/*!
+ Reads and parses the auxiliary registers of a chain.
+ @return int8_t, PEC Status. 0: No PEC error detected
+ */
+int8_t LTC681x_chain_rdaux(isospi_chain *chain, //!< Chain context
+                           uint8_t reg //!< Determines which GPIO voltage register is read back.
+                          );
+
+/*!
+ Reads and parses the stat registers of a chain.
+ @return int8_t, PEC Status. 0: No PEC error detected
+ */
+int8_t LTC681x_chain_rdstat(isospi_chain *chain, //!< Chain context
+                            uint8_t reg //!< Determines which Stat register is read back.
+                           );
+
 /*!
  Calculates  and returns the CRC15
  @returns The calculated pec15 as an unsigned int
@@ -564,6 +778,39 @@ void LTC681x_run_openwire_single(uint8_t total_ic, //!< Number of ICs in the dai
 						         cell_asic *ic //!< A two dimensional array that will store the data
 						        );								
 				 
+/*!
+ Initializes the incremental open wire check of a chain and starts the first check.
+ @return void
+ */
+void LTC681x_openwire_init(uint8_t total_ic, //!< Number of ICs in the daisy chain
+                           openwire_state *ow, //!< Open wire state to be initialized
+                           openwire_ic *ow_ic, //!< Array of total_ic entries used by the state
+                           uint8_t md, //!< ADC mode of the ADOW conversions, MD_26HZ_2KHZ in the blocking functions
+                           uint8_t interval //!< Normal scans between two ADOW conversions, at least 1
+                          );
+
+/*!
+ Starts a new incremental open wire check. The previous results stay valid until it finishes.
+ @return void
+ */
+void LTC681x_openwire_start(openwire_state *ow //!< Open wire state
+                           );
+
+/*!
+ Advances the incremental open wire check by at most one ADOW conversion.
+ Call it once per measurement cycle, before the normal ADCV scan. It never waits for the ADC:
+ it starts an ADOW conversion, polls a running one, or reads the cell registers right after
+ the last conversion of a phase, before a normal scan can overwrite them. The readings are
+ kept in the openwire_ic array, so ic[].cells is never touched. When a check finishes, the
+ open inputs are in openwire_ic.open_wires and ic[].system_open_wire is set as by
+ LTC681x_run_openwire_single().
+ @return uint8_t, OPENWIRE_ADC_FREE, OPENWIRE_ADC_BUSY or OPENWIRE_RESULT
+ */
+uint8_t LTC681x_openwire_step(uint8_t total_ic, //!< Number of ICs in the daisy chain
+                              cell_asic *ic, //!< A two dimensional array that will store the result
+                              openwire_state *ow //!< Open wire state of the chain
+                             );
+
 /*!
  Runs open wire for GPIOs
  @return void	 
@@ -766,7 +1013,151 @@ void LTC681x_set_cfgr_ov(uint8_t nIC, //!< Current IC
                          cell_asic *ic, //!< A two dimensional array that will store the data
                          uint16_t ov //!< The OV value
 						 );		
-						 
+
+/*!
+ Initializes the balancing state of a chain. No cells are bled until the first update.
+ @return void
+ */
+void LTC681x_balance_init(uint8_t total_ic, //!< Number of ICs in the daisy chain
+                          balance_state *state, //!< Balancing state to be initialized
+                          balance_ic *bal_ic //!< Array of total_ic entries used by the state
+                         );
+
+/*!
+ Selects the cells to bleed from the latest cell, aux and stat readings and writes
+ the discharge configuration. Cells with a PEC error in their register keep their state.
+ Only register groups whose DCC bits changed are written: CFGRA (with PWM A), and
+ on parts with more than 12 cells CFGRB (with PWM/S control B).
+ @return uint8_t, number of cells being bled. 0 once the chain is balanced.
+ */
+uint8_t LTC681x_balance_update(uint8_t total_ic, //!< Number of ICs in the daisy chain
+                               cell_asic *ic, //!< A two dimensional array with the latest readings
+                               const balance_cfg *cfg, //!< Balancing policy
+                               balance_state *state //!< Balancing state of the chain
+                              );
+
+/*!
+ Stops bleeding every cell of the chain.
+ @return void
+ */
+void LTC681x_balance_stop(uint8_t total_ic, //!< Number of ICs in the daisy chain
+                          cell_asic *ic, //!< A two dimensional array that will store the data
+                          const balance_cfg *cfg, //!< Balancing policy
+                          balance_state *state //!< Balancing state of the chain
+                         );
+
+/*!
+ Copies the cell codes of the last LTC681x_rdcv() into one contiguous array, IC by IC
+ (codes[cic*cell_channels+cell]), so the statistics below can run over plain arrays.
+ @return uint16_t, number of codes written: total_ic*cell_channels
+ */
+uint16_t LTC681x_snapshot_cells(uint16_t total_ic, //!< Number of ICs in the daisy chain
+                                cell_asic *ic, //!< A two dimensional array with the latest readings
+                                uint16_t *codes, //!< total_ic*cell_channels entries
+                                uint8_t *pec_errors //!< total_ic entries, cell register groups with a PEC error. May be NULL.
+                               );
+
+/*!
+ Copies the aux codes of the last LTC681x_rdaux() into one contiguous array, IC by IC
+ (codes[cic*aux_channels+channel]), in the order of ic[].aux.a_codes.
+ @return uint16_t, number of codes written: total_ic*aux_channels
+ */
+uint16_t LTC681x_snapshot_aux(uint16_t total_ic, //!< Number of ICs in the daisy chain
+                              cell_asic *ic, //!< A two dimensional array with the latest readings
+                              uint16_t *codes, //!< total_ic*aux_channels entries
+                              uint8_t *pec_errors //!< total_ic entries, aux register groups with a PEC error. May be NULL.
+                             );
+
+/*!
+ Computes min, max, mean and delta of a block of codes and counts the codes outside
+ the limits. The loop has no data dependent branches, so host compilers vectorize it.
+ @return void
+ */
+void LTC681x_snapshot_stats(const uint16_t *codes, //!< Codes, e.g. from LTC681x_snapshot_cells()
+                            uint16_t count, //!< Number of codes
+                            uint16_t high, //!< Codes above this are counted as over
+                            uint16_t low, //!< Codes below this are counted as under
+                            snapshot_stats *stats //!< Result
+                           );
+
+/*!
+ Computes the statistics of every module (IC) of a snapshot and of the whole stack in one
+ pass over the codes. Stack indexes are positions in the snapshot array.
+ @return uint8_t, flags of the whole stack
+ */
+uint8_t LTC681x_snapshot_module_stats(const uint16_t *codes, //!< Codes from LTC681x_snapshot_cells() or LTC681x_snapshot_aux()
+                                      uint16_t modules, //!< Number of modules, usually total_ic
+                                      uint8_t per_module, //!< Codes per module
+                                      const uint8_t *pec_errors, //!< PEC errors per module from the snapshot, or NULL
+                                      uint16_t high, //!< Codes above this are counted as over
+                                      uint16_t low, //!< Codes below this are counted as under
+                                      snapshot_stats *module, //!< modules entries, or NULL for only the stack statistics
+                                      snapshot_stats *stack //!< Statistics of the whole stack
+                                     );
+
+/*!
+ Initializes a redundant isoSPI ring over a chain initialized with LTC681x_init_chain().
+ The ring starts closed: everything is read forward until a break is seen.
+ @return void
+ */
+void LTC681x_ring_init(isospi_ring *ring, //!< Ring context to be initialized
+                       isospi_chain *chain, //!< Forward side of the ring
+                       uint8_t reverse_cs_pin, //!< Chip select of the isoSPI interface at the far end
+                       uint8_t confirm, //!< Scans that must see the same break before it is latched, at least 1
+                       uint8_t probe_interval //!< Scans between two full forward reads while the ring is open, 0 never
+                      );
+
+/*!
+ Wakes the isoSPI of the ring from IDLE state, from both ends once a break has been seen.
+ @return void
+ */
+void LTC681x_ring_wakeup_idle(isospi_ring *ring //!< Ring context
+                             );
+
+/*!
+ Starts cell voltage conversion. Once a break has been seen the command is also sent
+ through the reverse port, so that the ICs above the break convert too.
+ @return void
+ */
+void LTC681x_ring_adcv(isospi_ring *ring, //!< Ring context
+                       uint8_t MD, //!< ADC Mode
+                       uint8_t DCP, //!< Discharge Permit
+                       uint8_t CH //!< Cell Channels to be measured
+                      );
+
+/*!
+ Starts a GPIO and Vref2 conversion, through both ends once a break has been seen.
+ @return void
+ */
+void LTC681x_ring_adax(isospi_ring *ring, //!< Ring context
+                       uint8_t MD, //!< ADC Mode
+                       uint8_t CHG //!< GPIO Channels to be measured
+                      );
+
+/*!
+ Reads the cell voltage registers of the whole ring into chain->ic. While the ring is closed
+ this is one forward read, as LTC681x_rdcv(). When the ICs from some position up all fail
+ PEC, that upper segment is read again through the reverse port and the break is counted;
+ after ring->confirm such scans it is latched and every scan reads the lower segment
+ forward and the upper segment in reverse. That sends each read command twice, one per port, so
+ a split scan costs a little more than a closed ring: 338 against 312 SPI bytes to read all cell
+ groups of six LTC6813s. Scans that re-read a new break cost more until it is latched.
+ The first scan that sees a new break gets the upper ICs' codes of their last conversion,
+ as they did not receive the ADCV that was sent forward.
+ @return int8_t, number of ICs whose registers still failed PEC. 0 for a complete snapshot.
+ */
+int8_t LTC681x_ring_rdcv(isospi_ring *ring, //!< Ring context
+                         uint8_t reg //!< Cell voltage register to read, 0 for all
+                        );
+
+/*!
+ Reads the aux registers of the whole ring into chain->ic, as LTC681x_ring_rdcv().
+ @return int8_t, number of ICs whose registers still failed PEC. 0 for a complete snapshot.
+ */
+int8_t LTC681x_ring_rdaux(isospi_ring *ring, //!< Ring context
+                          uint8_t reg //!< Aux register to read, 0 for all
+                         );
+
 #ifdef MBED
 //This needs a PROGMEM =  when using with a LINDUINO
 const uint16_t crc15Table[256] {0x0,0xc599, 0xceab, 0xb32, 0xd8cf, 0x1d56, 0x1664, 0xd3fd, 0xf407, 0x319e, 0x3aac,  // precomputed CRC15 Table
@@ -47,6 +47,12 @@ Copyright 2017 Linear Technology Corp. (LTC)
 #include "LT_SPI.h"
 #include <SPI.h>
 
+void cs_init(uint8_t pin)
+{
+  output_high(pin);
+  pinMode(pin, OUTPUT);
+}
+
 void cs_low(uint8_t pin)
 {
   output_low(pin);
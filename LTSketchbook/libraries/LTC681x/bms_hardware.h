@@ -49,6 +49,7 @@ Copyright 2017 Linear Technology Corp. (LTC)
 #include <stdint.h>
 
 
+void cs_init(uint8_t pin);//drives the pin high and makes it an output
 void cs_low(uint8_t pin);//name conflicts with linduino
 
 void cs_high(uint8_t pin);
@@ -78,4 +79,4 @@ void spi_write_read(uint8_t tx_Data[],//array of data to be written on SPI port
                    );
 
 uint8_t spi_read_byte(uint8_t tx_dat);//name conflicts with linduino also needs to take a byte as a parameter
-#endif
\ No newline at end of file
+#endif
\ No newline at end of file
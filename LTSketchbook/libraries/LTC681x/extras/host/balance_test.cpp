@@ -0,0 +1,312 @@
+/*
+Host test for the LTC681x cell balancing engine.
+
+NOT AN ARDUINO SKETCH.  This program builds LTC681x with g++ against
+Utilities/host_stubs and replaces the bms_hardware SPI routines with a chain
+of two simulated LTC6813s.  The model decodes the register groups written to
+each IC (CFGRA, CFGRB, PWM A and PWM/S control B), checks their PEC, and
+returns cell voltages and the die temperature from a simple pack:
+
+  36 cells of 0.2 Ah with about 5% initial state of charge spread,
+  a 33 ohm bleed resistor per cell, one balancing update per second.
+
+Each update the registers of every IC must match the engine's state and
+obey the policy: no neighbouring cells when adjacency is off, at most
+max_per_ic cells per IC, and no bleeding on an IC while its die is past
+max_itmp.  The pack must converge, and LTC681x_balance_stop() must clear
+every discharge bit.  Convergence time and SPI bytes are printed for a few
+policies.
+
+  make
+  ./balance_test
+
+Copyright 2018(c) Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in
+   the documentation and/or other materials provided with the
+   distribution.
+ - Neither the name of Analog Devices, Inc. nor the names of its
+   contributors may be used to endorse or promote products derived
+   from this software without specific prior written permission.
+ - The use of this software may or may not infringe the patent rights
+   of one or more patent holders.  This license does not release you
+   from the requirement that you obtain separate licenses from these
+   patent holders to use this software.
+ - Use of the software either in source or binary form, must be run
+   on or directly connected to an Analog Devices Inc. component.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "LTC681x.h"
+#include "bms_hardware.h"
+
+#define TOTAL_IC        2
+#define CELLS           18
+#define CELL_AH         0.2
+#define BLEED_OHMS      33.0
+#define UPDATE_SECONDS  1.0
+#define MAX_UPDATES     200000
+#define HOT_START       100       // Updates during which IC 1 runs hot
+#define HOT_END         400
+
+// Simulated LTC6813
+struct sim_ic
+{
+  uint8_t cfga[6], cfgb[6], pwm[6], psb[6];
+  double soc[CELLS];
+  double volts[CELLS];
+  uint16_t itmp;
+};
+
+static sim_ic sim[TOTAL_IC];
+static uint8_t frame[512];
+static int frame_length;
+static long spi_bytes;
+static int failures;
+
+static uint8_t *sim_register(sim_ic &ic, uint16_t cmd)
+{
+  switch (cmd)
+  {
+    case 0x0001:
+      return ic.cfga;   // WRCFGA
+    case 0x0024:
+      return ic.cfgb;   // WRCFGB
+    case 0x0020:
+      return ic.pwm;    // WRPWM
+    case 0x001C:
+      return ic.psb;    // WRPSB
+  }
+  return NULL;
+}
+
+void cs_init(uint8_t) {}
+void delay_u(uint16_t) {}
+void delay_m(uint16_t) {}
+
+void cs_low(uint8_t)
+{
+  frame_length = 0;
+}
+
+// A write is applied when CS goes high.  The first data block of a daisy
+// chain write ends up in the last IC.
+void cs_high(uint8_t)
+{
+  if (frame_length > 4)
+  {
+    uint16_t cmd = (frame[0] << 8) | frame[1];
+    for (int k = 0; k < (frame_length - 4) / 8; k++)
+    {
+      uint8_t *data = frame + 4 + 8 * k;
+      uint8_t *reg = sim_register(sim[TOTAL_IC - 1 - k], cmd);
+      if (((data[6] << 8) | data[7]) != pec15_calc(6, data))
+      {
+        printf("FAIL: bad PEC in write %04X\n", cmd);
+        failures++;
+      }
+      else if (reg == NULL)
+      {
+        printf("FAIL: unexpected write %04X\n", cmd);
+        failures++;
+      }
+      else
+        memcpy(reg, data, 6);
+    }
+  }
+  frame_length = 0;
+}
+
+void spi_write_array(uint8_t length, uint8_t *data)
+{
+  memcpy(frame + frame_length, data, length);
+  frame_length += length;
+  spi_bytes += length;
+}
+
+void spi_write_read(uint8_t *tx, uint8_t tx_length, uint8_t *rx, uint8_t rx_length)
+{
+  static const uint16_t rdcv[6] = {0x0004, 0x0006, 0x0008, 0x000A, 0x0009, 0x000B};
+  uint16_t cmd = (tx[0] << 8) | tx[1];
+  int group = -1;
+
+  spi_bytes += tx_length + rx_length;
+  for (int g = 0; g < 6; g++)
+    if (cmd == rdcv[g])
+      group = g;
+  for (int i = 0; i < TOTAL_IC; i++)
+  {
+    uint8_t data[8] = {0};
+    if (group >= 0)
+    {
+      for (int c = 0; c < 3; c++)
+      {
+        uint16_t code = (uint16_t)(sim[i].volts[group * 3 + c] * 10000 + 0.5);
+        data[2 * c] = code;
+        data[2 * c + 1] = code >> 8;
+      }
+    }
+    else if (cmd == 0x0010)   // RDSTATA
+    {
+      data[2] = sim[i].itmp;
+      data[3] = sim[i].itmp >> 8;
+    }
+    uint16_t pec = pec15_calc(6, data);
+    data[6] = pec >> 8;
+    data[7] = pec;
+    memcpy(rx + 8 * i, data, 8);
+  }
+}
+
+uint8_t spi_read_byte(uint8_t)
+{
+  spi_bytes++;
+  return 0xFF;
+}
+
+static bool sim_dcc(const sim_ic &ic, int cell)
+{
+  if (cell < 8)
+    return (ic.cfga[4] >> cell) & 1;
+  if (cell < 12)
+    return (ic.cfga[5] >> (cell - 8)) & 1;
+  if (cell < 16)
+    return (ic.cfgb[0] >> (cell - 8)) & 1;
+  return (ic.cfgb[1] >> (cell - 16)) & 1;
+}
+
+static int sim_pwm(const sim_ic &ic, int cell)
+{
+  uint8_t reg = (cell < 12) ? ic.pwm[cell / 2] : ic.psb[(cell - 12) / 2];
+  return (cell & 1) ? reg >> 4 : reg & 0x0F;
+}
+
+static void fail(const char *what, long update, int ic, int cell)
+{
+  printf("FAIL: %s (update %ld, IC %d, cell %d)\n", what, update, ic, cell + 1);
+  failures++;
+}
+
+// Run the pack until balancing stops.  Returns false on a policy violation.
+static bool run_pack(bool allow_adjacent, uint8_t max_per_ic, bool hot)
+{
+  cell_asic ic[TOTAL_IC];
+  balance_ic bal_ic[TOTAL_IC];
+  balance_state state;
+  balance_cfg cfg = {50, 20, 30000, max_per_ic, allow_adjacent, 8, BALANCE_ITMP_CODE(60), 0, 0};
+  long updates = 0, register_updates = 0, balance_bytes = 0;
+  uint8_t bleeding;
+
+  memset(ic, 0, sizeof(ic));
+  memset(sim, 0, sizeof(sim));
+  LTC681x_init_reg_limits(TOTAL_IC, ic, IC_LTC6813);
+  LTC681x_balance_init(TOTAL_IC, &state, bal_ic);
+  srand(1);
+  for (int i = 0; i < TOTAL_IC; i++)
+  {
+    sim[i].itmp = BALANCE_ITMP_CODE(35);
+    for (int c = 0; c < CELLS; c++)
+      sim[i].soc[c] = 0.5 + 0.05 * (rand() / (double)RAND_MAX - 0.5);
+  }
+  spi_bytes = 0;
+
+  do
+  {
+    for (int i = 0; i < TOTAL_IC; i++)
+      for (int c = 0; c < CELLS; c++)
+        sim[i].volts[c] = 3.0 + 1.2 * sim[i].soc[c];
+    if (hot)
+      sim[1].itmp = BALANCE_ITMP_CODE(((updates >= HOT_START) && (updates < HOT_END)) ? 70 : 35);
+
+    LTC681x_adcv(MD_7KHZ_3KHZ, DCP_ENABLED, CELL_CH_ALL);
+    LTC681x_rdcv(0, TOTAL_IC, ic);
+    LTC681x_rdstat(1, TOTAL_IC, ic);
+    bleeding = LTC681x_balance_update(TOTAL_IC, ic, &cfg, &state);
+    if (state.spi_bytes)
+      register_updates++;
+    balance_bytes += state.spi_bytes;
+
+    for (int i = 0; i < TOTAL_IC; i++)
+    {
+      int count = 0;
+      for (int c = 0; c < CELLS; c++)
+      {
+        bool dcc = sim_dcc(sim[i], c);
+        if (dcc != (bool)((bal_ic[i].dcc >> c) & 1))
+          fail("DCC bit does not match the balancing state", updates, i, c);
+        if (sim_pwm(sim[i], c) != (dcc ? cfg.pwm_duty : 0))
+          fail("PWM duty does not match the DCC bit", updates, i, c);
+        if (dcc && !allow_adjacent && (c > 0) && sim_dcc(sim[i], c - 1))
+          fail("neighbouring cells bled", updates, i, c);
+        count += dcc;
+      }
+      if (max_per_ic && (count > max_per_ic))
+        fail("more than max_per_ic cells bled", updates, i, 0);
+      if (hot && (i == 1) && (updates >= HOT_START) && (updates < HOT_END) && count)
+        fail("hot IC bled", updates, i, 0);
+    }
+    if (failures)
+      return false;
+
+    for (int i = 0; i < TOTAL_IC; i++)
+      for (int c = 0; c < CELLS; c++)
+        if (sim_dcc(sim[i], c))
+          sim[i].soc[c] -= sim[i].volts[c] / BLEED_OHMS * UPDATE_SECONDS / (CELL_AH * 3600);
+    updates++;
+  }
+  while (bleeding && (updates < MAX_UPDATES));
+
+  if (bleeding)
+  {
+    printf("FAIL: no convergence after %d updates\n", MAX_UPDATES);
+    failures++;
+    return false;
+  }
+  printf("  %-8s %3u  %-3s  %7ld  %7.1f  %6u  %8ld  %7.1f  %7.1f\n", allow_adjacent ? "yes" : "no", max_per_ic,
+         hot ? "yes" : "no", updates, updates * UPDATE_SECONDS / 60, state.spread, register_updates,
+         (double)balance_bytes / (updates + 1), (double)spi_bytes / (updates + 1));
+
+  LTC681x_balance_stop(TOTAL_IC, ic, &cfg, &state);
+  for (int i = 0; i < TOTAL_IC; i++)
+    for (int c = 0; c < CELLS; c++)
+      if (sim_dcc(sim[i], c) || sim_pwm(sim[i], c))
+        fail("LTC681x_balance_stop() left a cell bleeding", updates, i, c);
+  return failures == 0;
+}
+
+int main()
+{
+  printf("  %-8s %3s  %-3s  %7s  %7s  %6s  %8s  %7s  %7s\n", "adjacent", "max", "hot", "updates", "minutes",
+         "spread", "register", "balance", "total");
+  printf("  %-8s %3s  %-3s  %7s  %7s  %6s  %8s  %7s  %7s\n", "", "", "", "", "", "codes", "writes",
+         "bytes", "bytes");
+  printf("  %-8s %3s  %-3s  %7s  %7s  %6s  %8s  %7s  %7s\n", "", "", "", "", "", "", "", "/update", "/update");
+  run_pack(false, 0, false);
+  run_pack(true, 0, false);
+  run_pack(false, 4, false);
+  run_pack(true, 2, false);
+  run_pack(false, 0, true);
+  run_pack(true, 4, true);
+
+  printf("\n%s\n", failures ? "FAILED" : "PASSED");
+  return failures ? 1 : 0;
+}
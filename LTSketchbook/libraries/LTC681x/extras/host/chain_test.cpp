@@ -0,0 +1,292 @@
+/*
+Host test for the LTC6804 libraries on the LTC681x core.
+
+NOT AN ARDUINO SKETCH.  This program is built twice against
+Utilities/host_stubs, once with LTC68041 (daisy chain) and once with LTC68042
+(addressed), both on top of LTC681x.  The bms_hardware SPI routines are
+replaced by a simulated chain of three LTC6804s that checks every command
+PEC, answers broadcast or addressed register reads, and applies
+configuration writes.
+
+For each variant it checks that:
+
+  LTC6804_wrcfg() puts each IC's configuration in the right IC,
+  LTC6804_rdcfg() reads it back,
+  LTC6804_adcv() and LTC6804_adax() send the commands chosen by set_adc(),
+  LTC6804_rdcv() and LTC6804_rdaux() parse every register group, and a
+  single group, into the right IC and cell,
+  a corrupted register PEC is reported, and clean data is not.
+
+The SPI bytes of each call are printed.
+
+  make
+  ./chain_test_68041
+  ./chain_test_68042
+
+Copyright 2018(c) Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in
+   the documentation and/or other materials provided with the
+   distribution.
+ - Neither the name of Analog Devices, Inc. nor the names of its
+   contributors may be used to endorse or promote products derived
+   from this software without specific prior written permission.
+ - The use of this software may or may not infringe the patent rights
+   of one or more patent holders.  This license does not release you
+   from the requirement that you obtain separate licenses from these
+   patent holders to use this software.
+ - Use of the software either in source or binary form, must be run
+   on or directly connected to an Analog Devices Inc. component.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <Arduino.h>
+#include "Linduino.h"
+#if LTC6804_VARIANT == 2
+#include "LTC68042.h"
+#else
+#include "LTC68041.h"
+#endif
+#include "bms_hardware.h"
+
+#define TOTAL_IC 3
+
+// Simulated LTC6804 chain.  IC 0 is the first IC read back, and the one at address 0.
+static uint8_t sim_cfg[TOTAL_IC][6];
+static uint8_t sim_cv[TOTAL_IC][4][6];
+static uint8_t sim_aux[TOTAL_IC][2][6];
+static uint8_t tx[256], rx[256];
+static int tx_count, rx_count, rx_next;
+static int corrupt_next_read;
+static uint16_t last_command;
+static long spi_bytes;
+static int failures;
+
+static void check(int ok, const char *what)
+{
+  if (!ok)
+  {
+    printf("FAIL: %s\n", what);
+    failures++;
+  }
+}
+
+static void sim_add_register(const uint8_t *reg)
+{
+  uint16_t pec = pec15_calc(6, (uint8_t *)reg);
+  memcpy(&rx[rx_count], reg, 6);
+  rx[rx_count + 6] = pec >> 8;
+  rx[rx_count + 7] = pec;
+  rx_count += 8;
+}
+
+// Decode the command once its four bytes are in and queue the read data
+static void sim_command()
+{
+  uint16_t command = ((tx[0] & 0x07) << 8) | tx[1];
+  uint8_t addressed = tx[0] & 0x80;
+  uint8_t address = (tx[0] >> 3) & 0x0F;
+  uint16_t pec = pec15_calc(2, tx);
+
+  check((tx[2] == (pec >> 8)) && (tx[3] == (pec & 0xFF)), "command PEC");
+  last_command = command;
+  for (int ic = 0; ic < TOTAL_IC; ic++)
+  {
+    if (addressed && (ic != address))
+      continue;
+    if (command == 0x0002)
+      sim_add_register(sim_cfg[ic]);
+    else if ((command >= 0x0004) && (command <= 0x000A) && !(command & 1))
+      sim_add_register(sim_cv[ic][(command - 0x0004) / 2]);
+    else if ((command == 0x000C) || (command == 0x000E))
+      sim_add_register(sim_aux[ic][(command - 0x000C) / 2]);
+  }
+  if (corrupt_next_read && rx_count)
+  {
+    rx[3] ^= 1;
+    corrupt_next_read = 0;
+  }
+}
+
+static uint8_t sim_transfer(uint8_t data)
+{
+  spi_bytes++;
+  if (tx_count < (int)sizeof(tx))
+    tx[tx_count++] = data;
+  if (tx_count == 4)
+  {
+    sim_command();
+    return 0xFF;
+  }
+  return ((tx_count > 4) && (rx_next < rx_count)) ? rx[rx_next++] : 0xFF;
+}
+
+void cs_init(uint8_t) {}
+void delay_u(uint16_t) {}
+void delay_m(uint16_t) {}
+void quikeval_SPI_connect() {}
+void spi_enable(uint8_t) {}
+
+void cs_low(uint8_t)
+{
+  tx_count = 0;
+  rx_count = 0;
+  rx_next = 0;
+}
+
+// Configuration writes take effect when CS goes high.  The first block of a
+// daisy chain write ends up in the last IC.
+void cs_high(uint8_t)
+{
+  if ((tx_count > 4) && ((((tx[0] & 0x07) << 8) | tx[1]) == 0x0001))
+  {
+    if (tx[0] & 0x80)
+      memcpy(sim_cfg[(tx[0] >> 3) & 0x0F], &tx[4], 6);
+    else
+      for (int ic = 0; ic < TOTAL_IC; ic++)
+        memcpy(sim_cfg[ic], &tx[4 + 8 * (TOTAL_IC - 1 - ic)], 6);
+  }
+  tx_count = 0;
+}
+
+void spi_write_array(uint8_t length, uint8_t *data)
+{
+  for (int i = 0; i < length; i++)
+    sim_transfer(data[i]);
+}
+
+void spi_write_read(uint8_t *tx_data, uint8_t tx_length, uint8_t *rx_data, uint8_t rx_length)
+{
+  for (int i = 0; i < tx_length; i++)
+    sim_transfer(tx_data[i]);
+  for (int i = 0; i < rx_length; i++)
+    rx_data[i] = sim_transfer(0xFF);
+}
+
+uint8_t spi_read_byte(uint8_t data)
+{
+  return sim_transfer(data);
+}
+
+static uint16_t sim_cell(int ic, int cell)
+{
+  const uint8_t *reg = sim_cv[ic][cell / 3];
+  return reg[2 * (cell % 3)] | (reg[2 * (cell % 3) + 1] << 8);
+}
+
+static uint16_t sim_gpio(int ic, int channel)
+{
+  const uint8_t *reg = sim_aux[ic][channel / 3];
+  return reg[2 * (channel % 3)] | (reg[2 * (channel % 3) + 1] << 8);
+}
+
+static void report(const char *name)
+{
+  printf("  %-30s %4ld SPI bytes\n", name, spi_bytes);
+  spi_bytes = 0;
+}
+
+int main()
+{
+  uint8_t config[TOTAL_IC][6];
+  uint8_t read_config[TOTAL_IC][8];
+  uint16_t cells[TOTAL_IC][12];
+  uint16_t gpio[TOTAL_IC][6];
+  int ic, i, same;
+
+  printf("LTC6804-%d, %d ICs\n", LTC6804_VARIANT, TOTAL_IC);
+  for (ic = 0; ic < TOTAL_IC; ic++)
+  {
+    for (i = 0; i < 24; i++)
+      sim_cv[ic][i / 6][i % 6] = 0x10 + 50 * ic + i;
+    for (i = 0; i < 12; i++)
+      sim_aux[ic][i / 6][i % 6] = 0x80 + 20 * ic + i;
+    for (i = 0; i < 6; i++)
+      config[ic][i] = (i == 0) ? 0xFE : ((i == 4) ? (1 << ic) : 0);
+  }
+
+  LTC6804_initialize();
+  wakeup_sleep();
+  spi_bytes = 0;
+
+  LTC6804_wrcfg(TOTAL_IC, config);
+  check(memcmp(sim_cfg, config, sizeof(config)) == 0, "wrcfg reaches the right IC");
+  report("LTC6804_wrcfg");
+
+  check(LTC6804_rdcfg(TOTAL_IC, read_config) == 0, "rdcfg PEC");
+  for (ic = 0; ic < TOTAL_IC; ic++)
+    check(memcmp(read_config[ic], config[ic], 6) == 0, "rdcfg data");
+  report("LTC6804_rdcfg");
+
+  LTC6804_adcv();
+  check(last_command == (0x0260 | (MD_NORMAL << 7) | (DCP_DISABLED << 4) | CELL_CH_ALL), "ADCV command");
+  report("LTC6804_adcv");
+  LTC6804_adax();
+  check(last_command == (0x0460 | (MD_NORMAL << 7) | AUX_CH_ALL), "ADAX command");
+  report("LTC6804_adax");
+
+  memset(cells, 0, sizeof(cells));
+  check(LTC6804_rdcv(0, TOTAL_IC, cells) == 0, "rdcv all groups PEC");
+  same = 1;
+  for (ic = 0; ic < TOTAL_IC; ic++)
+    for (i = 0; i < 12; i++)
+      same &= (cells[ic][i] == sim_cell(ic, i));
+  check(same, "rdcv all groups data");
+  report("LTC6804_rdcv, all groups");
+
+  for (uint8_t reg = 1; reg <= 4; reg++)
+  {
+    memset(cells, 0, sizeof(cells));
+    check(LTC6804_rdcv(reg, TOTAL_IC, cells) == 0, "rdcv single group PEC");
+    same = 1;
+    for (ic = 0; ic < TOTAL_IC; ic++)
+      for (i = 0; i < 12; i++)
+        same &= (cells[ic][i] == ((i / 3 == reg - 1) ? sim_cell(ic, i) : 0));
+    check(same, "rdcv single group data");
+  }
+  report("LTC6804_rdcv, each group");
+
+  memset(gpio, 0, sizeof(gpio));
+  check(LTC6804_rdaux(0, TOTAL_IC, gpio) == 0, "rdaux PEC");
+  same = 1;
+  for (ic = 0; ic < TOTAL_IC; ic++)
+    for (i = 0; i < 6; i++)
+      same &= (gpio[ic][i] == sim_gpio(ic, i));
+  check(same, "rdaux data");
+  report("LTC6804_rdaux");
+
+  corrupt_next_read = 1;
+  check(LTC6804_rdcv(2, TOTAL_IC, cells) != 0, "rdcv reports a PEC error");
+  corrupt_next_read = 1;
+  check(LTC6804_rdaux(1, TOTAL_IC, gpio) != 0, "rdaux reports a PEC error");
+  corrupt_next_read = 1;
+  check(LTC6804_rdcfg(TOTAL_IC, read_config) != 0, "rdcfg reports a PEC error");
+  spi_bytes = 0;
+
+  LTC6804_clrcell();
+  check(last_command == 0x0711, "CLRCELL command");
+  LTC6804_clraux();
+  check(last_command == 0x0712, "CLRAUX command");
+
+  printf("\n%s\n", failures ? "FAILED" : "PASSED");
+  return failures ? 1 : 0;
+}
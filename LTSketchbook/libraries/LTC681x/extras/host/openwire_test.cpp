@@ -0,0 +1,278 @@
+/*
+Host test for the incremental open wire check of the LTC681x library.
+
+NOT AN ARDUINO SKETCH.  This program builds LTC681x with g++ against
+Utilities/host_stubs.  The bms_hardware SPI routines are replaced by a
+simulated daisy chain of two LTC6811s.  ADCV fills the cell registers with
+the cell voltages.  ADOW does the same, except that with the pull-down
+current an open input Cn pulls CELLn down by 1.5 V per conversion, as the
+data sheet open wire algorithm expects.  An ADOW conversion stays busy for
+one PLADC poll.
+
+The application loop calls LTC681x_openwire_step() once per scan cycle and
+runs a normal ADCV scan and LTC681x_rdcv() whenever the ADC is free.  For a
+wire open at IC 1 C5 the test checks that:
+
+  the check reports C5 on IC 1 and nothing on IC 0, in open_wires and in
+  system_open_wire, after 3 pull-up and then 3 pull-down conversions,
+  every interleaved cell scan reads back the true cell voltages,
+  a PEC error on the phase read restarts the check, which still finds C5,
+  a check on an intact chain reports nothing,
+  the result of a check stays valid while the next one runs.
+
+The ADOW conversions and scan cycles per check are printed.
+
+  make
+  ./openwire_test
+
+Copyright 2018(c) Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in
+   the documentation and/or other materials provided with the
+   distribution.
+ - Neither the name of Analog Devices, Inc. nor the names of its
+   contributors may be used to endorse or promote products derived
+   from this software without specific prior written permission.
+ - The use of this software may or may not infringe the patent rights
+   of one or more patent holders.  This license does not release you
+   from the requirement that you obtain separate licenses from these
+   patent holders to use this software.
+ - Use of the software either in source or binary form, must be run
+   on or directly connected to an Analog Devices Inc. component.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "LTC681x.h"
+#include "bms_hardware.h"
+
+#define TOTAL_IC    2
+#define CELLS       12
+
+// Simulated LTC6811 chain.  IC 0 is the first IC read back.
+static double sim_volts[TOTAL_IC][CELLS];
+static uint16_t sim_cv[TOTAL_IC][CELLS];
+static int sim_open[TOTAL_IC];              // open input Cn, 0 for none
+static int sim_pull_downs;                  // ADOW pull-down conversions in a row
+static int sim_busy;                        // PLADC polls left before the conversion is done
+static bool sim_adow_last;                  // the cell registers hold an ADOW result
+static int corrupt_adow_read;               // corrupt this many reads of ADOW results
+static int adow_up, adow_down;              // ADOW conversions started
+static uint8_t frame[64];
+static int frame_length;
+static int failures;
+
+static void check(int ok, const char *what)
+{
+  if (!ok)
+  {
+    printf("FAIL: %s\n", what);
+    failures++;
+  }
+}
+
+static uint16_t code(double volts)
+{
+  return volts <= 0 ? 0 : (uint16_t)(volts * 10000 + 0.5);
+}
+
+static void sim_convert(bool adow, bool pull_up)
+{
+  if (adow && !pull_up)
+    sim_pull_downs++;
+  else
+    sim_pull_downs = 0;
+  for (int i = 0; i < TOTAL_IC; i++)
+    for (int c = 0; c < CELLS; c++)
+    {
+      double v = sim_volts[i][c];
+      if (adow && !pull_up && (sim_open[i] == c + 1))
+        v -= 1.5 * sim_pull_downs;
+      sim_cv[i][c] = code(v);
+    }
+  sim_adow_last = adow;
+}
+
+void cs_init(uint8_t) {}
+void delay_u(uint16_t) {}
+void delay_m(uint16_t) {}
+
+void cs_low(uint8_t)
+{
+  frame_length = 0;
+}
+
+// Conversion commands take effect when CS goes high
+void cs_high(uint8_t)
+{
+  if (frame_length == 4)
+  {
+    uint8_t cmd0 = frame[0] & 0x07, cmd1 = frame[1];
+    check(((frame[2] << 8) | frame[3]) == pec15_calc(2, frame), "command PEC");
+    if ((cmd0 & 0x06) == 0x02 && (cmd1 & 0x68) == 0x60)         // ADCV
+      sim_convert(false, false);
+    else if ((cmd0 & 0x06) == 0x02 && (cmd1 & 0x28) == 0x28)    // ADOW
+    {
+      bool pull_up = (cmd1 >> 6) & 1;
+      check(!pull_up || adow_down == 0, "pull-up phase before the pull-down phase");
+      if (pull_up)
+        adow_up++;
+      else
+        adow_down++;
+      sim_convert(true, pull_up);
+      sim_busy = 1;
+    }
+  }
+  frame_length = 0;
+}
+
+void spi_write_array(uint8_t length, uint8_t *data)
+{
+  memcpy(frame + frame_length, data, length);
+  frame_length += length;
+}
+
+void spi_write_read(uint8_t *tx, uint8_t tx_length, uint8_t *rx, uint8_t rx_length)
+{
+  static const uint16_t rdcv[4] = {0x0004, 0x0006, 0x0008, 0x000A};
+  uint16_t cmd = (tx[0] << 8) | tx[1];
+  int group = -1;
+
+  for (int g = 0; g < 4; g++)
+    if (cmd == rdcv[g])
+      group = g;
+  for (int i = 0; i < TOTAL_IC; i++)
+  {
+    uint8_t data[8] = {0};
+    if (group >= 0)
+      for (int c = 0; c < 3; c++)
+      {
+        data[2 * c] = sim_cv[i][group * 3 + c];
+        data[2 * c + 1] = sim_cv[i][group * 3 + c] >> 8;
+      }
+    uint16_t pec = pec15_calc(6, data);
+    data[6] = pec >> 8;
+    data[7] = pec;
+    memcpy(rx + 8 * i, data, 8);
+  }
+  if (group >= 0 && sim_adow_last && corrupt_adow_read > 0)
+  {
+    rx[8 * (TOTAL_IC - 1) + 2] ^= 1;
+    corrupt_adow_read--;
+  }
+}
+
+// PLADC: 0 while the conversion runs
+uint8_t spi_read_byte(uint8_t)
+{
+  if ((frame_length == 4) && (frame[0] == 0x07) && (frame[1] == 0x14))
+  {
+    if (sim_busy > 0)
+    {
+      sim_busy--;
+      return 0x00;
+    }
+    return 0xFF;
+  }
+  return 0xFF;
+}
+
+// Run one check to its result.  Returns the scan cycles it took.
+static int run_check(cell_asic *ic, openwire_state *ow, int *adow)
+{
+  int cycles = 0;
+  uint8_t state;
+
+  do
+  {
+    state = LTC681x_openwire_step(TOTAL_IC, ic, ow);
+    check(adow_up + adow_down <= 12, "check finishes");
+    if (adow_up + adow_down > 12)
+      break;
+    if (state != OPENWIRE_ADC_BUSY)
+    {
+      bool intact = true;
+      LTC681x_adcv(MD_7KHZ_3KHZ, DCP_DISABLED, CELL_CH_ALL);
+      check(LTC681x_rdcv(0, TOTAL_IC, ic) == 0, "scan PEC");
+      for (int i = 0; i < TOTAL_IC; i++)
+        for (int c = 0; c < CELLS; c++)
+          intact &= (ic[i].cells.c_codes[c] == code(sim_volts[i][c]));
+      check(intact, "interleaved scan reads the cell voltages");
+    }
+    cycles++;
+  }
+  while (state != OPENWIRE_RESULT);
+  *adow = adow_up + adow_down;
+  return cycles;
+}
+
+int main()
+{
+  cell_asic ic[TOTAL_IC];
+  openwire_ic ow_ic[TOTAL_IC];
+  openwire_state ow;
+  int cycles, adow;
+
+  memset(ic, 0, sizeof(ic));
+  LTC681x_init_reg_limits(TOTAL_IC, ic, IC_LTC6811);
+  for (int i = 0; i < TOTAL_IC; i++)
+    for (int c = 0; c < CELLS; c++)
+      sim_volts[i][c] = 3.6 + 0.01 * c + 0.1 * i;
+  printf("  %-36s %8s %6s %6s\n", "case", "interval", "ADOW", "cycles");
+
+  // Wire open at IC 1 C5
+  sim_open[1] = 5;
+  for (uint8_t interval = 1; interval <= 3; interval += 2)
+  {
+    LTC681x_openwire_init(TOTAL_IC, &ow, ow_ic, MD_7KHZ_3KHZ, interval);
+    adow_up = adow_down = 0;
+    cycles = run_check(ic, &ow, &adow);
+    printf("  %-36s %8u %6d %6d\n", "open IC 1 C5", interval, adow, cycles);
+    check(adow == 2 * OPENWIRE_CONVERSIONS, "6 ADOW conversions per check");
+    check(ow_ic[1].open_wires == (1UL << 5), "IC 1 C5 reported");
+    check(ow_ic[0].open_wires == 0, "IC 0 intact");
+    check(ic[1].system_open_wire == 5, "IC 1 system_open_wire");
+    check(ic[0].system_open_wire == 0xFFFF, "IC 0 system_open_wire");
+  }
+
+  // A PEC error on the pull-up phase read restarts the check
+  corrupt_adow_read = 1;
+  LTC681x_openwire_init(TOTAL_IC, &ow, ow_ic, MD_7KHZ_3KHZ, 3);
+  adow_up = adow_down = 0;
+  cycles = run_check(ic, &ow, &adow);
+  printf("  %-36s %8u %6d %6d\n", "open IC 1 C5, PEC error on a read", 3, adow, cycles);
+  check(adow == 3 * OPENWIRE_CONVERSIONS, "check restarted after the PEC error");
+  check(ow_ic[1].open_wires == (1UL << 5), "IC 1 C5 reported after a restart");
+
+  // Wire repaired: the old result stays until the next check finishes
+  sim_open[1] = 0;
+  LTC681x_openwire_start(&ow);
+  adow_up = adow_down = 0;
+  LTC681x_openwire_step(TOTAL_IC, ic, &ow);
+  check(ow_ic[1].open_wires == (1UL << 5), "result valid while the next check runs");
+  cycles = run_check(ic, &ow, &adow) + 1;
+  printf("  %-36s %8u %6d %6d\n", "intact chain", 3, adow, cycles);
+  check(ow_ic[0].open_wires == 0 && ow_ic[1].open_wires == 0, "intact chain reports nothing");
+  check(ic[0].system_open_wire == 0xFFFF && ic[1].system_open_wire == 0xFFFF, "intact system_open_wire");
+
+  printf("\n%s\n", failures ? "FAILED" : "PASSED");
+  return failures ? 1 : 0;
+}
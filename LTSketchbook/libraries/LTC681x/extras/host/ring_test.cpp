@@ -0,0 +1,292 @@
+/*
+Host test for the redundant isoSPI ring of the LTC681x library.
+
+NOT AN ARDUINO SKETCH.  This program builds LTC681x with g++ against
+Utilities/host_stubs.  The bms_hardware SPI routines are replaced by a
+simulated ring of six LTC6813s with two chip selects: FORWARD_CS reaches
+IC 0 first, REVERSE_CS reaches IC 5 first.  A broken link at position n
+cuts ICs n and above off the forward port and ICs below n off the reverse
+port; an IC that is cut off answers 0xFF.  ADCV gives every IC it reaches
+new codes, so stale codes can be told from fresh ones.
+
+It checks that:
+
+  a closed ring reads in one forward pass, 312 SPI bytes like LTC681x_rdcv(),
+  a break above IC 3 is latched on the second scan and every IC is fresh from then on,
+  a latched split scan reads the cells in 338 SPI bytes,
+  a repaired link is found by the next probe and the ring reads forward again,
+  a break at the host end is read entirely through the reverse port,
+  LTC681x_rdcv() of a single register group lands in the right cells.
+
+The SPI bytes of each scan are printed.
+
+  make
+  ./ring_test
+
+Copyright 2018(c) Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in
+   the documentation and/or other materials provided with the
+   distribution.
+ - Neither the name of Analog Devices, Inc. nor the names of its
+   contributors may be used to endorse or promote products derived
+   from this software without specific prior written permission.
+ - The use of this software may or may not infringe the patent rights
+   of one or more patent holders.  This license does not release you
+   from the requirement that you obtain separate licenses from these
+   patent holders to use this software.
+ - Use of the software either in source or binary form, must be run
+   on or directly connected to an Analog Devices Inc. component.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "LTC681x.h"
+#include "bms_hardware.h"
+
+#define TOTAL_IC        6
+#define FORWARD_CS      10
+#define REVERSE_CS      9
+#define CONFIRM         2
+#define PROBE_INTERVAL  4
+#define CLOSED_BYTES    312
+#define SPLIT_BYTES     338
+
+// Simulated LTC6813 ring.  IC 0 is the one next to the forward port.
+static int sim_break = -1;                  // first IC cut off the forward port, -1 for a closed ring
+static uint16_t sim_conversion;             // id of the next ADCV
+static uint16_t sim_value[TOTAL_IC];        // base code of each IC's last conversion
+static uint8_t tx[8], rx[256];
+static int tx_count, rx_count, rx_next;
+static int cs_pin;
+static long spi_bytes;
+static int failures;
+
+static void check(int ok, const char *what)
+{
+  if (!ok)
+  {
+    printf("FAIL: %s\n", what);
+    failures++;
+  }
+}
+
+static bool sim_reach(int ic)
+{
+  if (sim_break < 0)
+    return true;
+  return (cs_pin == FORWARD_CS) ? (ic < sim_break) : (ic >= sim_break);
+}
+
+static uint16_t sim_cell(int ic, int cell)
+{
+  return sim_value[ic] + 100 * cell;
+}
+
+// Decode the command once its four bytes are in and queue the read data
+static void sim_command()
+{
+  static const uint8_t rdcv[6] = {0x04, 0x06, 0x08, 0x0A, 0x09, 0x0B};
+  uint16_t command = ((tx[0] & 0x07) << 8) | tx[1];
+  int group = -1;
+
+  if ((command & 0x027F) == 0x0260)
+  {
+    for (int ic = 0; ic < TOTAL_IC; ic++)
+      if (sim_reach(ic))
+        sim_value[ic] = 1000 * ic + sim_conversion;
+    return;
+  }
+  for (int g = 0; g < 6; g++)
+    if (command == rdcv[g])
+      group = g;
+  if (group < 0)
+    return;
+  for (int k = 0; k < TOTAL_IC; k++)
+  {
+    int ic = (cs_pin == FORWARD_CS) ? k : TOTAL_IC - 1 - k;
+    uint8_t data[6];
+    if (!sim_reach(ic))
+    {
+      memset(&rx[rx_count], 0xFF, 8);
+      rx_count += 8;
+      continue;
+    }
+    for (int c = 0; c < 3; c++)
+    {
+      data[2 * c] = sim_cell(ic, group * 3 + c);
+      data[2 * c + 1] = sim_cell(ic, group * 3 + c) >> 8;
+    }
+    uint16_t pec = pec15_calc(6, data);
+    memcpy(&rx[rx_count], data, 6);
+    rx[rx_count + 6] = pec >> 8;
+    rx[rx_count + 7] = pec;
+    rx_count += 8;
+  }
+}
+
+static uint8_t sim_transfer(uint8_t data)
+{
+  spi_bytes++;
+  if (tx_count < 4)
+  {
+    tx[tx_count++] = data;
+    if (tx_count == 4)
+      sim_command();
+    return 0xFF;
+  }
+  return (rx_next < rx_count) ? rx[rx_next++] : 0xFF;
+}
+
+void cs_init(uint8_t) {}
+void delay_u(uint16_t) {}
+void delay_m(uint16_t) {}
+
+void cs_low(uint8_t pin)
+{
+  cs_pin = pin;
+  tx_count = 0;
+  rx_count = 0;
+  rx_next = 0;
+}
+
+void cs_high(uint8_t) {}
+
+void spi_write_array(uint8_t length, uint8_t *data)
+{
+  for (int i = 0; i < length; i++)
+    sim_transfer(data[i]);
+}
+
+void spi_write_read(uint8_t *tx_data, uint8_t tx_length, uint8_t *rx_data, uint8_t rx_length)
+{
+  for (int i = 0; i < tx_length; i++)
+    sim_transfer(tx_data[i]);
+  for (int i = 0; i < rx_length; i++)
+    rx_data[i] = sim_transfer(0xFF);
+}
+
+uint8_t spi_read_byte(uint8_t data)
+{
+  return sim_transfer(data);
+}
+
+static cell_asic ic[TOTAL_IC];
+static isospi_chain chain;
+static isospi_ring ring;
+static uint8_t scratch[LTC681x_SCRATCH_SIZE(TOTAL_IC)];
+
+// ICs whose codes are those of the conversion just started
+static int fresh_ics()
+{
+  int fresh = 0;
+  for (int i = 0; i < TOTAL_IC; i++)
+  {
+    bool same = true;
+    for (int c = 0; c < 18; c++)
+      same &= (ic[i].cells.c_codes[c] == 1000 * i + sim_conversion + 100 * c);
+    fresh += same;
+  }
+  return fresh;
+}
+
+// One application scan: wake up, convert, read.  Returns the SPI bytes of the read.
+static long scan(const char *name, int *fresh)
+{
+  long read_bytes;
+
+  sim_conversion++;
+  LTC681x_ring_wakeup_idle(&ring);
+  LTC681x_ring_adcv(&ring, MD_7KHZ_3KHZ, DCP_DISABLED, CELL_CH_ALL);
+  spi_bytes = 0;
+  check(LTC681x_ring_rdcv(&ring, 0) == 0, "every IC read with a good PEC");
+  read_bytes = spi_bytes;
+  *fresh = fresh_ics();
+  printf("  %-14s break_at %d  fresh %d/%d  %4ld SPI bytes\n", name, ring.break_at, *fresh, TOTAL_IC, read_bytes);
+  return read_bytes;
+}
+
+int main()
+{
+  long bytes;
+  int fresh, s;
+
+  LTC681x_init_chain(&chain, FORWARD_CS, TOTAL_IC, IC_LTC6813, ic, scratch);
+  LTC681x_ring_init(&ring, &chain, REVERSE_CS, CONFIRM, PROBE_INTERVAL);
+  printf("%d LTC6813s, confirm %d, probe every %d scans\n", TOTAL_IC, CONFIRM, PROBE_INTERVAL);
+
+  sim_conversion++;
+  LTC681x_select_chain(&chain);
+  LTC681x_adcv(MD_7KHZ_3KHZ, DCP_DISABLED, CELL_CH_ALL);
+  spi_bytes = 0;
+  check(LTC681x_rdcv(0, TOTAL_IC, ic) == 0, "rdcv PEC");
+  printf("  %-14s %27ld SPI bytes\n", "LTC681x_rdcv", spi_bytes);
+  check(spi_bytes == CLOSED_BYTES, "rdcv reads 312 SPI bytes");
+  check(fresh_ics() == TOTAL_IC, "rdcv data");
+
+  // Closed ring: one forward read
+  for (s = 0; s < 2; s++)
+  {
+    bytes = scan("closed", &fresh);
+    check(bytes == CLOSED_BYTES, "closed ring reads as rdcv");
+    check(fresh == TOTAL_IC && ring.break_at == TOTAL_IC, "closed ring fresh");
+  }
+  check(ring.reverse_reads == 0, "closed ring never reads in reverse");
+
+  // Break above IC 3: the first scan re-reads IC 4 and 5 in reverse, the second latches
+  sim_break = 4;
+  scan("break at 4", &fresh);
+  check(ring.break_at == TOTAL_IC && fresh == 4, "first scan gets the upper ICs' last codes");
+  scan("break at 4", &fresh);
+  check(ring.break_at == 4 && fresh == TOTAL_IC, "break latched on the second scan");
+  for (s = 0; s < PROBE_INTERVAL - 1; s++)
+  {
+    bytes = scan("split", &fresh);
+    check(fresh == TOTAL_IC, "split scan fresh");
+    check(bytes == SPLIT_BYTES, "split scan reads 338 SPI bytes");
+  }
+
+  // Repaired link: found by the next probe
+  sim_break = -1;
+  for (s = 0; s <= PROBE_INTERVAL && ring.break_at != TOTAL_IC; s++)
+  {
+    scan("repaired", &fresh);
+    check(fresh == TOTAL_IC, "repaired ring fresh");
+  }
+  check(ring.break_at == TOTAL_IC, "repaired link found by the next probe");
+  bytes = scan("closed", &fresh);
+  check(bytes == CLOSED_BYTES && fresh == TOTAL_IC, "repaired ring reads forward");
+
+  // Break at the host end: everything through the reverse port
+  sim_break = 0;
+  for (s = 0; s < CONFIRM + 1; s++)
+    scan("break at 0", &fresh);
+  check(ring.break_at == 0 && fresh == TOTAL_IC, "break at the host end read in reverse");
+
+  // Single register group
+  sim_break = -1;
+  LTC681x_select_chain(&chain);
+  check(LTC681x_rdcv(3, TOTAL_IC, ic) == 0, "rdcv group C PEC");
+  check(ic[2].cells.c_codes[6] == sim_cell(2, 6) && ic[5].cells.c_codes[8] == sim_cell(5, 8), "rdcv group C data");
+
+  printf("\n%s\n", failures ? "FAILED" : "PASSED");
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,233 @@
+/*
+Host benchmark for the LTC681x snapshot statistics.
+
+NOT AN ARDUINO SKETCH.  This program builds LTC681x with g++ against
+Utilities/host_stubs.  It fills a synthetic 10008-cell stack of 556 LTC6813s
+with random cell codes, a few out-of-limit cells and a few PEC errors, then
+takes the statistics in one call:
+
+  LTC681x_snapshot_cells() copies the codes into one contiguous array,
+  LTC681x_snapshot_module_stats() computes the per-IC and stack statistics.
+
+Every module and the stack are checked against a reference that walks
+ic[].cells.c_codes[] IC by IC, and both are timed.  snapshot_bench_novec is
+the same program built with -fno-tree-vectorize.
+
+  make
+  ./snapshot_bench
+  ./snapshot_bench_novec
+
+Copyright 2018(c) Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in
+   the documentation and/or other materials provided with the
+   distribution.
+ - Neither the name of Analog Devices, Inc. nor the names of its
+   contributors may be used to endorse or promote products derived
+   from this software without specific prior written permission.
+ - The use of this software may or may not infringe the patent rights
+   of one or more patent holders.  This license does not release you
+   from the requirement that you obtain separate licenses from these
+   patent holders to use this software.
+ - Use of the software either in source or binary form, must be run
+   on or directly connected to an Analog Devices Inc. component.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "LTC681x.h"
+#include "bms_hardware.h"
+
+#define TOTAL_IC    556
+#define CELLS       18
+#define TOTAL_CELLS (TOTAL_IC*CELLS)
+#define OV_CODE     42000
+#define UV_CODE     30000
+#define RUNS        2000
+
+static cell_asic ic[TOTAL_IC];
+static uint16_t codes[TOTAL_CELLS];
+static uint8_t pec_errors[TOTAL_IC];
+static snapshot_stats module[TOTAL_IC];
+static snapshot_stats ref_module[TOTAL_IC];
+static int failures;
+
+static void check(int ok, const char *what, int index)
+{
+  if (!ok)
+  {
+    printf("FAIL: %s (%d)\n", what, index);
+    failures++;
+  }
+}
+
+// No SPI traffic: the benchmark fills ic[] directly
+void cs_init(uint8_t) {}
+void cs_low(uint8_t) {}
+void cs_high(uint8_t) {}
+void delay_u(uint16_t) {}
+void delay_m(uint16_t) {}
+void spi_write_array(uint8_t, uint8_t *) {}
+void spi_write_read(uint8_t *, uint8_t, uint8_t *, uint8_t) {}
+uint8_t spi_read_byte(uint8_t)
+{
+  return 0xFF;
+}
+
+static double now_us()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+// Reference: the IC by IC walk application code does today
+static void aos_stats(snapshot_stats *stack)
+{
+  memset(stack, 0, sizeof(*stack));
+  stack->min = 0xFFFF;
+  for (int i = 0; i < TOTAL_IC; i++)
+  {
+    snapshot_stats *st = &ref_module[i];
+    memset(st, 0, sizeof(*st));
+    st->min = 0xFFFF;
+    for (int c = 0; c < CELLS; c++)
+    {
+      uint16_t code = ic[i].cells.c_codes[c];
+      if (code < st->min)
+      {
+        st->min = code;
+        st->min_index = c;
+      }
+      if (code > st->max)
+      {
+        st->max = code;
+        st->max_index = c;
+      }
+      st->sum += code;
+      if (code > OV_CODE)
+        st->over++;
+      if (code < UV_CODE)
+        st->under++;
+    }
+    for (int reg = 0; reg < 6; reg++)
+      st->pec_errors += ic[i].cells.pec_match[reg];
+    st->mean = st->sum / CELLS;
+    st->delta = st->max - st->min;
+    if (st->over > 0) st->flags |= SNAPSHOT_OVER;
+    if (st->under > 0) st->flags |= SNAPSHOT_UNDER;
+    if (st->pec_errors > 0) st->flags |= SNAPSHOT_PEC;
+    if (st->min < stack->min)
+    {
+      stack->min = st->min;
+      stack->min_index = i * CELLS + st->min_index;
+    }
+    if (st->max > stack->max)
+    {
+      stack->max = st->max;
+      stack->max_index = i * CELLS + st->max_index;
+    }
+    stack->sum += st->sum;
+    stack->over += st->over;
+    stack->under += st->under;
+    stack->pec_errors += st->pec_errors;
+    stack->flags |= st->flags;
+  }
+  stack->mean = stack->sum / TOTAL_CELLS;
+  stack->delta = stack->max - stack->min;
+}
+
+static void compare(const snapshot_stats *a, const snapshot_stats *b, int index)
+{
+  check(a->min == b->min && a->max == b->max, "min and max", index);
+  check(a->min_index == b->min_index && a->max_index == b->max_index, "positions", index);
+  check(a->sum == b->sum && a->mean == b->mean && a->delta == b->delta, "sum, mean and delta", index);
+  check(a->over == b->over && a->under == b->under, "over and under counts", index);
+  check(a->pec_errors == b->pec_errors && a->flags == b->flags, "PEC errors and flags", index);
+}
+
+int main()
+{
+  snapshot_stats stack, ref_stack;
+  volatile uint32_t sink = 0;
+  double start, flat_us, copy_us, aos_us;
+  uint16_t n = 0;
+
+  for (int i = 0; i < TOTAL_IC; i++)
+    LTC681x_init_reg_limits(1, &ic[i], IC_LTC6813);
+  srand(1);
+  for (int i = 0; i < TOTAL_IC; i++)
+    for (int c = 0; c < CELLS; c++)
+      ic[i].cells.c_codes[c] = 36000 + rand() % 4000;
+  ic[17].cells.c_codes[4] = 43000;
+  ic[300].cells.c_codes[11] = 29000;
+  ic[555].cells.c_codes[17] = 45000;
+  ic[42].cells.pec_match[2] = 1;
+  ic[511].cells.pec_match[0] = 1;
+  ic[511].cells.pec_match[5] = 1;
+
+  // Results
+  n = LTC681x_snapshot_cells(TOTAL_IC, ic, codes, pec_errors);
+  check(n == TOTAL_CELLS, "codes written", n);
+  uint8_t flags = LTC681x_snapshot_module_stats(codes, TOTAL_IC, CELLS, pec_errors, OV_CODE, UV_CODE, module, &stack);
+  aos_stats(&ref_stack);
+  for (int i = 0; i < TOTAL_IC; i++)
+    compare(&module[i], &ref_module[i], i);
+  compare(&stack, &ref_stack, -1);
+  check(flags == (SNAPSHOT_OVER | SNAPSHOT_UNDER | SNAPSHOT_PEC), "stack flags", flags);
+  check(stack.max_index == 555 * CELLS + 17 && stack.min_index == 300 * CELLS + 11, "stack positions", -1);
+  check(stack.over == 2 && stack.under == 1 && stack.pec_errors == 3, "stack counts", -1);
+
+  // Timing
+  start = now_us();
+  for (int r = 0; r < RUNS; r++)
+  {
+    LTC681x_snapshot_module_stats(codes, TOTAL_IC, CELLS, pec_errors, OV_CODE, UV_CODE, module, &stack);
+    sink += stack.sum;
+  }
+  flat_us = (now_us() - start) / RUNS;
+  start = now_us();
+  for (int r = 0; r < RUNS; r++)
+  {
+    LTC681x_snapshot_cells(TOTAL_IC, ic, codes, pec_errors);
+    sink += codes[r % TOTAL_CELLS];
+  }
+  copy_us = (now_us() - start) / RUNS;
+  start = now_us();
+  for (int r = 0; r < RUNS; r++)
+  {
+    aos_stats(&ref_stack);
+    sink += ref_stack.sum;
+  }
+  aos_us = (now_us() - start) / RUNS;
+
+  printf("%d cells, %d ICs, %d runs\n", TOTAL_CELLS, TOTAL_IC, RUNS);
+  printf("  snapshot_module_stats  %8.1f us\n", flat_us);
+  printf("  snapshot_cells         %8.1f us\n", copy_us);
+  printf("  AoS walk               %8.1f us\n", aos_us);
+  printf("  stack min %u @%u, max %u @%u, mean %u, flags 0x%02X\n", stack.min, stack.min_index,
+         stack.max, stack.max_index, stack.mean, flags);
+
+  printf("\n%s\n", failures ? "FAILED" : "PASSED");
+  return failures ? 1 : 0;
+}
@@ -107,7 +107,8 @@ void LT_PMBusDetect::detect ()
     free(rails_);
   }
 
-  addresses = pmbus_->smbus()->probeUnique(0x00);
+  addresses = pmbus_->smbus()->scanCached(LT_SMBUS_SCAN_FIRST, LT_SMBUS_SCAN_LAST, true, LT_SMBUS_SCAN_SPEED,
+                                           LT_PMBUS_DETECT_SCAN_AGE);
 
   // May be more than required. Can add code to trim based on deviceCnt_
   // +1 and calloc so there is a terminating NULL
@@ -195,4 +196,4 @@ void LT_PMBusDetect::detect ()
 
   rails_ = (LT_PMBusRail **) realloc(rails_, (railCnt_ + 1) * sizeof(LT_PMBusRail *));
   rails_[railCnt_] = NULL;
-}
\ No newline at end of file
+}
\ No newline at end of file
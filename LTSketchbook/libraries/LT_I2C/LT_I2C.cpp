@@ -80,6 +80,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <Arduino.h>
 #include <stdint.h>
+#include <avr/interrupt.h>
 #include <util/delay.h>
 #include "Linduino.h"
 #include "LT_I2C.h"
@@ -89,302 +90,136 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define F_CPU 16000000UL
 #endif
 
-// Read a byte, store in "value".
-int8_t i2c_read_byte(uint8_t address, uint8_t *value)
+static i2c_transaction *volatile i2c_queue_head = NULL;  // Transaction being executed, NULL if idle
+static i2c_transaction *volatile i2c_queue_tail = NULL;  // Last queued transaction
+static volatile uint8_t i2c_queue_index;                 // Byte index within the current phase
+static volatile uint8_t i2c_queue_phase;                 // 0 = command bytes, 1 = write data, 2 = read data
+
+static int8_t i2c_wait_stop();
+static int8_t i2c_queue_wait(i2c_transaction *transaction);
+
+// Runs one transaction on the queue and waits for it to finish. Data arrays are sent and filled
+// from the last index down, like the blocking routines always have.
+static int8_t i2c_transfer_flags(uint8_t address, const uint8_t *command, uint8_t command_length,
+                                 uint8_t *write_data, uint8_t write_length, uint8_t *read_data, uint8_t read_length,
+                                 uint8_t flags)
 {
-  uint8_t ret=0;
-  if (i2c_start()!=0)                                //I2C START
-    return(1);                                  //Stop and return 0 if START fail
-  ret |= i2c_write((address<<1)|I2C_READ_BIT);                // Write the I2C 7-bit address with R bit
-  if (ret != 0)                                   // Returns 1 if failed
+  i2c_transaction transaction;
+  uint8_t i;
+
+  transaction.address = address;
+  for (i = 0; i < command_length; i++)
+    transaction.command[i] = command[i];
+  transaction.command_length = command_length;
+  transaction.write_data = write_data;
+  transaction.write_length = write_length;
+  transaction.read_data = read_data;
+  transaction.read_length = read_length;
+  transaction.flags = flags;
+  transaction.status = I2C_TRANSACTION_DONE;
+  transaction.callback = NULL;
+  if (i2c_queue_transaction(&transaction) != 0)
     return(1);
+  return(i2c_wait_transaction(&transaction));
+}
 
-  *value = i2c_read(WITH_NACK);                           // Read byte from I2C Bus with NAK
-  i2c_stop();                                     //I2C STOP
-  return(0);                                      // Return success
+// Blocking transfer with the byte order of the original LT_I2C routines: arrays last index first
+static int8_t i2c_transfer(uint8_t address, const uint8_t *command, uint8_t command_length,
+                           uint8_t *write_data, uint8_t write_length, uint8_t *read_data, uint8_t read_length)
+{
+  return(i2c_transfer_flags(address, command, command_length, write_data, write_length, read_data, read_length,
+                            I2C_TRANSACTION_MSB_FIRST));
+}
 
+// Read a byte, store in "value".
+int8_t i2c_read_byte(uint8_t address, uint8_t *value)
+{
+  return(i2c_transfer(address, NULL, 0, NULL, 0, value, 1));
 }
 
 // Write "value" byte to device at "address"
 int8_t i2c_write_byte(uint8_t address, uint8_t value)
 {
-  int8_t ret= 0 ;
-
-  if (i2c_start()!=0)                                //I2C START
-    return(1);                                  //Stop and return 0 if START fail
-  ret |= i2c_write((address<<1)|I2C_WRITE_BIT);        //Write the I2C 7 bit address with W bit
-  ret |= i2c_write(value);            //Write value
-  i2c_stop();                         //I2C STOP
-  if (ret!=0)                            // Returns 1 if failed
-    return(1);
-  return(0);                          // Returns 0 if success
+  return(i2c_transfer(address, &value, 1, NULL, 0, NULL, 0));
 }
 
 // Read a byte of data at register specified by "command", store in "value"
 int8_t i2c_read_byte_data(uint8_t address, uint8_t command, uint8_t *value)
 {
-  int8_t ret = 0;
-  if (i2c_start()!=0)                                //I2C START
-    return(1);                                  //Stop and return 0 if START fail
-  ret |= i2c_write((address<<1)|I2C_WRITE_BIT);        // Write 7 bit address with W bit
-  if (ret!=0)   //If NACK return 1
-  {
-    i2c_stop();                         //I2C STOP
-    return(1);
-  }
-  ret|= i2c_write(command);                 // Set register to be read to command
-  if (ret!=0)   //If NACK return 1
-  {
-    i2c_stop();                         //I2C STOP
-    return(1);
-  }
-  if (i2c_start()!=0)                                 //I2C repeated START
-  {
-    i2c_stop();                                 //Attempt to issue I2C STOP
-    return(1);                                  //Stop and return 0 if START fail
-  }
-  ret |= i2c_write((address<<1)|I2C_READ_BIT);     // Write 7 bit address with R bit
-  *value = i2c_read(WITH_NACK);               // Read byte from buffer with NAK
-  i2c_stop();                         // I2C STOP
-  if (ret!=0)                         //If there was a NAK return 1
-    return(1);
-  return(0);                     // Return success
+  return(i2c_transfer(address, &command, 1, NULL, 0, value, 1));
 }
 
 // Write a byte of data to register specified by "command"
 int8_t i2c_write_byte_data(uint8_t address, uint8_t command, uint8_t value)
 {
-  int8_t ret = 0;
-
-  if (i2c_start()!=0)                                //I2C START
-    return(1);                                  //Stop and return 0 if START fail
-  ret |= i2c_write((address<<1)|I2C_WRITE_BIT);        // Write 7 bit address with W bit
-  ret|= i2c_write(command);                 // Set register to be read to command
-  ret|= i2c_write(value);
-  i2c_stop();                        // I2C STOP
+  uint8_t bytes[2];
 
-  if (ret!=0)                         //If there was a NAK return 1
-    return(1);
-  return(0);                     // Return success
+  bytes[0] = command;
+  bytes[1] = value;
+  return(i2c_transfer(address, bytes, 2, NULL, 0, NULL, 0));
 }
 
 // Read a 16-bit word of data from register specified by "command"
 int8_t i2c_read_word_data(uint8_t address, uint8_t command, uint16_t *value)
 {
-  int8_t ret = 0;
-
-  union
-  {
-    uint8_t b[2];
-    uint16_t w;
-  } data;
+  uint8_t data[2];                                    // data[1] is the MSB, read first
 
-
-  if (i2c_start()!=0)                                //I2C START
-    return(1);                                  //Stop and return 0 if START fail
-  ret |= i2c_write((address<<1)|I2C_WRITE_BIT);        // Write 7 bit address with W bit
-  if (ret!=0)   //If NACK return 1
-  {
-    i2c_stop();                         //I2C STOP
-    return(1);
-  }
-  ret |= i2c_write(command);                 // Set register to be read to command
-  if (ret!=0)   //If NACK return 1
-  {
-    i2c_stop();                         //I2C STOP
+  if (i2c_transfer(address, &command, 1, NULL, 0, data, 2) != 0)
     return(1);
-  }
-  if (i2c_start()!=0)                                 //I2C START
-  {
-    i2c_stop();                                 //Attempt to issue I2C STOP
-    return(1);                                  //Stop and return 0 if START fail
-  }
-  ret |= i2c_write((address<<1)|I2C_READ_BIT);     // Write 7 bit address with R bit
-
-  data.b[1] = i2c_read(WITH_ACK);                        // Read MSB from buffer
-  data.b[0] = i2c_read(WITH_NACK);                        // Read LSB from buffer
-  i2c_stop();                         //I2C STOP
-
-  *value = data.w;
-
-  if (ret!=0)                         //If NAK
-    return (1);                     //return 1
-  return(0);                                      // Return success
+  *value = ((uint16_t)data[1] << 8) | data[0];
+  return(0);
 }
 
 // Write a 16-bit word of data to register specified by "command"
 int8_t i2c_write_word_data(uint8_t address, uint8_t command, uint16_t value)
 {
-  int8_t ret=0;
-
-  union
-  {
-    uint8_t b[2];
-    uint16_t w;
-  } data;
-  data.w = value;
-
-  if (i2c_start()!=0)                                //I2C START
-    return(1);                                  //Stop and return 0 if START fail
-  ret |= i2c_write((address<<1)|I2C_WRITE_BIT);       // Write 7 bit address with W bit
-  ret|= i2c_write(command);                 // Set register to be read to command
-  ret|= i2c_write(data.b[1]);         //Write MSB
-  ret|= i2c_write(data.b[0]);         //Write LSB;
-
-  i2c_stop();                        // I2C STOP
-
-  if (ret!=0)                         //If there was a NAK return 1
-    return(1);
-  return(0);
-
+  uint8_t data[2];                                    // data[1] is the MSB, written first
 
+  data[1] = value >> 8;
+  data[0] = value & 0xFF;
+  return(i2c_transfer(address, &command, 1, data, 2, NULL, 0));
 }
 
 // Read a block of data, starting at register specified by "command" and ending at (command + length - 1)
 int8_t i2c_read_block_data(uint8_t address, uint8_t command, uint8_t length, uint8_t *values)
 {
-  uint8_t i = (length-1);
-  int8_t ret = 0;
-
-  if (i2c_start()!=0)                                //I2C START
-    return(1);                                  //Stop and return 0 if START fail
-  ret |= i2c_write((address<<1)|I2C_WRITE_BIT);       //Write 7-bit address with W bit
-  if (ret!=0)   //If NACK return 1
-  {
-    i2c_stop();                         //I2C STOP
-    return(1);
-  }
-  ret|= i2c_write(command);                           //Write 8 bit command word
-  if (ret!=0)   //If NACK return 1
-  {
-    i2c_stop();                         //I2C STOP
+  if (length == 0)
     return(1);
-  }
-  if (i2c_start()!=0)                                 //I2C repeated START
-  {
-    i2c_stop();                                 //Attempt to issue I2C STOP
-    return(1);                                  //Stop and return 0 if START fail
-  }
-  ret |= i2c_write((address<<1)|I2C_READ_BIT);        //Write 7-bit address with R bit
+  return(i2c_transfer(address, &command, 1, NULL, 0, values, length));
+}
 
-  if (ret!=0)   //If NACK return 1
-  {
-    i2c_stop();                         //I2C STOP
+// Read a block of data, starting at register specified by "command", in register order
+int8_t i2c_read_register_block(uint8_t address, uint8_t command, uint8_t length, uint8_t *values)
+{
+  if (length == 0)
     return(1);
-  }
-  while (i>0)                         //Begin read loop
-  {
-    values[i] = i2c_read(WITH_ACK); //Read from bus with ACK
-    i--;
-  }
-
-  values[0] = i2c_read(WITH_NACK);    //Read from bus with NACK for the last one;
-
-  i2c_stop();                         //I2C STOP
-
-
-  return(0);                           // Success!
+  return(i2c_transfer_flags(address, &command, 1, NULL, 0, values, length, 0));
 }
 
-
 // Read a block of data, no command byte, reads length number of bytes and stores it in values.
 int8_t i2c_read_block_data(uint8_t address, uint8_t length, uint8_t *values)
 {
-  uint8_t i = (length-1);
-  int8_t ret = 0;
-
-  if (i2c_start()!=0)                                //I2C START
-    return(1);                                  //Stop and return 0 if START fail
-  ret |= i2c_write((address<<1)|I2C_READ_BIT);        //Write 7-bit address with R bit
-
-  if (ret!=0)   //If NACK return 1
-  {
-    i2c_stop();                         //I2C STOP
+  if (length == 0)
     return(1);
-  }
-  while (i>0)                         //Begin read loop
-  {
-    values[i] = i2c_read(WITH_ACK); //Read from bus with ACK
-    i--;
-  }
-
-  values[0] = i2c_read(WITH_NACK);    //Read from bus with NACK for the last one;
-
-  i2c_stop();                         //I2C STOP
-
-
-  return(0);                           // Success!
+  return(i2c_transfer(address, NULL, 0, NULL, 0, values, length));
 }
 
-
 // Write a block of data, starting at register specified by "command" and ending at (command + length - 1)
 int8_t i2c_write_block_data(uint8_t address, uint8_t command, uint8_t length, uint8_t *values)
 {
-  int8_t i = length-1;
-  int8_t ret = 0;
-
-  if (i2c_start()!=0)                                //I2C START
-    return(1);                                  //Stop and return 0 if START fail
-  ret |= i2c_write((address<<1)|I2C_WRITE_BIT);        // Write 7 bit address with W bit
-  ret|= i2c_write(command);           // Set register to be read to command
-
-  while (i>=0)
-  {
-    ret|= i2c_write(values[i]);     //Write Value
-    i--;
-  }
-  i2c_stop();                        // I2C STOP
-
-  if (ret!=0)
-    return(1);
-  else
-    return(0);                      // Success!
+  return(i2c_transfer(address, &command, 1, values, length, NULL, 0));
 }
 
 // Write two command bytes, then receive a block of data
 int8_t i2c_two_byte_command_read_block(uint8_t address, uint16_t command, uint8_t length, uint8_t *values)
 {
+  uint8_t bytes[2];
 
-  int8_t ret = 0;
-
-  union
-  {
-    uint8_t b[2];
-    uint16_t w;
-  } comm;
-  comm.w = command;
-
-  uint8_t i = (length-1);
-
-
-  if (i2c_start()!=0)                                //I2C START
-    return(1);                                  //Stop and return 0 if START fail
-  ret |= i2c_write((address<<1)|I2C_WRITE_BIT);           //Write 7-bit address with W bit
-  ret |= i2c_write(comm.b[1]);                             //Write MSB command word
-  ret |= i2c_write(comm.b[0]);                             // Write LSB of command
-  if (i2c_start()!=0)                                 //I2C repeated START
-  {
-    i2c_stop();                                 //Attempt to issue I2C STOP
-    return(1);                                  //Stop and return 0 if START fail
-  }
-  ret |= i2c_write((address<<1)|I2C_READ_BIT);            //Write 7-bit address with R bit
-  if (ret!=0)                                              //If NACK return 1
-  {
-    i2c_stop();
+  if (length == 0)
     return(1);
-  }
-  while (i> 0)                         //Begin read loop
-  {
-    values[i] = i2c_read(WITH_ACK); //Read from bus with ACK
-    i--;
-  }
-
-  values[0] = i2c_read(WITH_NACK);    //Read from bus with NACK for the last one;
-  i2c_stop();                         //I2C STOP
-
-
-  return(0);                           // Success!
-
+  bytes[0] = command >> 8;                            // MSB first
+  bytes[1] = command & 0xFF;
+  return(i2c_transfer(address, bytes, 2, NULL, 0, values, length));
 }
 
 // Initializes Linduino I2C port.
@@ -420,12 +255,31 @@ void i2c_enable()
 }
 
 
+// Wait for a stop condition to be sent
+// return 0 if successful, 1 if the stop is still pending after HW_I2C_TIMEOUT us
+static int8_t i2c_wait_stop()
+{
+  uint16_t timeout;
+  for (timeout = 0; timeout < HW_I2C_TIMEOUT; timeout++)
+  {
+    if (!(TWCR & (1<<TWSTO))) return(0);
+    _delay_us(1);
+  }
+  return(1);
+}
+
 // Write start bit to the hardware I2C port
 // return 0 if successful, 1 if not successful
 int8_t i2c_start()
 {
   uint8_t result;
   uint16_t timeout;
+  if (i2c_queue_wait(NULL))                                 //! 0) Wait for queued transactions to finish
+  {
+    i2c_wait_stop();
+    return(1);
+  }
+  if (i2c_wait_stop()) return(1);                           //!    and for their stop condition
   TWCR=(1<<TWINT) | (1<<TWSTA) | (1<<TWEN);                 //! 1) I2C start
   for (timeout = 0; timeout < HW_I2C_TIMEOUT; timeout++)    //! 2) START the timeout loop
   {
@@ -462,7 +316,7 @@ int8_t i2c_repeated_start()
 void i2c_stop()
 {
   TWCR=(1<<TWINT) | (1<<TWEN) | (1<<TWSTO);  //! 1) I2C stop
-  while (TWCR & (1<<TWSTO));                 //! 2) Wait for stop to complete
+  i2c_wait_stop();                           //! 2) Wait for stop to complete
 }
 
 // Send a data byte to hardware I2C port
@@ -524,11 +378,303 @@ uint8_t i2c_read(int8_t ack)
 // Poll the I2C port and look for an acknowledge
 // Returns 0 if successful, 1 if not successful
 int8_t i2c_poll(uint8_t i2c_address)
+{
+  return(i2c_transfer(i2c_address, NULL, 0, NULL, 0, NULL, 0));  // Address with W bit, then stop
+}
+
+// Start the transaction at the head of the queue. TWCR bits other than the start
+// condition are supplied by the caller so a stop can be sent in the same write.
+static uint8_t i2c_queue_begin(i2c_transaction *transaction)
+{
+  transaction->status = I2C_TRANSACTION_ACTIVE;
+  i2c_queue_index = 0;
+  i2c_queue_phase = 0;
+  return((1<<TWINT) | (1<<TWEN) | (1<<TWIE) | (1<<TWSTA));
+}
+
+// Finish the current transaction with status, then start the next one if there is one.
+static void i2c_queue_finish(uint8_t status)
+{
+  i2c_transaction *transaction = i2c_queue_head;
+  i2c_transaction *next = transaction->next;
+  uint8_t control = (1<<TWINT) | (1<<TWEN) | (1<<TWSTO);
+
+  i2c_queue_head = next;
+  if (next == NULL)
+    i2c_queue_tail = NULL;
+  else
+    control |= i2c_queue_begin(next);                       // A stop followed by a start
+  TWCR = control;
+  transaction->next = NULL;
+  transaction->status = status;
+  if (transaction->callback != NULL)
+    transaction->callback(transaction);
+}
+
+// Return the index into a data array, honoring I2C_TRANSACTION_MSB_FIRST
+static uint8_t i2c_queue_data_index(i2c_transaction *transaction, uint8_t length)
+{
+  if (transaction->flags & I2C_TRANSACTION_MSB_FIRST)
+    return(length - 1 - i2c_queue_index);
+  return(i2c_queue_index);
+}
+
+// Send the next command or data byte, or move on to the read phase or stop.
+static void i2c_queue_write_next(i2c_transaction *transaction)
+{
+  if (i2c_queue_phase == 0)
+  {
+    if (i2c_queue_index < transaction->command_length)
+    {
+      TWDR = transaction->command[i2c_queue_index++];
+      TWCR = (1<<TWINT) | (1<<TWEN) | (1<<TWIE);
+      return;
+    }
+    i2c_queue_phase = 1;
+    i2c_queue_index = 0;
+  }
+  if (i2c_queue_phase == 1)
+  {
+    if (i2c_queue_index < transaction->write_length)
+    {
+      TWDR = transaction->write_data[i2c_queue_data_index(transaction, transaction->write_length)];
+      i2c_queue_index++;
+      TWCR = (1<<TWINT) | (1<<TWEN) | (1<<TWIE);
+      return;
+    }
+  }
+  if (transaction->read_length > 0)
+  {
+    i2c_queue_phase = 2;                                      // Repeated start, then read
+    i2c_queue_index = 0;
+    TWCR = (1<<TWINT) | (1<<TWEN) | (1<<TWIE) | (1<<TWSTA);
+  }
+  else
+    i2c_queue_finish(I2C_TRANSACTION_DONE);
+}
+
+// TWI state machine. Runs for each TWINT, from the TWI interrupt or from i2c_queue_wait().
+static void i2c_queue_service()
+{
+  i2c_transaction *transaction = i2c_queue_head;
+  uint8_t remaining;
+
+  if (transaction == NULL)
+  {
+    TWCR = (1<<TWINT) | (1<<TWEN);                            // Nothing to do, release the interrupt
+    return;
+  }
+
+  switch (TWSR & 0xF8)
+  {
+    case STATUS_START:
+    case STATUS_REPEATED_START:
+      // Write the address with R bit in the read phase, or if there is nothing to write
+      if ((i2c_queue_phase == 2)
+          || ((transaction->command_length == 0) && (transaction->write_length == 0) && (transaction->read_length > 0)))
+      {
+        i2c_queue_phase = 2;
+        TWDR = (transaction->address<<1) | I2C_READ_BIT;
+      }
+      else
+        TWDR = (transaction->address<<1) | I2C_WRITE_BIT;
+      TWCR = (1<<TWINT) | (1<<TWEN) | (1<<TWIE);
+      break;
+
+    case STATUS_ADDRESS_WRITE_ACK:
+    case STATUS_WRITE_ACK:
+      i2c_queue_write_next(transaction);
+      break;
+
+    case STATUS_READ_ACK:
+      transaction->read_data[i2c_queue_data_index(transaction, transaction->read_length)] = TWDR;
+      i2c_queue_index++;
+    // fall through
+    case STATUS_ADDRESS_READ_ACK:
+      remaining = transaction->read_length - i2c_queue_index;
+      if (remaining > 1)
+        TWCR = (1<<TWINT) | (1<<TWEN) | (1<<TWIE) | (1<<TWEA);  // ACK, more bytes to come
+      else
+        TWCR = (1<<TWINT) | (1<<TWEN) | (1<<TWIE);              // NACK the last byte
+      break;
+
+    case STATUS_READ_NACK:
+      transaction->read_data[i2c_queue_data_index(transaction, transaction->read_length)] = TWDR;
+      i2c_queue_finish(I2C_TRANSACTION_DONE);
+      break;
+
+    case STATUS_ADDRESS_WRITE_NACK:
+    case STATUS_WRITE_NACK:
+    case STATUS_ADDRESS_READ_NACK:
+      i2c_queue_finish(I2C_TRANSACTION_NACK);
+      break;
+
+    default:                                                    // Arbitration lost or bus error
+      i2c_queue_finish(I2C_TRANSACTION_ERROR);
+      break;
+  }
+}
+
+// Declared weak so the Wire library's handler wins if it is linked
+ISR(TWI_vect, __attribute__((weak)))
+{
+  i2c_queue_service();
+}
+
+// Wait for a transaction to finish, or for the queue to empty if transaction is NULL.
+// TWINT is also serviced here with interrupts disabled, so the queue keeps running when the
+// caller has interrupts off or another TWI_vect is linked. After I2C_QUEUE_TIMEOUT ms the
+// queue is aborted. Returns 0 on success, 1 on timeout
+static int8_t i2c_queue_wait(i2c_transaction *transaction)
+{
+  uint32_t timeout;
+  uint8_t sreg;
 
+  for (timeout = 0; timeout < (uint32_t)I2C_QUEUE_TIMEOUT * 1000; timeout++)
+  {
+    if ((transaction == NULL) ? (i2c_queue_head == NULL) : i2c_transaction_complete(transaction))
+      return(0);
+    _delay_us(1);
+    sreg = SREG;
+    cli();
+    if ((i2c_queue_head != NULL) && (TWCR & (1<<TWINT)))
+      i2c_queue_service();
+    SREG = sreg;
+  }
+  i2c_abort_queue();
+  return(1);
+}
+
+// Add a transaction to the queue and start the bus if it is idle.
+// Returns 0 if queued, 1 if the transaction is already queued or has nothing to do
+int8_t i2c_queue_transaction(i2c_transaction *transaction)
 {
-  int8_t ack=0;
-  ack |= i2c_start();                                  //! 1) I2C start
-  ack |= i2c_write((i2c_address<<1) | I2C_WRITE_BIT); //! 2) I2C address + !write
-  i2c_stop();                                   //! 3) I2C stop
-  return(ack);                                  //! 4) Return ack status
+  uint8_t sreg;
+
+  if ((transaction->status == I2C_TRANSACTION_QUEUED) || (transaction->status == I2C_TRANSACTION_ACTIVE))
+    return(1);
+  if (transaction->command_length > 2)
+    return(1);
+  if ((transaction->read_length > 0) && (transaction->read_data == NULL))
+    return(1);
+  if ((transaction->write_length > 0) && (transaction->write_data == NULL))
+    return(1);
+
+  transaction->next = NULL;
+  transaction->status = I2C_TRANSACTION_QUEUED;
+  if (i2c_queue_head == NULL)
+    i2c_wait_stop();                                        // Let the last stop finish before a new start
+  sreg = SREG;
+  cli();
+  if (i2c_queue_head == NULL)
+  {
+    i2c_queue_head = transaction;
+    i2c_queue_tail = transaction;
+    TWCR = i2c_queue_begin(transaction);
+  }
+  else
+  {
+    i2c_queue_tail->next = transaction;
+    i2c_queue_tail = transaction;
+  }
+  SREG = sreg;
+  return(0);
+}
+
+// Returns 1 if the queue is busy, 0 if idle
+uint8_t i2c_queue_busy()
+{
+  return(i2c_queue_head != NULL);
+}
+
+// Returns 1 if the transaction has finished, 0 if still queued or active
+uint8_t i2c_transaction_complete(i2c_transaction *transaction)
+{
+  uint8_t status = transaction->status;
+  return((status != I2C_TRANSACTION_QUEUED) && (status != I2C_TRANSACTION_ACTIVE));
+}
+
+// Wait for a transaction to finish, aborting the queue after I2C_QUEUE_TIMEOUT ms.
+// Returns 0 on success, 1 on failure
+int8_t i2c_wait_transaction(i2c_transaction *transaction)
+{
+  i2c_queue_wait(transaction);
+  return(transaction->status != I2C_TRANSACTION_DONE);
+}
+
+// Stop the bus and fail every queued transaction
+void i2c_abort_queue()
+{
+  i2c_transaction *transaction;
+  uint8_t sreg;
+
+  sreg = SREG;
+  cli();
+  transaction = i2c_queue_head;
+  i2c_queue_head = NULL;
+  i2c_queue_tail = NULL;
+  TWCR = (1<<TWINT) | (1<<TWEN) | (1<<TWSTO);               // Stop with the interrupt disabled
+  SREG = sreg;
+  while (transaction != NULL)
+  {
+    i2c_transaction *next = transaction->next;
+    transaction->next = NULL;
+    transaction->status = I2C_TRANSACTION_ERROR;
+    if (transaction->callback != NULL)
+      transaction->callback(transaction);
+    transaction = next;
+  }
+}
+
+// Fill in a transaction for the async wrappers
+static void i2c_transaction_setup(i2c_transaction *transaction, uint8_t address, uint8_t command_length,
+                                  uint8_t *write_data, uint8_t write_length, uint8_t *read_data, uint8_t read_length,
+                                  void (*callback)(i2c_transaction *transaction))
+{
+  transaction->address = address;
+  transaction->command_length = command_length;
+  transaction->write_data = write_data;
+  transaction->write_length = write_length;
+  transaction->read_data = read_data;
+  transaction->read_length = read_length;
+  transaction->flags = I2C_TRANSACTION_MSB_FIRST;
+  transaction->callback = callback;
+}
+
+// Queue a block read with the same byte order as i2c_read_block_data
+int8_t i2c_read_block_data_async(i2c_transaction *transaction, uint8_t address, uint8_t command, uint8_t length, uint8_t *values,
+                                 void (*callback)(i2c_transaction *transaction))
+{
+  if (length == 0)
+    return(1);
+  if (!i2c_transaction_complete(transaction))
+    return(1);
+  i2c_transaction_setup(transaction, address, 1, NULL, 0, values, length, callback);
+  transaction->command[0] = command;
+  return(i2c_queue_transaction(transaction));
+}
+
+// Queue a block write with the same byte order as i2c_write_block_data
+int8_t i2c_write_block_data_async(i2c_transaction *transaction, uint8_t address, uint8_t command, uint8_t length, uint8_t *values,
+                                  void (*callback)(i2c_transaction *transaction))
+{
+  if (!i2c_transaction_complete(transaction))
+    return(1);
+  i2c_transaction_setup(transaction, address, 1, values, length, NULL, 0, callback);
+  transaction->command[0] = command;
+  return(i2c_queue_transaction(transaction));
+}
+
+// Queue a two byte command followed by a block read, with the same byte order as i2c_two_byte_command_read_block
+int8_t i2c_two_byte_command_read_block_async(i2c_transaction *transaction, uint8_t address, uint16_t command, uint8_t length, uint8_t *values,
+                                             void (*callback)(i2c_transaction *transaction))
+{
+  if (length == 0)
+    return(1);
+  if (!i2c_transaction_complete(transaction))
+    return(1);
+  i2c_transaction_setup(transaction, address, 2, NULL, 0, values, length, callback);
+  transaction->command[0] = command >> 8;                   // MSB first
+  transaction->command[1] = command & 0xFF;
+  return(i2c_queue_transaction(transaction));
 }
@@ -144,6 +144,15 @@ int8_t i2c_read_block_data(uint8_t address,     //!< 7-bit I2C address
                            uint8_t *values   //!< Byte array to be read
                           );
 
+//! Read a block of data, starting at register specified by "command" and ending at (command + length - 1),
+//! in register order: values[0] holds register "command". Use this to copy a register map.
+//! @return 0 on success, 1 on failure
+int8_t i2c_read_register_block(uint8_t address,     //!< 7-bit I2C address
+                               uint8_t command,     //!< Command byte
+                               uint8_t length,      //!< Length of array
+                               uint8_t *values      //!< Byte array to be read
+                              );
+
 //! Read a block of data, no command byte, reads length number of bytes and stores it in values.
 //! @return 0 on success, 1 on failure
 int8_t i2c_read_block_data(uint8_t address,     //!< 7-bit I2C address
@@ -181,7 +190,8 @@ void quikeval_I2C_connect(void);
 //! i2c_enable or quikeval_I2C_init must be called before using any of the other I2C routines.
 void i2c_enable(void);
 
-//! Write start bit to the hardware I2C port
+//! Write start bit to the hardware I2C port. Queued transactions are given I2C_QUEUE_TIMEOUT ms
+//! to finish first; if they have not, the queue is aborted and the start fails.
 //! @return 0 if successful, 1 if not successful
 int8_t i2c_start();
 
@@ -208,6 +218,101 @@ uint8_t i2c_read(int8_t ack //!< If ACK is 0 then an acknowledge is generated, e
 int8_t i2c_poll(uint8_t i2c_address //!< i2c_address is the address of the slave being polled.
                );
 
+//! @name INTERRUPT DRIVEN TRANSACTION QUEUE
+//! Transactions are queued with i2c_queue_transaction and executed by the TWI interrupt while
+//! the CPU does other work. Each transaction sends its command bytes and write data, then, if
+//! read_length is nonzero, issues a repeated start and reads. Completion is reported through
+//! the status field and the optional callback, which runs in interrupt context and must not
+//! call the blocking I2C routines.
+//! i2c_read_byte through i2c_two_byte_command_read_block, and i2c_poll, are built on the queue:
+//! each queues one transaction and waits for it, so they are ordered with queued work. The byte
+//! level routines (i2c_start, i2c_write, i2c_read, i2c_stop) still drive the TWI directly, and
+//! i2c_start waits up to I2C_QUEUE_TIMEOUT ms for the queue to drain first, then aborts it and fails.
+//! While waiting, the TWI state machine is also run from the wait loop, so the blocking routines
+//! work with interrupts disabled. The TWI interrupt handler is weak; if the Wire library is linked
+//! its handler is used instead, and queued transactions only advance while something waits on them.
+//! @{
+#define I2C_TRANSACTION_DONE      0   //!< Transaction completed successfully
+#define I2C_TRANSACTION_QUEUED    1   //!< Transaction waiting in the queue
+#define I2C_TRANSACTION_ACTIVE    2   //!< Transaction being executed
+#define I2C_TRANSACTION_NACK      3   //!< Address or data byte was not acknowledged
+#define I2C_TRANSACTION_ERROR     4   //!< Bus error, arbitration lost or timeout
+
+#define I2C_TRANSACTION_MSB_FIRST 0x01  //!< Data arrays are sent and filled from the last index down, like i2c_read_block_data
+#define I2C_QUEUE_TIMEOUT         100   //!< i2c_wait_transaction and i2c_start queue timeout in ms
+//! @}
+
+//! One queued I2C transaction. The structure and its data buffers must stay valid until the
+//! transaction completes. Zero initialize a new structure so its status reads as complete.
+typedef struct i2c_transaction
+{
+  uint8_t address;                  //!< 7-bit I2C address
+  uint8_t command[2];               //!< Command bytes, sent before write_data
+  uint8_t command_length;           //!< Number of command bytes (0 to 2)
+  uint8_t *write_data;              //!< Data written after the command bytes
+  uint8_t write_length;             //!< Number of bytes in write_data
+  uint8_t *read_data;               //!< Buffer for data read after a repeated start
+  uint8_t read_length;              //!< Number of bytes to read, 0 for a write only transaction
+  uint8_t flags;                    //!< I2C_TRANSACTION_MSB_FIRST or 0
+  volatile uint8_t status;          //!< I2C_TRANSACTION_DONE, _QUEUED, _ACTIVE, _NACK or _ERROR
+  void (*callback)(struct i2c_transaction *transaction);  //!< Called from the ISR on completion, may be NULL
+  struct i2c_transaction *next;     //!< Queue link, managed by the driver
+} i2c_transaction;
+
+//! Add a transaction to the queue and start the bus if it is idle.
+//! @return 0 if queued, 1 if the transaction is already queued or has nothing to do
+int8_t i2c_queue_transaction(i2c_transaction *transaction   //!< Transaction to execute
+                            );
+
+//! Check whether queued transactions are still being executed
+//! @return 1 if the queue is busy, 0 if idle
+uint8_t i2c_queue_busy();
+
+//! Check whether a transaction has finished, successfully or not
+//! @return 1 if finished, 0 if still queued or active
+uint8_t i2c_transaction_complete(i2c_transaction *transaction   //!< Transaction to check
+                                );
+
+//! Wait for a transaction to finish. If it does not finish within I2C_QUEUE_TIMEOUT ms the
+//! queue is aborted.
+//! @return 0 on success, 1 on failure
+int8_t i2c_wait_transaction(i2c_transaction *transaction    //!< Transaction to wait for
+                           );
+
+//! Stop the bus and fail every queued transaction with I2C_TRANSACTION_ERROR
+void i2c_abort_queue();
+
+//! Queue a block read with the same byte order as i2c_read_block_data
+//! @return 0 if queued, 1 if not
+int8_t i2c_read_block_data_async(i2c_transaction *transaction,  //!< Transaction storage
+                                 uint8_t address,               //!< 7-bit I2C address
+                                 uint8_t command,               //!< Command byte
+                                 uint8_t length,                //!< Length of array
+                                 uint8_t *values,               //!< Byte array to be read
+                                 void (*callback)(i2c_transaction *transaction)  //!< Completion callback, may be NULL
+                                );
+
+//! Queue a block write with the same byte order as i2c_write_block_data
+//! @return 0 if queued, 1 if not
+int8_t i2c_write_block_data_async(i2c_transaction *transaction, //!< Transaction storage
+                                  uint8_t address,              //!< 7-bit I2C address
+                                  uint8_t command,              //!< Command byte
+                                  uint8_t length,               //!< Length of array
+                                  uint8_t *values,              //!< Byte array to be written
+                                  void (*callback)(i2c_transaction *transaction)  //!< Completion callback, may be NULL
+                                 );
+
+//! Queue a two byte command followed by a block read, with the same byte order as
+//! i2c_two_byte_command_read_block
+//! @return 0 if queued, 1 if not
+int8_t i2c_two_byte_command_read_block_async(i2c_transaction *transaction,  //!< Transaction storage
+                                             uint8_t address,               //!< 7-bit I2C address
+                                             uint16_t command,              //!< Command word
+                                             uint8_t length,                //!< Length of array
+                                             uint8_t *values,               //!< Byte array to be read
+                                             void (*callback)(i2c_transaction *transaction)  //!< Completion callback, may be NULL
+                                            );
+
 
 // //! Read a byte, store in "value".
 // //! @return -1 if failed or value if it succeeds
@@ -0,0 +1,384 @@
+/*
+Host test for the LT_I2C interrupt driven transaction queue.
+
+NOT AN ARDUINO SKETCH.  This program builds LT_I2C with g++ against
+Utilities/host_stubs with HOST_TWI_MODEL defined, so every write to TWCR
+reaches a model of the ATmega328P TWI.  The model executes each command at
+once, sets TWSR and TWINT like the hardware, and talks to a simulated
+register-file slave with an auto-incrementing pointer.  Every bus event is
+logged:
+
+  S  start            Sr  repeated start      P  stop
+  aW/aR  address byte, + or - for ACK or NACK from the slave
+  wXX    data byte written, + or -
+  rXX    data byte read, + when the master ACKed it, - when it NACKed
+
+Each test checks the exact event sequence, the data and the return value:
+
+  - every blocking routine (byte, word, block, two byte command, poll),
+    with interrupts off, so the wait loop runs the state machine
+  - the same routines with interrupts on, where the state machine runs only
+    from the simulated TWI interrupt
+  - an address NACK, a data NACK and a NACK on the read address
+  - three queued transactions with callbacks, run only by the interrupt,
+    chained with a stop followed by a start
+  - a hung bus, which must time out, abort the queue and send a stop
+  - the byte level i2c_start()/i2c_write()/i2c_read()/i2c_stop() routines
+
+  make
+  ./twi_test
+
+Copyright 2018(c) Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in
+   the documentation and/or other materials provided with the
+   distribution.
+ - Neither the name of Analog Devices, Inc. nor the names of its
+   contributors may be used to endorse or promote products derived
+   from this software without specific prior written permission.
+ - The use of this software may or may not infringe the patent rights
+   of one or more patent holders.  This license does not release you
+   from the requirement that you obtain separate licenses from these
+   patent holders to use this software.
+ - Use of the software either in source or binary form, must be run
+   on or directly connected to an Analog Devices Inc. component.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <Arduino.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include "LT_I2C.h"
+
+extern "C" void TWI_vect(void);
+
+#define SLAVE_ADDRESS   0x50
+#define ABSENT_ADDRESS  0x51
+
+// Simulated slave
+static uint8_t slave_reg[256];
+static uint8_t slave_pointer;
+static int slave_write_limit = 1000;  // Data bytes the slave ACKs before it NACKs
+static int slave_written;
+static bool slave_pointer_set;
+static bool slave_nack_read;          // NACK the read address
+
+// Simulated TWI
+enum { BUS_IDLE, BUS_ADDRESS, BUS_WRITE, BUS_READ, BUS_NACKED };
+static int bus_state = BUS_IDLE;
+static bool bus_hung;
+static std::string bus_log;
+static int isr_calls;
+static int failures;
+
+#define CHECK(c) do { if (!(c)) { printf("FAIL line %d: %s\n", __LINE__, #c); failures++; } } while (0)
+#define CHECK_LOG(expected) do { if (bus_log != (expected)) { printf("FAIL line %d: bus log\n  got:      %s\n  expected: %s\n", \
+                                   __LINE__, bus_log.c_str(), (expected)); failures++; } bus_log.clear(); } while (0)
+
+static void bus_event(const char *format, int value = 0, char ack = 0)
+{
+  char text[16];
+  snprintf(text, sizeof(text), format, value, ack);
+  if (!bus_log.empty())
+    bus_log += " ";
+  bus_log += text;
+}
+
+static void twi_flag(uint8_t status)
+{
+  TWSR = status;
+  host_twcr |= (1<<TWINT);
+}
+
+// Executes a TWCR write.  Writing 1 to TWINT clears the flag and starts the command.
+void host_twi_control(uint8_t value)
+{
+  host_twcr = value & ~(1<<TWINT);
+  if (!(value & (1<<TWINT)) || bus_hung)
+    return;
+
+  if (value & (1<<TWSTO))
+  {
+    bus_event("P");
+    bus_state = BUS_IDLE;
+    host_twcr &= ~(1<<TWSTO);
+    if (!(value & (1<<TWSTA)))
+      return;
+  }
+  if (value & (1<<TWSTA))
+  {
+    bool repeated = (bus_state != BUS_IDLE);
+    bus_event(repeated ? "Sr" : "S");
+    bus_state = BUS_ADDRESS;
+    twi_flag(repeated ? 0x10 : 0x08);
+    return;
+  }
+
+  switch (bus_state)
+  {
+    case BUS_ADDRESS:
+    {
+      bool read = TWDR & 1;
+      bool ack = ((TWDR >> 1) == SLAVE_ADDRESS) && !(read && slave_nack_read);
+      bus_event(read ? "aR%c" : "aW%c", ack ? '+' : '-');
+      if (!ack)
+      {
+        bus_state = BUS_NACKED;
+        twi_flag(read ? 0x48 : 0x20);
+        break;
+      }
+      bus_state = read ? BUS_READ : BUS_WRITE;
+      slave_pointer_set = false;
+      twi_flag(read ? 0x40 : 0x18);
+      break;
+    }
+    case BUS_WRITE:
+    {
+      bool ack = slave_written < slave_write_limit;
+      bus_event("w%02X%c", TWDR, ack ? '+' : '-');
+      if (ack)
+      {
+        slave_written++;
+        if (!slave_pointer_set)
+        {
+          slave_pointer = TWDR;
+          slave_pointer_set = true;
+        }
+        else
+          slave_reg[slave_pointer++] = TWDR;
+      }
+      twi_flag(ack ? 0x28 : 0x30);
+      break;
+    }
+    case BUS_READ:
+    {
+      bool master_ack = value & (1<<TWEA);
+      TWDR = slave_reg[slave_pointer++];
+      bus_event("r%02X%c", TWDR, master_ack ? '+' : '-');
+      twi_flag(master_ack ? 0x50 : 0x58);
+      break;
+    }
+    default:                // Flag cleared with nothing to do
+      break;
+  }
+}
+
+// Runs the TWI interrupt for as long as it is enabled and pending
+static void run_interrupts()
+{
+  while ((SREG & 0x80) && (host_twcr & (1<<TWINT)) && (host_twcr & (1<<TWIE)))
+  {
+    isr_calls++;
+    TWI_vect();
+  }
+}
+
+// The blocking routines wait in _delay_us(), which is where the interrupt would fire
+void _delay_us(double us)
+{
+  host_time_us += (unsigned long)us;
+  run_interrupts();
+}
+
+static void reset(bool interrupts)
+{
+  for (int i = 0; i < 256; i++)
+    slave_reg[i] = i ^ 0xA5;
+  slave_write_limit = 1000;
+  slave_written = 0;
+  bus_hung = false;
+  bus_log.clear();
+  isr_calls = 0;
+  if (interrupts)
+    sei();
+  else
+    cli();
+}
+
+static void test_blocking(bool interrupts)
+{
+  uint8_t value;
+  uint16_t word;
+  uint8_t block[4];
+  uint8_t data[3] = {0x33, 0x22, 0x11};     // Sent last index first
+
+  reset(interrupts);
+  CHECK(i2c_read_byte_data(SLAVE_ADDRESS, 0x10, &value) == 0);
+  CHECK(value == (0x10 ^ 0xA5));
+  CHECK_LOG("S aW+ w10+ Sr aR+ rB5- P");
+
+  CHECK(i2c_write_byte_data(SLAVE_ADDRESS, 0x20, 0x5A) == 0);
+  CHECK(slave_reg[0x20] == 0x5A);
+  CHECK_LOG("S aW+ w20+ w5A+ P");
+
+  CHECK(i2c_read_word_data(SLAVE_ADDRESS, 0x30, &word) == 0);
+  CHECK(word == (((0x30 ^ 0xA5) << 8) | (0x31 ^ 0xA5)));
+  CHECK_LOG("S aW+ w30+ Sr aR+ r95+ r94- P");
+
+  CHECK(i2c_write_word_data(SLAVE_ADDRESS, 0x40, 0xBEEF) == 0);
+  CHECK(slave_reg[0x40] == 0xBE && slave_reg[0x41] == 0xEF);
+  CHECK_LOG("S aW+ w40+ wBE+ wEF+ P");
+
+  CHECK(i2c_write_block_data(SLAVE_ADDRESS, 0x50, 3, data) == 0);
+  CHECK(slave_reg[0x50] == 0x11 && slave_reg[0x51] == 0x22 && slave_reg[0x52] == 0x33);
+  CHECK_LOG("S aW+ w50+ w11+ w22+ w33+ P");
+
+  CHECK(i2c_read_block_data(SLAVE_ADDRESS, 0x50, 4, block) == 0);
+  CHECK(block[3] == 0x11 && block[2] == 0x22 && block[1] == 0x33 && block[0] == (0x53 ^ 0xA5));
+  CHECK_LOG("S aW+ w50+ Sr aR+ r11+ r22+ r33+ rF6- P");
+
+  CHECK(i2c_read_register_block(SLAVE_ADDRESS, 0x50, 4, block) == 0);
+  CHECK(block[0] == 0x11 && block[1] == 0x22 && block[2] == 0x33 && block[3] == (0x53 ^ 0xA5));
+  CHECK_LOG("S aW+ w50+ Sr aR+ r11+ r22+ r33+ rF6- P");
+
+  CHECK(i2c_two_byte_command_read_block(SLAVE_ADDRESS, 0x5051, 2, block) == 0);
+  CHECK(block[1] == 0x22 && block[0] == 0x33);
+  CHECK_LOG("S aW+ w50+ w51+ Sr aR+ r22+ r33- P");
+
+  CHECK(i2c_write_byte(SLAVE_ADDRESS, 0x60) == 0);
+  CHECK_LOG("S aW+ w60+ P");
+  CHECK(i2c_read_byte(SLAVE_ADDRESS, &value) == 0);
+  CHECK(value == (0x60 ^ 0xA5));
+  CHECK_LOG("S aR+ rC5- P");
+  CHECK(i2c_read_block_data(SLAVE_ADDRESS, 2, block) == 0);
+  CHECK(block[1] == (0x61 ^ 0xA5) && block[0] == (0x62 ^ 0xA5));
+  CHECK_LOG("S aR+ rC4+ rC7- P");
+
+  CHECK(i2c_poll(SLAVE_ADDRESS) == 0);
+  CHECK_LOG("S aW+ P");
+  CHECK(i2c_poll(ABSENT_ADDRESS) == 1);
+  CHECK_LOG("S aW- P");
+
+  // NACKs end the transaction with a stop and fail it
+  CHECK(i2c_read_byte_data(ABSENT_ADDRESS, 0x10, &value) == 1);
+  CHECK_LOG("S aW- P");
+  slave_write_limit = slave_written + 2;
+  CHECK(i2c_write_block_data(SLAVE_ADDRESS, 0x70, 3, data) == 1);
+  CHECK_LOG("S aW+ w70+ w11+ w22- P");
+
+  if (interrupts)
+    CHECK(isr_calls > 0);
+  else
+    CHECK(isr_calls == 0);
+  CHECK(!i2c_queue_busy());
+}
+
+// The slave ACKs its write address and command but not the read address after the repeated start
+static void test_read_address_nack()
+{
+  uint8_t value;
+
+  reset(false);
+  slave_nack_read = true;
+  CHECK(i2c_read_byte_data(SLAVE_ADDRESS, 0x10, &value) == 1);
+  CHECK_LOG("S aW+ w10+ Sr aR- P");
+  slave_nack_read = false;
+}
+
+static int callback_order[3];
+static int callbacks;
+
+static void record_callback(i2c_transaction *transaction)
+{
+  callback_order[callbacks++] = transaction->command[0];
+}
+
+// Queued transactions run from the interrupt while the CPU does other work
+static void test_queue()
+{
+  i2c_transaction transaction[3];
+  uint8_t block[3];
+  uint8_t data[2] = {0x02, 0x01};
+
+  reset(true);
+  callbacks = 0;
+  memset(transaction, 0, sizeof(transaction));
+  CHECK(i2c_read_block_data_async(&transaction[0], SLAVE_ADDRESS, 0x80, 3, block, record_callback) == 0);
+  CHECK(i2c_write_block_data_async(&transaction[1], SLAVE_ADDRESS, 0x90, 2, data, record_callback) == 0);
+  CHECK(i2c_two_byte_command_read_block_async(&transaction[2], ABSENT_ADDRESS, 0xA0A1, 3, block, record_callback) == 0);
+  CHECK(i2c_read_block_data_async(&transaction[0], SLAVE_ADDRESS, 0x80, 3, block, record_callback) == 1);  // Already queued
+  CHECK(i2c_queue_busy());
+  CHECK(transaction[0].status == I2C_TRANSACTION_ACTIVE);
+  CHECK(transaction[1].status == I2C_TRANSACTION_QUEUED);
+
+  run_interrupts();
+  CHECK(!i2c_queue_busy());
+  CHECK(transaction[0].status == I2C_TRANSACTION_DONE);
+  CHECK(transaction[1].status == I2C_TRANSACTION_DONE);
+  CHECK(transaction[2].status == I2C_TRANSACTION_NACK);
+  CHECK(callbacks == 3 && callback_order[0] == 0x80 && callback_order[1] == 0x90 && callback_order[2] == 0xA0);
+  CHECK(block[2] == (0x80 ^ 0xA5) && block[1] == (0x81 ^ 0xA5) && block[0] == (0x82 ^ 0xA5));
+  CHECK(slave_reg[0x90] == 0x01 && slave_reg[0x91] == 0x02);
+  CHECK_LOG("S aW+ w80+ Sr aR+ r25+ r24+ r27- P S aW+ w90+ w01+ w02+ P S aW- P");
+}
+
+// A bus that never raises TWINT must not hang the caller
+static void test_hung_bus()
+{
+  uint8_t value;
+  unsigned long start;
+
+  reset(false);
+  bus_hung = true;
+  start = host_time_us;
+  CHECK(i2c_read_byte_data(SLAVE_ADDRESS, 0x10, &value) == 1);
+  CHECK(host_time_us - start >= I2C_QUEUE_TIMEOUT * 1000UL);
+  CHECK(!i2c_queue_busy());
+  bus_hung = false;
+  CHECK(i2c_read_byte_data(SLAVE_ADDRESS, 0x10, &value) == 0);
+  CHECK(value == (0x10 ^ 0xA5));
+}
+
+// The byte level routines still drive the TWI directly, after the queue has drained
+static void test_byte_level()
+{
+  i2c_transaction transaction;
+  uint8_t block[2];
+
+  reset(false);
+  memset(&transaction, 0, sizeof(transaction));
+  CHECK(i2c_read_block_data_async(&transaction, SLAVE_ADDRESS, 0x00, 2, block, NULL) == 0);
+  CHECK(i2c_start() == 0);                  // Runs the queued read first
+  CHECK(transaction.status == I2C_TRANSACTION_DONE);
+  CHECK(i2c_write((SLAVE_ADDRESS << 1) | I2C_WRITE_BIT) == 0);
+  CHECK(i2c_write(0x08) == 0);
+  CHECK(i2c_repeated_start() == 0);
+  CHECK(i2c_write((SLAVE_ADDRESS << 1) | I2C_READ_BIT) == 0);
+  CHECK(i2c_read(WITH_ACK) == (0x08 ^ 0xA5));
+  CHECK(i2c_read(WITH_NACK) == (0x09 ^ 0xA5));
+  i2c_stop();
+  CHECK_LOG("S aW+ w00+ Sr aR+ rA5+ rA4- P S aW+ w08+ Sr aR+ rAD+ rAC- P");
+}
+
+int main()
+{
+  i2c_enable();
+  test_blocking(false);
+  test_blocking(true);
+  test_read_address_nack();
+  test_queue();
+  test_hung_bus();
+  test_byte_level();
+  printf(failures ? "FAILED (%d checks)\n" : "PASSED\n", failures);
+  return failures != 0;
+}
@@ -53,6 +53,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "LT_PMBusDevice.h"
 #include "LT_PMBusRail.h"
 
+//! Age in ms after which detect() scans the bus again instead of using the cached scan
+#define LT_PMBUS_DETECT_SCAN_AGE 5000
+
 class LT_PMBusDetect
 {
   protected:
@@ -65,7 +68,7 @@ class LT_PMBusDetect
   public:
     LT_PMBusDetect(LT_PMBus *pmbus);
 
-    //! Detect devices on bus
+    //! Detect devices on bus. The address scan is cached for LT_PMBUS_DETECT_SCAN_AGE ms.
     void detect();
 
     LT_PMBusDevice **getDevices();
@@ -72,6 +72,7 @@ LT_I2CBus::LT_I2CBus(uint32_t speed)
 
 void LT_I2CBus::changeSpeed(uint32_t speed)
 {
+  speed_ = speed;
   LT_Wire.begin(speed);
 }
 
@@ -91,6 +92,13 @@ int8_t LT_I2CBus::readByte(uint8_t address, uint8_t *value)
   return ret;
 }
 
+// Send only the address with the write bit
+int8_t LT_I2CBus::quickCommand(uint8_t address)
+{
+  LT_Wire.beginTransmission(address);
+  return LT_Wire.endTransmission(!inGroupProtocol_);
+}
+
 // Write "value" byte to device at "address"
 int8_t LT_I2CBus::writeByte(uint8_t address, uint8_t value)
 {
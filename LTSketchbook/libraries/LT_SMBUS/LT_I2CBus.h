@@ -70,6 +70,11 @@ class LT_I2CBus
                     uint8_t *value    //!< Byte to be read
                    );
 
+    //! Send only the address with the write bit (SMBus quick command), used to probe for a device
+    //! @return 0 if the address was acknowledged, nonzero if not
+    int8_t quickCommand(uint8_t address  //!< 7-bit I2C address
+                       );
+
     //! Write "value" byte to device at "address"
     //! @return 0 on success, 1 on failure
     int8_t writeByte(uint8_t address, //!< 7-bit I2C address
@@ -58,6 +58,16 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define SUCCESS                 1
 #define FAILURE                 0
 
+//! @name Address scan
+//!@{
+#define LT_SMBUS_SCAN_FIRST       0x10    //!< First address of a full scan
+#define LT_SMBUS_SCAN_LAST        0x7E    //!< Last address of a full scan
+#ifndef LT_SMBUS_SCAN_SPEED
+#define LT_SMBUS_SCAN_SPEED       400000  //!< Default upper limit of the bus speed while scanning
+#endif
+#define LT_SMBUS_SCAN_LATENCY_SIZE 16     //!< Number of found addresses with a recorded latency
+//!@}
+
 class LT_SMBus
 {
   protected:
@@ -259,6 +269,36 @@ class LT_SMBus
     virtual uint8_t *probeUnique(uint8_t command    //!< Command byte
                                 ) = 0;
 
+    //! Quick command scan of an address range
+    //! @return array of addresses (caller must not delete return memory)
+    virtual uint8_t *scan(uint8_t first,    //!< First address to probe
+                          uint8_t last,     //!< Last address to probe
+                          bool unique,      //!< Skip the global and ARA addresses
+                          uint32_t max_speed //!< Scan at no more than this speed in Hz
+                         ) = 0;
+
+    //! Quick command scan of an address range, reusing a result younger than max_age ms
+    //! @return array of addresses (caller must not delete return memory)
+    virtual uint8_t *scanCached(uint8_t first,    //!< First address to probe
+                                uint8_t last,     //!< Last address to probe
+                                bool unique,      //!< Skip the global and ARA addresses
+                                uint32_t max_speed, //!< Scan at no more than this speed in Hz
+                                uint32_t max_age  //!< Maximum age of the cached result in ms
+                               ) = 0;
+
+    //! Forget the cached scan
+    //! @return void
+    virtual void clearScanCache(void) = 0;
+
+    //! ACK latency recorded by the last scan
+    //! @return latency in us, 0 if not found
+    virtual uint16_t scanLatency(uint8_t address    //!< Slave address
+                                ) = 0;
+
+    //! Duration of the last scan
+    //! @return duration in us
+    virtual uint32_t scanDuration(void) = 0;
+
 };
 
 #endif /* LT_SMBus_H_ */
@@ -60,6 +60,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 bool LT_SMBusBase::open_ = false;
 uint8_t LT_SMBusBase::found_address_[FOUND_SIZE + 1];
+uint16_t LT_SMBusBase::scan_latency_[LT_SMBUS_SCAN_LATENCY_SIZE];
+uint32_t LT_SMBusBase::scan_time_;
+uint32_t LT_SMBusBase::scan_duration_;
+uint8_t LT_SMBusBase::scan_first_;
+uint8_t LT_SMBusBase::scan_last_;
+bool LT_SMBusBase::scan_unique_;
+bool LT_SMBusBase::scan_valid_ = false;
 
 LT_SMBusBase::LT_SMBusBase()
 {
@@ -121,6 +128,8 @@ uint8_t *LT_SMBusBase::probe(uint8_t command)
   uint8_t   address;
   uint8_t   found = 0;
 
+  scan_valid_ = false;
+
   for (address = 0x10; address < 0x7F; address++)
   {
     if (address == 0x0C)
@@ -147,6 +156,8 @@ uint8_t *LT_SMBusBase::probeUnique(uint8_t command)
   uint8_t   address;
   uint8_t   found = 0;
 
+  scan_valid_ = false;
+
   for (address = 0x10; address < 0x7F; address++)
   {
     if (address == 0x0C)
@@ -174,6 +185,84 @@ uint8_t *LT_SMBusBase::probeUnique(uint8_t command)
   return found_address_;
 }
 
+uint8_t *LT_SMBusBase::scan(uint8_t first, uint8_t last, bool unique, uint32_t max_speed)
+{
+  uint8_t   address;
+  uint8_t   found = 0;
+  uint32_t  speed;
+  uint32_t  start;
+  uint32_t  sweep_start;
+  uint16_t  latency;
+
+  speed = i2cbus_->getSpeed();
+  if (max_speed < speed)
+    i2cbus_->changeSpeed(max_speed);
+
+  sweep_start = micros();
+  for (address = first; address <= last && address < 0x80; address++)
+  {
+    if (address == 0x0C)
+      continue;
+    if (unique && (address == 0x5A || address == 0x5B || address == 0x7C))
+      continue;
+
+    start = micros();
+    if (0 == i2cbus_->quickCommand(address))
+    {
+      latency = micros() - start;
+      if (found < LT_SMBUS_SCAN_LATENCY_SIZE)
+        scan_latency_[found] = latency;
+      if (found < FOUND_SIZE)
+        found_address_[found++] = address;
+    }
+  }
+  scan_duration_ = micros() - sweep_start;
+
+  if (max_speed < speed)
+    i2cbus_->changeSpeed(speed);
+
+  found_address_[found] = 0;
+  scan_first_ = first;
+  scan_last_ = last;
+  scan_unique_ = unique;
+  scan_time_ = millis();
+  scan_valid_ = true;
+
+  return found_address_;
+}
+
+uint8_t *LT_SMBusBase::scanCached(uint8_t first, uint8_t last, bool unique, uint32_t max_speed, uint32_t max_age)
+{
+  if (scan_valid_ && scan_first_ == first && scan_last_ == last && scan_unique_ == unique
+      && (millis() - scan_time_) <= max_age)
+    return found_address_;
+  return scan(first, last, unique, max_speed);
+}
+
+void LT_SMBusBase::clearScanCache(void)
+{
+  scan_valid_ = false;
+}
+
+uint16_t LT_SMBusBase::scanLatency(uint8_t address)
+{
+  uint8_t i;
+
+  if (!scan_valid_)
+    return 0;
+  for (i = 0; i < LT_SMBUS_SCAN_LATENCY_SIZE && found_address_[i] != 0; i++)
+  {
+    if (found_address_[i] == address)
+      return scan_latency_[i];
+  }
+  return 0;
+}
+
+uint32_t LT_SMBusBase::scanDuration(void)
+{
+  return scan_duration_;
+}
+
 void LT_SMBusBase::writeByte(uint8_t address, uint8_t command, uint8_t data)
 {
   if (pec_enabled_)
@@ -62,6 +62,13 @@ class LT_SMBusBase : public LT_SMBus
   protected:
     static bool         open_;          //!< Used to ensure initialisation of i2c once
     static uint8_t found_address_[];
+    static uint16_t scan_latency_[];    //!< ACK latency in us of the first found addresses
+    static uint32_t scan_time_;         //!< millis() at the end of the last scan
+    static uint32_t scan_duration_;     //!< Duration of the last scan in us
+    static uint8_t scan_first_;         //!< Range of the cached scan
+    static uint8_t scan_last_;
+    static bool scan_unique_;           //!< Cached scan skipped the global addresses
+    static bool scan_valid_;            //!< found_address_ holds a scan result
     LT_I2CBus *i2cbus_;
 
     LT_SMBusBase();
@@ -215,6 +222,40 @@ class LT_SMBusBase : public LT_SMBus
     uint8_t *probeUnique(uint8_t command      //!< Command byte
                         );
 
+    //! Probe first to last with quick commands at the lower of the current bus speed and
+    //! max_speed, recording the ACK latency and the sweep duration. The bus is never sped up,
+    //! so a bus slowed down for long wires or weak pull-ups is scanned at its own speed. The
+    //! result shares storage with probe() and probeUnique().
+    //! @return array of addresses, terminated by 0
+    uint8_t *scan(uint8_t first,      //!< First address to probe
+                  uint8_t last,       //!< Last address to probe
+                  bool unique,        //!< Skip the global and ARA addresses, as probeUnique does
+                  uint32_t max_speed  //!< Scan at no more than this speed in Hz, e.g. LT_SMBUS_SCAN_SPEED
+                 );
+
+    //! Return the previous scan if it covered the same range and is younger than max_age,
+    //! otherwise scan again.
+    //! @return array of addresses, terminated by 0
+    uint8_t *scanCached(uint8_t first,      //!< First address to probe
+                        uint8_t last,       //!< Last address to probe
+                        bool unique,        //!< Skip the global and ARA addresses
+                        uint32_t max_speed, //!< Scan at no more than this speed in Hz
+                        uint32_t max_age    //!< Maximum age of the cached result in ms
+                       );
+
+    //! Forget the cached scan so the next scanCached() probes the bus
+    //! @return void
+    void clearScanCache(void);
+
+    //! ACK latency recorded by the last scan
+    //! @return latency in us, 0 if the address was not found or not recorded
+    uint16_t scanLatency(uint8_t address    //!< Slave address
+                        );
+
+    //! Duration of the last scan
+    //! @return duration in us
+    uint32_t scanDuration(void);
+
 };
 
 #endif /* LT_SMBusBase_H_ */
@@ -0,0 +1,223 @@
+/*
+Host benchmark for the LT_SMBus quick command address scan.
+
+NOT AN ARDUINO SKETCH.  This program builds LT_SMBusBase, LT_SMBusNoPec and
+LT_I2CBus with g++ against Utilities/host_stubs.  LT_TwoWire is replaced by a
+simulated bus: every quick command advances the host clock by the 11 bit
+times (start, address, ACK, stop) it takes at the current bus speed, and
+each device acknowledges only up to the fastest speed it can follow.  One
+device models a part at the end of a long cable that works at 100 kHz but
+misses its address at 400 kHz.
+
+For each case the benchmark prints the bus speed the scan ran at, the number
+of quick commands, the simulated sweep time and scanDuration(), and checks:
+
+  - scan() runs at the lower of the current speed and max_speed, so a slow
+    bus is never sped up and the slow device is found
+  - a bus faster than max_speed is slowed down for the scan and restored
+  - the unique scan skips the global and ARA addresses
+  - scanCached() returns a young result without touching the bus, and scans
+    again once the result is older than max_age
+
+  make
+  ./scan_bench
+
+Copyright 2018(c) Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in
+   the documentation and/or other materials provided with the
+   distribution.
+ - Neither the name of Analog Devices, Inc. nor the names of its
+   contributors may be used to endorse or promote products derived
+   from this software without specific prior written permission.
+ - The use of this software may or may not infringe the patent rights
+   of one or more patent holders.  This license does not release you
+   from the requirement that you obtain separate licenses from these
+   patent holders to use this software.
+ - Use of the software either in source or binary form, must be run
+   on or directly connected to an Analog Devices Inc. component.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <Arduino.h>
+#include "LT_SMBusNoPec.h"
+
+extern unsigned long host_time_us;
+
+static int failures;
+#define CHECK(c) do { if (!(c)) { failures++; printf("  FAIL line %d: %s\n", __LINE__, #c); } } while (0)
+
+// Simulated devices and the fastest bus each one follows
+struct sim_device
+{
+  uint8_t address;
+  uint32_t max_speed;
+};
+
+static const sim_device devices[] =
+{
+  { 0x20, 1000000 },
+  { 0x40,  400000 },
+  { 0x4F,  400000 },
+  { 0x5B,  400000 },    // answers the global address too
+  { 0x64,  100000 },    // long cable, 100 kHz only
+};
+
+static uint32_t bus_speed;
+static uint32_t bus_max_speed;      // fastest speed a quick command ran at
+static uint16_t bus_probes;
+static uint8_t bus_address;
+
+LT_TwoWire LT_Wire;
+
+LT_TwoWire::LT_TwoWire() {}
+
+void LT_TwoWire::begin(uint32_t speed)
+{
+  bus_speed = speed;
+}
+
+uint8_t LT_TwoWire::requestFrom(uint8_t, uint8_t *, uint16_t)
+{
+  return 0;
+}
+uint8_t LT_TwoWire::requestFrom(uint8_t, uint8_t *, uint16_t, uint8_t)
+{
+  return 0;
+}
+uint8_t LT_TwoWire::requestFrom(int, uint8_t *, int)
+{
+  return 0;
+}
+uint8_t LT_TwoWire::requestFrom(int, uint8_t *, int, int)
+{
+  return 0;
+}
+
+void TwoWire::beginTransmission(uint8_t address)
+{
+  bus_address = address;
+}
+
+// Address only: 2 if nobody acknowledged, as Wire.endTransmission() reports it
+uint8_t TwoWire::endTransmission(uint8_t)
+{
+  uint8_t i;
+
+  bus_probes++;
+  if (bus_speed > bus_max_speed)
+    bus_max_speed = bus_speed;
+  host_time_us += (11UL * 1000000UL + bus_speed - 1) / bus_speed;
+  for (i = 0; i < sizeof(devices) / sizeof(devices[0]); i++)
+  {
+    if (devices[i].address == bus_address && bus_speed <= devices[i].max_speed)
+      return 0;
+  }
+  return 2;
+}
+
+static bool contains(const uint8_t *found, uint8_t address)
+{
+  for (; *found; found++)
+    if (*found == address)
+      return true;
+  return false;
+}
+
+static const uint8_t *run_scan(LT_SMBus *smbus, const char *name, uint32_t max_speed, bool unique)
+{
+  unsigned long start;
+  uint8_t *found;
+  uint8_t n;
+
+  bus_probes = 0;
+  bus_max_speed = 0;
+  start = host_time_us;
+  found = smbus->scan(LT_SMBUS_SCAN_FIRST, LT_SMBUS_SCAN_LAST, unique, max_speed);
+  for (n = 0; found[n]; n++);
+  printf("%-28s %8lu %8lu %6u %9lu %9lu %6u\n", name, (unsigned long)max_speed,
+         (unsigned long)bus_max_speed, bus_probes, host_time_us - start,
+         (unsigned long)smbus->scanDuration(), n);
+  return found;
+}
+
+int main()
+{
+  LT_SMBusNoPec smbus(100000);
+  LT_I2CBus *bus = smbus.i2cbus();
+  const uint8_t *found;
+  unsigned long start;
+
+  printf("%-28s %8s %8s %6s %9s %9s %6s\n", "case", "limit", "ran at", "probes", "time us",
+         "duration", "found");
+
+  // Slow bus: the old scan raised it to 400 kHz and lost the 0x64 device
+  found = run_scan(&smbus, "100 kHz bus", LT_SMBUS_SCAN_SPEED, true);
+  CHECK(bus_max_speed == 100000);
+  CHECK(bus->getSpeed() == 100000);
+  CHECK(contains(found, 0x64));
+  CHECK(contains(found, 0x20) && contains(found, 0x40) && contains(found, 0x4F));
+  CHECK(!contains(found, 0x5B));
+  CHECK(bus_probes == LT_SMBUS_SCAN_LAST - LT_SMBUS_SCAN_FIRST + 1 - 3);
+
+  found = run_scan(&smbus, "100 kHz bus, global addrs", LT_SMBUS_SCAN_SPEED, false);
+  CHECK(contains(found, 0x5B));
+  CHECK(bus_probes == LT_SMBUS_SCAN_LAST - LT_SMBUS_SCAN_FIRST + 1);
+
+  bus->changeSpeed(400000);
+  found = run_scan(&smbus, "400 kHz bus", LT_SMBUS_SCAN_SPEED, true);
+  CHECK(bus_max_speed == 400000);
+  CHECK(bus->getSpeed() == 400000);
+  CHECK(!contains(found, 0x64));
+
+  found = run_scan(&smbus, "400 kHz bus, 100 kHz limit", 100000, true);
+  CHECK(bus_max_speed == 100000);
+  CHECK(bus->getSpeed() == 400000);
+  CHECK(contains(found, 0x64));
+
+  bus->changeSpeed(1000000);
+  found = run_scan(&smbus, "1 MHz bus", LT_SMBUS_SCAN_SPEED, true);
+  CHECK(bus_max_speed == LT_SMBUS_SCAN_SPEED);
+  CHECK(bus->getSpeed() == 1000000);
+  CHECK(smbus.scanDuration() > 0);
+
+  // Cached: a young result costs no bus traffic, an old one is scanned again
+  bus->changeSpeed(100000);
+  smbus.clearScanCache();
+  bus_probes = 0;
+  smbus.scanCached(LT_SMBUS_SCAN_FIRST, LT_SMBUS_SCAN_LAST, true, LT_SMBUS_SCAN_SPEED, 1000);
+  CHECK(bus_probes > 0);
+  bus_probes = 0;
+  start = host_time_us;
+  delay(500);
+  found = smbus.scanCached(LT_SMBUS_SCAN_FIRST, LT_SMBUS_SCAN_LAST, true, LT_SMBUS_SCAN_SPEED, 1000);
+  printf("%-28s %8lu %8s %6u %9lu %9s %6s\n", "scanCached, 500 ms old", (unsigned long)LT_SMBUS_SCAN_SPEED,
+         "-", bus_probes, host_time_us - start - 500000UL, "-", "-");
+  CHECK(bus_probes == 0);
+  CHECK(contains(found, 0x64));
+  delay(600);
+  smbus.scanCached(LT_SMBUS_SCAN_FIRST, LT_SMBUS_SCAN_LAST, true, LT_SMBUS_SCAN_SPEED, 1000);
+  CHECK(bus_probes > 0);
+
+  printf(failures ? "FAILED (%d checks)\n" : "PASSED\n", failures);
+  return failures != 0;
+}
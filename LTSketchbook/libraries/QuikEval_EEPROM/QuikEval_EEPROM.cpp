@@ -70,9 +70,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 struct demo_board_type demo_board;
 
+static uint8_t demo_board_cached = 0;   // Set once a valid ID string has been read and parsed into demo_board
+
 // Read the id string from the EEPROM, then parse the
 // product name, demo board name, and demo board option
 // from the id string into the global demo_board variable.
+// The result is cached for discover_demo_board() only if the comma fields,
+// product name and demo board name were all found.
 // Returns the number of characters read from the information string.
 uint8_t read_quikeval_id_string(char *buffer)
 {
@@ -80,7 +84,7 @@ uint8_t read_quikeval_id_string(char *buffer)
   uint8_t comma_position[8] = {0};  // Contains the position of the commas in the buffer
   uint8_t comma_count = 0;      // The number of commas found in the buffer
   uint8_t buffer_count;       // The number of characters read
-  int8_t option;              // Temporary demo board option
+  int8_t option = 0;          // Temporary demo board option
   // read the id string from the demo board EEPROM
   // starting EEPROM address=0, terminator=0x0a, max buffer length=52 bytes
   // Enable I2C
@@ -90,11 +94,12 @@ uint8_t read_quikeval_id_string(char *buffer)
   digitalWrite(QUIKEVAL_MUX_MODE_PIN, LOW);
   buffer_count = eeprom_read_buffer_with_terminator(EEPROM_I2C_ADDRESS, buffer, 0, QUIKEVAL_ID_TERMINATOR, QUIKEVAL_ID_SIZE+2);
   digitalWrite(QUIKEVAL_MUX_MODE_PIN, QUIKEVAL_MUX_MODE_PIN_state);  // Restore the QUIKEVAL_MUX_MODE_PIN (8) to its previous state.  (But, it will be left as output.)
+  demo_board_cached = 0;
   if (buffer_count == 0) return(0);   // quit if no data read
   // find comma positions
   for (i = 0; i < buffer_count; i++)
   {
-    if (buffer[i] == ',') comma_position[comma_count++]=i;
+    if ((buffer[i] == ',') && (comma_count < sizeof(comma_position))) comma_position[comma_count++]=i;
   }
 
   if (comma_position[6] < comma_position[5])// comma_position[6]=strlen(buffer);  // some demo boards are missing the last comma
@@ -133,10 +138,21 @@ uint8_t read_quikeval_id_string(char *buffer)
   if ((option >= 0x41) && (option <= 0x5A)) demo_board.option = option;
   // final demo board name is 6 characters without the option
   demo_board.name[6]='\0';
+  // cache only an ID string with all the comma fields and non-empty names that fit demo_board
+  if ((comma_count >= 6) && (comma_position[0] > 0) && (comma_position[0] < sizeof(demo_board.product_name))
+      && (comma_position[6] > comma_position[5] + 1) && ((uint8_t)(comma_position[6] - comma_position[5]) <= sizeof(demo_board.name)))
+    demo_board_cached = 1;
   return(buffer_count);
 }
 
+// Forget the parsed demo board descriptor so the next discover_demo_board() reads the EEPROM again.
+void clear_demo_board_cache()
+{
+  demo_board_cached = 0;
+}
+
 // Read the ID string from the EEPROM and determine if the correct board is connected.
+// The EEPROM is only read if the ID string has not already been parsed into demo_board.
 // Returns 1 if successful, 0 if not successful
 int8_t discover_demo_board(char *demo_name)
 {
@@ -144,7 +160,7 @@ int8_t discover_demo_board(char *demo_name)
   connected = 1;
   // read the ID from the serial EEPROM on the board
   // reuse the buffer declared in UserInterface
-  if (read_quikeval_id_string(&ui_buffer[0]) == 0) connected = 0;
+  if (!demo_board_cached && (read_quikeval_id_string(&ui_buffer[0]) == 0)) connected = 0;
   // make sure it is the correct demo board
   if (strcmp(demo_board.name, demo_name) != 0) connected = 0;
   if (connected != 0)
@@ -230,51 +246,73 @@ uint8_t eeprom_write_byte(uint8_t i2c_address, char data, uint16_t address)
 }
 
 // Write the data byte array to the EEPROM with i2c_address starting at EEPROM address.
-// Returns the total number of bytes written
+// The array is split on EEPROM_PAGE_SIZE boundaries and each page is read first; only the
+// span of bytes that changed is written, with one page write per page.
+// Returns the number of bytes up to the last page whose write was acknowledged, including
+// pages that already matched
 uint8_t eeprom_write_byte_array(uint8_t i2c_address, char data[], uint16_t address, uint8_t num_bytes)
 {
+  char current[EEPROM_PAGE_SIZE];     // Present contents of the page being written
+  uint8_t index = 0;                  // Index of the first byte of the current page in data
+  uint8_t confirmed = 0;              // Bytes of data known to be in the EEPROM
+  uint8_t page_bytes;                 // Number of bytes of data that fall in the current page
+  uint8_t first, last;                // First and last bytes in the current page that differ
   uint8_t i;
-  for (i = 0; i < num_bytes; i++)
+  uint8_t write_pending = 0;
+
+  if (address >= EEPROM_DATA_SIZE)                        // Make sure the address is in bounds
+    return(0);
+  if (num_bytes > EEPROM_DATA_SIZE - address)
+    num_bytes = EEPROM_DATA_SIZE - address;
+
+  while (index < num_bytes)
+  {
+    page_bytes = EEPROM_PAGE_SIZE - (address % EEPROM_PAGE_SIZE);   // Stop at the page boundary
+    if (page_bytes > num_bytes - index)
+      page_bytes = num_bytes - index;
+
+    // Reading the page waits for the previous page write to finish, so this is the only
+    // acknowledge polling loop per page. A successful read also confirms that write.
+    if (eeprom_read_byte_array(i2c_address, current, address, page_bytes) != page_bytes)
+      break;
+    confirmed = index;
+    write_pending = 0;
+    for (first = 0; first < page_bytes; first++)          // Find the first changed byte
+      if (current[first] != data[index + first]) break;
+
+    if (first < page_bytes)
+    {
+      for (last = page_bytes - 1; last > first; last--)   // Find the last changed byte
+        if (current[last] != data[index + last]) break;
+      if (eeprom_poll(i2c_address))
+        break;
+      if (EEPROM_DATA_SIZE > 0x100)
+        i2c_write((address + first)>>8);                  // Send upper byte of address if size > 256 bytes
+      i2c_write(address + first);                         // Send lower byte of address
+      for (i = first; i <= last; i++)
+        i2c_write(data[index + i]);                       // Write the changed span of the page
+      i2c_stop();                                         // The stop bit starts the write process
+      write_pending = 1;
+    }
+    index += page_bytes;
+    address += page_bytes;
+    if (!write_pending)
+      confirmed = index;                                  // Page already matched
+  }
+
+  if (write_pending && (eeprom_write_poll(i2c_address) == 0))  // Wait for the last page to be written
   {
-    if (eeprom_write_byte(i2c_address, data[i], address+i) != 1) break;
+    i2c_stop();
+    confirmed = index;
   }
-  return (i);
+  return (confirmed);
 }
 
-// Write the buffer to the EEPROM with i2c_address starting at EEPROM address in blocks of EEPROM_PAGE_SIZE bytes.
+// Write the null terminated buffer to the EEPROM with i2c_address starting at EEPROM address using eeprom_write_byte_array.
 // Returns the total number of byte written
 uint8_t eeprom_write_buffer(uint8_t i2c_address, char *buffer, uint16_t address)
 {
-  uint8_t i, j;
-  uint8_t index = 0;
-  uint8_t page_count;
-  uint8_t byte_count;
-  page_count=((strlen(buffer)-1)/EEPROM_PAGE_SIZE)+1; // Calculate page count
-  if (address < EEPROM_DATA_SIZE)                       // Make sure the address is in bounds
-  {
-    for (i = 0; i < page_count; i++)
-    {
-      if (!eeprom_poll(i2c_address))                  // Check if EEPROM is ready
-      {
-        if (EEPROM_DATA_SIZE > 0x100)
-          i2c_write(address>>8);                      // Send upper byte of address if size > 256 bytes
-        i2c_write(address);                           // Send lower byte of address
-        byte_count = strlen(buffer)-index;              // Calculate the remaining byte count
-        if (byte_count > EEPROM_PAGE_SIZE)              // Limit to EEPROM_PAGE_SIZE
-          byte_count = EEPROM_PAGE_SIZE;
-        for (j = 0; j < byte_count; j++)
-        {
-          if (address >= EEPROM_DATA_SIZE) break;       // Quit if the address is at the end
-          i2c_write(buffer[index++]);                 // Write byte to EEPROM
-          address++;                                  // Increment the EEPROM address
-        }
-        i2c_stop();                                   // The stop bit starts the write process
-      }
-      else
-        break;
-    }
-  }
-  return(index);                                      // Return the number of bytes written
+  return(eeprom_write_byte_array(i2c_address, buffer, address, strlen(buffer)));
 }
 
 // Read a data byte at address from the EEPROM with i2c_address.
@@ -299,16 +337,27 @@ uint8_t eeprom_read_byte(uint8_t i2c_address, char *data, uint16_t address)
   return(byte_count);
 }
 
-// Read a data byte at address from the EEPROM with i2c_address.
+// Read num_bytes starting at address from the EEPROM with i2c_address in one sequential read.
 // Returns the number of bytes read.
 uint8_t eeprom_read_byte_array(uint8_t i2c_address, char *data, uint16_t address, uint8_t num_bytes)
 {
   uint8_t i;
-  for (i = 0; i < num_bytes; i++)
-  {
-    if (eeprom_read_byte(i2c_address, data+i, address+i) != 1) break;
-  }
-  return (i);
+  if ((num_bytes == 0) || (address >= EEPROM_DATA_SIZE))  // Make sure the address is in bounds
+    return(0);
+  if (num_bytes > EEPROM_DATA_SIZE - address)
+    num_bytes = EEPROM_DATA_SIZE - address;
+  if (eeprom_poll(i2c_address))                       // Check if EEPROM is ready
+    return(0);
+  if (EEPROM_DATA_SIZE > 0x100)
+    i2c_write(address>>8);                            // Send upper byte of address if size > 256 bytes
+  i2c_write(address);                                 // Send lower byte of address
+  i2c_repeated_start();                               // Repeated start
+  i2c_write(i2c_address | I2C_READ_BIT);              // I2C address + read
+  for (i = 0; i < num_bytes - 1; i++)
+    data[i] = i2c_read(WITH_ACK);                     // Sequential read with ACK
+  data[i] = i2c_read(WITH_NACK);                      // Read last byte from EEPROM with NACK
+  i2c_stop();                                         // I2C stop
+  return (num_bytes);
 }
 
 // Read data bytes from the EEPROM starting at address until number bytes read equals count. A null terminator is
@@ -371,23 +420,18 @@ uint8_t eeprom_read_buffer_with_terminator(uint8_t i2c_address, char *buffer, ui
     return(0);
 }
 
-// Write the 2 byte integer data to the EEPROM starting at address. Use the eeprom_write_byte
-// routine to avoid keeping track of page boundaries with the eeprom_write_buffer routine.
+// Write the 2 byte integer data to the EEPROM starting at address. Uses the page aware
+// eeprom_write_byte_array routine, so values may straddle a page boundary.
 // Returns the total number of bytes written.
 uint8_t eeprom_write_int16(uint8_t i2c_address, int16_t write_data, uint16_t address)
 {
   union
   {
     int16_t a;
-    int8_t b[2];
+    char b[2];
   } data;
-  uint8_t byte_count;
   data.a = write_data;                                              // get the data
-  byte_count = eeprom_write_byte(i2c_address, data.b[0], address++);  // write the LSB to EEPROM
-  if (eeprom_write_poll(i2c_address)) return(0);                  // poll EEPROM until complete
-  byte_count+=eeprom_write_byte(i2c_address, data.b[1], address);   // write the MSB to EEPROM
-  if (eeprom_write_poll(i2c_address)) return(1);                  // poll EEPROM until complete
-  return(byte_count);
+  return(eeprom_write_byte_array(i2c_address, data.b, address, 2));
 }
 
 // Read the two byte integer data from the EEPROM starting at address.
@@ -399,15 +443,14 @@ uint8_t eeprom_read_int16(uint8_t i2c_address, int16_t *read_data, uint16_t addr
     int16_t a;
     char b[2];
   } data;
-  uint8_t byte_count = 0;
-  byte_count = eeprom_read_byte(i2c_address, &data.b[0], address++);  // read the LSB from EEPROM
-  byte_count+=eeprom_read_byte(i2c_address, &data.b[1], address++);  // read the MSB from EEPROM
+  uint8_t byte_count;
+  byte_count = eeprom_read_byte_array(i2c_address, data.b, address, 2);
   *read_data = data.a;
   return(byte_count);
 }
 
-// Write the 4 byte float data to the EEPROM starting at address. Use the eeprom_write_byte
-// routine to avoid keeping track of page boundaries with the eeprom_write_buffer routine.
+// Write the 4 byte float data to the EEPROM starting at address. Uses the page aware
+// eeprom_write_byte_array routine, so values may straddle a page boundary.
 // Returns the total number of bytes written.
 uint8_t eeprom_write_float(uint8_t i2c_address, float write_data, uint16_t address)
 {
@@ -416,18 +459,9 @@ uint8_t eeprom_write_float(uint8_t i2c_address, float write_data, uint16_t addre
     float a;
     char b[4];
   } data;
-  uint8_t byte_count;
 
   data.a = write_data;
-  byte_count = eeprom_write_byte(i2c_address, data.b[0], address++);
-  if (eeprom_write_poll(i2c_address)) return(0);
-  byte_count+=eeprom_write_byte(i2c_address, data.b[1], address++);
-  if (eeprom_write_poll(i2c_address)) return(1);
-  byte_count+=eeprom_write_byte(i2c_address, data.b[2], address++);
-  if (eeprom_write_poll(i2c_address)) return(2);
-  byte_count+=eeprom_write_byte(i2c_address, data.b[3], address);
-  if (eeprom_write_poll(i2c_address)) return(3);
-  return(byte_count);
+  return(eeprom_write_byte_array(i2c_address, data.b, address, 4));
 }
 
 // Read the four byte float data from the EEPROM starting at address.
@@ -439,18 +473,15 @@ uint8_t eeprom_read_float(uint8_t i2c_address, float *read_data, uint16_t addres
     float a;
     char b[4];
   } data;
-  uint8_t byte_count = 0;
+  uint8_t byte_count;
 
-  byte_count = eeprom_read_byte(i2c_address, &data.b[0], address++);
-  byte_count+=eeprom_read_byte(i2c_address, &data.b[1], address++);
-  byte_count+=eeprom_read_byte(i2c_address, &data.b[2], address++);
-  byte_count+=eeprom_read_byte(i2c_address, &data.b[3], address++);
+  byte_count = eeprom_read_byte_array(i2c_address, data.b, address, 4);
   *read_data = data.a;
   return(byte_count);
 }
 
-// Write the 4 byte int32 data to the EEPROM starting at address. Use the eeprom_write_byte
-// routine to avoid keeping track of page boundaries with the eeprom_write_buffer routine.
+// Write the 4 byte int32 data to the EEPROM starting at address. Uses the page aware
+// eeprom_write_byte_array routine, so values may straddle a page boundary.
 // Returns the total number of bytes written.
 uint8_t eeprom_write_int32(uint8_t i2c_address, int32_t write_data, uint16_t address)
 {
@@ -459,18 +490,9 @@ uint8_t eeprom_write_int32(uint8_t i2c_address, int32_t write_data, uint16_t add
     int32_t a;
     char b[4];
   } data;
-  uint8_t byte_count;
 
   data.a = write_data;
-  byte_count = eeprom_write_byte(i2c_address, data.b[0], address++);
-  if (eeprom_write_poll(i2c_address)) return(0);
-  byte_count+=eeprom_write_byte(i2c_address, data.b[1], address++);
-  if (eeprom_write_poll(i2c_address)) return(1);
-  byte_count+=eeprom_write_byte(i2c_address, data.b[2], address++);
-  if (eeprom_write_poll(i2c_address)) return(2);
-  byte_count+=eeprom_write_byte(i2c_address, data.b[3], address);
-  if (eeprom_write_poll(i2c_address)) return(3);
-  return(byte_count);
+  return(eeprom_write_byte_array(i2c_address, data.b, address, 4));
 }
 
 // Read the four byte int32 data from the EEPROM starting at address.
@@ -482,16 +504,180 @@ uint8_t eeprom_read_int32(uint8_t i2c_address, int32_t *read_data, uint16_t addr
     int32_t a;
     char b[4];
   } data;
-  uint8_t byte_count = 0;
+  uint8_t byte_count;
 
-  byte_count = eeprom_read_byte(i2c_address, &data.b[0], address++);
-  byte_count+=eeprom_read_byte(i2c_address, &data.b[1], address++);
-  byte_count+=eeprom_read_byte(i2c_address, &data.b[2], address++);
-  byte_count+=eeprom_read_byte(i2c_address, &data.b[3], address++);
+  byte_count = eeprom_read_byte_array(i2c_address, data.b, address, 4);
   *read_data = data.a;
   return(byte_count);
 }
 
+// CRC-16-CCITT (polynomial 0x1021) update for one byte
+static uint16_t eeprom_crc16_update(uint16_t crc, uint8_t data)
+{
+  uint8_t i;
+  crc ^= (uint16_t)data << 8;
+  for (i = 0; i < 8; i++)
+  {
+    if (crc & 0x8000)
+      crc = (crc << 1) ^ 0x1021;
+    else
+      crc = crc << 1;
+  }
+  return(crc);
+}
+
+// Start the record CRC with the version, sequence and length header bytes
+static uint16_t eeprom_record_header_crc(const struct eeprom_record_header *header)
+{
+  uint16_t crc = 0xFFFF;
+  crc = eeprom_crc16_update(crc, header->version);
+  crc = eeprom_crc16_update(crc, header->sequence);
+  crc = eeprom_crc16_update(crc, header->length);
+  return(crc);
+}
+
+// Newer sequence numbers win, allowing for wrap around
+static int8_t eeprom_record_is_newer(const struct eeprom_record_header *a, const struct eeprom_record_header *b)
+{
+  return((int8_t)(a->sequence - b->sequence) > 0);
+}
+
+// Read the record header at slot_address.
+// Returns 0 if the magic byte is present and the length fits in the slot, 1 if not.
+static int8_t eeprom_record_read_header(uint8_t i2c_address, uint16_t slot_address, uint8_t slot_size, struct eeprom_record_header *header)
+{
+  uint8_t data[EEPROM_RECORD_HEADER_SIZE];
+  if (eeprom_read_byte_array(i2c_address, (char *)data, slot_address, EEPROM_RECORD_HEADER_SIZE) != EEPROM_RECORD_HEADER_SIZE)
+    return(1);
+  header->magic = data[0];
+  header->version = data[1];
+  header->sequence = data[2];
+  header->length = data[3];
+  header->crc = data[4] | ((uint16_t)data[5] << 8);
+  if (header->magic != EEPROM_RECORD_MAGIC) return(1);
+  if (header->length > slot_size - EEPROM_RECORD_HEADER_SIZE) return(1);
+  return(0);
+}
+
+// Read the record payload in one sequential read, updating the CRC as each byte arrives.
+// The payload is copied to data unless data is NULL.
+// Returns 0 if the CRC matches the header, 1 if not.
+static int8_t eeprom_record_check_payload(uint8_t i2c_address, uint16_t slot_address, const struct eeprom_record_header *header, uint8_t *data)
+{
+  uint16_t crc;
+  uint16_t address;
+  uint8_t i, value;
+
+  crc = eeprom_record_header_crc(header);
+  if (header->length > 0)
+  {
+    address = slot_address + EEPROM_RECORD_HEADER_SIZE;
+    if (eeprom_poll(i2c_address))                       // Check if EEPROM is ready
+      return(1);
+    if (EEPROM_DATA_SIZE > 0x100)
+      i2c_write(address>>8);                            // Send upper byte of address if size > 256 bytes
+    i2c_write(address);                                 // Send lower byte of address
+    i2c_repeated_start();                               // Repeated start
+    i2c_write(i2c_address | I2C_READ_BIT);              // I2C address + read
+    for (i = 0; i < header->length; i++)
+    {
+      value = i2c_read((i == header->length - 1) ? WITH_NACK : WITH_ACK);  // NACK the last byte
+      crc = eeprom_crc16_update(crc, value);
+      if (data != NULL) data[i] = value;
+    }
+    i2c_stop();                                         // I2C stop
+  }
+  return(crc != header->crc);
+}
+
+// Read the newest valid record from the two slots starting at address and address + slot_size.
+// Returns 0 if a record with matching version and length was copied to data, 1 if not.
+int8_t eeprom_record_read(uint8_t i2c_address, uint16_t address, uint8_t slot_size, uint8_t version, void *data, uint8_t length)
+{
+  struct eeprom_record_header header[2];
+  uint8_t valid[2];
+  uint8_t slot, i;
+
+  if ((length > slot_size - EEPROM_RECORD_HEADER_SIZE) || (slot_size < EEPROM_RECORD_HEADER_SIZE)
+      || ((uint32_t)address + 2 * (uint32_t)slot_size > EEPROM_DATA_SIZE))
+    return(1);
+
+  for (i = 0; i < 2; i++)
+  {
+    valid[i] = (eeprom_record_read_header(i2c_address, address + i * slot_size, slot_size, &header[i]) == 0)
+               && (header[i].version == version) && (header[i].length == length);
+  }
+
+  // Try the newest slot first, then fall back to the other one
+  slot = (valid[1] && (!valid[0] || eeprom_record_is_newer(&header[1], &header[0]))) ? 1 : 0;
+  for (i = 0; i < 2; i++, slot ^= 1)
+  {
+    if (valid[slot] && (eeprom_record_check_payload(i2c_address, address + slot * slot_size, &header[slot], (uint8_t *)data) == 0))
+      return(0);
+  }
+  return(1);
+}
+
+// Write data as a new record into the slot that does not hold the newest valid record.
+// Returns 0 if the record was written and reads back valid, 1 if not.
+int8_t eeprom_record_write(uint8_t i2c_address, uint16_t address, uint8_t slot_size, uint8_t version, const void *data, uint8_t length)
+{
+  struct eeprom_record_header header[2];
+  struct eeprom_record_header record;
+  uint8_t header_bytes[EEPROM_RECORD_HEADER_SIZE];
+  uint8_t valid[2];
+  uint8_t newest, slot, i;
+  uint16_t slot_address;
+
+  if ((length > slot_size - EEPROM_RECORD_HEADER_SIZE) || (slot_size < EEPROM_RECORD_HEADER_SIZE)
+      || ((uint32_t)address + 2 * (uint32_t)slot_size > EEPROM_DATA_SIZE))
+    return(1);
+
+  // Find the newest record of any version that passes its CRC check
+  for (i = 0; i < 2; i++)
+  {
+    slot_address = address + i * slot_size;
+    valid[i] = (eeprom_record_read_header(i2c_address, slot_address, slot_size, &header[i]) == 0)
+               && (eeprom_record_check_payload(i2c_address, slot_address, &header[i], NULL) == 0);
+  }
+  newest = (valid[1] && (!valid[0] || eeprom_record_is_newer(&header[1], &header[0]))) ? 1 : 0;
+
+  record.magic = EEPROM_RECORD_MAGIC;
+  record.version = version;
+  record.length = length;
+  if (valid[newest])
+  {
+    slot = newest ^ 1;                                  // Alternate slots so the newest record survives a failed write
+    record.sequence = header[newest].sequence + 1;
+  }
+  else
+  {
+    slot = 0;
+    record.sequence = 0;
+  }
+  record.crc = eeprom_record_header_crc(&record);
+  for (i = 0; i < length; i++)
+    record.crc = eeprom_crc16_update(record.crc, ((const uint8_t *)data)[i]);
+
+  // Write the payload first and the header last, so a partial write never passes the CRC check
+  slot_address = address + slot * slot_size;
+  if (eeprom_write_byte_array(i2c_address, (char *)data, slot_address + EEPROM_RECORD_HEADER_SIZE, length) != length)
+    return(1);
+  header_bytes[0] = record.magic;
+  header_bytes[1] = record.version;
+  header_bytes[2] = record.sequence;
+  header_bytes[3] = record.length;
+  header_bytes[4] = record.crc & 0xFF;
+  header_bytes[5] = record.crc >> 8;
+  if (eeprom_write_byte_array(i2c_address, (char *)header_bytes, slot_address, EEPROM_RECORD_HEADER_SIZE) != EEPROM_RECORD_HEADER_SIZE)
+    return(1);
+
+  // Read the record back to verify it
+  if (eeprom_record_read_header(i2c_address, slot_address, slot_size, &header[slot]) != 0)
+    return(1);
+  return(eeprom_record_check_payload(i2c_address, slot_address, &header[slot], NULL));
+}
+
 // Write Cal Key back
 uint8_t enable_calibration()
 {
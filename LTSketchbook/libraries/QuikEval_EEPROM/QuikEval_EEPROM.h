@@ -63,6 +63,23 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define EEPROM_TIMEOUT            10      //! EEPROM timeout in ms
 //!@}
 
+//!@name Calibration record constants
+//!@{
+#define EEPROM_RECORD_MAGIC       0xCA    //! First byte of a valid record header
+#define EEPROM_RECORD_HEADER_SIZE 6       //! Record header size in bytes
+//!@}
+
+//! Header stored at the start of each calibration record slot.
+//! The CRC-16-CCITT covers version, sequence, length and the payload.
+struct eeprom_record_header
+{
+  uint8_t magic;               //!< EEPROM_RECORD_MAGIC
+  uint8_t version;             //!< Record layout version chosen by the caller
+  uint8_t sequence;            //!< Incremented on every write, the newest valid slot wins
+  uint8_t length;              //!< Payload length in bytes
+  uint16_t crc;                //!< CRC-16-CCITT, stored LSB first
+};
+
 //! Structure to hold parsed information from
 //! ID string - example: LTC2654-L16,Cls,D2636,01,01,DC,DC1678A-A,-------
 struct demo_board_type
@@ -78,13 +95,19 @@ extern demo_board_type demo_board;
 //! Read the id string from the EEPROM, then parse the
 //! product name, demo board name, and demo board option
 //! from the id string into the global demo_board variable.
+//! The result is cached for discover_demo_board() only if the comma fields,
+//! product name and demo board name were all found.
 //! Returns the number of characters read from the information string.
 uint8_t read_quikeval_id_string(char *buffer);
 
 //! Read the ID string from the EEPROM and determine if the correct board is connected.
+//! The EEPROM is only read if the ID string has not already been parsed into demo_board.
 //! Returns 1 if successful, 0 if not successful
 int8_t discover_demo_board(char *demo_name);
 
+//! Forget the parsed demo board descriptor so the next discover_demo_board() reads the EEPROM again.
+void clear_demo_board_cache();
+
 //! Determine if the EEPROM is ready for communication by writing
 //! the address+!write byte and looking for an acknowledge. This is
 //! repeated every 1ms until an acknowledge occurs, or a timeout occurs.
@@ -102,10 +125,13 @@ int8_t eeprom_write_poll(uint8_t i2c_address);
 uint8_t eeprom_write_byte(uint8_t i2c_address, char data, uint16_t address);
 
 //! Write the data byte array to the EEPROM with i2c_address starting at EEPROM address.
-//!! Returns the total number of bytes written
+//! The array is split on EEPROM_PAGE_SIZE boundaries, bytes that already match are skipped,
+//! and each page is written with a single page write. Returns after the last write completes.
+//! Returns the number of bytes up to the last page whose write was acknowledged, including
+//! pages that already matched. A short count means the EEPROM stopped answering.
 uint8_t eeprom_write_byte_array(uint8_t i2c_address, char data[], uint16_t address, uint8_t num_bytes);
 
-//! Write the buffer to the EEPROM with i2c_address starting at EEPROM address in blocks of EEPROM_PAGE_SIZE bytes.
+//! Write the null terminated buffer to the EEPROM with i2c_address starting at EEPROM address using eeprom_write_byte_array.
 //! Returns the total number of byte written
 uint8_t eeprom_write_buffer(uint8_t i2c_address, char *buffer, uint16_t address);
 
@@ -113,7 +139,7 @@ uint8_t eeprom_write_buffer(uint8_t i2c_address, char *buffer, uint16_t address)
 //! Returns the number of bytes read.
 uint8_t eeprom_read_byte(uint8_t i2c_address, char *data, uint16_t address);
 
-//! Read a data byte at address from the EEPROM with i2c_address.
+//! Read num_bytes starting at address from the EEPROM with i2c_address in one sequential read.
 //! Returns the number of bytes read.
 uint8_t eeprom_read_byte_array(uint8_t i2c_address, char *data, uint16_t address, uint8_t num_bytes);
 
@@ -127,8 +153,8 @@ uint8_t eeprom_read_buffer(uint8_t i2c_address, char *buffer, uint16_t address,
 //! Returns the number of bytes read.
 uint8_t eeprom_read_buffer_with_terminator(uint8_t i2c_address, char *buffer, uint16_t address, char terminator, uint8_t count);
 
-//! Write the 2 byte integer data to the EEPROM starting at address. Use the eeprom_write_byte
-//! routine to avoid keeping track of page boundaries with the eeprom_write_buffer routine.
+//! Write the 2 byte integer data to the EEPROM starting at address. Uses the page aware
+//! eeprom_write_byte_array routine, so values may straddle a page boundary.
 //! Returns the total number of bytes written.
 uint8_t eeprom_write_int16(uint8_t i2c_address, int16_t write_data, uint16_t address);
 
@@ -136,8 +162,8 @@ uint8_t eeprom_write_int16(uint8_t i2c_address, int16_t write_data, uint16_t add
 //! Returns the total number of bytes read.
 uint8_t eeprom_read_int16(uint8_t i2c_address, int16_t *read_data, uint16_t address);
 
-//! Write the 4 byte float data to the EEPROM starting at address. Use the eeprom_write_byte
-//! routine to avoid keeping track of page boundaries with the eeprom_write_buffer routine.
+//! Write the 4 byte float data to the EEPROM starting at address. Uses the page aware
+//! eeprom_write_byte_array routine, so values may straddle a page boundary.
 //! Returns the total number of bytes written.
 uint8_t eeprom_write_float(uint8_t i2c_address, float write_data, uint16_t address);
 
@@ -145,8 +171,8 @@ uint8_t eeprom_write_float(uint8_t i2c_address, float write_data, uint16_t addre
 //! Returns the total number of bytes written
 uint8_t eeprom_read_float(uint8_t i2c_address, float *read_data, uint16_t address);
 
-//! Write the 4 byte long data to the EEPROM starting at address. Use the eeprom_write_byte
-//! routine to avoid keeping track of page boundaries with the eeprom_write_buffer routine.
+//! Write the 4 byte long data to the EEPROM starting at address. Uses the page aware
+//! eeprom_write_byte_array routine, so values may straddle a page boundary.
 //! Returns the total number of bytes written.
 uint8_t eeprom_write_int32(uint8_t i2c_address, int32_t write_data, uint16_t address);
 
@@ -154,6 +180,31 @@ uint8_t eeprom_write_int32(uint8_t i2c_address, int32_t write_data, uint16_t add
 //! Returns the total number of bytes written
 uint8_t eeprom_read_int32(uint8_t i2c_address, int32_t *read_data, uint16_t address);
 
+//! Read the newest valid record from the two slots starting at address and address + slot_size.
+//! Both headers are read, then the payload of the newest one is read in one sequential burst
+//! and checked against the CRC as it arrives. If that fails the other slot is tried.
+//! The contents of data are undefined if no valid record is found.
+//! Returns 0 if a record with matching version and length was copied to data, 1 if not.
+int8_t eeprom_record_read(uint8_t i2c_address,    //!< EEPROM I2C address
+                          uint16_t address,       //!< Start of the first slot
+                          uint8_t slot_size,      //!< Size of each slot, EEPROM_RECORD_HEADER_SIZE + payload or more
+                          uint8_t version,        //!< Expected record version
+                          void *data,             //!< Payload destination
+                          uint8_t length          //!< Expected payload length
+                         );
+
+//! Write data as a new record into the slot that does not hold the newest valid record,
+//! so the previous record survives a failed or interrupted write. The payload is written
+//! before the header and unchanged bytes are skipped by eeprom_write_byte_array.
+//! Returns 0 if the record was written and reads back valid, 1 if not.
+int8_t eeprom_record_write(uint8_t i2c_address,   //!< EEPROM I2C address
+                           uint16_t address,      //!< Start of the first slot
+                           uint8_t slot_size,     //!< Size of each slot, EEPROM_RECORD_HEADER_SIZE + payload or more
+                           uint8_t version,       //!< Record version to store
+                           const void *data,      //!< Payload to store
+                           uint8_t length         //!< Payload length
+                          );
+
 //! Functions to set and clear the calibration key. Useful for swtiching between
 //! calibrated operation and default operation, without actually clearing the stored
 //! calibration numbers.
@@ -0,0 +1,337 @@
+/*
+Host test for the QuikEval EEPROM page writer.
+
+NOT AN ARDUINO SKETCH.  This program builds QuikEval_EEPROM with g++ against
+Utilities/host_stubs and replaces the LT_I2C primitives with a simulated
+24LC025: 256 bytes, 16 byte pages whose write address wraps inside the page,
+and a write cycle that holds off the address acknowledge for a few polls.
+
+  eeprom_write_byte_array() is checked against a reference copy of the
+  memory for random addresses, lengths and partly unchanged data.  It must
+  return the number of bytes stored, never write more than one page write
+  per page touched, and leave the rest of the memory alone.
+
+  A chip that stops acknowledging after its last page write must not be
+  reported as written; the return value only counts confirmed pages.
+
+  discover_demo_board() must cache a well formed ID string and read the
+  EEPROM again after a malformed one.
+
+  eeprom_record_write() and eeprom_record_read() are run through many
+  generations, then the newest slot is corrupted to check the fallback to
+  the previous record and that the next write replaces the corrupt slot.
+
+  make
+  ./eeprom_test
+
+Copyright 2018(c) Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in
+   the documentation and/or other materials provided with the
+   distribution.
+ - Neither the name of Analog Devices, Inc. nor the names of its
+   contributors may be used to endorse or promote products derived
+   from this software without specific prior written permission.
+ - The use of this software may or may not infringe the patent rights
+   of one or more patent holders.  This license does not release you
+   from the requirement that you obtain separate licenses from these
+   patent holders to use this software.
+ - Use of the software either in source or binary form, must be run
+   on or directly connected to an Analog Devices Inc. component.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <Arduino.h>
+#include "LT_I2C.h"
+#include "QuikEval_EEPROM.h"
+
+#define EEPROM_ADDRESS  0xA0
+#define WRITE_CYCLE_POLLS  3      // Address NACKs after each page write
+#define TRIALS          2000
+
+// Simulated 24LC025
+enum sim_state { SIM_IDLE, SIM_ADDRESSED, SIM_WRITING, SIM_READING };
+
+static uint8_t sim_memory[EEPROM_DATA_SIZE];
+static sim_state state = SIM_IDLE;
+static uint8_t pointer;           // Word address
+static uint8_t written;           // Data bytes received in this write
+static int busy;                  // Address polls left to NACK, negative for never ready
+static int page_writes;
+static int read_transactions;
+static int stop_after_writes = -1;  // Page write after which the chip never acknowledges again
+
+int8_t i2c_start()
+{
+  state = SIM_IDLE;
+  return 0;
+}
+
+int8_t i2c_repeated_start()
+{
+  state = SIM_IDLE;               // A write without a stop is abandoned
+  return 0;
+}
+
+void i2c_stop()
+{
+  if (state == SIM_WRITING && written > 0)
+  {
+    pointer = (pointer & ~(EEPROM_PAGE_SIZE - 1)) | ((pointer + written) & (EEPROM_PAGE_SIZE - 1));
+    page_writes++;
+    busy = (page_writes == stop_after_writes) ? -1 : WRITE_CYCLE_POLLS;
+  }
+  state = SIM_IDLE;
+}
+
+int8_t i2c_write(uint8_t data)
+{
+  switch (state)
+  {
+    case SIM_IDLE:
+      if (busy != 0)
+      {
+        if (busy > 0)
+          busy--;
+        return 1;
+      }
+      state = (data & I2C_READ_BIT) ? SIM_READING : SIM_ADDRESSED;
+      if (state == SIM_READING)
+        read_transactions++;
+      return 0;
+    case SIM_ADDRESSED:
+      pointer = data;
+      written = 0;
+      state = SIM_WRITING;
+      return 0;
+    case SIM_WRITING:
+      // Page write: the low address bits wrap, the page bits stay put
+      sim_memory[(pointer & ~(EEPROM_PAGE_SIZE - 1)) | ((pointer + written) & (EEPROM_PAGE_SIZE - 1))] = data;
+      written++;
+      return 0;
+    default:
+      return 1;
+  }
+}
+
+uint8_t i2c_read(int8_t ack)
+{
+  return sim_memory[pointer++];
+}
+
+static int failures;
+
+static void check(int ok, const char *what)
+{
+  if (!ok)
+  {
+    printf("FAIL: %s\n", what);
+    failures++;
+  }
+}
+
+static void sim_reset()
+{
+  memset(sim_memory, 0xFF, sizeof(sim_memory));
+  state = SIM_IDLE;
+  busy = 0;
+  page_writes = 0;
+  stop_after_writes = -1;
+}
+
+static int pages_spanned(int address, int count)
+{
+  return count ? (address + count - 1) / EEPROM_PAGE_SIZE - address / EEPROM_PAGE_SIZE + 1 : 0;
+}
+
+// Random writes against a reference copy of the memory
+static void test_random_writes()
+{
+  uint8_t reference[EEPROM_DATA_SIZE];
+  char data[80], readback[80];
+  int trial, i;
+
+  sim_reset();
+  srand(1);
+  memcpy(reference, sim_memory, sizeof(reference));
+  for (trial = 0; trial < TRIALS; trial++)
+  {
+    int address = rand() % EEPROM_DATA_SIZE;
+    int count = rand() % sizeof(data);
+    int expected = (count > EEPROM_DATA_SIZE - address) ? EEPROM_DATA_SIZE - address : count;
+    int writes_before = page_writes;
+
+    for (i = 0; i < count; i++)
+      data[i] = (rand() % 3) ? reference[(address + i) % EEPROM_DATA_SIZE] : rand();
+
+    check(eeprom_write_byte_array(EEPROM_ADDRESS, data, address, count) == expected, "write count");
+    memcpy(reference + address, data, expected);
+    check(memcmp(reference, sim_memory, sizeof(reference)) == 0, "memory contents");
+    check(page_writes - writes_before <= pages_spanned(address, expected), "one page write per page");
+    check(eeprom_read_byte_array(EEPROM_ADDRESS, readback, address, count) == expected
+          && memcmp(readback, data, expected) == 0, "read back");
+  }
+  printf("%d random writes, %d page writes\n", TRIALS, page_writes);
+}
+
+// A 64 byte record rewritten with the same data costs no page writes
+static void test_unchanged()
+{
+  char data[64];
+  int i;
+
+  sim_reset();
+  for (i = 0; i < 64; i++)
+    data[i] = i;
+  check(eeprom_write_byte_array(EEPROM_ADDRESS, data, 0x48, 64) == 64, "first write count");
+  check(page_writes == pages_spanned(0x48, 64), "first write page writes");
+  page_writes = 0;
+  check(eeprom_write_byte_array(EEPROM_ADDRESS, data, 0x48, 64) == 64, "unchanged write count");
+  check(page_writes == 0, "unchanged write skipped");
+}
+
+// Values straddling a page boundary
+static void test_straddle()
+{
+  int32_t value;
+
+  sim_reset();
+  check(eeprom_write_int32(EEPROM_ADDRESS, 0x12345678, 14) == 4, "int32 write count");
+  check(eeprom_read_int32(EEPROM_ADDRESS, &value, 14) == 4 && value == 0x12345678, "int32 read back");
+  check(page_writes == 2, "int32 page writes");
+}
+
+// The chip stops acknowledging after the Nth page write
+static void test_stuck()
+{
+  char data[48];
+  int n;
+
+  memset(data, 0x5A, sizeof(data));
+  for (n = 1; n <= 3; n++)
+  {
+    sim_reset();
+    stop_after_writes = n;
+    check(eeprom_write_byte_array(EEPROM_ADDRESS, data, 0x10, sizeof(data)) == (n - 1) * EEPROM_PAGE_SIZE,
+          "stuck chip counts only confirmed pages");
+  }
+  // An unconfirmed last page of an unaligned write
+  sim_reset();
+  stop_after_writes = 2;
+  check(eeprom_write_byte_array(EEPROM_ADDRESS, data, 0x1C, 8) == 4, "unaligned stuck write");
+}
+
+static void load_id_string(const char *id)
+{
+  sim_reset();
+  memcpy(sim_memory, id, strlen(id) + 1);
+  clear_demo_board_cache();
+}
+
+// A good ID string is read once, a malformed one is not cached
+static void test_id_cache()
+{
+  char dc1337[] = "DC1337";
+  char dc1234[] = "DC1234";
+
+  load_id_string("LTC2309,Cls,D1859,01,01,DC,DC1337A-A,------------\n");
+  check(discover_demo_board(dc1337) == 1, "good ID string found");
+  check(strcmp(demo_board.product_name, "LTC2309") == 0 && demo_board.option == 'A', "good ID string parsed");
+  read_transactions = 0;
+  check(discover_demo_board(dc1337) == 1 && read_transactions == 0, "good ID string cached");
+
+  // Missing the trailing comma after the demo board name
+  load_id_string("LTC2309,Cls,D1859,01,01,DC,DC1337A-A------------\n");
+  check(discover_demo_board(dc1337) == 1, "ID string without last comma found");
+  read_transactions = 0;
+  check(discover_demo_board(dc1337) == 1 && read_transactions == 0, "ID string without last comma cached");
+
+  // Truncated and empty fields are parsed but must be read again next time
+  static const char *bad[] =
+  {
+    "LTC2309,Cls,D1859,01\n",
+    ",Cls,D1859,01,01,DC,DC1337A-A,\n",
+    "LTC2309,Cls,D1859,01,01,DC,,\n",
+    ",,,,,,,,,,,,,,,,,,,,\n",
+  };
+  for (unsigned int i = 0; i < sizeof(bad) / sizeof(bad[0]); i++)
+  {
+    load_id_string(bad[i]);
+    discover_demo_board(dc1337);
+    read_transactions = 0;
+    discover_demo_board(dc1337);
+    check(read_transactions > 0, "malformed ID string not cached");
+  }
+
+  // Once the board answers with a good string it is cached again
+  load_id_string("LTC1234,Cls,D1859,01,01,DC,DC1234A-A,------------\n");
+  check(discover_demo_board(dc1234) == 1, "good ID string after malformed one");
+}
+
+// Double buffered calibration records
+static void test_records()
+{
+  const uint16_t base = 0x80;
+  const uint8_t slot_size = 32;
+  uint8_t data[20], readback[20];
+  int generation, i, slot;
+
+  sim_reset();
+  check(eeprom_record_read(EEPROM_ADDRESS, base, slot_size, 1, readback, sizeof(readback)) == 1, "blank EEPROM has no record");
+  for (generation = 0; generation < 300; generation++)
+  {
+    for (i = 0; i < (int)sizeof(data); i++)
+      data[i] = generation + i;
+    check(eeprom_record_write(EEPROM_ADDRESS, base, slot_size, 1, data, sizeof(data)) == 0, "record write");
+    memset(readback, 0, sizeof(readback));
+    check(eeprom_record_read(EEPROM_ADDRESS, base, slot_size, 1, readback, sizeof(readback)) == 0
+          && memcmp(readback, data, sizeof(data)) == 0, "record read back");
+  }
+  check(eeprom_record_read(EEPROM_ADDRESS, base, slot_size, 2, readback, sizeof(readback)) == 1, "record version checked");
+
+  // Corrupt the newest record, the previous generation must be returned
+  slot = memcmp(sim_memory + base + EEPROM_RECORD_HEADER_SIZE, data, sizeof(data)) == 0 ? 0 : 1;
+  sim_memory[base + slot * slot_size + 10] ^= 1;
+  check(eeprom_record_read(EEPROM_ADDRESS, base, slot_size, 1, readback, sizeof(readback)) == 0
+        && readback[0] == (uint8_t)(generation - 2), "fallback to previous record");
+
+  // The next write goes into the corrupt slot
+  for (i = 0; i < (int)sizeof(data); i++)
+    data[i] = 7 * i;
+  eeprom_record_write(EEPROM_ADDRESS, base, slot_size, 1, data, sizeof(data));
+  check(memcmp(sim_memory + base + slot * slot_size + EEPROM_RECORD_HEADER_SIZE, data, sizeof(data)) == 0,
+        "write replaces corrupt slot");
+}
+
+int main()
+{
+  test_random_writes();
+  test_unchanged();
+  test_straddle();
+  test_stuck();
+  test_id_cache();
+  test_records();
+
+  printf("\n%s\n", failures ? "FAILED" : "PASSED");
+  return failures ? 1 : 0;
+}